@@ -0,0 +1,198 @@
+#ifndef ASYNCPRICING_H
+#define ASYNCPRICING_H
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Pricer.h"
+
+/**
+ * @brief Fixed-size thread pool that runs submitted pricing work.
+ *
+ * Tasks run in submission order on the first free worker. Destroying the
+ * executor finishes every queued task before joining the workers, so no
+ * future obtained from it is left without a value.
+ */
+class PricingExecutor {
+ public:
+  /**
+   * @brief Starts the worker threads.
+   * @param threads the number of workers (0 = all cores).
+   */
+  explicit PricingExecutor(unsigned threads = 0);
+  ~PricingExecutor();
+  PricingExecutor(const PricingExecutor&) = delete;
+  PricingExecutor& operator=(const PricingExecutor&) = delete;
+
+  /**
+   * @brief Gets a process-wide executor using every core.
+   */
+  static PricingExecutor& shared();
+
+  /**
+   * @brief Queues a task.
+   * @throws std::runtime_error if the executor is shutting down.
+   */
+  void post(std::function<void()> task);
+
+  /**
+   * @brief Queues a callable and returns a future for its result.
+   */
+  template <class F>
+  std::future<std::invoke_result_t<F>> submit(F&& f) {
+    auto task{std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(
+        std::forward<F>(f))};
+    auto future{task->get_future()};
+    post([task] { (*task)(); });
+    return future;
+  }
+
+  std::size_t threadCount() const { return workers.size(); }
+
+ private:
+  std::mutex mutex{};
+  std::condition_variable ready{};
+  std::deque<std::function<void()>> tasks{};
+  bool stopping{false};
+  std::vector<std::jthread> workers{};
+
+  void workLoop();
+};
+
+/**
+ * @brief Outcome of an asynchronous pricing.
+ *
+ * A cancelled Monte Carlo pricing still carries the estimate over the paths
+ * it finished; the pricer itself can be queried for details (path counts,
+ * VaR, Greeks where available).
+ */
+struct AsyncPriceResult {
+  bool cancelled{false};
+  std::optional<double> price{};          // empty if nothing was priced
+  std::optional<double> standardError{};  // empty for analytic engines
+  std::shared_ptr<Pricer> pricer{};
+};
+
+namespace async {
+/**
+ * @brief Prices synchronously with cancellation; the body of every async
+ * entry point.
+ *
+ * @param pricer the pricer to run.
+ * @param token stops the pricing between chunks.
+ * @return the (possibly partial) result.
+ */
+AsyncPriceResult run(std::shared_ptr<Pricer> pricer, std::stop_token token);
+
+/**
+ * @brief Submits a pricing to an executor.
+ *
+ * @param pricer the pricer to run; shared so it stays alive until done.
+ * @param token optional stop token for cooperative cancellation.
+ * @param executor the executor to run on.
+ * @return a future for the result.
+ */
+std::future<AsyncPriceResult> priceFuture(
+    std::shared_ptr<Pricer> pricer, std::stop_token token = {},
+    PricingExecutor& executor = PricingExecutor::shared());
+
+/**
+ * @brief Awaitable that prices on an executor and resumes the awaiting
+ * coroutine there once done.
+ */
+class PriceAwaitable {
+ public:
+  PriceAwaitable(std::shared_ptr<Pricer> pricer, std::stop_token token,
+                 PricingExecutor& executor)
+      : pricer{std::move(pricer)}, token{std::move(token)}, executor{executor} {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    executor.post([this, handle] {
+      try {
+        result = run(pricer, token);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      handle.resume();  // may destroy *this; nothing touches it afterwards
+    });
+  }
+
+  AsyncPriceResult await_resume() {
+    if (error) std::rethrow_exception(error);
+    return std::move(result);
+  }
+
+ private:
+  std::shared_ptr<Pricer> pricer;
+  std::stop_token token;
+  PricingExecutor& executor;
+  AsyncPriceResult result{};
+  std::exception_ptr error{};
+};
+
+/**
+ * @brief Gets an awaitable pricing: `auto r = co_await async::price(p);`.
+ */
+inline PriceAwaitable price(
+    std::shared_ptr<Pricer> pricer, std::stop_token token = {},
+    PricingExecutor& executor = PricingExecutor::shared()) {
+  return PriceAwaitable{std::move(pricer), std::move(token), executor};
+}
+
+/**
+ * @brief Minimal eagerly started coroutine returning a value.
+ *
+ * Lets plain code start coroutines that co_await pricings and collect their
+ * result with get(). Frameworks with their own task type can co_await
+ * async::price() directly instead.
+ *
+ * @tparam T the coroutine's (non-void) result type.
+ */
+template <class T>
+class Task {
+ public:
+  struct promise_type {
+    std::promise<T> result{};
+
+    Task get_return_object() { return Task{result.get_future().share()}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_value(T value) { result.set_value(std::move(value)); }
+    void unhandled_exception() { result.set_exception(std::current_exception()); }
+  };
+
+  /**
+   * @brief Waits for the coroutine and gets its result (or rethrows); may
+   * be called repeatedly.
+   */
+  T get() { return future.get(); }
+
+  /**
+   * @brief Checks whether the coroutine has finished.
+   */
+  bool isReady() const {
+    return future.wait_for(std::chrono::seconds{0}) ==
+           std::future_status::ready;
+  }
+
+ private:
+  explicit Task(std::shared_future<T> future) : future{std::move(future)} {}
+  std::shared_future<T> future;
+};
+}  // namespace async
+
+#endif  // ASYNCPRICING_H
@@ -0,0 +1,156 @@
+#ifndef BATCHIO_H
+#define BATCHIO_H
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Option.h"
+
+class PriceCache;
+
+/**
+ * @brief The pricing engines selectable in batch mode.
+ */
+enum class BatchEngine { BLACK_SCHOLES, MONTE_CARLO, IMPLIED_VOL };
+
+/**
+ * @brief One input row of a batch: option parameters plus an optional
+ * market price (required by the implied-vol engine).
+ */
+struct OptionRecord {
+  std::uint64_t id{0};  // position in the input stream
+  OptionType type{OptionType::CALL};
+  double S{}, K{}, T{}, r{}, sigma{}, q{};
+  double marketPrice{0.0};
+  std::string error{};  // non-empty if the row could not be read
+};
+
+/**
+ * @brief One output row of a batch.
+ */
+struct BatchResult {
+  std::uint64_t id{0};
+  double value{0.0};          // price, or implied vol for the IV engine
+  double standardError{0.0};  // Monte Carlo only
+  std::string error{};        // non-empty if the record could not be priced
+};
+
+/**
+ * @brief Settings shared by every record of a batch run.
+ */
+struct BatchConfig {
+  BatchEngine engine{BatchEngine::BLACK_SCHOLES};
+  unsigned long numSimulations{100000};
+  unsigned int seed{42u};  // MC seed is seed + record id
+  // derive the MC seed from the contract instead of the record id, so
+  // duplicate contracts get identical paths (and share cache entries)
+  bool seedByContract{false};
+  PriceCache* cache{nullptr};  // optional shared result cache
+};
+
+namespace batch {
+/// Magic bytes at the start of a binary option stream.
+constexpr char BINARY_MAGIC[8] = {'M', 'C', 'P', 'O', 'P', 'T', '0', '1'};
+
+/**
+ * @brief Parses an engine name ("bs", "mc" or "iv").
+ *
+ * @param name the engine name.
+ * @return the engine.
+ * @throws std::invalid_argument if the name is unknown.
+ */
+BatchEngine parseEngine(std::string_view name);
+
+/**
+ * @brief Parses one CSV line of the form type,S,K,T,r,sigma,q[,price].
+ *
+ * The type is "call"/"put" (or "c"/"p"), case-insensitive. Blank lines,
+ * lines starting with '#' and a header line starting with "type" are
+ * skipped.
+ *
+ * @param line the text of the line, without the newline.
+ * @param out the record to fill (its id is left untouched).
+ * @return true if a record was parsed, false if the line was skipped.
+ * @throws std::invalid_argument if the line is malformed.
+ */
+bool parseCsvLine(std::string_view line, OptionRecord& out);
+
+/**
+ * @brief Reads up to maxRecords CSV records from a stream.
+ *
+ * A malformed line still takes the next id and becomes a record whose
+ * error is set, so one bad row does not stop a batch.
+ *
+ * @param in the input stream.
+ * @param out the batch to fill (cleared first).
+ * @param maxRecords the batch size.
+ * @param nextId the id of the next record; advanced for each record read.
+ * @return the number of records read (0 at end of input).
+ */
+std::size_t readCsvBatch(std::istream& in, std::vector<OptionRecord>& out,
+                         std::size_t maxRecords, std::uint64_t& nextId);
+
+/**
+ * @brief Checks the magic header of a binary option stream.
+ *
+ * @param in the input stream, positioned at the start.
+ * @throws std::runtime_error if the header is missing or wrong.
+ */
+void readBinaryHeader(std::istream& in);
+
+/**
+ * @brief Reads up to maxRecords fixed-size binary records from a stream.
+ *
+ * Each record is 64 bytes: the option type as one byte, 7 bytes of padding,
+ * then S, K, T, r, sigma, q and the market price as native doubles. A
+ * type byte other than 0 (call) or 1 (put) yields a record whose error is
+ * set.
+ *
+ * @param in the input stream, positioned after the header.
+ * @param out the batch to fill (cleared first).
+ * @param maxRecords the batch size.
+ * @param nextId the id of the next record; advanced for each record read.
+ * @return the number of records read (0 at end of input).
+ * @throws std::runtime_error if the stream ends mid-record.
+ */
+std::size_t readBinaryBatch(std::istream& in, std::vector<OptionRecord>& out,
+                            std::size_t maxRecords, std::uint64_t& nextId);
+
+/**
+ * @brief Writes the binary header followed by the given records.
+ *
+ * @param out the output stream.
+ * @param records the records to write.
+ * @param withHeader whether to write the magic header first.
+ */
+void writeBinaryRecords(std::ostream& out,
+                        const std::vector<OptionRecord>& records,
+                        bool withHeader = true);
+
+/**
+ * @brief Prices one record with the configured engine.
+ *
+ * Never throws: invalid inputs, and records that could not be read, are
+ * reported in BatchResult::error so one bad row does not stop a batch.
+ *
+ * @param record the record to price.
+ * @param config the batch settings.
+ * @return the result for the record.
+ */
+BatchResult priceRecord(const OptionRecord& record, const BatchConfig& config);
+
+/**
+ * @brief Writes one result as a CSV line: id,value,std_error,error.
+ *
+ * The error is written as a quoted field with embedded quotes doubled.
+ *
+ * @param out the output stream.
+ * @param result the result to write.
+ */
+void writeCsvResult(std::ostream& out, const BatchResult& result);
+}  // namespace batch
+
+#endif  // BATCHIO_H
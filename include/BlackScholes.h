@@ -1,5 +1,7 @@
 #ifndef BLACKSCHOLES_H
 #define BLACKSCHOLES_H
+#include <span>
+
 #include "Pricer.h"
 
 /**
@@ -23,8 +25,32 @@ class BlackScholes : public Pricer {
    */
   double calculatePrice() const override;
 
+  /**
+   * @brief Black-Scholes price from raw parameters.
+   *
+   * Same formula and T≈0 / σ≈0 fallbacks as calculatePrice(), without
+   * constructing (and re-validating) an Option.
+   *
+   * @return the analytic price.
+   */
+  static double price(OptionType type, double S, double K, double T, double r,
+                      double sigma, double q);
+
+  /**
+   * @brief Prices a whole column set of options.
+   *
+   * @param options the option parameters, one row per option.
+   * @param out receives one price per row; must have options.size() entries.
+   * @throws std::invalid_argument if the sizes differ.
+   */
+  static void priceBatch(const OptionColumns& options, std::span<double> out);
+
   std::string getPricingMethod() const override { return "Black-Scholes"; }
 
+  std::optional<PriceKey> cacheKey() const override {
+    return PriceKey::make(PriceKey::engineId("Black-Scholes"), option);
+  }
+
   /**
    * @brief Computes option Greeks analytically (Δ, Γ, Θ, ν, ρ).
    * @return a Greeks struct populated with sensitivity values.
@@ -0,0 +1,115 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+/**
+ * @brief Blocking multi-producer/multi-consumer queue with a fixed capacity.
+ *
+ * Used to connect pipeline stages: a full queue blocks its producer, which
+ * propagates backpressure upstream and keeps memory use constant. The time
+ * producers and consumers spend blocked is recorded so a pipeline can report
+ * which stage is the bottleneck.
+ *
+ * @tparam T the element type.
+ */
+template <class T>
+class BoundedQueue {
+ public:
+  /**
+   * @brief Time spent blocked on either side of the queue.
+   */
+  struct Stats {
+    std::size_t pushWaits{0};                        // pushes that blocked
+    std::size_t popWaits{0};                         // pops that blocked
+    std::chrono::duration<double> pushBlocked{0.0};  // producer stall time
+    std::chrono::duration<double> popBlocked{0.0};   // consumer stall time
+  };
+
+  /**
+   * @brief Constructs an empty queue.
+   * @param capacity the maximum number of queued elements (> 0).
+   */
+  explicit BoundedQueue(std::size_t capacity) : capacity{capacity} {
+    if (capacity == 0) {
+      throw std::invalid_argument("Queue capacity must be positive.");
+    }
+  }
+
+  /**
+   * @brief Appends an element, blocking while the queue is full.
+   *
+   * @param value the element to append.
+   * @return false if the queue was closed (the element is dropped).
+   */
+  bool push(T value) {
+    std::unique_lock lock{mutex};
+    if (!closed && items.size() >= capacity) {
+      const auto start{std::chrono::steady_clock::now()};
+      notFull.wait(lock, [&] { return closed || items.size() < capacity; });
+      ++stats.pushWaits;
+      stats.pushBlocked += std::chrono::steady_clock::now() - start;
+    }
+    if (closed) return false;
+    items.push_back(std::move(value));
+    notEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element, blocking while the queue is empty.
+   *
+   * @return the element, or std::nullopt once the queue is closed and
+   * drained.
+   */
+  std::optional<T> pop() {
+    std::unique_lock lock{mutex};
+    if (!closed && items.empty()) {
+      const auto start{std::chrono::steady_clock::now()};
+      notEmpty.wait(lock, [&] { return closed || !items.empty(); });
+      ++stats.popWaits;
+      stats.popBlocked += std::chrono::steady_clock::now() - start;
+    }
+    if (items.empty()) return std::nullopt;
+    T value{std::move(items.front())};
+    items.pop_front();
+    notFull.notify_one();
+    return value;
+  }
+
+  /**
+   * @brief Closes the queue: pending elements can still be popped, further
+   * pushes fail and blocked callers wake up.
+   */
+  void close() {
+    std::lock_guard lock{mutex};
+    closed = true;
+    notEmpty.notify_all();
+    notFull.notify_all();
+  }
+
+  /**
+   * @brief Gets the blocking statistics so far.
+   * @return a snapshot of the statistics.
+   */
+  Stats getStats() const {
+    std::lock_guard lock{mutex};
+    return stats;
+  }
+
+ private:
+  const std::size_t capacity;
+  std::deque<T> items{};
+  bool closed{false};
+  Stats stats{};
+  mutable std::mutex mutex{};
+  std::condition_variable notFull{};
+  std::condition_variable notEmpty{};
+};
+
+#endif  // BOUNDEDQUEUE_H
@@ -0,0 +1,133 @@
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Thread-local, size-classed cache of simulation buffers.
+ *
+ * Blocks are rounded up to a power-of-two size class (minimum 4 KiB) and,
+ * when released, kept on a per-class free list instead of being returned to
+ * the system. A pricer destroyed on one thread therefore hands its storage
+ * to the next pricer created on that thread, avoiding malloc/free and fresh
+ * page faults in tight pricing loops. Classes of 2 MiB and above are backed
+ * by anonymous mappings that may be advised as transparent huge pages.
+ *
+ * Each thread owns its own pool, so no locking is needed; a block may be
+ * released on a different thread than the one that acquired it.
+ */
+class BufferPool {
+ public:
+  /**
+   * @brief Tunables for a thread's pool.
+   */
+  struct Config {
+    std::size_t maxCachedPerClass{8};  // free blocks kept per size class
+    bool hugePages{true};              // advise large blocks as huge pages
+  };
+
+  /**
+   * @brief Counters describing how well the pool is being reused.
+   */
+  struct Stats {
+    std::size_t hits{0};         // requests served from a free list
+    std::size_t misses{0};       // requests that went to the system
+    std::size_t cachedBytes{0};  // bytes currently held on free lists
+  };
+
+  ~BufferPool();
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  /**
+   * @brief Gets the calling thread's pool.
+   * @return a reference to the thread-local pool.
+   */
+  static BufferPool& local();
+
+  /**
+   * @brief Acquires a block of at least the given size from the calling
+   * thread's pool.
+   *
+   * Requests smaller than the minimum size class bypass the pool.
+   *
+   * @param bytes the number of bytes required.
+   * @return a 64-byte aligned pointer to the block.
+   */
+  static void* acquire(std::size_t bytes);
+
+  /**
+   * @brief Returns a block previously obtained from acquire().
+   *
+   * @param ptr the block to return.
+   * @param bytes the size originally requested.
+   */
+  static void release(void* ptr, std::size_t bytes) noexcept;
+
+  /**
+   * @brief Replaces this pool's configuration.
+   * @param newConfig the new settings.
+   */
+  void configure(const Config& newConfig);
+
+  /**
+   * @brief Gets this pool's reuse counters.
+   * @return a snapshot of the counters.
+   */
+  Stats getStats() const { return stats; }
+
+  /**
+   * @brief Frees every cached block back to the system.
+   */
+  void trim() noexcept;
+
+ private:
+  BufferPool() = default;
+
+  static constexpr std::size_t MIN_CLASS_SHIFT{12};  // 4 KiB
+  static constexpr std::size_t HUGE_CLASS_SHIFT{21};  // 2 MiB
+  static constexpr std::size_t NUM_CLASSES{48 - MIN_CLASS_SHIFT};
+
+  Config config{};
+  Stats stats{};
+  std::array<std::vector<void*>, NUM_CLASSES> freeLists{};
+
+  void* allocateClass(std::size_t shift);
+  void cacheOrFree(void* ptr, std::size_t shift) noexcept;
+  static std::size_t classShift(std::size_t bytes);
+  static void* systemAllocate(std::size_t shift, bool hugePages);
+  static void systemFree(void* ptr, std::size_t shift) noexcept;
+};
+
+/**
+ * @brief Stateless standard allocator drawing from the thread-local
+ * BufferPool.
+ *
+ * @tparam T the element type.
+ */
+template <class T>
+struct PoolAllocator {
+  using value_type = T;
+
+  PoolAllocator() noexcept = default;
+  template <class U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(BufferPool::acquire(n * sizeof(T)));
+  }
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    BufferPool::release(ptr, n * sizeof(T));
+  }
+
+  template <class U>
+  bool operator==(const PoolAllocator<U>&) const noexcept {
+    return true;
+  }
+};
+
+/// Pool-backed vector used for simulation paths and scratch space.
+using SimBuffer = std::vector<double, PoolAllocator<double>>;
+
+#endif  // BUFFERPOOL_H
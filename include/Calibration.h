@@ -0,0 +1,130 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+#include <span>
+#include <vector>
+
+#include "Heston.h"
+
+/**
+ * @brief Raw SVI parameterization of one expiry's total implied variance,
+ * w(k) = a + b(ρ(k - m) + √((k - m)² + σ²)) in log-moneyness k = ln(K/F).
+ */
+struct SviParams {
+  double a{0.01};
+  double b{0.1};
+  double rho{0.0};
+  double m{0.0};
+  double sigma{0.1};
+
+  /**
+   * @brief Gets the total implied variance w(k).
+   */
+  double totalVariance(double k) const;
+
+  /**
+   * @brief Gets Durrleman's density factor g(k); the slice is free of
+   * butterfly arbitrage where g(k) >= 0.
+   */
+  double durrleman(double k) const;
+};
+
+namespace calibration {
+/**
+ * @brief One implied-volatility quote.
+ */
+struct Quote {
+  double expiry{0.0};
+  double strike{0.0};
+  double vol{0.0};
+  double weight{1.0};
+};
+
+/**
+ * @brief Settings shared by the calibrators.
+ */
+struct Config {
+  unsigned maxIterations{100};  // Levenberg-Marquardt iterations
+  double tolerance{1e-10};      // relative cost or step change to stop at
+  unsigned threads{0};          // 0 = all cores
+};
+
+/**
+ * @brief The SVI fit of one expiry.
+ */
+struct SviFit {
+  double expiry{0.0};
+  SviParams params{};
+  double rmse{0.0};  // implied-volatility RMSE over the slice's quotes
+  unsigned iterations{0};
+  bool butterflyFree{true};  // g(k) >= 0 across and beyond the quotes
+  bool calendarFree{true};   // w(k) not below the previous expiry's
+};
+
+/**
+ * @brief Fits SVI to every expiry slice.
+ *
+ * Quotes are grouped by exact expiry. Each slice is fitted by projected
+ * Levenberg-Marquardt on total variance; the parameters are kept inside
+ * the bounds b >= 0, |ρ| < 1, σ > 0, b(1 + |ρ|) <= 2 (Lee's wing bound)
+ * and min w >= 0, and negative Durrleman factors on a grid around the
+ * quotes are penalized so the fit stays free of butterfly arbitrage. The
+ * Jacobian is analytic for the quote residuals and central-differenced for
+ * the penalty rows. Slices are fitted in parallel, then
+ * checked pairwise for calendar arbitrage.
+ *
+ * @param quotes the quotes, in any order.
+ * @param spot the spot.
+ * @param r the risk-free rate.
+ * @param q the dividend yield.
+ * @param config the solver settings.
+ * @param previous earlier fits; a slice with the same expiry starts from
+ * its parameters instead of the default guess.
+ * @return one fit per expiry, in increasing expiry order.
+ * @throws std::invalid_argument if a quote is not positive, a slice has
+ * fewer than five quotes or the spot is not positive.
+ */
+std::vector<SviFit> fitSvi(std::span<const Quote> quotes, double spot,
+                           double r, double q, const Config& config,
+                           std::span<const SviFit> previous = {});
+
+/**
+ * @brief The result of a Heston calibration.
+ */
+struct HestonFit {
+  HestonParams params{};
+  double rmse{0.0};  // vega-scaled price error, ≈ implied-volatility RMSE
+  unsigned iterations{0};
+  bool converged{false};
+};
+
+/**
+ * @brief Calibrates Heston to the whole surface at once.
+ *
+ * Minimizes vega-scaled call-price errors (C_model - C_market) / vega, a
+ * first-order proxy for implied-volatility errors that needs no inversion,
+ * by projected Levenberg-Marquardt. Model prices use the Lewis integral on
+ * Gauss-Legendre nodes fixed per expiry, with the strike rotations e^{iuk}
+ * tabulated once, so each iteration is one characteristic-function
+ * evaluation per node and expiry followed by multiply-adds per quote. The
+ * characteristic function is evaluated on forward-mode dual numbers, which
+ * gives the exact gradient of the quadrature price with respect to all
+ * five parameters in the same pass. Expiries and quotes are processed in
+ * parallel.
+ *
+ * @param quotes the quotes, in any order.
+ * @param spot the spot.
+ * @param r the risk-free rate.
+ * @param q the dividend yield.
+ * @param initial the starting point, typically the previous fit.
+ * @param config the solver settings.
+ * @return the fitted parameters and diagnostics.
+ * @throws std::invalid_argument if there are fewer than five quotes, a
+ * quote is not positive, the spot is not positive or the initial
+ * parameters are invalid.
+ */
+HestonFit fitHeston(std::span<const Quote> quotes, double spot, double r,
+                    double q, const HestonParams& initial,
+                    const Config& config);
+}  // namespace calibration
+
+#endif  // CALIBRATION_H
@@ -0,0 +1,103 @@
+#ifndef CHARACTERISTICFUNCTION_H
+#define CHARACTERISTICFUNCTION_H
+#include <complex>
+#include <memory>
+#include <string>
+
+#include "Heston.h"
+#include "Merton.h"
+
+/**
+ * @brief Cumulants of a log-return, used to size Fourier truncation ranges.
+ */
+struct Cumulants {
+  double c1{0.0};  // mean
+  double c2{0.0};  // variance
+  double c4{0.0};  // fourth cumulant
+};
+
+/**
+ * @brief Model plugged into FourierPricer: the characteristic function of
+ * the centred log-return X = ln(S_T / S_0) - (r - q)T.
+ *
+ * Models are immutable once constructed, so one instance can be shared by
+ * many pricers and threads.
+ */
+class CharacteristicFunction {
+ public:
+  virtual ~CharacteristicFunction() = default;
+
+  /**
+   * @brief Evaluates E[exp(i·u·X)] at horizon T; u may be complex.
+   */
+  virtual std::complex<double> operator()(std::complex<double> u,
+                                          double T) const = 0;
+
+  /**
+   * @brief Gets the cumulants of X at horizon T.
+   */
+  virtual Cumulants cumulants(double T) const = 0;
+
+  /**
+   * @brief Gets a copy with the model's volatility level bumped (σ for
+   * Black-Scholes and Merton, √v0 for Heston), for vega.
+   */
+  virtual std::unique_ptr<CharacteristicFunction> withVolatilityBump(
+      double eps) const = 0;
+
+  virtual std::string name() const = 0;
+};
+
+/**
+ * @brief Lognormal log-returns (constant volatility).
+ */
+class BlackScholesCF : public CharacteristicFunction {
+ public:
+  explicit BlackScholesCF(double sigma);
+  std::complex<double> operator()(std::complex<double> u,
+                                  double T) const override;
+  Cumulants cumulants(double T) const override;
+  std::unique_ptr<CharacteristicFunction> withVolatilityBump(
+      double eps) const override;
+  std::string name() const override { return "Black-Scholes"; }
+
+ private:
+  double sigma;
+};
+
+/**
+ * @brief Heston stochastic volatility (see heston::characteristicFunction).
+ */
+class HestonCF : public CharacteristicFunction {
+ public:
+  explicit HestonCF(const HestonParams& params);
+  std::complex<double> operator()(std::complex<double> u,
+                                  double T) const override;
+  /// Mean and variance are exact; c4 is left at 0 (widen the range instead).
+  Cumulants cumulants(double T) const override;
+  std::unique_ptr<CharacteristicFunction> withVolatilityBump(
+      double eps) const override;
+  std::string name() const override { return "Heston"; }
+
+ private:
+  HestonParams params;
+};
+
+/**
+ * @brief Merton jump-diffusion (see merton::characteristicFunction).
+ */
+class MertonCF : public CharacteristicFunction {
+ public:
+  explicit MertonCF(const MertonParams& params);
+  std::complex<double> operator()(std::complex<double> u,
+                                  double T) const override;
+  Cumulants cumulants(double T) const override;
+  std::unique_ptr<CharacteristicFunction> withVolatilityBump(
+      double eps) const override;
+  std::string name() const override { return "Merton"; }
+
+ private:
+  MertonParams params;
+};
+
+#endif  // CHARACTERISTICFUNCTION_H
@@ -0,0 +1,129 @@
+#ifndef DEADLINEPRICING_H
+#define DEADLINEPRICING_H
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "Option.h"
+
+/**
+ * @brief Online model of Monte Carlo throughput.
+ *
+ * Keeps an exponentially weighted moving average of the time per path,
+ * updated after every run, and turns a time budget into a path count.
+ * Thread-safe, so one model can be shared by every caller in a process.
+ */
+class ThroughputModel {
+ public:
+  /**
+   * @brief Model settings.
+   */
+  struct Config {
+    double smoothing{0.2};              // weight of each new observation
+    double initialPathsPerSecond{5e6};  // conservative cold-start guess
+    double headroom{0.8};               // fraction of the budget planned
+  };
+
+  ThroughputModel() : ThroughputModel(Config{}) {}
+  explicit ThroughputModel(Config config);
+
+  /**
+   * @brief Gets the process-wide model.
+   */
+  static ThroughputModel& global();
+
+  /**
+   * @brief Records a completed run.
+   *
+   * @param paths the paths simulated.
+   * @param elapsed how long they took.
+   */
+  void record(unsigned long paths, std::chrono::nanoseconds elapsed);
+
+  /**
+   * @brief Gets the number of paths expected to finish within a budget,
+   * after headroom.
+   *
+   * @param budget the time available.
+   * @return the path count (0 for an empty budget).
+   */
+  unsigned long pathsFor(std::chrono::nanoseconds budget) const;
+
+  /**
+   * @brief Gets the current throughput estimate.
+   */
+  double pathsPerSecond() const;
+
+  /**
+   * @brief Gets the number of runs recorded.
+   */
+  std::uint64_t samples() const;
+
+ private:
+  Config config;
+  mutable std::mutex mutex{};
+  double secondsPerPath;
+  std::uint64_t sampleCount{0};
+};
+
+/**
+ * @brief Settings for a deadline-bounded pricing.
+ */
+struct DeadlineConfig {
+  unsigned long minPaths{1000};      // below this, use Black-Scholes
+  unsigned long maxPaths{10000000};  // never simulate more than this
+  unsigned long chunks{4};           // slices the planned paths are run in
+  std::optional<unsigned int> seed{};
+};
+
+/**
+ * @brief What a deadline-bounded pricing actually delivered.
+ */
+struct DeadlineResult {
+  double price{0.0};
+  std::optional<double> standardError{};  // empty for the analytic fallback
+  unsigned long paths{0};                 // 0 for the analytic fallback
+  bool fallback{false};  // true if Black-Scholes was used instead of MC
+  bool metDeadline{true};
+  std::chrono::nanoseconds elapsed{0};
+};
+
+namespace deadline {
+/**
+ * @brief Prices an option by Monte Carlo within a wall-clock deadline.
+ *
+ * The path count is planned from the throughput model and simulated in a
+ * few chunks (continuing one random stream, so a seeded run of N paths
+ * equals MonteCarlo with N paths). Each chunk updates the model and the
+ * plan is re-checked against the clock before the next one, so a slower
+ * machine than expected stops early with fewer paths rather than missing
+ * the deadline. If not even minPaths fit, the Black-Scholes price is
+ * returned instead.
+ *
+ * @param option the option to price.
+ * @param deadline the time by which the result is needed.
+ * @param config the pricing settings.
+ * @param model the throughput model to plan with and update.
+ * @return the price and what was delivered.
+ * @throws std::invalid_argument if minPaths is 0, maxPaths < minPaths or
+ * chunks is 0.
+ */
+DeadlineResult priceWithDeadline(
+    const Option& option, std::chrono::steady_clock::time_point deadline,
+    const DeadlineConfig& config = {},
+    ThroughputModel& model = ThroughputModel::global());
+
+/**
+ * @brief Prices an option within a time budget from now.
+ */
+inline DeadlineResult priceWithin(
+    const Option& option, std::chrono::nanoseconds budget,
+    const DeadlineConfig& config = {},
+    ThroughputModel& model = ThroughputModel::global()) {
+  return priceWithDeadline(option, std::chrono::steady_clock::now() + budget,
+                           config, model);
+}
+}  // namespace deadline
+
+#endif  // DEADLINEPRICING_H
@@ -0,0 +1,93 @@
+#ifndef HESTON_H
+#define HESTON_H
+#include <complex>
+#include <string>
+
+#include "Pricer.h"
+
+/**
+ * @brief Heston stochastic-volatility model parameters.
+ *
+ * dS/S = (r - q) dt + √v dW₁,  dv = κ(θ - v) dt + ξ√v dW₂,  d⟨W₁,W₂⟩ = ρ dt.
+ */
+struct HestonParams {
+  double v0{0.04};     // initial variance
+  double kappa{1.5};   // mean-reversion speed κ
+  double theta{0.04};  // long-run variance θ
+  double xi{0.3};      // volatility of variance ξ
+  double rho{-0.7};    // spot/variance correlation ρ
+
+  /**
+   * @brief Checks the parameters are admissible.
+   * @throws std::invalid_argument if v0, θ or ξ is negative, κ is not
+   * positive or |ρ| > 1.
+   */
+  void validate() const;
+
+  /**
+   * @brief Checks the Feller condition 2κθ >= ξ² (variance stays positive).
+   */
+  bool fellerSatisfied() const { return 2.0 * kappa * theta >= xi * xi; }
+};
+
+namespace heston {
+/**
+ * @brief Characteristic function of the centred log-return
+ * X = ln(S_T / S_0) - (r - q)T under Heston.
+ *
+ * Uses the "little trap" formulation of Albrecher et al., which stays on the
+ * principal branch of the complex logarithm for long maturities. Accepts
+ * complex arguments, as the Lewis and Fourier pricers need.
+ *
+ * @param u the transform argument.
+ * @param T the horizon.
+ * @param params the model parameters.
+ * @return E[exp(i·u·X)].
+ */
+std::complex<double> characteristicFunction(std::complex<double> u, double T,
+                                            const HestonParams& params);
+
+/**
+ * @brief Semi-analytic Heston call/put price (Lewis single-integral form).
+ *
+ * @return the price; puts via put-call parity.
+ */
+double price(OptionType type, double S, double K, double T, double r,
+             double q, const HestonParams& params);
+}  // namespace heston
+
+/**
+ * @brief Semi-analytic Heston pricer for European options.
+ *
+ * Prices by integrating the characteristic function along Re(u), shifted
+ * by -i/2 (Lewis 2000), with adaptive Gauss-Legendre panels. The option's
+ * own volatility is ignored; the Heston parameters drive the variance.
+ */
+class HestonAnalytic : public Pricer {
+ public:
+  /**
+   * @brief Constructs a Heston pricer.
+   *
+   * @param option the option (its σ is unused).
+   * @param params the Heston parameters.
+   * @throws std::invalid_argument if the parameters are invalid.
+   */
+  HestonAnalytic(const Option& option, const HestonParams& params);
+
+  double calculatePrice() const override;
+
+  std::string getPricingMethod() const override { return "Heston"; }
+
+  /**
+   * @brief Calculates Greeks by finite differences of the semi-analytic
+   * price; vega is taken with respect to the initial volatility √v0.
+   */
+  Greeks calculateGreeks() override;
+
+  const HestonParams& getParams() const { return params; }
+
+ private:
+  HestonParams params;
+};
+
+#endif  // HESTON_H
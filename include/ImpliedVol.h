@@ -1,6 +1,8 @@
 #ifndef IMPLIEDVOL_H
 #define IMPLIEDVOL_H
 
+#include <span>
+
 #include "Option.h"
 
 /**
@@ -19,4 +21,35 @@
 double impliedVolBS(const Option& option, double targetPrice, double tol = 1e-8,
                     int maxIter = 50);
 
+/**
+ * @brief Solves for implied volatility from raw option parameters.
+ *
+ * Same solver as the Option overload, for callers that already hold
+ * validated parameters (e.g. batch columns).
+ *
+ * @return the implied volatility σ.
+ * @throws std::invalid_argument if targetPrice <= 0.
+ */
+double impliedVolBS(OptionType type, double S, double K, double T, double r,
+                    double q, double targetPrice, double tol = 1e-8,
+                    int maxIter = 50);
+
+/**
+ * @brief Solves for implied volatility row by row over a column set.
+ *
+ * The options' own sigma column is ignored. Rows with a non-positive target
+ * price get NaN instead of throwing, so one bad quote does not abort a batch.
+ *
+ * @param options     the option parameters, one row per option.
+ * @param targetPrices the market price of each row.
+ * @param out         receives one implied vol per row.
+ * @param tol         the convergence tolerance (default: 1e-8).
+ * @param maxIter     the maximum number of iterations per row (default: 50).
+ * @throws std::invalid_argument if the sizes differ.
+ */
+void impliedVolBatch(const OptionColumns& options,
+                     std::span<const double> targetPrices,
+                     std::span<double> out, double tol = 1e-8,
+                     int maxIter = 50);
+
 #endif  // IMPLIEDVOL_H
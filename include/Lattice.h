@@ -0,0 +1,112 @@
+#ifndef LATTICE_H
+#define LATTICE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Pricer.h"
+
+/**
+ * @brief Tree constructions supported by Lattice.
+ */
+enum class LatticeMethod : std::uint8_t {
+  CRR,            // Cox-Ross-Rubinstein binomial, u·d = 1
+  LEISEN_REIMER,  // binomial centred on the strike (Peizer-Pratt), odd steps
+  TRINOMIAL,      // Kamrad-Ritchken style log-space trinomial
+};
+
+/**
+ * @brief Binomial / trinomial lattice pricer for European and American
+ * vanillas.
+ *
+ * Backward induction runs in place over one array of node values (plus one
+ * of node spots for early exercise), so memory is O(steps) rather than
+ * O(steps²). Each layer is a unit-stride loop of multiply-adds with no
+ * branches for European exercise, which the compiler vectorizes across
+ * nodes. Delta, gamma and theta are read off the first tree layers during
+ * the same induction; vega and rho reprice with bumped inputs.
+ *
+ * With Richardson extrapolation enabled, the price combines trees of N and
+ * about N/2 steps, cancelling the leading error term (1/N for CRR and the
+ * trinomial, 1/N² for Leisen-Reimer).
+ */
+class Lattice : public Pricer {
+ public:
+  /**
+   * @brief Tree settings.
+   */
+  struct Config {
+    LatticeMethod method{LatticeMethod::LEISEN_REIMER};
+    ExerciseStyle exercise{ExerciseStyle::EUROPEAN};
+    std::size_t steps{201};  // rounded up to odd for Leisen-Reimer
+    bool richardson{false};
+  };
+
+  /**
+   * @brief Constructs a lattice pricer.
+   *
+   * @param option the option to price.
+   * @param config the tree settings.
+   * @throws std::invalid_argument if steps is below 4.
+   */
+  Lattice(const Option& option, Config config);
+  explicit Lattice(const Option& option) : Lattice(option, Config{}) {}
+
+  /**
+   * @brief Calculates the option price by backward induction.
+   * @return the price (Richardson-extrapolated if enabled).
+   */
+  double calculatePrice() const override;
+
+  std::string getPricingMethod() const override { return "Lattice"; }
+
+  /**
+   * @brief Calculates Greeks: delta, gamma and theta from the first layers
+   * of the tree already built for the price, vega and rho by repricing with
+   * bumped inputs.
+   */
+  Greeks calculateGreeks() override;
+
+  /**
+   * @brief Gets the number of steps actually used (after odd rounding).
+   */
+  std::size_t getSteps() const;
+
+  const Config& getConfig() const { return config; }
+
+ private:
+  Config config;
+
+  // reused induction workspace
+  mutable std::vector<double> values{};
+  mutable std::vector<double> spots{};
+
+  /**
+   * @brief Values and spots of the first tree layers, kept by induce().
+   */
+  struct Layers {
+    double price{0.0};
+    double dt{0.0};
+    double v1[3]{}, s1[3]{};  // layer 1 (2 nodes binomial, 3 trinomial)
+    double v2[3]{}, s2[3]{};  // layer 2 (binomial only)
+  };
+
+  // first layers of the fine tree behind the cached price, for the Greeks
+  mutable Layers priceLayers{};
+
+  /**
+   * @brief Runs one backward induction with the given inputs and steps.
+   */
+  Layers induce(const Option& priced, std::size_t steps) const;
+
+  /**
+   * @brief Prices with the configured steps and extrapolation.
+   *
+   * @param priced the option to price.
+   * @param fine if not null, receives the first layers of the fine tree.
+   */
+  double priceOf(const Option& priced, Layers* fine = nullptr) const;
+};
+
+#endif  // LATTICE_H
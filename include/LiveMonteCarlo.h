@@ -0,0 +1,152 @@
+#ifndef LIVEMONTECARLO_H
+#define LIVEMONTECARLO_H
+#include <random>
+#include <utility>
+
+#include "BufferPool.h"
+#include "Option.h"
+#include "Pricer.h"
+
+/**
+ * @brief Monte Carlo pricer for streaming market data.
+ *
+ * Under GBM the terminal price is S_T = S0 * exp(drift) * exp(σ√T z), so the
+ * per-path diffusion factors exp(σ√T z) can be cached once and every spot
+ * tick repriced with a single multiply-max-sum pass: no RNG and no exp.
+ * Price, standard error and all Greeks (pathwise delta, vega, rho and theta;
+ * gamma from pathwise deltas at S ± h) come out of that same pass.
+ *
+ * Market updates only invalidate what they affect:
+ * - spot: nothing cached, just the next pass;
+ * - rate / dividend yield: the scalar drift factor;
+ * - volatility / maturity: the diffusion factors (one exp per path).
+ */
+class LiveMonteCarlo : public Pricer {
+  unsigned long numSimulations{};
+
+  std::default_random_engine randomEngine{};
+  std::normal_distribution<double> standardNormal{};
+
+  // drawn once per instance
+  SimBuffer normals{};
+  // exp(σ√T z_i), refreshed on vol / maturity changes
+  SimBuffer diffusion{};
+  // exp((r - q - σ²/2) T), refreshed on any non-spot change
+  double driftFactor{};
+
+  mutable double standardError{};
+  mutable Greeks cachedGreeks{};
+
+ public:
+  /**
+   * @brief Constructs a live pricer and draws its normals.
+   *
+   * @param option the European option to price.
+   * @param numSimulations the number of cached paths (default 100,000).
+   */
+  explicit LiveMonteCarlo(const Option& option,
+                          unsigned long numSimulations = 100000);
+
+  /**
+   * @brief Constructs a live pricer with the specified random seed.
+   *
+   * @param option the European option to price.
+   * @param numSimulations the number of cached paths.
+   * @param seed the random seed for the cached normals.
+   */
+  LiveMonteCarlo(const Option& option, unsigned long numSimulations,
+                 unsigned int seed);
+
+  /**
+   * @brief Prices the option on the cached paths.
+   *
+   * Runs the single repricing pass (which also fills the Greeks and the
+   * standard error) unless the current state has already been priced.
+   *
+   * @return the discounted mean payoff.
+   */
+  double calculatePrice() const override;
+
+  std::string getPricingMethod() const override { return "Live Monte Carlo"; }
+
+  /**
+   * @brief Gets the Greeks computed alongside the latest price.
+   * @return a Greeks struct with sensitivity values.
+   */
+  Greeks calculateGreeks() override;
+
+  /**
+   * @brief Gets the standard error of the latest price.
+   * @return the standard error.
+   */
+  double getStandardError() override;
+
+  /**
+   * @brief Calculates a confidence interval for the latest price.
+   *
+   * @param confidenceLevel the two-sided confidence level (default 0.95).
+   * @return a pair of (lower bound, upper bound).
+   */
+  std::pair<double, double> getConfidenceInterval(
+      double confidenceLevel = 0.95) override;
+
+  /**
+   * @brief Moves the spot price; no cached state is recomputed.
+   * @param S the new spot price.
+   */
+  void updateSpot(double S);
+
+  /**
+   * @brief Changes the volatility and refreshes the diffusion factors.
+   * @param sigma the new volatility.
+   */
+  void updateVolatility(double sigma);
+
+  /**
+   * @brief Changes the risk-free rate; only the drift factor is refreshed.
+   * @param r the new risk-free rate.
+   */
+  void updateRiskFreeRate(double r);
+
+  /**
+   * @brief Changes the dividend yield; only the drift factor is refreshed.
+   * @param q the new dividend yield.
+   */
+  void updateDividendYield(double q);
+
+  /**
+   * @brief Changes the time to maturity and refreshes the diffusion factors.
+   * @param T the new time to maturity.
+   */
+  void updateTimeToMaturity(double T);
+
+  /**
+   * @brief Rebinds to a new option, keeping the cached normals.
+   * @param newOption the option to price next.
+   */
+  void reset(const Option& newOption) override;
+
+  /**
+   * @brief Gets the number of cached paths.
+   * @return the number of simulation paths.
+   */
+  unsigned long getNumSimulations() const { return numSimulations; }
+
+ private:
+  /**
+   * @brief Replaces the option with one built from the given parameters.
+   */
+  void rebuild(double S, double T, double r, double sigma, double q);
+
+  /**
+   * @brief Recomputes exp(σ√T z_i) for every path.
+   */
+  void refreshDiffusion();
+
+  /**
+   * @brief Recomputes the scalar drift factor.
+   */
+  void refreshDrift();
+};
+
+#endif  // LIVEMONTECARLO_H
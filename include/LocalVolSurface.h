@@ -0,0 +1,185 @@
+#ifndef LOCALVOLSURFACE_H
+#define LOCALVOLSURFACE_H
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Implied-volatility surface on an expiry × strike grid.
+ *
+ * Each expiry row is interpolated by a natural cubic spline of total
+ * implied variance w = σ²T in log-moneyness y = ln(K / F_T). Beyond the
+ * quoted strikes w continues linearly with the end slopes (smooth to second
+ * order, as the spline's end curvature is zero), floored at a tenth of the
+ * end value. Between expiries w is linear in
+ * T at fixed y; before the first and after the last expiry the implied
+ * volatility is held constant.
+ */
+class ImpliedVolSurface {
+ public:
+  /**
+   * @brief Constructs a surface from quoted implied volatilities.
+   *
+   * @param expiries the expiries, strictly increasing and positive.
+   * @param strikes the strikes, strictly increasing and positive.
+   * @param vols the implied volatilities, row-major expiries × strikes.
+   * @param spot the spot the quotes refer to.
+   * @param riskFreeRate the continuously compounded rate.
+   * @param dividendYield the continuous dividend yield.
+   * @throws std::invalid_argument if the grid is not increasing, fewer than
+   * two strikes are given, the sizes differ or a volatility or the spot is
+   * not positive.
+   */
+  ImpliedVolSurface(std::vector<double> expiries, std::vector<double> strikes,
+                    std::vector<double> vols, double spot,
+                    double riskFreeRate, double dividendYield = 0.0);
+
+  /**
+   * @brief Gets the total implied variance w(T, y) at log-moneyness y.
+   */
+  double totalVariance(double T, double y) const;
+
+  /**
+   * @brief Gets the implied volatility for expiry T and strike K.
+   */
+  double volatility(double T, double K) const;
+
+  /**
+   * @brief Gets the forward S·e^{(r-q)T}.
+   */
+  double forward(double T) const;
+
+  double getSpot() const { return spot; }
+  double getRiskFreeRate() const { return riskFreeRate; }
+  double getDividendYield() const { return dividendYield; }
+  const std::vector<double>& getExpiries() const { return expiries; }
+  const std::vector<double>& getStrikes() const { return strikes; }
+
+ private:
+  std::vector<double> expiries;
+  std::vector<double> strikes;
+  std::vector<double> variances;  // w at each quote, row-major
+  std::vector<double> moneyness;  // y at each quote, row-major
+  std::vector<double> curvature;  // spline second derivatives, row-major
+  double spot;
+  double riskFreeRate;
+  double dividendYield;
+
+  /**
+   * @brief Evaluates the spline of expiry row i at log-moneyness y.
+   */
+  double rowVariance(std::size_t i, double y) const;
+};
+
+/**
+ * @brief Immutable Dupire local-volatility grid.
+ *
+ * Built once from an implied surface with Gatheral's total-variance form of
+ * Dupire's equation, σ²(T, y) = ∂w/∂T / D(y, w, ∂w/∂y, ∂²w/∂y²), whose
+ * derivatives are taken by central differences of the interpolated surface.
+ * Nodes where the surface admits arbitrage (a non-positive numerator or
+ * denominator) or the result leaves [minVol, maxVol] are clamped and
+ * counted.
+ *
+ * The grid is uniform in time and in log-spot and stored contiguously,
+ * row-major by time, so a pricer can interpolate one row per time step and
+ * then look paths up with a single linear interpolation. It never changes
+ * after construction, so one shared instance can serve any number of
+ * pricers on any number of threads.
+ */
+class LocalVolSurface {
+ public:
+  /**
+   * @brief Grid settings.
+   */
+  struct Config {
+    double horizon{0.0};     // last grid time; 0 = the last quoted expiry
+    unsigned timeSteps{100};  // time intervals to the horizon
+    unsigned spotNodes{201};  // log-spot nodes
+    double spotRange{5.0};    // half-width in standard deviations at horizon
+    double minVol{0.01};
+    double maxVol{4.0};
+  };
+
+  /**
+   * @brief Builds the local-volatility grid from an implied surface.
+   *
+   * Rows are computed in parallel.
+   *
+   * @param implied the implied-volatility surface.
+   * @param config the grid settings.
+   * @return the shared, immutable grid.
+   * @throws std::invalid_argument if a count is too small, the range or
+   * volatility bounds are not positive or the bounds are inverted.
+   */
+  static std::shared_ptr<const LocalVolSurface> build(
+      const ImpliedVolSurface& implied, Config config);
+  static std::shared_ptr<const LocalVolSurface> build(
+      const ImpliedVolSurface& implied) {
+    return build(implied, Config{});
+  }
+
+  /**
+   * @brief Gets the local volatility at time t and spot S, interpolating
+   * bilinearly and holding the grid edges constant outside it.
+   */
+  double localVol(double t, double S) const;
+
+  /**
+   * @brief Interpolates the grid linearly in time into one row of local
+   * volatilities over the log-spot nodes.
+   *
+   * @param t the time.
+   * @param out receives getSpotNodes() volatilities.
+   * @throws std::invalid_argument if out has the wrong size.
+   */
+  void interpolateRow(double t, std::span<double> out) const;
+
+  /**
+   * @brief Looks up a volatility in a row from interpolateRow().
+   *
+   * @param row the interpolated row.
+   * @param logSpot the log-spot ln S.
+   * @return the linearly interpolated volatility.
+   */
+  double lookup(const double* row, double logSpot) const {
+    double u{(logSpot - logSpotMin) * inverseLogSpotStep};
+    u = u < 0.0 ? 0.0 : (u > maxIndex ? maxIndex : u);
+    const std::size_t i{static_cast<std::size_t>(u)};
+    const double frac{u - static_cast<double>(i)};
+    return row[i] + frac * (row[i + 1] - row[i]);
+  }
+
+  double getHorizon() const { return horizon; }
+  std::size_t getTimeNodes() const { return timeNodes; }
+  std::size_t getSpotNodes() const { return spotNodes; }
+  double getLogSpotMin() const { return logSpotMin; }
+  double getLogSpotStep() const { return logSpotStep; }
+
+  /**
+   * @brief Gets the number of nodes whose local variance was clamped.
+   */
+  std::size_t getClampedNodes() const { return clampedNodes; }
+
+  /**
+   * @brief Gets the grid, row-major by time.
+   */
+  const std::vector<double>& getGrid() const { return grid; }
+
+ private:
+  LocalVolSurface() = default;
+
+  std::vector<double> grid;
+  double horizon{0.0};
+  double timeStep{0.0};
+  std::size_t timeNodes{0};
+  std::size_t spotNodes{0};
+  double logSpotMin{0.0};
+  double logSpotStep{0.0};
+  double inverseLogSpotStep{0.0};
+  double maxIndex{0.0};  // just below spotNodes - 1, so i + 1 stays valid
+  std::size_t clampedNodes{0};
+};
+
+#endif  // LOCALVOLSURFACE_H
@@ -0,0 +1,137 @@
+#ifndef LONGSTAFFSCHWARTZ_H
+#define LONGSTAFFSCHWARTZ_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "Pricer.h"
+#include "RandomStreams.h"
+
+/**
+ * @brief Polynomial families for the continuation-value regression, in the
+ * moneyness x = S/K.
+ */
+enum class RegressionBasis : std::uint8_t {
+  MONOMIAL,  // 1, x, x², ...
+  LAGUERRE,  // L0(x), L1(x), ... (unweighted)
+  HERMITE,   // probabilists' He0(x), He1(x), ...
+};
+
+/**
+ * @brief Least-squares Monte Carlo (Longstaff-Schwartz) pricer for American
+ * options.
+ *
+ * Exercise is allowed on `exerciseDates` equally spaced dates up to
+ * maturity (a Bermudan approximation that converges to the American price
+ * as the dates increase). At each date the continuation value is regressed
+ * on a polynomial basis over the in-the-money paths only, and paths exercise
+ * where the intrinsic value beats it.
+ *
+ * Paths are never stored over time. The simulation runs backwards with a
+ * Brownian bridge: W(T) is drawn first and each earlier W(t_k) from its
+ * bridge given W(t_{k+1}), in step with the backward induction. A path thus
+ * needs only its current W, moneyness and discounted cash flow (three
+ * doubles), so memory is O(paths), not O(paths × dates).
+ *
+ * Paths live in cache-sized random_streams::BlockLayout blocks, one draw
+ * per normal (inverse CDF). One team of threads runs the whole induction:
+ * per date, each worker accumulates fixed-size normal equations over its
+ * blocks, and at a barrier these are reduced in block order and solved by
+ * Cholesky.
+ */
+class LongstaffSchwartz : public Pricer {
+ public:
+  /// Most basis functions supported (degree + 1).
+  static constexpr std::size_t MAX_BASIS{8};
+
+  /**
+   * @brief Engine settings.
+   */
+  struct Config {
+    unsigned long paths{100000};
+    unsigned exerciseDates{50};
+    unsigned degree{3};  // polynomial degree; degree + 1 basis functions
+    RegressionBasis basis{RegressionBasis::LAGUERRE};
+    unsigned long blockPaths{4096};  // paths per cache block
+    unsigned threads{0};             // 0 = all cores
+    unsigned int seed{42u};
+  };
+
+  /**
+   * @brief Constructs an American option pricer.
+   *
+   * @param option the option; its exercise is treated as American.
+   * @param config the engine settings.
+   * @throws std::invalid_argument if paths, exerciseDates or blockPaths is
+   * 0, degree + 1 exceeds MAX_BASIS, or the blocks would need more draws
+   * than their random substreams provide.
+   */
+  LongstaffSchwartz(const Option& option, Config config);
+  explicit LongstaffSchwartz(const Option& option)
+      : LongstaffSchwartz(option, Config{}) {}
+
+  /**
+   * @brief Calculates the American option price.
+   * @return the estimated price (never below intrinsic value).
+   */
+  double calculatePrice() const override;
+
+  std::string getPricingMethod() const override { return "Longstaff-Schwartz"; }
+
+  /**
+   * @brief Calculates Greeks by bump-and-reprice with common random numbers.
+   * @return the Greeks (theta as -∂V/∂T, like BlackScholes).
+   */
+  Greeks calculateGreeks() override;
+
+  /**
+   * @brief Gets the standard error of the discounted cash flows.
+   */
+  double getStandardError() override;
+
+  std::pair<double, double> getConfidenceInterval(
+      double confidenceLevel = 0.95) override;
+
+  /**
+   * @brief Gets the early-exercise premium over the matching European price
+   * from the same paths (the mean discounted payoff at maturity).
+   */
+  double getEarlyExercisePremium();
+
+  /**
+   * @brief Evaluates the basis functions at a moneyness.
+   *
+   * @param basis the polynomial family.
+   * @param degree the highest degree (< MAX_BASIS).
+   * @param x the moneyness S/K.
+   * @return the values; entries past degree are 0.
+   */
+  static std::array<double, MAX_BASIS> evaluateBasis(RegressionBasis basis,
+                                                     unsigned degree,
+                                                     double x);
+
+  const Config& getConfig() const { return config; }
+
+ private:
+  Config config;
+  random_streams::BlockLayout layout{};
+  mutable double standardError{0.0};
+  mutable double europeanPrice{0.0};
+
+  struct Estimate {
+    double price{0.0};
+    double standardError{0.0};
+    double european{0.0};
+  };
+
+  /**
+   * @brief Runs the full backward induction for some option parameters.
+   */
+  Estimate run(const Option& priced) const;
+
+  void validatePriceCalculated() const;
+};
+
+#endif  // LONGSTAFFSCHWARTZ_H
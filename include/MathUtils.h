@@ -1,12 +1,28 @@
 #ifndef MATHUTILS_H
 #define MATHUTILS_H
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace math {
 constexpr double INV_SQRT_2PI = 0.39894228040143267794;
 constexpr double INV_SQRT_2 = 0.70710678118654752440;
 
+// 16-point Gauss-Legendre nodes and weights on [-1, 1] (positive half)
+constexpr std::array<double, 8> GL_NODES{
+    0.0950125098376374, 0.2816035507792589, 0.4580167776572274,
+    0.6178762444026438, 0.7554044083550030, 0.8656312023878318,
+    0.9445750230732326, 0.9894009349916499};
+constexpr std::array<double, 8> GL_WEIGHTS{
+    0.1894506104550685, 0.1826034150449236, 0.1691565193950025,
+    0.1495959888165767, 0.1246289712555339, 0.0951585116824928,
+    0.0622535239386479, 0.0271524594117541};
+
 /**
  * @brief Probability density function of the standard normal distribution.
  * @param x the point at which to evaluate the PDF.
@@ -22,6 +38,163 @@ inline double norm_pdf(double x) {
  * @return the value of the CDF at x.
  */
 inline double norm_cdf(double x) { return 0.5 * std::erfc(-x * INV_SQRT_2); }
+
+/**
+ * @brief Inverse of the standard normal CDF (Acklam's rational
+ * approximation, relative error below 1.2e-9).
+ *
+ * Cheap enough to turn one uniform draw into one normal in simulation inner
+ * loops, where the approximation error is far below sampling noise.
+ *
+ * @param p a probability in (0, 1).
+ * @return x with norm_cdf(x) = p.
+ */
+inline double norm_inv(double p) {
+  constexpr double a1{-3.969683028665376e+01}, a2{2.209460984245205e+02},
+      a3{-2.759285104469687e+02}, a4{1.383577518672690e+02},
+      a5{-3.066479806614716e+01}, a6{2.506628277459239e+00};
+  constexpr double b1{-5.447609879822406e+01}, b2{1.615858368580409e+02},
+      b3{-1.556989798598866e+02}, b4{6.680131188771972e+01},
+      b5{-1.328068155288572e+01};
+  constexpr double c1{-7.784894002430293e-03}, c2{-3.223964580411365e-01},
+      c3{-2.400758277161838e+00}, c4{-2.549732539343734e+00},
+      c5{4.374664141464968e+00}, c6{2.938163982698783e+00};
+  constexpr double d1{7.784695709041462e-03}, d2{3.224671290700398e-01},
+      d3{2.445134137142996e+00}, d4{3.754408661907416e+00};
+  constexpr double LOW{0.02425};
+
+  if (p > LOW && p < 1.0 - LOW) {
+    const double q{p - 0.5};
+    const double r{q * q};
+    return (((((a1 * r + a2) * r + a3) * r + a4) * r + a5) * r + a6) * q /
+           (((((b1 * r + b2) * r + b3) * r + b4) * r + b5) * r + 1.0);
+  }
+  const double q{std::sqrt(-2.0 * std::log(p < 0.5 ? p : 1.0 - p))};
+  const double x{(((((c1 * q + c2) * q + c3) * q + c4) * q + c5) * q + c6) /
+                 ((((d1 * q + d2) * q + d3) * q + d4) * q + 1.0)};
+  return p < 0.5 ? x : -x;
+}
+
+/**
+ * @brief Two-sided standard normal quantile for a confidence level, taken
+ * from the 99%, 95%, 90% and 80% levels at or below it.
+ * @param confidenceLevel the confidence level in (0, 1).
+ * @return the z-score.
+ * @throws std::invalid_argument if the level is not in (0, 1).
+ */
+inline double confidence_z(double confidenceLevel) {
+  if (confidenceLevel <= 0.0 || confidenceLevel >= 1.0) {
+    throw std::invalid_argument("Confidence level must be between 0 and 1");
+  }
+  if (confidenceLevel >= 0.99) return 2.576;
+  if (confidenceLevel >= 0.95) return 1.96;
+  if (confidenceLevel >= 0.90) return 1.645;
+  return 1.282;
+}
+
+/**
+ * @brief Normal confidence interval estimate ± z·SE.
+ * @param estimate the point estimate.
+ * @param standardError its standard error.
+ * @param confidenceLevel the confidence level in (0, 1).
+ * @return the lower and upper bounds.
+ * @throws std::invalid_argument if the level is not in (0, 1).
+ */
+inline std::pair<double, double> confidence_interval(double estimate,
+                                                     double standardError,
+                                                     double confidenceLevel) {
+  const double margin{confidence_z(confidenceLevel) * standardError};
+  return {estimate - margin, estimate + margin};
+}
+
+/**
+ * @brief Count, mean and sum of squared deviations of a sample.
+ *
+ * Merges exactly with Chan's pairwise formula, as MonteCarloPartial does,
+ * so per-block moments reduced in block order give a result independent of
+ * which thread filled each block.
+ */
+struct SampleMoments {
+  double count{0.0};
+  double mean{0.0};
+  double squaredDeviations{0.0};  // Σ (x - mean)²
+
+  /**
+   * @brief Folds another sample into this one.
+   * @param other the moments to add.
+   */
+  void merge(const SampleMoments& other) {
+    if (other.count == 0.0) return;
+    if (count == 0.0) {
+      *this = other;
+      return;
+    }
+    const double n{count + other.count};
+    const double delta{other.mean - mean};
+    mean += delta * other.count / n;
+    squaredDeviations +=
+        other.squaredDeviations + delta * delta * count * other.count / n;
+    count = n;
+  }
+
+  /**
+   * @brief Gets the unbiased sample variance (0 below two samples).
+   */
+  double variance() const {
+    return count > 1.0 ? squaredDeviations / (count - 1.0) : 0.0;
+  }
+
+  /**
+   * @brief Gets the standard error of the mean (0 for an empty sample).
+   */
+  double standardError() const {
+    return count > 0.0 ? std::sqrt(variance() / count) : 0.0;
+  }
+};
+
+/**
+ * @brief Running sums of x - shift and (x - shift)², shifted by the first
+ * value added.
+ *
+ * The shift keeps the squared deviations accurate when the mean dwarfs the
+ * spread, as for deep in-the-money payoffs, where Σx² - (Σx)²/n cancels.
+ */
+struct ShiftedSums {
+  double shift{0.0};
+  double sum{0.0};
+  double squares{0.0};
+  std::size_t count{0};
+
+  /**
+   * @brief Adds one observation.
+   */
+  void add(double x) {
+    if (count++ == 0) shift = x;
+    const double d{x - shift};
+    sum += d;
+    squares += d * d;
+  }
+
+  /**
+   * @brief Gets the moments of the values added so far.
+   */
+  SampleMoments moments() const {
+    if (count == 0) return {};
+    const double n{static_cast<double>(count)};
+    return {n, shift + sum / n, std::max(squares - sum * sum / n, 0.0)};
+  }
+};
+
+/**
+ * @brief Merges per-block moments in block order.
+ * @param blocks the moments of each block.
+ * @return the moments of the whole sample.
+ */
+inline SampleMoments merge_blocks(const std::vector<SampleMoments>& blocks) {
+  SampleMoments total{};
+  for (const SampleMoments& block : blocks) total.merge(block);
+  return total;
+}
 }  // namespace math
 
 #endif  // MATHUTILS_H
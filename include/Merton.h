@@ -0,0 +1,104 @@
+#ifndef MERTON_H
+#define MERTON_H
+#include <complex>
+#include <string>
+
+#include "Pricer.h"
+
+/**
+ * @brief Merton jump-diffusion parameters.
+ *
+ * dS/S = (r - q - λk) dt + σ dW + (J - 1) dN, with N a Poisson process of
+ * intensity λ, ln J ~ N(μ_J, σ_J²) and k = E[J - 1] the jump compensator.
+ */
+struct MertonParams {
+  double sigma{0.2};      // diffusion volatility σ
+  double lambda{0.1};     // jump intensity λ (per year)
+  double jumpMean{-0.1};  // mean log jump μ_J
+  double jumpVol{0.15};   // log jump volatility σ_J
+
+  /**
+   * @brief Checks the parameters are admissible.
+   * @throws std::invalid_argument if σ, λ or σ_J is negative.
+   */
+  void validate() const;
+
+  /**
+   * @brief Gets the jump compensator k = exp(μ_J + σ_J²/2) - 1.
+   */
+  double compensator() const;
+};
+
+namespace merton {
+/**
+ * @brief Characteristic function of the centred log-return
+ * X = ln(S_T / S_0) - (r - q)T under Merton's model.
+ *
+ * @param u the transform argument (may be complex).
+ * @param T the horizon.
+ * @param params the model parameters.
+ * @return E[exp(i·u·X)].
+ */
+std::complex<double> characteristicFunction(std::complex<double> u, double T,
+                                            const MertonParams& params);
+
+/**
+ * @brief Merton's series price: a Poisson-weighted sum of Black-Scholes
+ * prices, one per jump count.
+ *
+ * Conditional on n jumps the terminal spot is lognormal, so the call is
+ * Σ e^{-λ'T}(λ'T)ⁿ/n! · BS(S, K, T, rₙ, σₙ, q) with λ' = λ(1 + k),
+ * σₙ² = σ² + nσ_J²/T and rₙ = r - λk + n·ln(1 + k)/T. Terms are priced in
+ * chunks through BlackScholes::priceBatch, and the sum stops once the
+ * remaining Poisson mass times the bound S·e^{-qT} on every term is below
+ * the tolerance. Puts come from put-call parity.
+ *
+ * @param tolerance the absolute truncation error allowed.
+ * @param terms if non-null, receives the number of series terms used.
+ * @return the price.
+ */
+double price(OptionType type, double S, double K, double T, double r,
+             double q, const MertonParams& params, double tolerance = 1e-12,
+             unsigned* terms = nullptr);
+}  // namespace merton
+
+/**
+ * @brief Analytic Merton jump-diffusion pricer for European options.
+ *
+ * Prices with merton::price; the option's own volatility is ignored in
+ * favour of the diffusion volatility σ in the parameters.
+ */
+class MertonAnalytic : public Pricer {
+ public:
+  /**
+   * @brief Constructs a Merton pricer.
+   *
+   * @param option the option (its σ is unused).
+   * @param params the jump-diffusion parameters.
+   * @throws std::invalid_argument if the parameters are invalid.
+   */
+  MertonAnalytic(const Option& option, const MertonParams& params);
+
+  double calculatePrice() const override;
+
+  std::string getPricingMethod() const override { return "Merton"; }
+
+  /**
+   * @brief Calculates Greeks by finite differences of the series price;
+   * vega is taken with respect to the diffusion volatility σ.
+   */
+  Greeks calculateGreeks() override;
+
+  const MertonParams& getParams() const { return params; }
+
+  /**
+   * @brief Gets the number of series terms the last price used.
+   */
+  unsigned getSeriesTerms() const { return seriesTerms; }
+
+ private:
+  MertonParams params;
+  mutable unsigned seriesTerms{0};
+};
+
+#endif  // MERTON_H
@@ -1,11 +1,35 @@
 #ifndef MONTECARLO_H
 #define MONTECARLO_H
 #include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
 #include <random>
+#include <string>
 #include <utility>
 #include <vector>
+#include "BufferPool.h"
+#include "MonteCarloPartial.h"
 #include "Option.h"
 #include "Pricer.h"
+#include "QuantileSketch.h"
+
+/**
+ * @brief How MonteCarlo draws the terminal normal of each path.
+ */
+enum class SamplingScheme : std::uint8_t {
+  PLAIN,       // i.i.d. standard normals
+  IMPORTANCE,  // mean-shifted normals, payoffs weighted by likelihood ratio
+  STRATIFIED,  // one normal per equal-probability stratum draw
+};
+
+/**
+ * @brief How a stratified MonteCarlo spreads paths over its strata.
+ */
+enum class StratumAllocation : std::uint8_t {
+  PROPORTIONAL,  // the same number of paths in every stratum
+  NEYMAN,        // paths in proportion to each stratum's payoff std. dev.
+};
 
 /**
  * @brief Monte Carlo Option pricer using geometric Brownian motion.
@@ -13,21 +37,84 @@
  * Implements industry-standard Monte Carlo simulation for European option
  * pricing. Uses geometric Brownian motion for stock price evolution and
  * includes statistical analysis capabilities for risk management applications.
+ *
+ * Besides the per-path buffers (needed for Greeks and exact VaR), the
+ * engine keeps running statistics over every simulated path: the payoff
+ * sum, shifted moments for the standard error and a QuantileSketch. These,
+ * together with the generator state, form a checkpoint that lets a long run
+ * be saved and resumed with runMoreSimulations(), giving bit-identical
+ * results to an uninterrupted run.
+ *
+ * With SamplingScheme::IMPORTANCE each draw is shifted by θ and its payoff
+ * weighted by the likelihood ratio exp(θ²/2 − θ·z); the running moments,
+ * standard error and Greek sums all use the weighted payoffs, so they stay
+ * unbiased. By default θ maximizes payoff × density (the saddle point of
+ * the zero-variance density), which moves the mode of the draws past the
+ * strike; deep out-of-the-money options gain orders of magnitude in
+ * variance.
+ *
+ * With SamplingScheme::STRATIFIED the unit interval is cut into J
+ * equal-probability strata and path i draws z = Φ⁻¹((j + U)/J) in its
+ * stratum j. Proportional allocation cycles through the strata; Neyman
+ * allocation spends a proportional pilot (a tenth of the paths) and then
+ * gives each stratum paths in proportion to its estimated payoff standard
+ * deviation. The price is Σ_j mean_j / J and the standard error
+ * √(Σ_j s_j² / (J² n_j)) from per-stratum moments, so it remains a valid
+ * per-path estimate; runMoreSimulations() extends the strata with the same
+ * rule.
  */
 class MonteCarlo : public Pricer {
   unsigned long numSimulations{};
 
-  // stored simulation results
-  mutable std::vector<double> payoffs{};
+  // stored simulation results (pool-backed, reused across instances)
+  mutable SimBuffer payoffs{};
 
   mutable std::default_random_engine randomEngine{};
   mutable std::normal_distribution<double> standardNormal{};
-  mutable std::vector<double> normals{};
+  mutable SimBuffer normals{};
+
+  // seed of the current stream; only set while results are reproducible
+  std::optional<unsigned int> seed{};
+
+  // running statistics over all simulated paths (checkpointed)
+  mutable double sumPayoffs{0.0};
+  mutable double payoffShift{0.0};  // first payoff; conditions the moments
+  mutable double sumShifted{0.0};
+  mutable double sumShiftedSquares{0.0};
+  mutable QuantileSketch payoffSketch{};
 
-  // pre-calculated constants
-  const double stockPrice{};
-  const double driftPerSim{};
-  const double volTimesSqrtT{};
+  // per-stratum running moments (stratified sampling)
+  struct StratumStats {
+    unsigned long count{0};
+    double sum{0.0};
+    double shift{0.0};
+    double sumShifted{0.0};
+    double sumShiftedSquares{0.0};
+  };
+  unsigned strataCount{0};
+  StratumAllocation allocation{StratumAllocation::PROPORTIONAL};
+  mutable std::vector<StratumStats> strata{};
+  // per buffered path; pool-backed like the path buffers
+  mutable std::vector<std::uint32_t, PoolAllocator<std::uint32_t>>
+      pathStrata{};
+  mutable std::vector<std::uint32_t, PoolAllocator<std::uint32_t>>
+      strataPlan{};  // next batch; else cycle
+
+  bool storePaths{true};
+  SamplingScheme sampling{SamplingScheme::PLAIN};
+  std::optional<double> fixedShift{};  // user-chosen θ; automatic if empty
+  double importanceShift{0.0};         // θ in use (importance sampling)
+  mutable unsigned long bufferStart{0};  // first path held in the buffers
+  unsigned long pendingSimulations{0};   // left over from a restored run
+
+  // periodic checkpoints (disabled when checkpointEvery is 0)
+  std::string checkpointPath{};
+  unsigned long checkpointEvery{0};
+
+  // pre-calculated constants (refreshed on reset)
+  double stockPrice{};
+  double driftPerSim{};
+  double volTimesSqrtT{};
 
  public:
   /**
@@ -39,6 +126,17 @@ class MonteCarlo : public Pricer {
    */
   MonteCarlo(const Option& option, unsigned long numSimulations = 100000);
 
+  /// Upper bound on generator draws per path (std::normal_distribution
+  /// on a 31-bit engine averages ~2.55: two draws per uniform, 4/π
+  /// uniforms per normal).
+  static constexpr std::uint64_t DRAWS_PER_PATH_BOUND{3};
+
+  /**
+   * @brief Gets the most paths one generator stream can simulate before
+   * its draws would repeat (the engine period over DRAWS_PER_PATH_BOUND).
+   */
+  static std::uint64_t maxPaths();
+
   /**
    * @brief Constructs a Monte Carlo pricer with the specified random seed.
    *
@@ -46,6 +144,8 @@ class MonteCarlo : public Pricer {
    * @param numSimulations The Number of simulation paths to run (default
    * 100,000)
    * @param seed The random seed for reproducible results and testing.
+   * @throws std::invalid_argument if numSimulations is 0 or above
+   * maxPaths().
    */
   MonteCarlo(const Option& option, unsigned long numSimulations,
              unsigned int seed);
@@ -60,6 +160,19 @@ class MonteCarlo : public Pricer {
    */
   double calculatePrice() const override;
 
+  /**
+   * @brief Calculates the price, checking the token between path chunks.
+   *
+   * If stopped, the paths simulated so far are kept: the pricer reports a
+   * price, standard error and VaR over them, getNumSimulations() returns
+   * their count and getPendingSimulations() the remainder, which
+   * runMoreSimulations() can still add to reach the uninterrupted result.
+   *
+   * @param token the stop token.
+   * @return true if every path was simulated.
+   */
+  bool calculatePriceCancellable(std::stop_token token) override;
+
   /**
    * @brief Gets the pricing method name.
    * @return "Monte Carlo Pricer"
@@ -69,6 +182,8 @@ class MonteCarlo : public Pricer {
   /**
    * @brief Calculates option Greeks using finite differences.
    * @return a Greeks struct with sensitivity values.
+   * @throws std::runtime_error if the path buffers do not cover every
+   * simulated path (paths not stored, or restored from a checkpoint).
   */
   Greeks calculateGreeks() override;
 
@@ -77,7 +192,8 @@ class MonteCarlo : public Pricer {
    *
    * @return A Pair containing (lower bound, upper bound) of the interval.
    */
-  std::pair<double, double> getConfidenceInterval(double confidenceLevel = 0.95) override;
+  std::pair<double, double> getConfidenceInterval(
+      double confidenceLevel = 0.95) override;
 
   /**
    * @brief Gets the standard error of the Monte Carlo estimate.
@@ -89,7 +205,14 @@ class MonteCarlo : public Pricer {
   /**
    * @brief Calculates Value at Risk (VaR) at a 5% confidence level.
    *
+   * Exact when every path is buffered; otherwise estimated from the payoff
+   * sketch (relative error below QuantileSketch::relativeAccuracy()). Under
+   * importance or stratified sampling the quantile is weighted by the path
+   * weights and needs buffered paths.
+   *
    * @return The 5% VaR of the option payoff distribution
+   * @throws std::runtime_error under importance or stratified sampling
+   * without buffers.
    */
   double calculateVaR(double confidenceLevel = 0.05) override;
 
@@ -97,11 +220,195 @@ class MonteCarlo : public Pricer {
    * @brief Runs additional simulations specified by the given amount to
    * improve accuracy.
    *
+   * The new paths continue the same random stream and running sums, so
+   * N paths followed by M more give exactly the result of N + M paths.
+   *
    * @param additionalSimulations The number of additional simulations.
    * @return The estimated price of the option.
+   * @throws std::invalid_argument if the total would exceed maxPaths()
+   * (the pricer is left unchanged).
    */
   double runMoreSimulations(unsigned long additionalSimulations);
 
+  /**
+   * @brief Extracts the mergeable statistics of this run.
+   *
+   * @param withGreeks also accumulate the bump-and-reprice sums used by
+   * calculateGreeks() (needs every path buffered).
+   * @return the partial result.
+   * @throws std::runtime_error if the price has not been calculated, the
+   * run is stratified (strata do not merge as plain samples), or Greeks are
+   * requested without buffered paths.
+   */
+  MonteCarloPartial getPartial(bool withGreeks = false) const;
+
+  /**
+   * @brief Finishes Greeks from bump-and-reprice payoff sums.
+   *
+   * calculateGreeks() is greeksFromSums() over this pricer's own paths; a
+   * merged MonteCarloPartial uses it over all shards.
+   *
+   * @param option the option priced.
+   * @param sums the undiscounted payoff sums per bump scenario.
+   * @param paths the number of paths summed.
+   * @return the Greeks.
+   */
+  static Greeks greeksFromSums(const Option& option, const GreekSums& sums,
+                               std::uint64_t paths);
+
+  /**
+   * @brief Chooses whether per-path buffers are kept.
+   *
+   * Without them memory stays constant for any path count; price, standard
+   * error and (sketch-based) VaR still work, Greeks do not.
+   *
+   * @param store true to keep paths (the default).
+   */
+  void setStorePaths(bool store) { storePaths = store; }
+
+  /**
+   * @brief Chooses how the terminal normals are drawn.
+   *
+   * @param scheme the sampling scheme.
+   * @throws std::runtime_error if the price has already been calculated
+   * (the running sums cannot mix schemes).
+   */
+  void setSamplingScheme(SamplingScheme scheme);
+
+  /**
+   * @brief Fixes the importance-sampling shift θ instead of choosing it
+   * automatically.
+   *
+   * @param shift θ, or nothing for optimalImportanceShift().
+   * @throws std::runtime_error if the price has already been calculated.
+   */
+  void setImportanceShift(std::optional<double> shift);
+
+  /**
+   * @brief Switches to stratified sampling of the terminal normal.
+   *
+   * @param strataCount the number of equal-probability strata J.
+   * @param allocation how paths are spread over the strata.
+   * @throws std::invalid_argument if J is 0 or the run has fewer than 2
+   * paths per stratum.
+   * @throws std::runtime_error if the price has already been calculated.
+   */
+  void setStratification(unsigned strataCount,
+                         StratumAllocation allocation =
+                             StratumAllocation::PROPORTIONAL);
+
+  /**
+   * @brief Gets the number of paths in each stratum (empty unless
+   * stratified).
+   */
+  std::vector<unsigned long> getStratumCounts() const;
+
+  SamplingScheme getSamplingScheme() const { return sampling; }
+
+  /**
+   * @brief Gets the shift θ in use (0 unless importance sampling).
+   */
+  double getImportanceShift() const { return importanceShift; }
+
+  /**
+   * @brief Finds the mean shift maximizing payoff(z)·φ(z) for the option.
+   *
+   * Solves d/dz [ln payoff(z) − z²/2] = 0 by bisection on the side of the
+   * strike where the payoff is positive.
+   *
+   * @param option the option.
+   * @return θ; 0 for a degenerate option (no time or volatility).
+   */
+  static double optimalImportanceShift(const Option& option);
+
+  /**
+   * @brief Writes a checkpoint automatically every given number of paths.
+   *
+   * Each checkpoint atomically replaces the file (write, then rename), so a
+   * preempted job always leaves the last complete one behind.
+   *
+   * @param path the checkpoint file.
+   * @param everyPaths paths between checkpoints; 0 disables them.
+   */
+  void setCheckpointing(const std::string& path, unsigned long everyPaths);
+
+  /**
+   * @brief Writes the statistical state: option, path counts, seed,
+   * sampling scheme, generator state, running moments and payoff sketch (no
+   * path buffers).
+   *
+   * @param out the stream to write to.
+   */
+  void saveCheckpoint(std::ostream& out) const;
+
+  /**
+   * @brief Writes a checkpoint file atomically.
+   *
+   * @param path the file to (re)place.
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void saveCheckpoint(const std::string& path) const;
+
+  /**
+   * @brief Recreates a pricer from a checkpoint.
+   *
+   * The pricer reports the paths completed so far; continue with
+   * runMoreSimulations(), e.g. getPendingSimulations() more to finish an
+   * interrupted run.
+   *
+   * @param in the stream to read from.
+   * @return the restored pricer.
+   * @throws std::runtime_error if the checkpoint is malformed or its target
+   * path count exceeds maxPaths().
+   */
+  static MonteCarlo restoreCheckpoint(std::istream& in);
+
+  /**
+   * @brief Recreates a pricer from a checkpoint file.
+   * @throws std::runtime_error if the file cannot be read or is malformed.
+   */
+  static MonteCarlo restoreCheckpoint(const std::string& path);
+
+  /**
+   * @brief Gets the paths an interrupted run still had to simulate when its
+   * checkpoint was written (0 otherwise).
+   */
+  unsigned long getPendingSimulations() const { return pendingSimulations; }
+
+  /**
+   * @brief Rebinds this pricer to a new option, keeping the random stream.
+   *
+   * Path buffers are cleared but keep their capacity, so a pooled pricer can
+   * price the next option without reallocating.
+   *
+   * @param newOption the option to price next.
+   */
+  void reset(const Option& newOption) override;
+
+  /**
+   * @brief Rebinds this pricer to a new option and reseeds the generator.
+   *
+   * After this call the pricer produces the same results as a freshly
+   * constructed MonteCarlo with the same option, path count and seed.
+   *
+   * @param newOption the option to price next.
+   * @param seed the new random seed.
+   */
+  void reset(const Option& newOption, unsigned int seed);
+
+  /**
+   * @brief Gets the cache key (engine, option, path count and seed).
+   *
+   * Only seeded pricers whose paths started at the seed are cacheable; an
+   * unseeded pricer, or one reset without reseeding, returns nothing. A run
+   * extended with runMoreSimulations(), stopped early or resumed from a
+   * checkpoint continues the seed's stream, so it is keyed by its current
+   * path count: it equals a fresh run of that many paths. The exception is
+   * Neyman allocation, whose pilot and plan are sized by the first run, so
+   * such a run returns nothing once it is extended, stopped or restored.
+   */
+  std::optional<PriceKey> cacheKey() const override;
+
   /**
    * @brief Gets the number of simulations used in this Monte Carlo object.
    *
@@ -110,6 +417,72 @@ class MonteCarlo : public Pricer {
   unsigned long getNumSimulations() const;
 
  private:
+  /**
+   * @brief Recomputes the drift and diffusion constants (and θ) from the
+   * option.
+   */
+  void updateConstants();
+
+  /**
+   * @brief Gets the undiscounted payoff mean estimate.
+   */
+  double meanPayoff() const;
+
+  /**
+   * @brief Gets the weight of a buffered path in the payoff mean: the
+   * likelihood ratio (importance), N / (J·n_j) (stratified) or 1.
+   */
+  double pathWeight(std::size_t index) const;
+
+  /**
+   * @brief Plans the strata of the next batch of paths under Neyman
+   * allocation (empty plan = cycle through the strata).
+   */
+  void planStrata(unsigned long paths) const;
+
+  /**
+   * @brief Accumulates the bump-and-reprice payoff sums over the buffered
+   * normals.
+   */
+  GreekSums greekSums() const;
+
+  /**
+   * @brief Whether strata are placed by Neyman allocation, whose results
+   * depend on how the run was split.
+   */
+  bool neymanAllocated() const;
+
+  /**
+   * @brief Simulates paths [from, to), running the Neyman pilot and
+   * planning the strata first when needed.
+   *
+   * @return the end of the simulated range (see simulate()).
+   */
+  unsigned long runPaths(unsigned long from, unsigned long to,
+                         std::stop_token token = {}) const;
+
+  /**
+   * @brief Simulates paths [from, to) in chunks, updating the running
+   * statistics and buffers and writing periodic checkpoints.
+   *
+   * @return the end of the simulated range; less than `to` only if the
+   * token was stopped (checked between chunks).
+   */
+  unsigned long simulate(unsigned long from, unsigned long to,
+                         std::stop_token token = {}) const;
+
+  /**
+   * @brief Writes a checkpoint with the given completed path count.
+   */
+  void writeCheckpoint(std::ostream& out, unsigned long completed,
+                       unsigned long target) const;
+
+  /**
+   * @brief Writes a checkpoint file via a temporary file and rename.
+   */
+  void writeCheckpointFile(const std::string& path, unsigned long completed,
+                           unsigned long target) const;
+
   /**
    * @brief Validates that price calculation has been performed.
    *
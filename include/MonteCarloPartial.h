@@ -0,0 +1,79 @@
+#ifndef MONTECARLOPARTIAL_H
+#define MONTECARLOPARTIAL_H
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+#include "Greeks.h"
+#include "Option.h"
+#include "QuantileSketch.h"
+
+/// Undiscounted payoff sums of the nine bump-and-reprice scenarios behind
+/// MonteCarlo::calculateGreeks() (base, S±, σ±, r±, T∓).
+using GreekSums = std::array<double, 9>;
+
+/**
+ * @brief Mergeable summary of a Monte Carlo run over one set of paths.
+ *
+ * Holds everything needed to finish a valuation without the paths: the path
+ * count, payoff sum, mean and squared-deviation sum (merged with Chan's
+ * pairwise formula), a payoff QuantileSketch and, optionally, the Greek
+ * bump sums. Partials from disjoint random streams merge into the result of
+ * one run over all of them; merging in a fixed order is deterministic.
+ */
+struct MonteCarloPartial {
+  std::uint64_t paths{0};
+  double sumPayoffs{0.0};
+  double meanPayoff{0.0};
+  double sumSquaredDeviations{0.0};  // Σ (payoff - mean)²
+  QuantileSketch sketch{};
+  bool hasGreeks{false};
+  GreekSums greekSums{};
+
+  /**
+   * @brief Folds another partial into this one.
+   *
+   * @param other the partial to add.
+   * @throws std::invalid_argument if exactly one side carries Greek sums
+   * (empty partials are exempt) or the sketches differ in precision.
+   */
+  void merge(const MonteCarloPartial& other);
+
+  /**
+   * @brief Gets the discounted price estimate.
+   * @throws std::runtime_error if the partial is empty.
+   */
+  double price(const Option& option) const;
+
+  /**
+   * @brief Gets the standard error of the price estimate.
+   * @throws std::runtime_error if fewer than two paths were merged.
+   */
+  double standardError(const Option& option) const;
+
+  /**
+   * @brief Gets finite-difference Greeks from the merged bump sums.
+   * @throws std::runtime_error if the partial has no Greek sums.
+   */
+  Greeks greeks(const Option& option) const;
+
+  /**
+   * @brief Gets the payoff VaR at the given level from the sketch.
+   */
+  double valueAtRisk(double confidenceLevel = 0.05) const {
+    return sketch.quantile(confidenceLevel);
+  }
+
+  /**
+   * @brief Writes the partial in a compact, exact text form.
+   */
+  void save(std::ostream& out) const;
+
+  /**
+   * @brief Reads a partial written by save().
+   * @throws std::runtime_error if the input is malformed.
+   */
+  static MonteCarloPartial load(std::istream& in);
+};
+
+#endif  // MONTECARLOPARTIAL_H
@@ -0,0 +1,191 @@
+#ifndef MULTIASSETMONTECARLO_H
+#define MULTIASSETMONTECARLO_H
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Option.h"
+#include "RandomStreams.h"
+
+/**
+ * @brief Payoff of a multi-asset option on the weighted terminal prices
+ * w_i·S_i.
+ */
+enum class BasketPayoff : std::uint8_t {
+  BASKET,    // Σ w_i·S_i against the strike
+  SPREAD,    // w_0·S_0 − w_1·S_1 against the strike (two assets)
+  BEST_OF,   // max_i w_i·S_i against the strike (rainbow)
+  WORST_OF,  // min_i w_i·S_i against the strike (rainbow)
+};
+
+/**
+ * @brief One underlying of a multi-asset option.
+ */
+struct Asset {
+  double spot{};
+  double volatility{};
+  double dividendYield{0.0};
+};
+
+/**
+ * @brief A European option on several correlated GBM underlyings.
+ */
+struct BasketOption {
+  OptionType type{OptionType::CALL};
+  BasketPayoff payoff{BasketPayoff::BASKET};
+  std::vector<Asset> assets{};
+  std::vector<double> weights{};      // one per asset
+  std::vector<double> correlation{};  // n × n, row-major
+  double strike{};
+  double maturity{};
+  double riskFreeRate{};
+
+  /**
+   * @brief Checks sizes and ranges.
+   * @throws std::invalid_argument if there are no assets, a size does not
+   * match the asset count, a spot or volatility is not positive, the strike
+   * or maturity is negative, a spread does not have exactly two assets, or
+   * the correlation matrix is not symmetric with a unit diagonal and
+   * entries in [-1, 1].
+   */
+  void validate() const;
+};
+
+/**
+ * @brief Monte Carlo pricer for basket, spread and rainbow options.
+ *
+ * The correlation matrix is Cholesky-factored once at construction; if it
+ * is not positive definite (e.g. assembled from pairwise estimates) it is
+ * first repaired by clipping its eigenvalues and rescaling to a unit
+ * diagonal. Paths run in blocks laid out as structure-of-arrays, one row of
+ * blockPaths values per asset: each block fills an n × blockPaths matrix of
+ * independent normals and correlates it as one small dense product with the
+ * lower-triangular factor, whose inner loop runs over paths and vectorizes,
+ * rather than a per-path matrix-vector loop. Blocks follow
+ * random_streams::BlockLayout.
+ *
+ * With latinHypercube set, each block is a Latin hypercube design: every
+ * asset's uniforms are stratified into blockPaths equal cells, one draw per
+ * cell, and the cells are paired across assets by independent random
+ * permutations. Paths within a block are then dependent, so the standard
+ * error is estimated from the spread of the (independent) block means
+ * instead of the per-path variance.
+ */
+class MultiAssetMonteCarlo {
+ public:
+  /**
+   * @brief Simulation settings.
+   */
+  struct Config {
+    unsigned long paths{100000};
+    unsigned long blockPaths{1024};  // paths per block
+    unsigned threads{0};             // 0 = all cores
+    unsigned int seed{42u};
+    bool latinHypercube{false};  // LHS within each block
+  };
+
+  /**
+   * @brief Constructs the pricer and factors the correlation matrix.
+   *
+   * @param option the multi-asset option.
+   * @param config the simulation settings.
+   * @throws std::invalid_argument if the option is invalid, a count is 0,
+   * Latin hypercube sampling has fewer than two blocks, or the blocks would
+   * exhaust their random substreams.
+   */
+  MultiAssetMonteCarlo(BasketOption option, Config config);
+  explicit MultiAssetMonteCarlo(BasketOption option)
+      : MultiAssetMonteCarlo(std::move(option), Config{}) {}
+
+  /**
+   * @brief Calculates the price (cached after the first call).
+   */
+  double calculatePrice() const;
+
+  /**
+   * @brief Calculates each asset's delta by bump-and-reprice with common
+   * random numbers.
+   *
+   * @return one delta per asset.
+   */
+  std::vector<double> calculateDeltas() const;
+
+  std::string getPricingMethod() const { return "Multi-Asset Monte Carlo"; }
+
+  /**
+   * @brief Gets the standard error of the price estimate.
+   * @throws std::runtime_error if the price has not been calculated.
+   */
+  double getStandardError() const;
+
+  /**
+   * @brief Gets a confidence interval for the price estimate.
+   * @throws std::runtime_error if the price has not been calculated.
+   * @throws std::invalid_argument if the level is not in (0, 1).
+   */
+  std::pair<double, double> getConfidenceInterval(
+      double confidenceLevel = 0.95) const;
+
+  /**
+   * @brief Gets the execution time of the last price calculation.
+   * @return the time in seconds
+   */
+  double getLastCalculationTime() const { return lastRunDuration.count(); }
+
+  /**
+   * @brief Whether the correlation matrix had to be repaired.
+   */
+  bool correlationRepaired() const { return repaired; }
+
+  /**
+   * @brief Gets the lower-triangular Cholesky factor (n × n, row-major).
+   */
+  const std::vector<double>& getCholeskyFactor() const { return cholesky; }
+
+  const BasketOption& getOption() const { return option; }
+  const Config& getConfig() const { return config; }
+
+  /**
+   * @brief Makes a symmetric unit-diagonal matrix positive definite.
+   *
+   * Eigenvalues are clipped from below at `floor` and the result rescaled
+   * to a unit diagonal; a matrix that is already positive definite with
+   * eigenvalues above the floor comes back unchanged up to rounding.
+   *
+   * @param matrix the n × n row-major matrix.
+   * @param n its dimension.
+   * @param floor the smallest eigenvalue kept.
+   * @return the repaired matrix.
+   */
+  static std::vector<double> repairCorrelation(std::vector<double> matrix,
+                                               std::size_t n,
+                                               double floor = 1e-8);
+
+ private:
+  BasketOption option;
+  Config config;
+  random_streams::BlockLayout layout{};
+  std::vector<double> cholesky{};
+  bool repaired{false};
+
+  mutable bool priceCalculated{false};
+  mutable double cachedPrice{0.0};
+  mutable double standardError{0.0};
+  mutable std::chrono::duration<double> lastRunDuration{0.0};
+
+  struct Estimate {
+    double price{0.0};
+    double standardError{0.0};
+  };
+
+  /**
+   * @brief Simulates every path with the given spots.
+   */
+  Estimate run(const std::vector<double>& spots) const;
+  void validatePriceCalculated() const;
+};
+
+#endif  // MULTIASSETMONTECARLO_H
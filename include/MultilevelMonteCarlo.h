@@ -0,0 +1,186 @@
+#ifndef MULTILEVELMONTECARLO_H
+#define MULTILEVELMONTECARLO_H
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MathUtils.h"
+#include "Pricer.h"
+
+/**
+ * @brief Path-dependent payoffs priced by MultilevelMonteCarlo.
+ */
+enum class PathPayoff : std::uint8_t {
+  EUROPEAN,      // vanilla on S_T (checks the level telescoping)
+  ASIAN,         // vanilla on the continuous arithmetic average of S
+  UP_AND_OUT,    // vanilla on S_T, void if S reaches the barrier from below
+  DOWN_AND_OUT,  // vanilla on S_T, void if S reaches the barrier from above
+};
+
+/**
+ * @brief Multilevel Monte Carlo (Giles) pricer for time-stepped payoffs.
+ *
+ * Level ℓ simulates baseSteps·2^ℓ Milstein steps of GBM; for ℓ > 0 each
+ * sample is a coupled pair whose coarse path takes the sums of the fine
+ * path's Brownian increments, so the estimator of E[P_ℓ − P_ℓ₋₁] has a
+ * variance that falls with ℓ. Barriers are monitored continuously through
+ * the Brownian-bridge crossing probability of each step; the coarse path
+ * interpolates its midpoint from the fine increments so both paths of a
+ * pair see the same bridge.
+ *
+ * The driver follows Giles' adaptive algorithm: it estimates each level's
+ * variance and cost online, allocates N_ℓ ∝ √(V_ℓ/C_ℓ) for the target RMSE
+ * (half the mean square error to variance, half to bias), and adds levels
+ * until the bias, extrapolated from the weak order fitted over the finest
+ * levels, is small enough. Cost is counted in simulated steps rather than
+ * wall time, so the allocation, and hence the result, is reproducible.
+ * Every level, including one just added, starts with initialSamples
+ * before its measured variance enters the allocation.
+ *
+ * Samples run in fixed-size blocks on jump-ahead substreams of the seed:
+ * each level owns an equal share of the engine's period and its blocks
+ * take consecutive runs of blockPaths·baseSteps·2^ℓ draws within it. The
+ * new blocks of every level are simulated together in parallel and reduced
+ * in block order, so results do not depend on the thread count, and Greeks
+ * reprice the same blocks with common random numbers.
+ */
+class MultilevelMonteCarlo : public Pricer {
+ public:
+  /**
+   * @brief Driver settings.
+   */
+  struct Config {
+    double targetRmse{0.01};
+    unsigned baseSteps{1};                // steps at level 0
+    unsigned maxLevel{10};
+    unsigned long initialSamples{10000};  // warm-up samples per level
+    unsigned long blockPaths{1024};       // samples per block
+    unsigned threads{0};                  // 0 = all cores
+    unsigned int seed{42u};
+  };
+
+  /**
+   * @brief Per-level estimates after pricing.
+   */
+  struct LevelStats {
+    unsigned long steps{};    // fine steps per sample
+    unsigned long samples{};
+    double mean{};            // E[P_ℓ − P_ℓ₋₁], discounted
+    double variance{};        // of one sample of the difference
+    double payoffVariance{};  // of one sample of P_ℓ alone
+    double cost{};            // simulated steps per sample
+  };
+
+  /**
+   * @brief Constructs an MLMC pricer.
+   *
+   * @param option the option (type, strike, spot, rates, σ).
+   * @param payoff the payoff.
+   * @param barrier the barrier level (barrier payoffs only).
+   * @param config the driver settings.
+   * @throws std::invalid_argument if a setting is out of range, the
+   * barrier is not positive or the spot already breaches it, or one block
+   * of the finest level would not fit in its level's substream.
+   */
+  MultilevelMonteCarlo(const Option& option, PathPayoff payoff,
+                       double barrier, Config config);
+  MultilevelMonteCarlo(const Option& option, PathPayoff payoff,
+                       double barrier = 0.0)
+      : MultilevelMonteCarlo(option, payoff, barrier, Config{}) {}
+
+  double calculatePrice() const override;
+  std::string getPricingMethod() const override {
+    return "Multilevel Monte Carlo";
+  }
+
+  /**
+   * @brief Calculates Greeks by repricing the same blocks and levels with
+   * bumped inputs (common random numbers).
+   */
+  Greeks calculateGreeks() override;
+
+  /**
+   * @brief Gets the statistical error √(Σ V_ℓ/N_ℓ) (excludes the bias).
+   */
+  double getStandardError() override;
+  std::pair<double, double> getConfidenceInterval(
+      double confidenceLevel = 0.95) override;
+  std::string getConvergenceInfo() const override;
+
+  /**
+   * @brief Gets the per-level statistics of the last run.
+   * @throws std::runtime_error if the price has not been calculated.
+   */
+  const std::vector<LevelStats>& getLevels() const;
+
+  /**
+   * @brief Gets the total work, Σ N_ℓ·C_ℓ, in simulated steps.
+   */
+  double getCost() const;
+
+  /**
+   * @brief Gets the work single-level MC would need for the same variance
+   * on the finest grid, 2·V[P_L]/ε² samples of C_L steps each.
+   */
+  double getSingleLevelCost() const;
+
+  /**
+   * @brief Whether the bias criterion was met within maxLevel.
+   */
+  bool isConverged() const;
+
+  const Config& getConfig() const { return config; }
+
+ private:
+  PathPayoff payoff;
+  double barrier;
+  Config config;
+
+  struct BlockSums {
+    math::SampleMoments y{};  // differences
+    math::SampleMoments p{};  // fine payoffs
+  };
+  struct Inputs {
+    double S{}, T{}, r{}, sigma{};
+  };
+
+  mutable std::vector<LevelStats> levels{};
+  mutable std::vector<std::vector<BlockSums>> blocks{};  // per level
+  mutable bool converged{false};
+
+  /**
+   * @brief Simulates one block of level ℓ.
+   */
+  BlockSums simulateBlock(unsigned level, std::size_t block,
+                          const Inputs& in) const;
+
+  /**
+   * @brief Simulates every missing block, then refreshes the level stats.
+   *
+   * @throws std::runtime_error if a level needs more blocks than its
+   * substream holds.
+   */
+  void simulateTo(const std::vector<std::size_t>& targetBlocks,
+                  const Inputs& in) const;
+
+  /**
+   * @brief Prices with a fixed number of blocks per level (for Greeks).
+   */
+  double priceFixed(const Inputs& in) const;
+
+  /**
+   * @brief Engine draws reserved for each level.
+   */
+  std::uint64_t levelShare() const;
+
+  /**
+   * @brief Engine draws one block of level ℓ consumes.
+   */
+  std::uint64_t blockDraws(unsigned level) const;
+
+  Inputs baseInputs() const;
+  void validatePriceCalculated() const;
+};
+
+#endif  // MULTILEVELMONTECARLO_H
@@ -1,13 +1,25 @@
 #ifndef OPTION_H
 #define OPTION_H
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <type_traits>
 /**
  * @brief Represents the types of an Option.
  *
  * Represents the two standard types of financial options:
  * CALL (buy option) and PUT (sell option).
  */
-enum class OptionType { CALL, PUT };
+enum class OptionType : std::uint8_t { CALL, PUT };
+
+/**
+ * @brief When an option may be exercised.
+ *
+ * Option itself describes the contract terms; engines that can price early
+ * exercise take the style as a setting.
+ */
+enum class ExerciseStyle : std::uint8_t { EUROPEAN, AMERICAN };
 
 /**
  * @brief European option representation.
@@ -156,4 +168,28 @@ class Option {
                           double sigma, double q = 0.0);
 };
 
+/**
+ * @brief Column-wise (structure-of-arrays) view over many options.
+ *
+ * Lets batch kernels run over contiguous parameter arrays, e.g. straight out
+ * of a memory-mapped option chain, without materialising Option objects. All
+ * spans must have the same length; the values are assumed to have been
+ * validated already.
+ */
+struct OptionColumns {
+  std::span<const OptionType> type{};
+  std::span<const double> S{};
+  std::span<const double> K{};
+  std::span<const double> T{};
+  std::span<const double> r{};
+  std::span<const double> sigma{};
+  std::span<const double> q{};
+
+  std::size_t size() const { return S.size(); }
+};
+
+// pricers hold their Option by value, so it must stay a cheap, flat record
+static_assert(std::is_trivially_copyable_v<Option>,
+              "Option must remain trivially copyable");
+
 #endif
@@ -0,0 +1,138 @@
+#ifndef OPTIONCHAINFILE_H
+#define OPTIONCHAINFILE_H
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Option.h"
+
+/**
+ * @brief In-memory columns for building an option chain file.
+ */
+struct OptionChainData {
+  std::vector<OptionType> type{};
+  std::vector<double> S{}, K{}, T{}, r{}, sigma{}, q{};
+  std::vector<double> marketPrice{};  // optional quotes for implied vol
+
+  /**
+   * @brief Appends one option (and its market quote, if any).
+   */
+  void add(const Option& option, double price = 0.0);
+
+  /**
+   * @brief Gets a column view over the data.
+   */
+  OptionColumns columns() const;
+
+  std::size_t size() const { return S.size(); }
+};
+
+/**
+ * @brief Read-only, memory-mapped view of a columnar option chain file.
+ *
+ * File layout (native byte order, checked on open):
+ * - a 128-byte header: magic "MCPCHAIN", version, flags, row count and the
+ *   byte offset of every column;
+ * - one 64-byte aligned column each for type (1 byte per row), S, K, T, r,
+ *   σ, q and the market price (8 bytes per row);
+ * - optionally, appended later, result columns for value and standard
+ *   error.
+ *
+ * Rows are validated once, in bulk, when the file is written, so mapping a
+ * file is O(1) and the columns can be handed straight to batch kernels such
+ * as BlackScholes::priceBatch() without copying or re-validating.
+ */
+class MappedOptionChain {
+  void* base{nullptr};
+  std::size_t length{0};
+  std::size_t rows{0};
+  bool results{false};
+  std::size_t offsets[10]{};
+
+ public:
+  /**
+   * @brief Maps the given chain file.
+   *
+   * @param path the file to map.
+   * @throws std::runtime_error if the file cannot be mapped or is not a
+   * valid chain file.
+   */
+  explicit MappedOptionChain(const std::string& path);
+  ~MappedOptionChain();
+  MappedOptionChain(const MappedOptionChain&) = delete;
+  MappedOptionChain& operator=(const MappedOptionChain&) = delete;
+  MappedOptionChain(MappedOptionChain&& other) noexcept;
+  MappedOptionChain& operator=(MappedOptionChain&& other) noexcept;
+
+  /**
+   * @brief Gets the number of options in the chain.
+   */
+  std::size_t size() const { return rows; }
+
+  /**
+   * @brief Gets zero-copy views of the option parameter columns.
+   */
+  OptionColumns columns() const;
+
+  /**
+   * @brief Gets the market price column (0 where no quote was given).
+   */
+  std::span<const double> marketPrices() const;
+
+  /**
+   * @brief Checks whether a results section has been appended.
+   */
+  bool hasResults() const { return results; }
+
+  /**
+   * @brief Gets the result value column.
+   * @throws std::runtime_error if the file has no results section.
+   */
+  std::span<const double> resultValues() const;
+
+  /**
+   * @brief Gets the result standard-error column.
+   * @throws std::runtime_error if the file has no results section.
+   */
+  std::span<const double> resultStandardErrors() const;
+
+ private:
+  template <class T>
+  std::span<const T> column(std::size_t index) const;
+  void unmap() noexcept;
+};
+
+namespace chain {
+/**
+ * @brief Validates every row and writes a columnar option chain file.
+ *
+ * Rows are checked with the same rules as the Option constructor.
+ *
+ * @param path the file to create (overwritten if it exists).
+ * @param options the option parameters.
+ * @param marketPrices optional quotes, empty or one per row.
+ * @throws std::invalid_argument naming the first invalid row.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void write(const std::string& path, const OptionColumns& options,
+           std::span<const double> marketPrices = {});
+
+/**
+ * @brief Appends (or replaces) the results section of a chain file.
+ *
+ * The input columns are left untouched; the file grows by two aligned
+ * columns and its header is updated last.
+ *
+ * @param path the chain file.
+ * @param values one result value per row (price or implied vol).
+ * @param standardErrors one standard error per row, or empty for zeros.
+ * @throws std::invalid_argument if the sizes do not match the file.
+ * @throws std::runtime_error if the file cannot be updated.
+ */
+void appendResults(const std::string& path, std::span<const double> values,
+                   std::span<const double> standardErrors = {});
+}  // namespace chain
+
+#endif  // OPTIONCHAINFILE_H
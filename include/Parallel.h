@@ -0,0 +1,71 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+/**
+ * @brief Gets the number of worker threads to use when none is requested.
+ * @return the hardware concurrency, or 1 if it is unknown.
+ */
+inline unsigned defaultThreadCount() {
+  const unsigned n{std::thread::hardware_concurrency()};
+  return n == 0 ? 1 : n;
+}
+
+/**
+ * @brief Calls body(i) for every i in [0, n) across a set of threads.
+ *
+ * Indices are handed out dynamically, so tasks of uneven cost balance
+ * themselves. Runs inline when only one thread is used. The first exception
+ * thrown by any call is rethrown on the calling thread once all workers have
+ * stopped.
+ *
+ * @param n the number of tasks.
+ * @param body the task body, invoked as body(std::size_t).
+ * @param threads the number of threads (0 = defaultThreadCount()).
+ */
+template <class Body>
+void forEachIndex(std::size_t n, Body&& body, unsigned threads = 0) {
+  if (threads == 0) threads = defaultThreadCount();
+  const std::size_t workers{std::min<std::size_t>(threads, n)};
+  if (workers <= 1) {
+    for (std::size_t i{0}; i < n; ++i) body(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr failure{};
+  std::mutex failureMutex{};
+
+  auto work = [&] {
+    for (std::size_t i{next++}; i < n; i = next++) {
+      try {
+        body(i);
+      } catch (...) {
+        std::lock_guard lock{failureMutex};
+        if (!failure) failure = std::current_exception();
+        next = n;  // stop handing out work
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> pool{};
+    pool.reserve(workers - 1);
+    for (std::size_t t{1}; t < workers; ++t) pool.emplace_back(work);
+    work();
+  }  // jthreads join here
+
+  if (failure) std::rethrow_exception(failure);
+}
+
+}  // namespace parallel
+
+#endif  // PARALLEL_H
@@ -0,0 +1,170 @@
+#ifndef PRICECACHE_H
+#define PRICECACHE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "PriceKey.h"
+#include "Pricer.h"
+
+/**
+ * @brief A cached pricing result.
+ */
+struct CachedResult {
+  double value{0.0};
+  double standardError{0.0};  // 0 for engines without one
+};
+
+/**
+ * @brief Process-wide, sharded LRU cache of pricing results.
+ *
+ * The per-pricer cache in Pricer only helps repeated calls on one object;
+ * this cache is shared by every caller, so the same contract priced from
+ * different books or threads is computed once. Entries are keyed by a
+ * canonical PriceKey and spread over independently locked shards, each with
+ * its own LRU list, so concurrent lookups rarely contend.
+ *
+ * Keys may optionally be quantized: each option parameter keeps only the
+ * configured number of mantissa bits, so inputs that differ by less than
+ * roughly 2^-bits (relative) share an entry.
+ */
+class PriceCache {
+ public:
+  /**
+   * @brief Cache settings.
+   */
+  struct Config {
+    std::size_t maxEntries{1u << 16};  // total, split evenly across shards
+    std::size_t shards{16};            // rounded up to a power of two
+    int quantizeBits{0};               // mantissa bits kept, 0 = exact keys
+  };
+
+  /**
+   * @brief Lookup counters since construction or the last resetStats().
+   */
+  struct Stats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t insertions{0};
+    std::uint64_t evictions{0};
+    std::size_t size{0};  // entries currently held
+
+    double hitRate() const {
+      const std::uint64_t total{hits + misses};
+      return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+  };
+
+  /**
+   * @brief Creates an empty cache.
+   *
+   * @param config the cache settings.
+   * @throws std::invalid_argument if maxEntries is 0 or quantizeBits is
+   * outside [0, 52].
+   */
+  explicit PriceCache(Config config);
+  PriceCache() : PriceCache(Config{}) {}
+  PriceCache(const PriceCache&) = delete;
+  PriceCache& operator=(const PriceCache&) = delete;
+
+  /**
+   * @brief Gets the process-wide cache (default settings).
+   */
+  static PriceCache& global();
+
+  /**
+   * @brief Looks up a result and marks it most recently used.
+   *
+   * @param key the result's key.
+   * @return the result, or nothing on a miss.
+   */
+  std::optional<CachedResult> find(const PriceKey& key);
+
+  /**
+   * @brief Stores (or replaces) a result, evicting the least recently used
+   * entry of the shard if it is full.
+   */
+  void insert(const PriceKey& key, const CachedResult& result);
+
+  /**
+   * @brief Returns the cached result for a key, computing and storing it on
+   * a miss.
+   *
+   * The computation runs without holding any lock, so two threads missing
+   * on the same key may both compute it; the later insert wins.
+   *
+   * @param key the result's key.
+   * @param compute callable returning the CachedResult.
+   */
+  template <class Compute>
+  CachedResult getOrCompute(const PriceKey& key, Compute&& compute) {
+    if (auto hit{find(key)}) return *hit;
+    const CachedResult result{std::forward<Compute>(compute)()};
+    insert(key, result);
+    return result;
+  }
+
+  /**
+   * @brief Prices through the cache.
+   *
+   * Engines whose results are not reproducible (Pricer::cacheKey() returns
+   * nothing, e.g. an unseeded Monte Carlo) are priced directly and never
+   * stored. On a hit the pricer itself is not run, so its own state (path
+   * buffers, cached price) is left untouched.
+   *
+   * @param pricer the pricer to run on a miss.
+   * @return the price and, where the engine provides one, standard error.
+   */
+  CachedResult price(Pricer& pricer);
+
+  /**
+   * @brief Removes every entry (counters are kept).
+   */
+  void clear();
+
+  /**
+   * @brief Gets the lookup counters and current size.
+   */
+  Stats getStats() const;
+
+  /**
+   * @brief Zeroes the lookup counters.
+   */
+  void resetStats();
+
+  /**
+   * @brief Gets the key actually stored for the given key (after
+   * quantization and -0/+0 folding).
+   */
+  PriceKey canonical(PriceKey key) const;
+
+ private:
+  struct KeyHash {
+    std::size_t operator()(const PriceKey& key) const { return key.hash(); }
+  };
+  using Entry = std::pair<PriceKey, CachedResult>;
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> lru;  // front = most recently used
+    std::unordered_map<PriceKey, std::list<Entry>::iterator, KeyHash> index;
+  };
+
+  Config config;
+  std::size_t shardMask{0};
+  std::size_t shardCapacity{0};
+  std::unique_ptr<Shard[]> shards;
+  std::atomic<std::uint64_t> hits{0}, misses{0}, insertions{0}, evictions{0};
+
+  Shard& shardFor(std::size_t hash) {
+    // the low bits pick the bucket inside the shard's map
+    return shards[(hash >> 48) & shardMask];
+  }
+};
+
+#endif  // PRICECACHE_H
@@ -0,0 +1,80 @@
+#ifndef PRICEKEY_H
+#define PRICEKEY_H
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "Option.h"
+
+/**
+ * @brief Canonical identity of a pricing result.
+ *
+ * Two pricers that would produce the same number produce equal keys: the
+ * engine, every option parameter, the engine's settings (e.g. path count)
+ * and its random seed. Engines fill the key through Pricer::cacheKey().
+ */
+struct PriceKey {
+  std::uint64_t engine{0};  // engineId() of the pricing method
+  OptionType type{OptionType::CALL};
+  double S{}, K{}, T{}, r{}, sigma{}, q{};
+  std::array<double, 2> params{};  // engine settings / extra inputs
+  std::uint64_t seed{0};
+
+  /**
+   * @brief Builds a key from an option.
+   *
+   * @param engine the engine id, see engineId().
+   * @param option the option priced.
+   * @param params engine settings that change the result.
+   * @param seed the random seed (0 for deterministic engines).
+   */
+  static PriceKey make(std::uint64_t engine, const Option& option,
+                       std::array<double, 2> params = {},
+                       std::uint64_t seed = 0) {
+    return PriceKey{engine,
+                    option.getType(),
+                    option.getStockPrice(),
+                    option.getStrikePrice(),
+                    option.getTimeToMaturity(),
+                    option.getRiskFreeRate(),
+                    option.getVolatility(),
+                    option.getDividendYield(),
+                    params,
+                    seed};
+  }
+
+  /**
+   * @brief Stable 64-bit id for an engine name (FNV-1a).
+   */
+  static constexpr std::uint64_t engineId(std::string_view name) {
+    std::uint64_t h{0xcbf29ce484222325ull};
+    for (const char c : name) {
+      h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return h;
+  }
+
+  /**
+   * @brief Hashes every field of the key.
+   */
+  std::size_t hash() const {
+    // splitmix64 finaliser per word; keys are compared in full on lookup
+    auto mix = [](std::uint64_t h, std::uint64_t v) {
+      v += h + 0x9e3779b97f4a7c15ull;
+      v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ull;
+      v = (v ^ (v >> 27)) * 0x94d049bb133111ebull;
+      return v ^ (v >> 31);
+    };
+    std::uint64_t h{mix(engine, static_cast<std::uint64_t>(type))};
+    for (const double x : {S, K, T, r, sigma, q, params[0], params[1]}) {
+      h = mix(h, std::bit_cast<std::uint64_t>(x));
+    }
+    return static_cast<std::size_t>(mix(h, seed));
+  }
+
+  bool operator==(const PriceKey&) const = default;
+};
+
+#endif  // PRICEKEY_H
@@ -1,9 +1,12 @@
 #ifndef PRICER_H
 #define PRICER_H
 #include <chrono>
+#include <optional>
+#include <stop_token>
 
 #include "Greeks.h"
 #include "Option.h"
+#include "PriceKey.h"
 
 /**
  * @brief Abstract base class for option pricing engines.
@@ -13,7 +16,7 @@
  */
 class Pricer {
  protected:
-  const Option& option;
+  Option option;
   mutable bool priceCalculated{false};
   mutable double cachedPrice{0.0};
   mutable std::chrono::duration<double> lastRunDuration{0.0};
@@ -22,6 +25,9 @@ class Pricer {
   /**
    * @brief Constructs this pricing engine with the given Option.
    *
+   * The option is copied, so the pricer does not depend on the lifetime of
+   * the caller's object and can be stored in pools or moved across threads.
+   *
    * @param option the option to price.
    */
   explicit Pricer(const Option& option) : option(option) {}
@@ -34,6 +40,22 @@ class Pricer {
    */
   virtual double calculatePrice() const = 0;
 
+  /**
+   * @brief Calculates the price, giving up early if the token is stopped.
+   *
+   * Engines with long-running loops check the token periodically and keep
+   * whatever partial estimate they have; the default only checks it once,
+   * before pricing.
+   *
+   * @param token the stop token.
+   * @return true if the price was fully calculated, false if stopped.
+   */
+  virtual bool calculatePriceCancellable(std::stop_token token) {
+    if (token.stop_requested()) return false;
+    calculatePrice();
+    return true;
+  }
+
   /**
    * @brief Gets the name of this pricing method.
    * @return the Method name (e.g., "Monte Carlo", "Black-Scholes")
@@ -102,6 +124,32 @@ class Pricer {
     return "No convergence information available for Generic Pricer";
   }
 
+  /**
+   * @brief Gets the key identifying this pricer's result in a PriceCache.
+   *
+   * Engines return a key only when the result is fully determined by it
+   * (option, settings and seed); the default is not cacheable.
+   *
+   * @return the key, or nothing if the result is not reproducible.
+   */
+  virtual std::optional<PriceKey> cacheKey() const { return std::nullopt; }
+
+  /**
+   * @brief Rebinds this pricer to a new option.
+   *
+   * Discards the cached price and timing so the pricer can be reused for the
+   * next option without being reconstructed. Engines that keep per-option
+   * state override this and must call the base version.
+   *
+   * @param newOption the option to price next.
+   */
+  virtual void reset(const Option& newOption) {
+    option = newOption;
+    priceCalculated = false;
+    cachedPrice = 0.0;
+    lastRunDuration = std::chrono::duration<double>{0.0};
+  }
+
   /**
    * @brief Gets the option being priced.
    * @return a reference to the option object
@@ -0,0 +1,231 @@
+#ifndef PRICINGSERVICE_H
+#define PRICINGSERVICE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Option.h"
+
+/**
+ * @brief Engines served by the shared-memory pricing service.
+ */
+enum class ServiceEngine : std::uint8_t { BLACK_SCHOLES, IMPLIED_VOL };
+
+/**
+ * @brief One request slot, written by a client into its request ring.
+ */
+struct PricingRequest {
+  std::uint64_t requestId{0};
+  ServiceEngine engine{ServiceEngine::BLACK_SCHOLES};
+  OptionType type{OptionType::CALL};
+  double S{}, K{}, T{}, r{}, sigma{}, q{};
+  double marketPrice{0.0};  // implied-vol requests only
+};
+
+/**
+ * @brief One response slot, written by the service into the response ring.
+ */
+struct PricingResponse {
+  std::uint64_t requestId{0};
+  double value{0.0};  // price, or implied vol
+  std::uint32_t status{0};  // 0 = ok, otherwise the request was invalid
+};
+
+/**
+ * @brief Local pricing daemon serving co-located processes over shared
+ * memory.
+ *
+ * The service creates a POSIX shared-memory segment holding a fixed set of
+ * channels; each client claims one channel, i.e. a pair of lock-free SPSC
+ * rings (requests in, responses out), which together form an MPSC request
+ * path into the service without any locks. The serving loop drains every
+ * channel, prices Black-Scholes requests with the batch kernel, gathered by
+ * underlying (split across a persistent worker team for large batches), and
+ * writes each response directly into the owning client's ring in the order
+ * that client submitted its requests. All batch workspace is reserved up
+ * front, so serving a request does not allocate. A response whose client's
+ * ring is full is held back and retried on later passes, and that client's
+ * requests are not drained until it has caught up, so one slow client never
+ * stalls the others.
+ *
+ * A Unix-domain control socket accepts line commands: "STATS" and "STOP".
+ */
+class PricingService {
+ public:
+  /**
+   * @brief Service settings.
+   */
+  struct Config {
+    std::string name{"mcpricer"};        // shared-memory / socket name
+    unsigned threads{1};                 // threads for large batches
+    std::size_t parallelThreshold{512};  // batch size before going parallel
+    bool controlSocket{true};            // listen for control commands
+  };
+
+  /**
+   * @brief Counters since the service started.
+   */
+  struct Stats {
+    std::uint64_t requests{0};
+    std::uint64_t batches{0};
+    std::uint64_t largestBatch{0};
+    std::uint32_t clients{0};
+  };
+
+  /**
+   * @brief Creates the shared-memory segment and control socket.
+   *
+   * A segment or socket left behind by a daemon that has died is replaced;
+   * a live daemon under the same name (its owner process still exists, or
+   * its control socket still accepts connections) is left untouched.
+   *
+   * @param config the service settings.
+   * @throws std::runtime_error if a daemon with this name is running, or
+   * the segment or socket cannot be created.
+   */
+  explicit PricingService(Config config);
+
+  /**
+   * @brief Stops the workers, unmaps and unlinks the segment and removes the
+   * socket.
+   */
+  ~PricingService();
+  PricingService(const PricingService&) = delete;
+  PricingService& operator=(const PricingService&) = delete;
+
+  /**
+   * @brief Serves requests until stop() is called, a STOP command arrives
+   * or the token is signalled.
+   *
+   * @param token an optional stop token.
+   */
+  void run(std::stop_token token = {});
+
+  /**
+   * @brief Asks a running serve loop to return.
+   */
+  void stop() { running.store(false); }
+
+  /**
+   * @brief Gets the service counters.
+   */
+  Stats getStats() const;
+
+  /**
+   * @brief Gets the control socket path for a service name.
+   */
+  static std::string socketPath(const std::string& name);
+
+ private:
+  Config config;
+  void* segment{nullptr};
+  int controlFd{-1};
+  std::atomic<bool> running{false};
+  std::atomic<std::uint64_t> requestCount{0};
+  std::atomic<std::uint64_t> batchCount{0};
+  std::atomic<std::uint64_t> largestBatch{0};
+
+  // reused batch workspace
+  struct Pending {
+    std::uint32_t channel{};
+    PricingRequest request{};
+  };
+  std::vector<Pending> batch{};
+  std::vector<PricingResponse> responses{};
+  std::vector<std::size_t> bsRows{};
+  std::vector<OptionType> types{};
+  std::vector<double> S{}, K{}, T{}, r{}, sigma{}, q{}, prices{};
+
+  // responses whose client's ring was full, in delivery order
+  struct Undelivered {
+    std::uint32_t channel{};
+    PricingResponse response{};
+  };
+  std::vector<Undelivered> backlog{};
+  std::uint32_t stalledChannels{0};  // bit c: channel c has a backlog
+
+  // worker team for large batches: the serve loop bumps the generation to
+  // hand out parts 1..workers of the batch and prices part 0 itself
+  std::vector<std::jthread> workers{};
+  std::atomic<std::uint64_t> generation{0};
+  std::atomic<std::size_t> partsLeft{0};
+  std::atomic<bool> workersStopping{false};
+
+  std::size_t drain();
+  void priceBatch();
+  void pricePart(std::size_t part);
+  void workLoop(std::size_t part);
+  void deliver();
+  void pollControl();
+};
+
+/**
+ * @brief Client side of the shared-memory pricing service.
+ *
+ * Attaching claims a free channel in the service's segment; the channel is
+ * released on destruction. A client must be used from one thread at a time.
+ */
+class PricingClient {
+ public:
+  /**
+   * @brief Attaches to a running service and claims a channel.
+   *
+   * @param name the service name.
+   * @throws std::runtime_error if the service is not running or every
+   * channel is taken.
+   */
+  explicit PricingClient(const std::string& name);
+  ~PricingClient();
+  PricingClient(const PricingClient&) = delete;
+  PricingClient& operator=(const PricingClient&) = delete;
+
+  /**
+   * @brief Enqueues a request without waiting.
+   * @return false if the request ring is full.
+   */
+  bool trySubmit(const PricingRequest& request);
+
+  /**
+   * @brief Dequeues a response without waiting.
+   *
+   * Responses arrive in submission order; those price() read past while
+   * waiting for its own come first.
+   *
+   * @return false if no response is ready.
+   */
+  bool tryReceive(PricingResponse& response);
+
+  /**
+   * @brief Sends one request and spins until its response arrives.
+   *
+   * Responses to requests sent earlier with trySubmit() are kept for
+   * tryReceive().
+   *
+   * @param request the request.
+   * @return the response.
+   */
+  PricingResponse price(const PricingRequest& request);
+
+  /**
+   * @brief Sends a control command ("STATS" or "STOP") over the Unix socket.
+   *
+   * @param name the service name.
+   * @param command the command.
+   * @return the service's reply line.
+   * @throws std::runtime_error if the socket cannot be reached.
+   */
+  static std::string control(const std::string& name,
+                             const std::string& command);
+
+ private:
+  void* segment{nullptr};
+  std::uint32_t channel{0};
+  std::deque<PricingResponse> early{};  // read past by price()
+};
+
+#endif  // PRICINGSERVICE_H
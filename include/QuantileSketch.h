@@ -0,0 +1,117 @@
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Mergeable streaming quantile sketch for non-negative values.
+ *
+ * Values are counted in log-linear buckets: a bucket is identified by the
+ * exponent and the top `subBucketBits` mantissa bits of the value, so every
+ * bucket spans a constant relative width and any quantile is returned with
+ * a relative error below 2^-(subBucketBits + 1). Adding a value is a few
+ * bit operations and one increment; memory grows only with the dynamic
+ * range of the data, not with the number of values. Sketches with the same
+ * precision merge exactly, which makes them suitable for checkpoints and
+ * for combining per-thread or per-process results.
+ */
+class QuantileSketch {
+ public:
+  /**
+   * @brief Creates an empty sketch.
+   *
+   * @param subBucketBits mantissa bits per bucket (1-16); 7 gives < 0.4%
+   * relative error.
+   * @throws std::invalid_argument if subBucketBits is out of range.
+   */
+  explicit QuantileSketch(unsigned subBucketBits = 7);
+
+  /**
+   * @brief Adds one value.
+   *
+   * @param x the value; must be >= 0.
+   * @throws std::invalid_argument if x is negative or NaN.
+   */
+  void add(double x) {
+    ++total;
+    if (x < MIN_POSITIVE) {
+      if (!(x >= 0.0)) {
+        --total;
+        throw std::invalid_argument("QuantileSketch values must be >= 0");
+      }
+      ++zeros;
+      return;
+    }
+    const std::int64_t index{
+        static_cast<std::int64_t>(std::bit_cast<std::uint64_t>(x) >> shift)};
+    if (index < offset || index >= offset + std::int64_t(counts.size())) {
+      grow(index);
+    }
+    ++counts[static_cast<std::size_t>(index - offset)];
+  }
+
+  /**
+   * @brief Adds every value counted by another sketch.
+   *
+   * @param other a sketch with the same precision.
+   * @throws std::invalid_argument if the precisions differ.
+   */
+  void merge(const QuantileSketch& other);
+
+  /**
+   * @brief Estimates the value at a quantile.
+   *
+   * Uses the same rank convention as MonteCarlo::calculateVaR(): the value
+   * at sorted position floor(q * count).
+   *
+   * @param q the quantile, in [0, 1].
+   * @return the estimate, or 0 if the sketch is empty.
+   * @throws std::invalid_argument if q is outside [0, 1].
+   */
+  double quantile(double q) const;
+
+  /**
+   * @brief Gets the number of values added.
+   */
+  std::uint64_t count() const { return total; }
+
+  /**
+   * @brief Gets the guaranteed relative error bound of quantile().
+   */
+  double relativeAccuracy() const;
+
+  /**
+   * @brief Removes every value, keeping the precision.
+   */
+  void clear();
+
+  /**
+   * @brief Writes the sketch as one text line.
+   */
+  void save(std::ostream& out) const;
+
+  /**
+   * @brief Reads a sketch written by save().
+   * @throws std::runtime_error if the input is malformed.
+   */
+  static QuantileSketch load(std::istream& in);
+
+ private:
+  // smaller values (including subnormals) are counted as zeros
+  static constexpr double MIN_POSITIVE{2.2250738585072014e-308};
+
+  unsigned bits;
+  unsigned shift;  // 52 - bits
+  std::uint64_t total{0};
+  std::uint64_t zeros{0};
+  std::int64_t offset{0};  // bucket index of counts[0]
+  std::vector<std::uint64_t> counts{};
+
+  void grow(std::int64_t index);
+};
+
+#endif  // QUANTILESKETCH_H
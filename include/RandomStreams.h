@@ -0,0 +1,182 @@
+#ifndef RANDOMSTREAMS_H
+#define RANDOMSTREAMS_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+/**
+ * @brief Seeds for independent random substreams of one logical stream.
+ *
+ * For a multiplicative linear congruential engine (libstdc++ and libc++
+ * both use one as std::default_random_engine) the seed is the state, so
+ * substream k can start exactly k·stride draws into the base sequence by
+ * jumping ahead with a^(k·stride) mod m in O(log k) steps. Substreams are
+ * then disjoint blocks of the same sequence as long as each consumes fewer
+ * than stride() draws. On platforms with another default engine the seeds
+ * are derived with std::seed_seq instead (independent, not provably
+ * disjoint).
+ */
+namespace random_streams {
+using Engine = std::default_random_engine;
+
+/// A multiplicative LCG with a modulus small enough for 64-bit products.
+template <class E>
+concept JumpableEngine = requires {
+  requires E::increment == 0;
+  requires E::modulus <= (std::uint64_t{1} << 32);
+  E::multiplier;
+};
+
+/// True when substreams are exact jump-ahead blocks of one sequence.
+inline constexpr bool JUMP_AHEAD{JumpableEngine<Engine>};
+
+namespace detail {
+inline std::uint64_t powMod(std::uint64_t base, std::uint64_t exp,
+                            std::uint64_t mod) {
+  std::uint64_t result{1 % mod};
+  base %= mod;
+  while (exp > 0) {
+    if (exp & 1) result = result * base % mod;
+    base = base * base % mod;
+    exp >>= 1;
+  }
+  return result;
+}
+}  // namespace detail
+
+/**
+ * @brief Gets the number of engine draws available to each of `streams`
+ * substreams before they would overlap.
+ */
+template <class E = Engine>
+std::uint64_t stride(std::uint64_t streams) {
+  if constexpr (JumpableEngine<E>) {
+    return (E::modulus - 1) / (streams == 0 ? 1 : streams);
+  } else {
+    return UINT64_MAX;
+  }
+}
+
+/**
+ * @brief Gets the seed that starts `offset` draws into the logical stream.
+ *
+ * Lets callers lay out substreams of unequal length; they stay disjoint as
+ * long as their [offset, offset + draws) ranges do not overlap.
+ *
+ * @param baseSeed the seed of the logical stream.
+ * @param offset the number of draws to skip.
+ * @return a seed for Engine.
+ */
+template <class E = Engine>
+unsigned int seedAt(unsigned int baseSeed, std::uint64_t offset) {
+  if constexpr (JumpableEngine<E>) {
+    constexpr std::uint64_t m{E::modulus};
+    // the engine maps seed 0 (mod m) to 1; do the same before jumping
+    std::uint64_t x{baseSeed % m};
+    if (x == 0) x = 1;
+    // exponents only matter mod the multiplicative order, which divides m-1
+    const std::uint64_t jump{
+        detail::powMod(E::multiplier, offset % (m - 1), m)};
+    return static_cast<unsigned int>(x * jump % m);
+  } else {
+    std::seed_seq seq{baseSeed, static_cast<unsigned int>(offset),
+                      static_cast<unsigned int>(offset >> 32)};
+    unsigned int out{0};
+    seq.generate(&out, &out + 1);
+    return out;
+  }
+}
+
+/**
+ * @brief Gets the seed that starts substream `stream` of `streams`.
+ *
+ * @param baseSeed the seed of the logical stream.
+ * @param stream the substream index, in [0, streams).
+ * @param streams the total number of substreams.
+ * @return a seed for Engine (and hence for MonteCarlo).
+ */
+template <class E = Engine>
+unsigned int seed(unsigned int baseSeed, std::uint64_t stream,
+                  std::uint64_t streams) {
+  if constexpr (JumpableEngine<E>) {
+    constexpr std::uint64_t m{E::modulus};
+    return seedAt<E>(baseSeed,
+                     stream % (m - 1) * stride<E>(streams) % (m - 1));
+  } else {
+    std::seed_seq seq{baseSeed, static_cast<unsigned int>(stream),
+                      static_cast<unsigned int>(stream >> 32)};
+    unsigned int out{0};
+    seq.generate(&out, &out + 1);
+    return out;
+  }
+}
+
+/**
+ * @brief Fixed-size blocks of paths, block b on substream b of the seed.
+ *
+ * Blocks are the unit of parallel work in the Monte Carlo engines: each
+ * draws from its own substream and the engines reduce per-block results in
+ * block order, so results do not depend on the thread count.
+ */
+class BlockLayout {
+ public:
+  BlockLayout() = default;
+
+  /**
+   * @brief Splits `paths` into blocks of `blockPaths` (the last may be
+   * short).
+   *
+   * @param paths the number of paths, > 0.
+   * @param blockPaths the paths per block, > 0.
+   * @param drawsPerPath the engine draws one path consumes.
+   * @throws std::invalid_argument if a count is 0 or a block would take
+   * more draws than its substream holds.
+   */
+  BlockLayout(std::uint64_t paths, std::uint64_t blockPaths,
+              std::uint64_t drawsPerPath)
+      : paths{paths},
+        blockPaths{blockPaths},
+        blocks{blockPaths == 0 ? 0 : (paths + blockPaths - 1) / blockPaths} {
+    if (paths == 0 || blockPaths == 0) {
+      throw std::invalid_argument("Paths and block size must be positive");
+    }
+    if (blockPaths * drawsPerPath > stride(blocks)) {
+      throw std::invalid_argument(
+          "Too many draws per block for disjoint random substreams");
+    }
+  }
+
+  /// Number of blocks.
+  std::size_t count() const { return blocks; }
+
+  /// Paths in block b.
+  std::size_t size(std::size_t b) const {
+    return std::min(blockPaths, paths - b * blockPaths);
+  }
+
+  /// Seed of block b's substream.
+  unsigned int seed(unsigned int baseSeed, std::size_t b) const {
+    return random_streams::seed(baseSeed, b, blocks);
+  }
+
+ private:
+  std::uint64_t paths{0};
+  std::uint64_t blockPaths{1};
+  std::uint64_t blocks{0};
+};
+
+/**
+ * @brief Maps an engine draw to a uniform strictly inside (0, 1), ready for
+ * math::norm_inv().
+ */
+inline double toUniform(Engine::result_type x) {
+  constexpr double lo{static_cast<double>(Engine::min())};
+  constexpr double span{static_cast<double>(Engine::max()) - lo + 1.0};
+  return (static_cast<double>(x) - lo + 0.5) / span;
+}
+
+}  // namespace random_streams
+
+#endif  // RANDOMSTREAMS_H
@@ -0,0 +1,91 @@
+#ifndef SHARDEDMONTECARLO_H
+#define SHARDEDMONTECARLO_H
+#include <cstdint>
+#include <vector>
+
+#include "MonteCarloPartial.h"
+#include "Option.h"
+
+/**
+ * @brief One Monte Carlo valuation split into independently run shards.
+ *
+ * Shard k simulates its own block of paths on substream k of the base seed
+ * (see random_streams::seed()) and returns a MonteCarloPartial. Shards can
+ * run in this process (optionally on several threads), in forked worker
+ * processes that report back over pipes, or anywhere else that can run
+ * runShard() and ship the partial's text form back. Partials are always
+ * merged in shard order, so every way of running gives bit-identical price,
+ * standard error and Greeks.
+ */
+class ShardedMonteCarlo {
+ public:
+  /**
+   * @brief Shard layout.
+   */
+  struct Config {
+    unsigned shards{8};
+    unsigned long pathsPerShard{100000};
+    unsigned int seed{42u};  // base seed of the logical stream
+    bool greeks{false};      // also accumulate Greek bump sums
+  };
+
+  /**
+   * @brief Plans a sharded valuation.
+   *
+   * @param option the option to price.
+   * @param config the shard layout.
+   * @throws std::invalid_argument if there are no shards or paths, or a
+   * shard would need more draws than its substream holds.
+   */
+  ShardedMonteCarlo(const Option& option, Config config);
+
+  /**
+   * @brief Runs one shard in the calling thread.
+   *
+   * @param shard the shard index, in [0, shards).
+   * @return the shard's partial result.
+   * @throws std::out_of_range if the index is invalid.
+   */
+  MonteCarloPartial runShard(unsigned shard) const;
+
+  /**
+   * @brief Runs every shard in this process and merges the partials.
+   *
+   * @param threads the number of threads (0 = all cores).
+   * @return the merged result.
+   */
+  MonteCarloPartial runInProcess(unsigned threads = 1) const;
+
+  /**
+   * @brief Runs the shards in forked worker processes and merges the
+   * partials they send back over pipes.
+   *
+   * Worker w runs shards w, w + processes, ... and writes each partial to
+   * its pipe; the coordinator reads all pipes, reaps the workers and merges
+   * in shard order.
+   *
+   * @param processes the number of worker processes (capped at shards).
+   * @return the merged result.
+   * @throws std::runtime_error if a worker cannot be started, fails or
+   * returns malformed output, or processes are unsupported on this system.
+   */
+  MonteCarloPartial runProcesses(unsigned processes) const;
+
+  /**
+   * @brief Merges per-shard partials in shard order.
+   *
+   * @param partials one partial per shard, indexed by shard.
+   * @return the merged result.
+   */
+  static MonteCarloPartial mergeAll(
+      const std::vector<MonteCarloPartial>& partials);
+
+  const Option& getOption() const { return option; }
+  const Config& getConfig() const { return config; }
+
+ private:
+  Option option;
+  Config config;
+};
+
+#endif  // SHARDEDMONTECARLO_H
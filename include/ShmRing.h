@@ -0,0 +1,84 @@
+#ifndef SHMRING_H
+#define SHMRING_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring buffer.
+ *
+ * Designed to live in memory shared between processes: it has no pointers,
+ * only fixed-size slots and two lock-free counters kept on separate cache
+ * lines. The producer owns the tail, the consumer owns the head; each side
+ * only ever reads the other's counter.
+ *
+ * @tparam T the slot type; must be trivially copyable.
+ * @tparam Capacity the number of slots; must be a power of two.
+ */
+template <class T, std::size_t Capacity>
+class SpscRing {
+  static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 0,
+                "capacity must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "slots are shared across processes");
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                "counters must be lock-free to work across processes");
+
+  static constexpr std::uint64_t MASK{Capacity - 1};
+
+  alignas(64) std::atomic<std::uint64_t> head{0};  // next slot to read
+  alignas(64) std::atomic<std::uint64_t> tail{0};  // next slot to write
+  alignas(64) T slots[Capacity];
+
+ public:
+  /**
+   * @brief Appends an element (producer side only).
+   *
+   * @param value the element to append.
+   * @return false if the ring is full.
+   */
+  bool tryPush(const T& value) {
+    const std::uint64_t t{tail.load(std::memory_order_relaxed)};
+    if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+    slots[t & MASK] = value;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element (consumer side only).
+   *
+   * @param out receives the element.
+   * @return false if the ring is empty.
+   */
+  bool tryPop(T& out) {
+    const std::uint64_t h{head.load(std::memory_order_relaxed)};
+    if (h == tail.load(std::memory_order_acquire)) return false;
+    out = slots[h & MASK];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Gets the number of queued elements (approximate under
+   * concurrency).
+   */
+  std::size_t size() const {
+    return static_cast<std::size_t>(tail.load(std::memory_order_acquire) -
+                                    head.load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief Drops every queued element. Only safe while neither side is
+   * active.
+   */
+  void clear() {
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+  }
+
+  static constexpr std::size_t capacity() { return Capacity; }
+};
+
+#endif  // SHMRING_H
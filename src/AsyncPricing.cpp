@@ -0,0 +1,78 @@
+#include "AsyncPricing.h"
+
+#include <stdexcept>
+
+#include "Parallel.h"
+
+PricingExecutor::PricingExecutor(unsigned threads) {
+  if (threads == 0) threads = parallel::defaultThreadCount();
+  workers.reserve(threads);
+  for (unsigned t{0}; t < threads; ++t) {
+    workers.emplace_back([this] { workLoop(); });
+  }
+}
+
+PricingExecutor::~PricingExecutor() {
+  {
+    std::lock_guard lock{mutex};
+    stopping = true;
+  }
+  ready.notify_all();
+  workers.clear();  // joins once the queue is drained
+}
+
+PricingExecutor& PricingExecutor::shared() {
+  static PricingExecutor executor{};
+  return executor;
+}
+
+void PricingExecutor::post(std::function<void()> task) {
+  {
+    std::lock_guard lock{mutex};
+    if (stopping) {
+      throw std::runtime_error("Executor is shutting down");
+    }
+    tasks.push_back(std::move(task));
+  }
+  ready.notify_one();
+}
+
+void PricingExecutor::workLoop() {
+  for (;;) {
+    std::function<void()> task{};
+    {
+      std::unique_lock lock{mutex};
+      ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+      if (tasks.empty()) return;  // stopping and drained
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    task();
+  }
+}
+
+namespace async {
+AsyncPriceResult run(std::shared_ptr<Pricer> pricer, std::stop_token token) {
+  AsyncPriceResult result{};
+  result.cancelled = !pricer->calculatePriceCancellable(token);
+  if (pricer->isPriceCalculated()) {
+    result.price = pricer->getPrice();
+    try {
+      result.standardError = pricer->getStandardError();
+    } catch (const std::runtime_error&) {
+      // analytic engines have no standard error
+    }
+  }
+  result.pricer = std::move(pricer);
+  return result;
+}
+
+std::future<AsyncPriceResult> priceFuture(std::shared_ptr<Pricer> pricer,
+                                          std::stop_token token,
+                                          PricingExecutor& executor) {
+  return executor.submit(
+      [pricer = std::move(pricer), token = std::move(token)]() mutable {
+        return run(std::move(pricer), std::move(token));
+      });
+}
+}  // namespace async
@@ -0,0 +1,246 @@
+#include "BatchIO.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "BlackScholes.h"
+#include "ImpliedVol.h"
+#include "MonteCarlo.h"
+#include "PriceCache.h"
+
+namespace {
+// on-disk layout of one binary record
+struct BinaryRecord {
+  std::uint8_t type{};
+  std::uint8_t padding[7]{};
+  double S{}, K{}, T{}, r{}, sigma{}, q{}, marketPrice{};
+};
+static_assert(sizeof(BinaryRecord) == 64, "binary record must be 64 bytes");
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+    s.remove_prefix(1);
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+    s.remove_suffix(1);
+  return s;
+}
+
+std::string lower(std::string_view s) {
+  std::string out{s};
+  std::ranges::transform(out, out.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  return out;
+}
+
+double parseDouble(std::string_view field) {
+  field = trim(field);
+  double value{};
+  const auto [ptr, ec]{
+      std::from_chars(field.data(), field.data() + field.size(), value)};
+  if (ec != std::errc{} || ptr != field.data() + field.size()) {
+    throw std::invalid_argument("Malformed number: '" + std::string{field} +
+                                "'");
+  }
+  return value;
+}
+}  // namespace
+
+namespace batch {
+BatchEngine parseEngine(std::string_view name) {
+  const std::string n{lower(name)};
+  if (n == "bs") return BatchEngine::BLACK_SCHOLES;
+  if (n == "mc") return BatchEngine::MONTE_CARLO;
+  if (n == "iv") return BatchEngine::IMPLIED_VOL;
+  throw std::invalid_argument("Unknown engine '" + std::string{name} +
+                              "' (expected bs, mc or iv)");
+}
+
+bool parseCsvLine(std::string_view line, OptionRecord& out) {
+  line = trim(line);
+  if (line.empty() || line.front() == '#') return false;
+
+  std::array<std::string_view, 8> fields{};
+  std::size_t count{0};
+  while (true) {
+    const std::size_t comma{line.find(',')};
+    if (count == fields.size()) {
+      throw std::invalid_argument("Too many CSV fields");
+    }
+    fields[count++] = line.substr(0, comma);
+    if (comma == std::string_view::npos) break;
+    line.remove_prefix(comma + 1);
+  }
+
+  const std::string type{lower(trim(fields[0]))};
+  if (type == "type") return false;  // header
+  if (count < 7) {
+    throw std::invalid_argument("Expected type,S,K,T,r,sigma,q[,price]");
+  }
+  if (type == "call" || type == "c") {
+    out.type = OptionType::CALL;
+  } else if (type == "put" || type == "p") {
+    out.type = OptionType::PUT;
+  } else {
+    throw std::invalid_argument("Unknown option type '" + type + "'");
+  }
+  out.S = parseDouble(fields[1]);
+  out.K = parseDouble(fields[2]);
+  out.T = parseDouble(fields[3]);
+  out.r = parseDouble(fields[4]);
+  out.sigma = parseDouble(fields[5]);
+  out.q = parseDouble(fields[6]);
+  out.marketPrice = count > 7 ? parseDouble(fields[7]) : 0.0;
+  return true;
+}
+
+std::size_t readCsvBatch(std::istream& in, std::vector<OptionRecord>& out,
+                         std::size_t maxRecords, std::uint64_t& nextId) {
+  out.clear();
+  std::string line{};
+  while (out.size() < maxRecords && std::getline(in, line)) {
+    OptionRecord record{};
+    try {
+      if (!parseCsvLine(line, record)) continue;
+    } catch (const std::invalid_argument& e) {
+      record = OptionRecord{};
+      record.error = e.what();
+    }
+    record.id = nextId++;
+    out.push_back(std::move(record));
+  }
+  return out.size();
+}
+
+void readBinaryHeader(std::istream& in) {
+  char magic[sizeof(BINARY_MAGIC)]{};
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0) {
+    throw std::runtime_error("Not a binary option stream (bad header)");
+  }
+}
+
+std::size_t readBinaryBatch(std::istream& in, std::vector<OptionRecord>& out,
+                            std::size_t maxRecords, std::uint64_t& nextId) {
+  out.clear();
+  BinaryRecord raw{};
+  while (out.size() < maxRecords &&
+         in.read(reinterpret_cast<char*>(&raw), sizeof(raw))) {
+    OptionRecord record{nextId++, OptionType::CALL, raw.S, raw.K, raw.T,
+                        raw.r,    raw.sigma,        raw.q, raw.marketPrice};
+    if (raw.type == 1) {
+      record.type = OptionType::PUT;
+    } else if (raw.type != 0) {
+      record.error = "Unknown option type byte " + std::to_string(raw.type);
+    }
+    out.push_back(std::move(record));
+  }
+  if (in.gcount() != 0 && in.gcount() != sizeof(raw)) {
+    throw std::runtime_error("Truncated binary record");
+  }
+  return out.size();
+}
+
+void writeBinaryRecords(std::ostream& out,
+                        const std::vector<OptionRecord>& records,
+                        bool withHeader) {
+  if (withHeader) out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  for (const OptionRecord& rec : records) {
+    BinaryRecord raw{};
+    raw.type = rec.type == OptionType::CALL ? 0 : 1;
+    raw.S = rec.S;
+    raw.K = rec.K;
+    raw.T = rec.T;
+    raw.r = rec.r;
+    raw.sigma = rec.sigma;
+    raw.q = rec.q;
+    raw.marketPrice = rec.marketPrice;
+    out.write(reinterpret_cast<const char*>(&raw), sizeof(raw));
+  }
+}
+
+BatchResult priceRecord(const OptionRecord& record,
+                        const BatchConfig& config) {
+  BatchResult result{};
+  result.id = record.id;
+  if (!record.error.empty()) {
+    result.error = record.error;
+    return result;
+  }
+  try {
+    const Option option{record.type, record.S,     record.K, record.T,
+                        record.r,    record.sigma, record.q};
+    switch (config.engine) {
+      case BatchEngine::BLACK_SCHOLES: {
+        BlackScholes bs{option};
+        result.value = config.cache ? config.cache->price(bs).value
+                                    : bs.calculatePrice();
+        break;
+      }
+      case BatchEngine::MONTE_CARLO: {
+        const unsigned int seed{
+            config.seedByContract
+                ? config.seed ^ static_cast<unsigned int>(
+                                    PriceKey::make(0, option).hash())
+                : config.seed + static_cast<unsigned int>(record.id)};
+        MonteCarlo mc{option, config.numSimulations, seed};
+        if (config.cache) {
+          const CachedResult cached{config.cache->price(mc)};
+          result.value = cached.value;
+          result.standardError = cached.standardError;
+        } else {
+          result.value = mc.calculatePrice();
+          result.standardError = mc.getStandardError();
+        }
+        break;
+      }
+      case BatchEngine::IMPLIED_VOL: {
+        auto solve = [&] {
+          return CachedResult{impliedVolBS(option, record.marketPrice), 0.0};
+        };
+        result.value =
+            config.cache
+                ? config.cache
+                      ->getOrCompute(
+                          PriceKey::make(PriceKey::engineId("Implied Vol"),
+                                         option, {record.marketPrice, 0.0}),
+                          solve)
+                      .value
+                : solve().value;
+        break;
+      }
+    }
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  }
+  return result;
+}
+
+void writeCsvResult(std::ostream& out, const BatchResult& result) {
+  out << result.id << ',';
+  if (result.error.empty()) {
+    char buf[32];
+    auto end{std::to_chars(buf, buf + sizeof(buf), result.value).ptr};
+    out.write(buf, end - buf);
+    out << ',';
+    end = std::to_chars(buf, buf + sizeof(buf), result.standardError).ptr;
+    out.write(buf, end - buf);
+    out << ",\n";
+  } else {
+    out << ",,\"";
+    for (const char c : result.error) {
+      if (c == '"') out << '"';
+      out << c;
+    }
+    out << "\"\n";
+  }
+}
+}  // namespace batch
@@ -1,5 +1,8 @@
 #include "BlackScholes.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "MathUtils.h"
 
 double BlackScholes::calculatePrice() const {
@@ -9,27 +12,26 @@ double BlackScholes::calculatePrice() const {
 
   auto start = std::chrono::high_resolution_clock::now();
 
-  const double S = option.getStockPrice();
-  const double K = option.getStrikePrice();
-  const double T = option.getTimeToMaturity();
-  const double r = option.getRiskFreeRate();
-  const double sigma = option.getVolatility();
-  const double q = option.getDividendYield();
+  cachedPrice = price(option.getType(), option.getStockPrice(),
+                      option.getStrikePrice(), option.getTimeToMaturity(),
+                      option.getRiskFreeRate(), option.getVolatility(),
+                      option.getDividendYield());
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+double BlackScholes::price(OptionType type, double S, double K, double T,
+                           double r, double sigma, double q) {
+  const double sign = type == OptionType::CALL ? 1.0 : -1.0;
 
   if (T <= 1e-12) {
-    cachedPrice = option.calculatePayoff(S);
-    priceCalculated = true;
-    lastRunDuration = std::chrono::high_resolution_clock::now() - start;
-    return cachedPrice;
+    return std::max(sign * (S - K), 0.0);
   }
 
   if (sigma <= 1e-12) {
     const double forward = S * std::exp((r - q) * T);
-    const double payoff = option.calculatePayoff(forward);
-    cachedPrice = payoff * std::exp(-r * T);
-    priceCalculated = true;
-    lastRunDuration = std::chrono::high_resolution_clock::now() - start;
-    return cachedPrice;
+    return std::max(sign * (forward - K), 0.0) * std::exp(-r * T);
   }
   const double sqrtT = std::sqrt(T);
   const double logSK = std::log(S / K);
@@ -40,16 +42,23 @@ double BlackScholes::calculatePrice() const {
       (logSK + (r - q + 0.5 * sigma * sigma) * T) / (sigma * sqrtT);
   const double d2 = d1 - sigma * sqrtT;
 
-  if (option.getType() == OptionType::CALL) {
-    cachedPrice =
-        S * discQ * math::norm_cdf(d1) - K * discR * math::norm_cdf(d2);
-  } else {
-    cachedPrice =
-        K * discR * math::norm_cdf(-d2) - S * discQ * math::norm_cdf(-d1);
+  // call: S e^{-qT} N(d1) - K e^{-rT} N(d2); put mirrors the signs
+  return sign * (S * discQ * math::norm_cdf(sign * d1) -
+                 K * discR * math::norm_cdf(sign * d2));
+}
+
+void BlackScholes::priceBatch(const OptionColumns& options,
+                              std::span<double> out) {
+  const std::size_t n = options.size();
+  if (out.size() != n || options.type.size() != n || options.K.size() != n ||
+      options.T.size() != n || options.r.size() != n ||
+      options.sigma.size() != n || options.q.size() != n) {
+    throw std::invalid_argument("Batch columns must all have the same size");
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = price(options.type[i], options.S[i], options.K[i], options.T[i],
+                   options.r[i], options.sigma[i], options.q[i]);
   }
-  priceCalculated = true;
-  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
-  return cachedPrice;
 }
 
 Greeks BlackScholes::calculateGreeks() {
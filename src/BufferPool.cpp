@@ -0,0 +1,140 @@
+#include "BufferPool.h"
+
+#include <bit>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+constexpr std::align_val_t BLOCK_ALIGN{64};
+
+// set once the calling thread's pool has been destroyed, so buffers freed
+// during thread teardown go straight back to the system
+thread_local bool poolDestroyed{false};
+}  // namespace
+
+BufferPool::~BufferPool() {
+  trim();
+  poolDestroyed = true;
+}
+
+BufferPool& BufferPool::local() {
+  thread_local BufferPool pool;
+  return pool;
+}
+
+void BufferPool::configure(const Config& newConfig) {
+  config = newConfig;
+  for (auto& list : freeLists) {
+    while (list.size() > config.maxCachedPerClass) {
+      const std::size_t shift{
+          static_cast<std::size_t>(&list - freeLists.data()) +
+          MIN_CLASS_SHIFT};
+      systemFree(list.back(), shift);
+      stats.cachedBytes -= std::size_t{1} << shift;
+      list.pop_back();
+    }
+  }
+}
+
+void BufferPool::trim() noexcept {
+  for (std::size_t c{0}; c < NUM_CLASSES; ++c) {
+    for (void* ptr : freeLists[c]) {
+      systemFree(ptr, c + MIN_CLASS_SHIFT);
+    }
+    freeLists[c].clear();
+  }
+  stats.cachedBytes = 0;
+}
+
+void* BufferPool::acquire(std::size_t bytes) {
+  if (bytes < (std::size_t{1} << MIN_CLASS_SHIFT)) {
+    return ::operator new(bytes == 0 ? 1 : bytes, BLOCK_ALIGN);
+  }
+  const std::size_t shift{classShift(bytes)};
+  if (poolDestroyed) {
+    return systemAllocate(shift, false);
+  }
+  return local().allocateClass(shift);
+}
+
+void BufferPool::release(void* ptr, std::size_t bytes) noexcept {
+  if (ptr == nullptr) return;
+  if (bytes < (std::size_t{1} << MIN_CLASS_SHIFT)) {
+    ::operator delete(ptr, BLOCK_ALIGN);
+    return;
+  }
+  const std::size_t shift{classShift(bytes)};
+  if (poolDestroyed) {
+    systemFree(ptr, shift);
+    return;
+  }
+  local().cacheOrFree(ptr, shift);
+}
+
+void* BufferPool::allocateClass(std::size_t shift) {
+  auto& list = freeLists[shift - MIN_CLASS_SHIFT];
+  if (!list.empty()) {
+    void* ptr{list.back()};
+    list.pop_back();
+    ++stats.hits;
+    stats.cachedBytes -= std::size_t{1} << shift;
+    return ptr;
+  }
+  ++stats.misses;
+  return systemAllocate(shift, config.hugePages);
+}
+
+void BufferPool::cacheOrFree(void* ptr, std::size_t shift) noexcept {
+  auto& list = freeLists[shift - MIN_CLASS_SHIFT];
+  if (list.size() >= config.maxCachedPerClass) {
+    systemFree(ptr, shift);
+    return;
+  }
+  try {
+    list.push_back(ptr);
+    stats.cachedBytes += std::size_t{1} << shift;
+  } catch (...) {
+    systemFree(ptr, shift);
+  }
+}
+
+std::size_t BufferPool::classShift(std::size_t bytes) {
+  const std::size_t shift{static_cast<std::size_t>(std::bit_width(bytes - 1))};
+  if (shift >= MIN_CLASS_SHIFT + NUM_CLASSES) {
+    throw std::bad_alloc();
+  }
+  return shift;
+}
+
+void* BufferPool::systemAllocate(std::size_t shift, bool hugePages) {
+  const std::size_t size{std::size_t{1} << shift};
+#ifdef __linux__
+  if (shift >= HUGE_CLASS_SHIFT) {
+    void* ptr{::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    if (ptr == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    if (hugePages) {
+      ::madvise(ptr, size, MADV_HUGEPAGE);  // best effort
+    }
+    return ptr;
+  }
+#else
+  (void)hugePages;
+#endif
+  return ::operator new(size, BLOCK_ALIGN);
+}
+
+void BufferPool::systemFree(void* ptr, std::size_t shift) noexcept {
+#ifdef __linux__
+  if (shift >= HUGE_CLASS_SHIFT) {
+    ::munmap(ptr, std::size_t{1} << shift);
+    return;
+  }
+#endif
+  ::operator delete(ptr, BLOCK_ALIGN);
+}
@@ -0,0 +1,709 @@
+#include "Calibration.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+#include "BlackScholes.h"
+#include "MathUtils.h"
+#include "Parallel.h"
+
+namespace {
+using Complex = std::complex<double>;
+
+using math::GL_NODES;
+using math::GL_WEIGHTS;
+
+constexpr std::size_t SVI_PARAMS{5};     // a, b, ρ, m, σ
+constexpr std::size_t HESTON_PARAMS{5};  // v0, κ, θ, ξ, ρ
+// Durrleman penalty rows per slice, and their weight against vol residuals
+constexpr std::size_t BUTTERFLY_POINTS{25};
+constexpr double BUTTERFLY_PENALTY{10.0};
+// grid for the post-fit butterfly and calendar checks
+constexpr std::size_t CHECK_POINTS{201};
+constexpr int MAX_DAMPING_TRIES{12};
+
+template <std::size_t N>
+using Params = std::array<double, N>;
+
+struct LmResult {
+  unsigned iterations{0};
+  bool converged{false};
+  double cost{0.0};  // half the sum of squared residuals at the result
+};
+
+/**
+ * @brief Solves (A + μ·diag(A)) x = -g by Cholesky; A is N×N row-major.
+ * @return false if the damped matrix is not positive definite.
+ */
+template <std::size_t N>
+bool solveDamped(const std::array<double, N * N>& A, const Params<N>& g,
+                 double mu, Params<N>& x) {
+  std::array<double, N * N> L{};
+  for (std::size_t i{0}; i < N; ++i) {
+    for (std::size_t j{0}; j <= i; ++j) {
+      double sum{A[i * N + j]};
+      if (i == j) sum += mu * std::max(A[i * N + i], 1e-12);
+      for (std::size_t k{0}; k < j; ++k) sum -= L[i * N + k] * L[j * N + k];
+      if (i == j) {
+        if (!(sum > 0.0)) return false;
+        L[i * N + i] = std::sqrt(sum);
+      } else {
+        L[i * N + j] = sum / L[j * N + j];
+      }
+    }
+  }
+  Params<N> y{};
+  for (std::size_t i{0}; i < N; ++i) {
+    double sum{-g[i]};
+    for (std::size_t k{0}; k < i; ++k) sum -= L[i * N + k] * y[k];
+    y[i] = sum / L[i * N + i];
+  }
+  for (std::size_t i{N}; i-- > 0;) {
+    double sum{y[i]};
+    for (std::size_t k{i + 1}; k < N; ++k) sum -= L[k * N + i] * x[k];
+    x[i] = sum / L[i * N + i];
+  }
+  return true;
+}
+
+/**
+ * @brief Projected Levenberg-Marquardt with Nielsen-style damping updates.
+ *
+ * evaluate(p, residuals, jacobian) fills the residuals for parameters p
+ * and, unless the span is empty, the Jacobian (row-major, rows × N); trial
+ * steps skip the Jacobian, so rejected steps stay cheap. project(p) moves
+ * p back into the feasible box after each step.
+ */
+template <std::size_t N, class Evaluate, class Project>
+LmResult levenbergMarquardt(Params<N>& p, std::size_t rows,
+                            Evaluate&& evaluate, Project&& project,
+                            const calibration::Config& config) {
+  std::vector<double> r(rows), J(rows * N), rTrial(rows);
+  auto halfSquares = [](const std::vector<double>& v) {
+    double sum{0.0};
+    for (const double x : v) sum += x * x;
+    return 0.5 * sum;
+  };
+  project(p);
+  evaluate(p, r, J);
+  double cost{halfSquares(r)};
+  double mu{1e-3};
+  LmResult result{};
+
+  while (result.iterations < config.maxIterations && !result.converged &&
+         cost > 0.0) {
+    ++result.iterations;
+    std::array<double, N * N> A{};
+    Params<N> g{};
+    for (std::size_t row{0}; row < rows; ++row) {
+      const double* Jr{&J[row * N]};
+      for (std::size_t i{0}; i < N; ++i) {
+        g[i] += Jr[i] * r[row];
+        for (std::size_t j{0}; j <= i; ++j) A[i * N + j] += Jr[i] * Jr[j];
+      }
+    }
+    for (std::size_t i{0}; i < N; ++i) {
+      for (std::size_t j{0}; j < i; ++j) A[j * N + i] = A[i * N + j];
+    }
+
+    bool accepted{false};
+    for (int attempt{0}; attempt < MAX_DAMPING_TRIES && !accepted; ++attempt) {
+      Params<N> step{};
+      if (!solveDamped<N>(A, g, mu, step)) {
+        mu *= 4.0;
+        continue;
+      }
+      Params<N> trial{};
+      for (std::size_t i{0}; i < N; ++i) trial[i] = p[i] + step[i];
+      project(trial);
+      evaluate(trial, rTrial, std::span<double>{});
+      const double trialCost{halfSquares(rTrial)};
+      if (trialCost < cost) {
+        double moved{0.0};
+        double size{0.0};
+        for (std::size_t i{0}; i < N; ++i) {
+          moved += (trial[i] - p[i]) * (trial[i] - p[i]);
+          size += p[i] * p[i];
+        }
+        result.converged =
+            cost - trialCost <= config.tolerance * cost ||
+            moved <= config.tolerance * config.tolerance * (size + 1e-12);
+        p = trial;
+        cost = trialCost;
+        if (!result.converged) evaluate(p, r, J);
+        mu = std::max(mu / 3.0, 1e-12);
+        accepted = true;
+      } else {
+        mu *= 4.0;
+      }
+    }
+    // no damping improves the cost: a minimum to working precision
+    if (!accepted) result.converged = true;
+  }
+  if (cost == 0.0) result.converged = true;
+  result.cost = cost;
+  return result;
+}
+
+void validateQuotes(std::span<const calibration::Quote> quotes, double spot) {
+  if (!(spot > 0.0)) {
+    throw std::invalid_argument("Spot must be positive");
+  }
+  for (const calibration::Quote& quote : quotes) {
+    if (!(quote.expiry > 0.0) || !(quote.strike > 0.0) || !(quote.vol > 0.0) ||
+        !(quote.weight >= 0.0)) {
+      throw std::invalid_argument(
+          "Quotes need positive expiry, strike and vol and a non-negative "
+          "weight");
+    }
+  }
+}
+
+/**
+ * @brief Quote indices grouped by expiry, in increasing expiry order.
+ */
+std::vector<std::vector<std::size_t>> groupByExpiry(
+    std::span<const calibration::Quote> quotes) {
+  std::vector<std::size_t> order(quotes.size());
+  for (std::size_t i{0}; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t x, std::size_t y) {
+                     return quotes[x].expiry < quotes[y].expiry;
+                   });
+  std::vector<std::vector<std::size_t>> groups;
+  for (const std::size_t i : order) {
+    if (groups.empty() || quotes[groups.back().front()].expiry !=
+                              quotes[i].expiry) {
+      groups.emplace_back();
+    }
+    groups.back().push_back(i);
+  }
+  return groups;
+}
+
+// ---------------------------------------------------------------- SVI
+
+void projectSvi(Params<SVI_PARAMS>& p) {
+  double& a{p[0]};
+  double& b{p[1]};
+  double& rho{p[2]};
+  double& sigma{p[4]};
+  sigma = std::max(sigma, 1e-4);
+  rho = std::clamp(rho, -0.999, 0.999);
+  b = std::clamp(b, 0.0, 2.0 / (1.0 + std::abs(rho)));
+  a = std::max(a, 1e-10 - b * sigma * std::sqrt(1.0 - rho * rho));
+}
+
+SviParams toSvi(const Params<SVI_PARAMS>& p) {
+  return SviParams{p[0], p[1], p[2], p[3], p[4]};
+}
+
+/**
+ * @brief One expiry slice in log-moneyness.
+ */
+struct SviSlice {
+  double expiry{0.0};
+  std::vector<double> k, vol, weight;
+  double lower{0.0}, upper{0.0};  // penalty and check range
+};
+
+calibration::SviFit fitSlice(const SviSlice& slice, const SviParams* start,
+                             const calibration::Config& config) {
+  const double T{slice.expiry};
+  const std::size_t n{slice.k.size()};
+  Params<SVI_PARAMS> p{};
+  if (start != nullptr) {
+    p = {start->a, start->b, start->rho, start->m, start->sigma};
+  } else {
+    // flat smile through the quote nearest the money
+    std::size_t atm{0};
+    for (std::size_t j{1}; j < n; ++j) {
+      if (std::abs(slice.k[j]) < std::abs(slice.k[atm])) atm = j;
+    }
+    const double b{0.1};
+    const double sigma{0.1};
+    p = {slice.vol[atm] * slice.vol[atm] * T - b * sigma, b, 0.0, 0.0, sigma};
+  }
+
+  std::array<double, BUTTERFLY_POINTS> grid{};
+  for (std::size_t j{0}; j < BUTTERFLY_POINTS; ++j) {
+    grid[j] = slice.lower + (slice.upper - slice.lower) * static_cast<double>(j) /
+                                (BUTTERFLY_POINTS - 1);
+  }
+
+  auto evaluate = [&](const Params<SVI_PARAMS>& x, std::span<double> r,
+                      std::span<double> J) {
+    const bool jacobian{!J.empty()};
+    const double a{x[0]}, b{x[1]}, rho{x[2]}, m{x[3]}, sigma{x[4]};
+    for (std::size_t j{0}; j < n; ++j) {
+      // total-variance error scaled to vol units at the quote
+      const double scale{slice.weight[j] / (2.0 * slice.vol[j] * T)};
+      const double km{slice.k[j] - m};
+      const double s{std::sqrt(km * km + sigma * sigma)};
+      const double w{a + b * (rho * km + s)};
+      r[j] = scale * (w - slice.vol[j] * slice.vol[j] * T);
+      if (!jacobian) continue;
+      double* row{&J[j * SVI_PARAMS]};
+      row[0] = scale;
+      row[1] = scale * (rho * km + s);
+      row[2] = scale * b * km;
+      row[3] = -scale * b * (rho + km / s);
+      row[4] = scale * b * sigma / s;
+    }
+    // penalty rows: central differences, zero wherever g ≥ 0 around x
+    for (std::size_t j{0}; j < BUTTERFLY_POINTS; ++j) {
+      auto penalty = [&](const Params<SVI_PARAMS>& y) {
+        return BUTTERFLY_PENALTY * std::min(toSvi(y).durrleman(grid[j]), 0.0);
+      };
+      r[n + j] = penalty(x);
+      if (!jacobian) continue;
+      double* row{&J[(n + j) * SVI_PARAMS]};
+      for (std::size_t i{0}; i < SVI_PARAMS; ++i) {
+        const double h{1e-6 * std::max(std::abs(x[i]), 1e-2)};
+        Params<SVI_PARAMS> up{x}, dn{x};
+        up[i] += h;
+        dn[i] -= h;
+        row[i] = (penalty(up) - penalty(dn)) / (2.0 * h);
+      }
+    }
+  };
+
+  const LmResult lm{levenbergMarquardt<SVI_PARAMS>(
+      p, n + BUTTERFLY_POINTS, evaluate, projectSvi, config)};
+
+  calibration::SviFit fit{};
+  fit.expiry = T;
+  fit.params = toSvi(p);
+  fit.iterations = lm.iterations;
+  double squares{0.0};
+  double weights{0.0};
+  for (std::size_t j{0}; j < n; ++j) {
+    const double error{std::sqrt(fit.params.totalVariance(slice.k[j]) / T) -
+                       slice.vol[j]};
+    squares += slice.weight[j] * slice.weight[j] * error * error;
+    weights += slice.weight[j] * slice.weight[j];
+  }
+  fit.rmse = weights > 0.0 ? std::sqrt(squares / weights) : 0.0;
+  for (std::size_t j{0}; j < CHECK_POINTS; ++j) {
+    const double k{slice.lower + (slice.upper - slice.lower) *
+                                     static_cast<double>(j) /
+                                     (CHECK_POINTS - 1)};
+    if (fit.params.durrleman(k) < -1e-10) fit.butterflyFree = false;
+  }
+  return fit;
+}
+
+// ------------------------------------------------------------- Heston
+
+// plain complex products: std::complex's operators guard against inf/NaN
+// through library calls, which dominate the dual-number arithmetic
+Complex mul(Complex x, Complex y) {
+  return {x.real() * y.real() - x.imag() * y.imag(),
+          x.real() * y.imag() + x.imag() * y.real()};
+}
+
+Complex inverse(Complex x) {
+  const double scale{1.0 / (x.real() * x.real() + x.imag() * x.imag())};
+  return {x.real() * scale, -x.imag() * scale};
+}
+
+/**
+ * @brief A complex value with its derivatives with respect to the Heston
+ * parameters (forward-mode dual number).
+ */
+struct Jet {
+  Complex v{};
+  std::array<Complex, HESTON_PARAMS> d{};
+};
+
+Jet variable(double value, std::size_t index) {
+  Jet x{Complex{value, 0.0}, {}};
+  x.d[index] = 1.0;
+  return x;
+}
+
+Jet operator+(const Jet& x, const Jet& y) {
+  Jet z{x.v + y.v, {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) z.d[i] = x.d[i] + y.d[i];
+  return z;
+}
+
+Jet operator-(const Jet& x, const Jet& y) {
+  Jet z{x.v - y.v, {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) z.d[i] = x.d[i] - y.d[i];
+  return z;
+}
+
+Jet operator-(Complex c, const Jet& x) {
+  Jet z{c - x.v, {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) z.d[i] = -x.d[i];
+  return z;
+}
+
+Jet operator*(const Jet& x, const Jet& y) {
+  Jet z{mul(x.v, y.v), {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) {
+    z.d[i] = mul(x.v, y.d[i]) + mul(y.v, x.d[i]);
+  }
+  return z;
+}
+
+Jet operator*(const Jet& x, Complex c) {
+  Jet z{mul(x.v, c), {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) z.d[i] = mul(x.d[i], c);
+  return z;
+}
+
+Jet operator/(const Jet& x, const Jet& y) {
+  const Complex inv{inverse(y.v)};
+  Jet z{mul(x.v, inv), {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) {
+    z.d[i] = mul(x.d[i] - mul(z.v, y.d[i]), inv);
+  }
+  return z;
+}
+
+Jet exp(const Jet& x) {
+  Jet z{std::exp(x.v), {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) z.d[i] = mul(z.v, x.d[i]);
+  return z;
+}
+
+Jet log(const Jet& x) {
+  const Complex inv{inverse(x.v)};
+  Jet z{std::log(x.v), {}};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) z.d[i] = mul(x.d[i], inv);
+  return z;
+}
+
+Jet sqrt(const Jet& x) {
+  Jet z{std::sqrt(x.v), {}};
+  const Complex half{inverse(2.0 * z.v)};
+  for (std::size_t i{0}; i < HESTON_PARAMS; ++i) z.d[i] = mul(x.d[i], half);
+  return z;
+}
+
+/**
+ * @brief heston::characteristicFunction on dual numbers, same formulation.
+ */
+Jet hestonCharacteristicFunction(Complex u, double T,
+                                 const Params<HESTON_PARAMS>& p) {
+  const Jet v0{variable(p[0], 0)};
+  const Jet kappa{variable(p[1], 1)};
+  const Jet theta{variable(p[2], 2)};
+  const Jet xi{variable(p[3], 3)};
+  const Jet rho{variable(p[4], 4)};
+  const Complex iu{Complex{0.0, 1.0} * u};
+  const Jet xi2{xi * xi};
+  const Jet beta{kappa - rho * xi * iu};
+  const Jet d{sqrt(beta * beta + xi2 * (iu + u * u))};
+  const Jet g{(beta - d) / (beta + d)};
+  const Jet e{exp(d * Complex{-T, 0.0})};
+  const Jet A{kappa * theta / xi2 *
+              ((beta - d) * Complex{T, 0.0} -
+               log((1.0 - g * e) / (1.0 - g)) * Complex{2.0, 0.0})};
+  const Jet D{(beta - d) / xi2 * (1.0 - e) / (1.0 - g * e)};
+  return exp(A + D * v0);
+}
+
+void projectHeston(Params<HESTON_PARAMS>& p) {
+  p[0] = std::clamp(p[0], 1e-4, 2.0);    // v0
+  p[1] = std::clamp(p[1], 1e-2, 20.0);   // κ
+  p[2] = std::clamp(p[2], 1e-4, 2.0);    // θ
+  p[3] = std::clamp(p[3], 1e-2, 4.0);    // ξ
+  p[4] = std::clamp(p[4], -0.99, 0.99);  // ρ
+}
+
+/**
+ * @brief Fixed Lewis-integral nodes for one expiry and the quotes priced
+ * on them.
+ */
+struct HestonSlice {
+  double expiry{0.0};
+  std::vector<double> u;       // nodes, GL_NODES.size() ± pairs per panel
+  std::vector<double> weight;  // quadrature weight / (u² + ¼)
+  std::vector<double> panelMid, panelHalf;
+  std::size_t firstQuote{0};
+  std::size_t quoteCount{0};
+  std::size_t psiOffset{0};  // into the per-evaluation ψ table
+};
+}  // namespace
+
+double SviParams::totalVariance(double k) const {
+  const double km{k - m};
+  return a + b * (rho * km + std::sqrt(km * km + sigma * sigma));
+}
+
+double SviParams::durrleman(double k) const {
+  const double km{k - m};
+  const double s{std::sqrt(km * km + sigma * sigma)};
+  const double w{a + b * (rho * km + s)};
+  const double w1{b * (rho + km / s)};
+  const double w2{b * sigma * sigma / (s * s * s)};
+  const double first{1.0 - k * w1 / (2.0 * w)};
+  return first * first - 0.25 * w1 * w1 * (1.0 / w + 0.25) + 0.5 * w2;
+}
+
+namespace calibration {
+std::vector<SviFit> fitSvi(std::span<const Quote> quotes, double spot,
+                           double r, double q, const Config& config,
+                           std::span<const SviFit> previous) {
+  validateQuotes(quotes, spot);
+  const std::vector<std::vector<std::size_t>> groups{groupByExpiry(quotes)};
+  std::vector<SviSlice> slices(groups.size());
+  for (std::size_t s{0}; s < groups.size(); ++s) {
+    if (groups[s].size() < SVI_PARAMS) {
+      throw std::invalid_argument("Each SVI slice needs at least five quotes");
+    }
+    SviSlice& slice{slices[s]};
+    slice.expiry = quotes[groups[s].front()].expiry;
+    const double forward{spot * std::exp((r - q) * slice.expiry)};
+    for (const std::size_t i : groups[s]) {
+      slice.k.push_back(std::log(quotes[i].strike / forward));
+      slice.vol.push_back(quotes[i].vol);
+      slice.weight.push_back(quotes[i].weight);
+    }
+    const auto [lo, hi] = std::minmax_element(slice.k.begin(), slice.k.end());
+    const double margin{std::max(0.5 * (*hi - *lo), 0.25)};
+    slice.lower = *lo - margin;
+    slice.upper = *hi + margin;
+  }
+
+  std::vector<SviFit> fits(slices.size());
+  parallel::forEachIndex(
+      slices.size(),
+      [&](std::size_t s) {
+        const SviParams* start{nullptr};
+        for (const SviFit& fit : previous) {
+          if (fit.expiry == slices[s].expiry) start = &fit.params;
+        }
+        fits[s] = fitSlice(slices[s], start, config);
+      },
+      config.threads);
+
+  // calendar arbitrage: total variance must not fall with expiry
+  for (std::size_t s{1}; s < fits.size(); ++s) {
+    const double lower{std::min(slices[s].lower, slices[s - 1].lower)};
+    const double upper{std::max(slices[s].upper, slices[s - 1].upper)};
+    for (std::size_t j{0}; j < CHECK_POINTS; ++j) {
+      const double k{lower + (upper - lower) * static_cast<double>(j) /
+                                 (CHECK_POINTS - 1)};
+      if (fits[s].params.totalVariance(k) <
+          fits[s - 1].params.totalVariance(k) - 1e-12) {
+        fits[s].calendarFree = false;
+      }
+    }
+  }
+  return fits;
+}
+
+HestonFit fitHeston(std::span<const Quote> quotes, double spot, double r,
+                    double q, const HestonParams& initial,
+                    const Config& config) {
+  validateQuotes(quotes, spot);
+  initial.validate();
+  if (quotes.size() < HESTON_PARAMS) {
+    throw std::invalid_argument("Heston calibration needs at least five quotes");
+  }
+  const std::vector<std::vector<std::size_t>> groups{groupByExpiry(quotes)};
+
+  // quotes in slice order, with everything that does not depend on the
+  // parameters precomputed
+  const std::size_t n{quotes.size()};
+  std::vector<double> target(n), scale(n), prefactor(n), spotDf(n);
+  std::vector<std::size_t> sliceOf(n), rotationOffset(n);
+  std::vector<HestonSlice> slices(groups.size());
+  std::size_t quoteIndex{0};
+  std::size_t psiSize{0};
+  std::size_t rotationSize{0};
+  for (std::size_t s{0}; s < groups.size(); ++s) {
+    HestonSlice& slice{slices[s]};
+    const double T{quotes[groups[s].front()].expiry};
+    slice.expiry = T;
+    slice.firstQuote = quoteIndex;
+    slice.quoteCount = groups[s].size();
+
+    double minVol{quotes[groups[s].front()].vol};
+    double maxLogMoneyness{0.0};
+    for (const std::size_t i : groups[s]) {
+      minVol = std::min(minVol, quotes[i].vol);
+      const double k{std::log(spot / quotes[i].strike) + (r - q) * T};
+      maxLogMoneyness = std::max(maxLogMoneyness, std::abs(k));
+    }
+    // panels widen from the 1/(u² + ¼) peak, stay short enough to resolve
+    // the strike oscillation, and stop where even half the lowest quoted
+    // vol has damped the integrand to round-off
+    const double sqrtT{std::sqrt(T)};
+    const double lowVol{std::max(0.5 * minVol, 0.02)};
+    const double upper{8.0 / (lowVol * sqrtT)};
+    const double maxWidth{std::min(
+        std::clamp(2.0 / (minVol * sqrtT), 1.0, 50.0),
+        2.0 * std::numbers::pi / std::max(maxLogMoneyness, 1e-3))};
+    double lower{0.0};
+    double width{0.25};
+    while (lower < upper) {
+      const double mid{lower + 0.5 * width};
+      const double half{0.5 * width};
+      slice.panelMid.push_back(mid);
+      slice.panelHalf.push_back(half);
+      for (std::size_t k{0}; k < GL_NODES.size(); ++k) {
+        for (const double sign : {-1.0, 1.0}) {
+          const double u{mid + sign * half * GL_NODES[k]};
+          slice.u.push_back(u);
+          slice.weight.push_back(half * GL_WEIGHTS[k] / (u * u + 0.25));
+        }
+      }
+      lower += width;
+      width = std::min(2.0 * width, maxWidth);
+    }
+    slice.psiOffset = psiSize;
+    psiSize += slice.u.size() * (HESTON_PARAMS + 1);
+
+    for (const std::size_t i : groups[s]) {
+      const Quote& quote{quotes[i]};
+      const double K{quote.strike};
+      const double sigma{quote.vol};
+      target[quoteIndex] =
+          BlackScholes::price(OptionType::CALL, spot, K, T, r, sigma, q);
+      const double d1{(std::log(spot / K) + (r - q + 0.5 * sigma * sigma) * T) /
+                      (sigma * sqrtT)};
+      const double vega{spot * std::exp(-q * T) * math::norm_pdf(d1) * sqrtT};
+      scale[quoteIndex] = quote.weight / std::max(vega, 1e-4 * spot);
+      prefactor[quoteIndex] = std::sqrt(spot * K) *
+                              std::exp(-0.5 * (r + q) * T) / std::numbers::pi;
+      spotDf[quoteIndex] = spot * std::exp(-q * T);
+      sliceOf[quoteIndex] = s;
+      rotationOffset[quoteIndex] = rotationSize;
+      rotationSize += slice.u.size();
+      ++quoteIndex;
+    }
+  }
+
+  // strike rotations e^{iuk} are fixed for the whole calibration
+  std::vector<double> rotationRe(rotationSize), rotationIm(rotationSize);
+  std::vector<double> logMoneyness(n);
+  for (std::size_t s{0}; s < slices.size(); ++s) {
+    for (std::size_t j{0}; j < slices[s].quoteCount; ++j) {
+      const Quote& quote{quotes[groups[s][j]]};
+      logMoneyness[slices[s].firstQuote + j] =
+          std::log(spot / quote.strike) + (r - q) * quote.expiry;
+    }
+  }
+  // by angle addition: e^{i(mid ± h·x)k} = e^{i·mid·k}·e^{±i·h·x·k}, and the
+  // offset factors repeat when a panel keeps its width or square when it
+  // doubles, so each quote needs about one sin/cos pair per panel
+  parallel::forEachIndex(
+      n,
+      [&](std::size_t j) {
+        const HestonSlice& slice{slices[sliceOf[j]]};
+        const double k{logMoneyness[j]};
+        double* re{&rotationRe[rotationOffset[j]]};
+        double* im{&rotationIm[rotationOffset[j]]};
+        std::array<Complex, GL_NODES.size()> offset{};
+        double previousHalf{0.0};
+        for (std::size_t panel{0}; panel < slice.panelMid.size(); ++panel) {
+          const double half{slice.panelHalf[panel]};
+          for (std::size_t m{0}; m < GL_NODES.size(); ++m) {
+            if (half == 2.0 * previousHalf) {
+              offset[m] = mul(offset[m], offset[m]);
+            } else if (half != previousHalf) {
+              const double angle{half * GL_NODES[m] * k};
+              offset[m] = {std::cos(angle), std::sin(angle)};
+            }
+          }
+          previousHalf = half;
+          const double angle{slice.panelMid[panel] * k};
+          const Complex center{std::cos(angle), std::sin(angle)};
+          for (std::size_t m{0}; m < GL_NODES.size(); ++m) {
+            const Complex up{mul(center, offset[m])};
+            const Complex down{mul(center, std::conj(offset[m]))};
+            const std::size_t at{(panel * GL_NODES.size() + m) * 2};
+            re[at] = down.real();
+            im[at] = down.imag();
+            re[at + 1] = up.real();
+            im[at + 1] = up.imag();
+          }
+        }
+      },
+      config.threads);
+
+  // ψ = weight · φ(u - i/2) and its parameter derivatives, per node, laid
+  // out as (HESTON_PARAMS + 1) contiguous runs per slice
+  std::vector<double> psiRe(psiSize), psiIm(psiSize);
+  auto evaluate = [&](const Params<HESTON_PARAMS>& p, std::span<double> res,
+                      std::span<double> J) {
+    const bool jacobian{!J.empty()};
+    const HestonParams params{p[0], p[1], p[2], p[3], p[4]};
+    parallel::forEachIndex(
+        slices.size(),
+        [&](std::size_t s) {
+          const HestonSlice& slice{slices[s]};
+          const std::size_t nodes{slice.u.size()};
+          for (std::size_t m{0}; m < nodes && !jacobian; ++m) {
+            const std::complex<double> phi{heston::characteristicFunction(
+                {slice.u[m], -0.5}, slice.expiry, params)};
+            psiRe[slice.psiOffset + m] = slice.weight[m] * phi.real();
+            psiIm[slice.psiOffset + m] = slice.weight[m] * phi.imag();
+          }
+          for (std::size_t m{0}; m < nodes && jacobian; ++m) {
+            const Jet phi{hestonCharacteristicFunction({slice.u[m], -0.5},
+                                                       slice.expiry, p)};
+            const double w{slice.weight[m]};
+            psiRe[slice.psiOffset + m] = w * phi.v.real();
+            psiIm[slice.psiOffset + m] = w * phi.v.imag();
+            for (std::size_t c{0}; c < HESTON_PARAMS; ++c) {
+              const std::size_t at{slice.psiOffset + (c + 1) * nodes + m};
+              psiRe[at] = w * phi.d[c].real();
+              psiIm[at] = w * phi.d[c].imag();
+            }
+          }
+        },
+        config.threads);
+    parallel::forEachIndex(
+        n,
+        [&](std::size_t j) {
+          const HestonSlice& slice{slices[sliceOf[j]]};
+          const std::size_t nodes{slice.u.size()};
+          const double* re{&rotationRe[rotationOffset[j]]};
+          const double* im{&rotationIm[rotationOffset[j]]};
+          std::array<double, HESTON_PARAMS + 1> integral{};
+          const std::size_t columns{jacobian ? HESTON_PARAMS + 1 : 1};
+          for (std::size_t c{0}; c < columns; ++c) {
+            const double* pr{&psiRe[slice.psiOffset + c * nodes]};
+            const double* pm{&psiIm[slice.psiOffset + c * nodes]};
+            double sum{0.0};
+            for (std::size_t m{0}; m < nodes; ++m) {
+              sum += re[m] * pr[m] - im[m] * pm[m];
+            }
+            integral[c] = sum;
+          }
+          const double call{spotDf[j] - prefactor[j] * integral[0]};
+          res[j] = scale[j] * (call - target[j]);
+          for (std::size_t c{0}; c < HESTON_PARAMS && jacobian; ++c) {
+            J[j * HESTON_PARAMS + c] =
+                -scale[j] * prefactor[j] * integral[c + 1];
+          }
+        },
+        config.threads);
+  };
+
+  Params<HESTON_PARAMS> p{initial.v0, initial.kappa, initial.theta,
+                          std::max(initial.xi, 1e-2), initial.rho};
+  const LmResult lm{levenbergMarquardt<HESTON_PARAMS>(p, n, evaluate,
+                                                      projectHeston, config)};
+
+  HestonFit fit{};
+  fit.params = HestonParams{p[0], p[1], p[2], p[3], p[4]};
+  fit.iterations = lm.iterations;
+  fit.converged = lm.converged;
+  double weights{0.0};
+  for (const Quote& quote : quotes) weights += quote.weight * quote.weight;
+  fit.rmse = weights > 0.0 ? std::sqrt(2.0 * lm.cost / weights) : 0.0;
+  return fit;
+}
+}  // namespace calibration
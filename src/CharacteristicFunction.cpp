@@ -0,0 +1,89 @@
+#include "CharacteristicFunction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+BlackScholesCF::BlackScholesCF(double sigma) : sigma{sigma} {
+  if (sigma < 0.0) {
+    throw std::invalid_argument("Volatility must be non-negative");
+  }
+}
+
+std::complex<double> BlackScholesCF::operator()(std::complex<double> u,
+                                                double T) const {
+  const std::complex<double> i{0.0, 1.0};
+  return std::exp(-0.5 * sigma * sigma * T * (i * u + u * u));
+}
+
+Cumulants BlackScholesCF::cumulants(double T) const {
+  return {-0.5 * sigma * sigma * T, sigma * sigma * T, 0.0};
+}
+
+std::unique_ptr<CharacteristicFunction> BlackScholesCF::withVolatilityBump(
+    double eps) const {
+  return std::make_unique<BlackScholesCF>(std::max(sigma + eps, 0.0));
+}
+
+HestonCF::HestonCF(const HestonParams& params) : params{params} {
+  params.validate();
+}
+
+std::complex<double> HestonCF::operator()(std::complex<double> u,
+                                          double T) const {
+  return heston::characteristicFunction(u, T, params);
+}
+
+Cumulants HestonCF::cumulants(double T) const {
+  // Fang & Oosterlee (2008), appendix A
+  const double k{params.kappa};
+  const double th{params.theta};
+  const double v0{params.v0};
+  const double x{params.xi};
+  const double r{params.rho};
+  const double e{std::exp(-k * T)};
+  Cumulants c{};
+  c.c1 = (1.0 - e) * (th - v0) / (2.0 * k) - 0.5 * th * T;
+  c.c2 = 1.0 / (8.0 * k * k * k) *
+         (x * T * k * e * (v0 - th) * (8.0 * k * r - 4.0 * x) +
+          k * r * x * (1.0 - e) * (16.0 * th - 8.0 * v0) +
+          2.0 * th * k * T * (-4.0 * k * r * x + x * x + 4.0 * k * k) +
+          x * x * ((th - 2.0 * v0) * e * e + th * (6.0 * e - 7.0) + 2.0 * v0) +
+          8.0 * k * k * (v0 - th) * (1.0 - e));
+  if (!(c.c2 > 0.0)) c.c2 = std::max(th, v0) * T;  // guard extreme inputs
+  return c;
+}
+
+std::unique_ptr<CharacteristicFunction> HestonCF::withVolatilityBump(
+    double eps) const {
+  HestonParams bumped{params};
+  const double vol0{std::max(std::sqrt(params.v0) + eps, 0.0)};
+  bumped.v0 = vol0 * vol0;
+  return std::make_unique<HestonCF>(bumped);
+}
+
+MertonCF::MertonCF(const MertonParams& params) : params{params} {
+  params.validate();
+}
+
+std::complex<double> MertonCF::operator()(std::complex<double> u,
+                                          double T) const {
+  return merton::characteristicFunction(u, T, params);
+}
+
+Cumulants MertonCF::cumulants(double T) const {
+  const double s2{params.sigma * params.sigma};
+  const double m{params.jumpMean};
+  const double v{params.jumpVol * params.jumpVol};
+  const double l{params.lambda};
+  return {(-0.5 * s2 - l * params.compensator() + l * m) * T,
+          (s2 + l * (m * m + v)) * T,
+          l * T * (m * m * m * m + 6.0 * v * m * m + 3.0 * v * v)};
+}
+
+std::unique_ptr<CharacteristicFunction> MertonCF::withVolatilityBump(
+    double eps) const {
+  MertonParams bumped{params};
+  bumped.sigma = std::max(params.sigma + eps, 0.0);
+  return std::make_unique<MertonCF>(bumped);
+}
@@ -0,0 +1,109 @@
+#include "DeadlinePricing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "MonteCarlo.h"
+
+ThroughputModel::ThroughputModel(Config config)
+    : config{config}, secondsPerPath{1.0 / config.initialPathsPerSecond} {
+  if (!(config.smoothing > 0.0 && config.smoothing <= 1.0) ||
+      !(config.initialPathsPerSecond > 0.0) ||
+      !(config.headroom > 0.0 && config.headroom <= 1.0)) {
+    throw std::invalid_argument("Invalid throughput model settings");
+  }
+}
+
+ThroughputModel& ThroughputModel::global() {
+  static ThroughputModel model{};
+  return model;
+}
+
+void ThroughputModel::record(unsigned long paths,
+                             std::chrono::nanoseconds elapsed) {
+  if (paths == 0) return;
+  const double observed{std::chrono::duration<double>(elapsed).count() /
+                        static_cast<double>(paths)};
+  std::lock_guard lock{mutex};
+  // the first observation replaces the cold-start guess outright
+  secondsPerPath = sampleCount == 0
+                       ? observed
+                       : secondsPerPath +
+                             config.smoothing * (observed - secondsPerPath);
+  ++sampleCount;
+}
+
+unsigned long ThroughputModel::pathsFor(std::chrono::nanoseconds budget) const {
+  if (budget <= std::chrono::nanoseconds::zero()) return 0;
+  const double seconds{std::chrono::duration<double>(budget).count()};
+  std::lock_guard lock{mutex};
+  return static_cast<unsigned long>(
+      std::floor(config.headroom * seconds / secondsPerPath));
+}
+
+double ThroughputModel::pathsPerSecond() const {
+  std::lock_guard lock{mutex};
+  return 1.0 / secondsPerPath;
+}
+
+std::uint64_t ThroughputModel::samples() const {
+  std::lock_guard lock{mutex};
+  return sampleCount;
+}
+
+namespace deadline {
+DeadlineResult priceWithDeadline(const Option& option,
+                                 std::chrono::steady_clock::time_point deadline,
+                                 const DeadlineConfig& config,
+                                 ThroughputModel& model) {
+  if (config.minPaths == 0 || config.maxPaths < config.minPaths ||
+      config.chunks == 0) {
+    throw std::invalid_argument("Invalid deadline pricing settings");
+  }
+  using Clock = std::chrono::steady_clock;
+  const auto start{Clock::now()};
+  DeadlineResult result{};
+
+  const unsigned long planned{
+      std::min(model.pathsFor(deadline - start), config.maxPaths)};
+  if (planned < config.minPaths) {
+    result.price = BlackScholes(option).calculatePrice();
+    result.fallback = true;
+  } else {
+    const unsigned long chunk{
+        std::max(config.minPaths, planned / config.chunks)};
+    std::optional<MonteCarlo> mc{};
+    unsigned long done{0};
+    while (done < planned) {
+      unsigned long step{std::min(chunk, planned - done)};
+      if (done > 0) {
+        // re-plan against the clock with the model as updated so far
+        step = std::min(step, model.pathsFor(deadline - Clock::now()));
+        if (step < config.minPaths) break;
+      }
+
+      const auto chunkStart{Clock::now()};
+      if (!mc) {
+        mc = config.seed ? MonteCarlo(option, step, *config.seed)
+                         : MonteCarlo(option, step);
+        mc->setStorePaths(false);
+        mc->calculatePrice();
+      } else {
+        mc->runMoreSimulations(step);
+      }
+      model.record(step, Clock::now() - chunkStart);
+      done += step;
+    }
+    result.price = mc->getPrice();
+    result.standardError = mc->getStandardError();
+    result.paths = mc->getNumSimulations();
+  }
+
+  const auto end{Clock::now()};
+  result.elapsed = end - start;
+  result.metDeadline = end <= deadline;
+  return result;
+}
+}  // namespace deadline
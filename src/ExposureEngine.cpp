@@ -0,0 +1,215 @@
+#include "ExposureEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "BlackScholes.h"
+#include "MathUtils.h"
+#include "Parallel.h"
+#include "QuantileSketch.h"
+#include "RandomStreams.h"
+
+namespace {
+// blocks in flight per worker thread; bounds the per-wave aggregates
+constexpr std::size_t BLOCKS_PER_THREAD{4};
+
+using random_streams::toUniform;
+
+/**
+ * @brief One block's per-date aggregates.
+ */
+struct BlockAggregates {
+  std::vector<double> value, positive, negative;
+  std::vector<QuantileSketch> exposure;
+
+  BlockAggregates(std::size_t dates, unsigned sketchBits)
+      : value(dates), positive(dates), negative(dates),
+        exposure(dates, QuantileSketch{sketchBits}) {}
+};
+}  // namespace
+
+ExposureEngine::ExposureEngine(const Market& market,
+                               std::vector<ExposureTrade> trades,
+                               std::vector<double> dates, Config config)
+    : market{market},
+      trades{std::move(trades)},
+      dates{std::move(dates)},
+      config{config} {
+  if (market.spot <= 0.0 || market.volatility <= 0.0) {
+    throw std::invalid_argument("Spot and volatility must be positive");
+  }
+  if (this->trades.empty() || this->dates.empty()) {
+    throw std::invalid_argument("Portfolio and date grid must not be empty");
+  }
+  for (const ExposureTrade& trade : this->trades) {
+    if (trade.strike <= 0.0 || trade.maturity <= 0.0) {
+      throw std::invalid_argument("Trade strike and maturity must be positive");
+    }
+  }
+  for (std::size_t d{0}; d < this->dates.size(); ++d) {
+    if (this->dates[d] <= (d == 0 ? 0.0 : this->dates[d - 1])) {
+      throw std::invalid_argument(
+          "Exposure dates must be positive and strictly increasing");
+    }
+  }
+  if (config.pfeQuantile <= 0.0 || config.pfeQuantile >= 1.0) {
+    throw std::invalid_argument("PFE quantile must be between 0 and 1");
+  }
+  QuantileSketch{config.sketchBits};  // validates the resolution
+  layout = random_streams::BlockLayout{config.paths, config.blockPaths,
+                                       this->dates.size()};
+}
+
+double ExposureEngine::presentValue() const {
+  double value{0.0};
+  for (const ExposureTrade& trade : trades) {
+    value += trade.quantity *
+             BlackScholes::price(trade.type, market.spot, trade.strike,
+                                 trade.maturity, market.riskFreeRate,
+                                 market.volatility, market.dividendYield);
+  }
+  return value;
+}
+
+const ExposureProfile& ExposureEngine::calculateProfile() {
+  if (profileCalculated) {
+    return profile;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const std::size_t dateCount{dates.size()};
+  const double r{market.riskFreeRate};
+  const double q{market.dividendYield};
+  const double sigma{market.volatility};
+  const double logS0{std::log(market.spot)};
+
+  // exact lognormal step from the previous date
+  std::vector<double> drift(dateCount), diffusion(dateCount);
+  for (std::size_t d{0}; d < dateCount; ++d) {
+    const double dt{dates[d] - (d == 0 ? 0.0 : dates[d - 1])};
+    drift[d] = (r - q - 0.5 * sigma * sigma) * dt;
+    diffusion[d] = sigma * std::sqrt(dt);
+  }
+
+  const std::size_t blockCount{layout.count()};
+  const unsigned workers{config.threads == 0 ? parallel::defaultThreadCount()
+                                             : config.threads};
+  const std::size_t wave{
+      std::min<std::size_t>(blockCount, BLOCKS_PER_THREAD * workers)};
+  std::vector<BlockAggregates> slots(
+      wave, BlockAggregates{dateCount, config.sketchBits});
+
+  const auto simulateBlock = [&](std::size_t b, BlockAggregates& out) {
+    const std::size_t size{layout.size(b)};
+    random_streams::Engine engine{layout.seed(config.seed, b)};
+    std::vector<double> logS(size, logS0), spot(size), z(size);
+    std::vector<double> value(size), prices(size);
+    // constant columns for the batch kernel, refilled per trade and date
+    std::vector<OptionType> typeColumn(size);
+    std::vector<double> strikeColumn(size), tauColumn(size);
+    const std::vector<double> rColumn(size, r), sigmaColumn(size, sigma),
+        qColumn(size, q);
+    const OptionColumns columns{typeColumn, spot,        strikeColumn,
+                                tauColumn,  rColumn,     sigmaColumn,
+                                qColumn};
+
+    for (std::size_t d{0}; d < dateCount; ++d) {
+      for (std::size_t i{0}; i < size; ++i) z[i] = toUniform(engine());
+      for (std::size_t i{0}; i < size; ++i) z[i] = math::norm_inv(z[i]);
+      for (std::size_t i{0}; i < size; ++i) {
+        logS[i] += drift[d] + diffusion[d] * z[i];
+        spot[i] = std::exp(logS[i]);
+      }
+
+      std::ranges::fill(value, 0.0);
+      for (const ExposureTrade& trade : trades) {
+        if (trade.maturity < dates[d]) continue;  // expired
+        std::ranges::fill(typeColumn, trade.type);
+        std::ranges::fill(strikeColumn, trade.strike);
+        std::ranges::fill(tauColumn, trade.maturity - dates[d]);
+        BlackScholes::priceBatch(columns, prices);
+        for (std::size_t i{0}; i < size; ++i) {
+          value[i] += trade.quantity * prices[i];
+        }
+      }
+
+      double sum{0.0};
+      double positive{0.0};
+      double negative{0.0};
+      QuantileSketch& sketch{out.exposure[d]};
+      for (std::size_t i{0}; i < size; ++i) {
+        const double v{value[i]};
+        sum += v;
+        positive += std::max(v, 0.0);
+        negative += std::min(v, 0.0);
+        sketch.add(std::max(v, 0.0));
+      }
+      out.value[d] = sum;
+      out.positive[d] = positive;
+      out.negative[d] = negative;
+    }
+  };
+
+  std::vector<double> valueSums(dateCount), positiveSums(dateCount),
+      negativeSums(dateCount);
+  std::vector<QuantileSketch> exposure(dateCount,
+                                       QuantileSketch{config.sketchBits});
+  for (std::size_t first{0}; first < blockCount; first += wave) {
+    const std::size_t count{std::min(wave, blockCount - first)};
+    parallel::forEachIndex(
+        count, [&](std::size_t i) { simulateBlock(first + i, slots[i]); },
+        config.threads);
+    // fold the wave in block order; sketch merges are exact
+    for (std::size_t i{0}; i < count; ++i) {
+      BlockAggregates& block{slots[i]};
+      for (std::size_t d{0}; d < dateCount; ++d) {
+        valueSums[d] += block.value[d];
+        positiveSums[d] += block.positive[d];
+        negativeSums[d] += block.negative[d];
+        exposure[d].merge(block.exposure[d]);
+        block.exposure[d].clear();
+      }
+    }
+  }
+
+  const double n{static_cast<double>(config.paths)};
+  ExposureProfile result{};
+  result.dates = dates;
+  result.expectedValue.resize(dateCount);
+  result.expectedExposure.resize(dateCount);
+  result.expectedNegativeExposure.resize(dateCount);
+  result.potentialFutureExposure.resize(dateCount);
+  for (std::size_t d{0}; d < dateCount; ++d) {
+    result.expectedValue[d] = valueSums[d] / n;
+    result.expectedExposure[d] = positiveSums[d] / n;
+    result.expectedNegativeExposure[d] = negativeSums[d] / n;
+    result.potentialFutureExposure[d] =
+        exposure[d].quantile(config.pfeQuantile);
+  }
+  profile = std::move(result);
+  profileCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return profile;
+}
+
+double ExposureEngine::calculateCva(double hazardRate, double recoveryRate) {
+  if (hazardRate < 0.0) {
+    throw std::invalid_argument("Hazard rate must be non-negative");
+  }
+  if (recoveryRate < 0.0 || recoveryRate > 1.0) {
+    throw std::invalid_argument("Recovery rate must be between 0 and 1");
+  }
+  const ExposureProfile& p{calculateProfile()};
+  double cva{0.0};
+  double survival{1.0};
+  for (std::size_t d{0}; d < p.dates.size(); ++d) {
+    const double t{p.dates[d]};
+    const double next{std::exp(-hazardRate * t)};
+    cva += std::exp(-market.riskFreeRate * t) * p.expectedExposure[d] *
+           (survival - next);
+    survival = next;
+  }
+  return (1.0 - recoveryRate) * cva;
+}
@@ -0,0 +1,332 @@
+#include "FiniteDifference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief Solves a tridiagonal system a·v[i-1] + b·v[i] + c·v[i+1] = d,
+ * optionally projecting onto v >= obstacle (Brennan-Schwartz).
+ *
+ * The projection is exact when the exercise region is a single interval at
+ * one end of the grid, which holds for vanilla puts (low end) and calls
+ * (high end): elimination then runs away from that end and the projected
+ * back-substitution towards it.
+ *
+ * @param obstacle the exercise values, or nullptr for no constraint.
+ * @param exerciseLow true if the exercise region is at the low end.
+ */
+void solveTridiagonal(const std::vector<double>& a,
+                      const std::vector<double>& b,
+                      const std::vector<double>& c,
+                      const std::vector<double>& d,
+                      std::vector<double>& v, std::vector<double>& work,
+                      const std::vector<double>* obstacle, bool exerciseLow) {
+  const std::size_t n{b.size()};
+  std::vector<double>& dd{work};  // modified right-hand side
+  if (!exerciseLow) {
+    // forward elimination of the sub-diagonal, back-substitution downwards
+    v[0] = b[0];  // v holds the modified diagonal until substitution
+    dd[0] = d[0];
+    for (std::size_t i{1}; i < n; ++i) {
+      const double m{a[i] / v[i - 1]};
+      v[i] = b[i] - m * c[i - 1];
+      dd[i] = d[i] - m * dd[i - 1];
+    }
+    double next{dd[n - 1] / v[n - 1]};
+    if (obstacle) next = std::max(next, (*obstacle)[n - 1]);
+    v[n - 1] = next;
+    for (std::size_t i{n - 1}; i-- > 0;) {
+      double x{(dd[i] - c[i] * v[i + 1]) / v[i]};
+      if (obstacle) x = std::max(x, (*obstacle)[i]);
+      v[i] = x;
+    }
+  } else {
+    // backward elimination of the super-diagonal, substitution upwards
+    v[n - 1] = b[n - 1];
+    dd[n - 1] = d[n - 1];
+    for (std::size_t i{n - 1}; i-- > 0;) {
+      const double m{c[i] / v[i + 1]};
+      v[i] = b[i] - m * a[i + 1];
+      dd[i] = d[i] - m * dd[i + 1];
+    }
+    double prev{dd[0] / v[0]};
+    if (obstacle) prev = std::max(prev, (*obstacle)[0]);
+    v[0] = prev;
+    for (std::size_t i{1}; i < n; ++i) {
+      double x{(dd[i] - a[i] * v[i - 1]) / v[i]};
+      if (obstacle) x = std::max(x, (*obstacle)[i]);
+      v[i] = x;
+    }
+  }
+}
+
+/**
+ * @brief Projected SOR for the same system, starting from v.
+ */
+void solvePsor(const std::vector<double>& a, const std::vector<double>& b,
+               const std::vector<double>& c, const std::vector<double>& d,
+               std::vector<double>& v, const std::vector<double>& obstacle,
+               double omega, double tolerance, std::size_t maxIterations) {
+  const std::size_t n{b.size()};
+  for (std::size_t it{0}; it < maxIterations; ++it) {
+    double change{0.0};
+    for (std::size_t i{0}; i < n; ++i) {
+      double sum{d[i]};
+      if (i > 0) sum -= a[i] * v[i - 1];
+      if (i + 1 < n) sum -= c[i] * v[i + 1];
+      const double gaussSeidel{sum / b[i]};
+      const double next{
+          std::max(obstacle[i], v[i] + omega * (gaussSeidel - v[i]))};
+      change += (next - v[i]) * (next - v[i]);
+      v[i] = next;
+    }
+    if (change < tolerance * tolerance) return;
+  }
+  throw std::runtime_error("PSOR did not converge");
+}
+}  // namespace
+
+FiniteDifference::FiniteDifference(const Option& option, Config config)
+    : Pricer(option), config{config} {
+  if (config.spaceSteps < 3 || config.timeSteps == 0) {
+    throw std::invalid_argument("Need at least 3 space steps and 1 time step");
+  }
+  if (!(config.clustering > 0.0) || !(config.stdDevs > 0.0)) {
+    throw std::invalid_argument("Clustering and grid width must be positive");
+  }
+  if (!(config.psorOmega > 0.0 && config.psorOmega < 2.0)) {
+    throw std::invalid_argument("PSOR omega must be in (0, 2)");
+  }
+}
+
+double FiniteDifference::gridLimit(double xMax, double T, double sigma) const {
+  const double width{config.stdDevs * std::max(sigma, 0.01) *
+                     std::sqrt(std::max(T, 1e-4))};
+  return std::max(xMax, 1.0) * std::exp(width);
+}
+
+void FiniteDifference::solve(OptionType type, double T, double r, double q,
+                             double sigma, double xMax) const {
+  const std::size_t n{config.spaceSteps + 1};
+  const bool american{config.exercise == ExerciseStyle::AMERICAN};
+  const bool isCall{type == OptionType::CALL};
+  for (auto* v : {&grid, &values, &previous, &exercise, &lower, &diag, &upper,
+                  &a, &b, &c, &rhs, &scratch}) {
+    v->resize(n);
+  }
+
+  // sinh grid on [0, xMax] clustered at the strike (x = 1)
+  const double cl{config.clustering};
+  const double lo{std::asinh(-1.0 / cl)};
+  const double hi{std::asinh((xMax - 1.0) / cl)};
+  for (std::size_t i{0}; i < n; ++i) {
+    const double u{static_cast<double>(i) / config.spaceSteps};
+    grid[i] = 1.0 + cl * std::sinh(lo + (hi - lo) * u);
+  }
+  grid[0] = 0.0;
+  grid[n - 1] = xMax;
+
+  for (std::size_t i{0}; i < n; ++i) {
+    exercise[i] = std::max(isCall ? grid[i] - 1.0 : 1.0 - grid[i], 0.0);
+    values[i] = exercise[i];
+  }
+
+  // spatial operator L = ½σ²x²∂xx + (r-q)x∂x - r, second order on the
+  // non-uniform grid; the end rows are Dirichlet and handled separately
+  const double halfVar{0.5 * sigma * sigma};
+  for (std::size_t i{1}; i + 1 < n; ++i) {
+    const double hm{grid[i] - grid[i - 1]};
+    const double hp{grid[i + 1] - grid[i]};
+    const double x{grid[i]};
+    const double diffusion{halfVar * x * x};
+    const double drift{(r - q) * x};
+    lower[i] =
+        diffusion * 2.0 / (hm * (hm + hp)) - drift * hp / (hm * (hm + hp));
+    upper[i] =
+        diffusion * 2.0 / (hp * (hm + hp)) + drift * hm / (hp * (hm + hp));
+    diag[i] = -diffusion * 2.0 / (hm * hp) + drift * (hp - hm) / (hm * hp) - r;
+  }
+
+  auto boundaries = [&](double tau, double& low, double& high) {
+    if (isCall) {
+      low = 0.0;
+      high = xMax * std::exp(-q * tau) - std::exp(-r * tau);
+      if (american) high = std::max(high, xMax - 1.0);
+    } else {
+      low = american ? 1.0 : std::exp(-r * tau);
+      high = 0.0;
+    }
+  };
+
+  // one θ-step of size dt from time-to-maturity tau to tau + dt
+  auto step = [&](double tau, double dt, double theta) {
+    for (std::size_t i{1}; i + 1 < n; ++i) {
+      a[i] = -theta * dt * lower[i];
+      b[i] = 1.0 - theta * dt * diag[i];
+      c[i] = -theta * dt * upper[i];
+      const double explicitPart{(1.0 - theta) * dt};
+      rhs[i] = values[i] + explicitPart * (lower[i] * values[i - 1] +
+                                           diag[i] * values[i] +
+                                           upper[i] * values[i + 1]);
+    }
+    double low{}, high{};
+    boundaries(tau + dt, low, high);
+    a[0] = 0.0, b[0] = 1.0, c[0] = 0.0, rhs[0] = low;
+    a[n - 1] = 0.0, b[n - 1] = 1.0, c[n - 1] = 0.0, rhs[n - 1] = high;
+
+    previous.swap(values);
+    if (american && config.americanSolver == AmericanSolver::PSOR) {
+      values = previous;  // warm start
+      solvePsor(a, b, c, rhs, values, exercise, config.psorOmega,
+                config.psorTolerance, config.psorMaxIterations);
+    } else {
+      solveTridiagonal(a, b, c, rhs, values, scratch,
+                       american ? &exercise : nullptr, !isCall);
+    }
+  };
+
+  const double dt{T / config.timeSteps};
+  const std::size_t smoothing{
+      std::min(config.rannacherSteps, config.timeSteps)};
+  double tau{0.0};
+  for (std::size_t k{0}; k < config.timeSteps; ++k) {
+    if (k < smoothing) {
+      step(tau, 0.5 * dt, 1.0);
+      step(tau + 0.5 * dt, 0.5 * dt, 1.0);
+    } else {
+      step(tau, dt, 0.5);
+    }
+    tau += dt;
+  }
+}
+
+void FiniteDifference::interpolate(double x, double& v, double& dv,
+                                   double& d2v) const {
+  const std::size_t n{grid.size()};
+  auto it{std::lower_bound(grid.begin(), grid.end(), x)};
+  std::size_t j{static_cast<std::size_t>(it - grid.begin())};
+  if (j > 0 && (j == n || x - grid[j - 1] < grid[j] - x)) --j;  // nearest
+  j = std::clamp<std::size_t>(j, 1, n - 2);
+
+  const double x0{grid[j - 1]}, x1{grid[j]}, x2{grid[j + 1]};
+  const double y0{values[j - 1]}, y1{values[j]}, y2{values[j + 1]};
+  const double d0{(x0 - x1) * (x0 - x2)};
+  const double d1{(x1 - x0) * (x1 - x2)};
+  const double d2{(x2 - x0) * (x2 - x1)};
+  v = y0 * (x - x1) * (x - x2) / d0 + y1 * (x - x0) * (x - x2) / d1 +
+      y2 * (x - x0) * (x - x1) / d2;
+  dv = y0 * (2.0 * x - x1 - x2) / d0 + y1 * (2.0 * x - x0 - x2) / d1 +
+       y2 * (2.0 * x - x0 - x1) / d2;
+  d2v = 2.0 * (y0 / d0 + y1 / d1 + y2 / d2);
+}
+
+double FiniteDifference::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const double K{option.getStrikePrice()};
+  const double x{option.getStockPrice() / K};
+  const double T{option.getTimeToMaturity()};
+  if (T <= 0.0) {
+    cachedPrice = option.calculatePayoff(option.getStockPrice());
+  } else {
+    solve(option.getType(), T, option.getRiskFreeRate(),
+          option.getDividendYield(), option.getVolatility(),
+          gridLimit(x, T, option.getVolatility()));
+    double v{}, dv{}, d2v{};
+    interpolate(x, v, dv, d2v);
+    cachedPrice = K * v;
+  }
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+void FiniteDifference::priceStrikes(std::span<const double> strikes,
+                                    std::span<double> out) const {
+  if (strikes.size() != out.size()) {
+    throw std::invalid_argument("Output size must match the strike count");
+  }
+  if (strikes.empty()) return;
+  const double S{option.getStockPrice()};
+  const double T{option.getTimeToMaturity()};
+  double xMax{0.0};
+  for (double K : strikes) {
+    if (!(K > 0.0)) {
+      throw std::invalid_argument("Strikes must be positive");
+    }
+    xMax = std::max(xMax, S / K);
+  }
+  if (T <= 0.0) {
+    for (std::size_t j{0}; j < strikes.size(); ++j) {
+      const double intrinsic{option.getType() == OptionType::CALL
+                                 ? S - strikes[j]
+                                 : strikes[j] - S};
+      out[j] = std::max(intrinsic, 0.0);
+    }
+    return;
+  }
+
+  solve(option.getType(), T, option.getRiskFreeRate(),
+        option.getDividendYield(), option.getVolatility(),
+        gridLimit(xMax, T, option.getVolatility()));
+  for (std::size_t j{0}; j < strikes.size(); ++j) {
+    double v{}, dv{}, d2v{};
+    interpolate(S / strikes[j], v, dv, d2v);
+    out[j] = strikes[j] * v;
+  }
+}
+
+Greeks FiniteDifference::calculateGreeks() {
+  const double S{option.getStockPrice()};
+  const double K{option.getStrikePrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  const double q{option.getDividendYield()};
+  const double sigma{option.getVolatility()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+  const double x{S / K};
+  const double xMax{gridLimit(x, T, sigma)};
+
+  // delta, gamma and theta from one solve: the grid and the layer one step
+  // before maturity
+  solve(option.getType(), T, r, q, sigma, xMax);
+  double v{}, dv{}, d2v{};
+  interpolate(x, v, dv, d2v);
+  previous.swap(values);
+  double vPrev{}, unused1{}, unused2{};
+  interpolate(x, vPrev, unused1, unused2);
+  previous.swap(values);
+  const double lastStep{
+      config.timeSteps <= config.rannacherSteps
+          ? 0.5 * T / config.timeSteps  // last step was an implicit half-step
+          : T / config.timeSteps};
+  const double delta{dv};
+  const double gamma{d2v / K};
+  const double theta{-K * (v - vPrev) / lastStep};
+
+  // vega and rho by central bumps on the same grid
+  auto priceAt = [&](double rr, double sg) {
+    solve(option.getType(), T, rr, q, sg, xMax);
+    double pv{}, pd{}, pd2{};
+    interpolate(x, pv, pd, pd2);
+    return K * pv;
+  };
+  const double epsSig{std::max(sigma * 1e-3, 1e-4)};
+  const double epsR{std::max(std::abs(r) * 1e-3, 1e-5)};
+  // the down bump is clamped for small σ: divide by the actual spread
+  const double sigmaDn{std::max(sigma - epsSig, 1e-8)};
+  const double vega{(priceAt(r, sigma + epsSig) - priceAt(r, sigmaDn)) /
+                    (sigma + epsSig - sigmaDn)};
+  const double rho{(priceAt(r + epsR, sigma) - priceAt(r - epsR, sigma)) /
+                   (2.0 * epsR)};
+
+  cachedPrice = K * v;
+  priceCalculated = true;
+  return Greeks{delta, gamma, theta, vega, rho};
+}
@@ -0,0 +1,273 @@
+#include "FourierPricer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+FourierPricer::FourierPricer(
+    const Option& option, std::shared_ptr<const CharacteristicFunction> model,
+    Config config)
+    : Pricer(option), model{std::move(model)}, config{config} {
+  if (!this->model) {
+    throw std::invalid_argument("Fourier pricer needs a model");
+  }
+  if (config.cosTerms < 2) {
+    throw std::invalid_argument("COS needs at least 2 terms");
+  }
+  if (config.fftSize < 16 || (config.fftSize & (config.fftSize - 1)) != 0) {
+    throw std::invalid_argument("FFT size must be a power of two >= 16");
+  }
+  if (!(config.fftSpacing > 0.0) || !(config.damping > 0.0) ||
+      !(config.truncation > 0.0)) {
+    throw std::invalid_argument(
+        "FFT spacing, damping and truncation must be positive");
+  }
+}
+
+std::string FourierPricer::getPricingMethod() const {
+  return (config.method == FourierMethod::COS ? "COS " : "Carr-Madan ") +
+         model->name();
+}
+
+void FourierPricer::priceChain(std::span<const double> strikes,
+                               std::span<double> out) const {
+  if (strikes.size() != out.size()) {
+    throw std::invalid_argument("Output size must match the strike count");
+  }
+  for (double K : strikes) {
+    if (!(K > 0.0)) {
+      throw std::invalid_argument("Strikes must be positive");
+    }
+  }
+  price(*model, option.getStockPrice(), option.getTimeToMaturity(),
+        option.getRiskFreeRate(), strikes, out);
+}
+
+void FourierPricer::price(const CharacteristicFunction& cf, double S, double T,
+                          double r, std::span<const double> strikes,
+                          std::span<double> out) const {
+  if (strikes.empty()) return;
+  const double q{option.getDividendYield()};
+  if (T <= 0.0) {
+    const bool isCall{option.getType() == OptionType::CALL};
+    for (std::size_t j{0}; j < strikes.size(); ++j) {
+      out[j] = std::max(isCall ? S - strikes[j] : strikes[j] - S, 0.0);
+    }
+    return;
+  }
+  if (config.method == FourierMethod::COS) {
+    priceCos(cf, S, T, r, q, strikes, out);
+  } else {
+    priceCarrMadan(cf, S, T, r, q, strikes, out);
+  }
+}
+
+void FourierPricer::priceCos(const CharacteristicFunction& cf, double S,
+                             double T, double r, double q,
+                             std::span<const double> strikes,
+                             std::span<double> out) const {
+  const std::size_t N{config.cosTerms};
+
+  // truncation range for y = ln(S_T / K) over every strike
+  double xMin{std::log(S / strikes[0])};
+  double xMax{xMin};
+  for (double K : strikes) {
+    const double x{std::log(S / K)};
+    xMin = std::min(xMin, x);
+    xMax = std::max(xMax, x);
+  }
+  const Cumulants c{cf.cumulants(T)};
+  const double drift{(r - q) * T};
+  const double width{config.truncation *
+                     std::sqrt(c.c2 + std::sqrt(std::max(c.c4, 0.0)))};
+  const double a{std::min(xMin + drift + c.c1 - width, -1e-3)};
+  const double b{std::max(xMax + drift + c.c1 + width, 1e-3)};
+  const double scale{std::numbers::pi / (b - a)};
+
+  // payoff coefficients of a unit-strike put on [a, 0]; cached per range
+  if (cosPayoff.size() != N || a != cachedLow || b != cachedHigh) {
+    cosPayoff.resize(N);
+    for (std::size_t k{0}; k < N; ++k) {
+      const double u{k * scale};
+      const double cosA{1.0};  // cos(u·(a - a))
+      const double cos0{std::cos(-u * a)};
+      const double sin0{std::sin(-u * a)};
+      const double chi{(cos0 - cosA * std::exp(a) + u * sin0) / (1.0 + u * u)};
+      const double psi{k == 0 ? -a : sin0 / u};
+      cosPayoff[k] = 2.0 / (b - a) * (psi - chi);
+    }
+    cachedLow = a;
+    cachedHigh = b;
+  }
+
+  // characteristic function terms, shared by every strike
+  cosPhi.resize(N);
+  for (std::size_t k{0}; k < N; ++k) {
+    const double u{k * scale};
+    const std::complex<double> shift{std::cos(u * (drift - a)),
+                                     std::sin(u * (drift - a))};
+    cosPhi[k] = cf({u, 0.0}, T) * shift * cosPayoff[k];
+  }
+  cosPhi[0] *= 0.5;
+
+  const double dfR{std::exp(-r * T)};
+  const double dfQ{std::exp(-q * T)};
+  const bool isCall{option.getType() == OptionType::CALL};
+  for (std::size_t j{0}; j < strikes.size(); ++j) {
+    const double K{strikes[j]};
+    const double x{std::log(S / K)};
+    // Σ Re(φ_k·e^{i·u_k·x}), with e^{i·u_k·x} by rotation
+    const std::complex<double> step{std::cos(scale * x), std::sin(scale * x)};
+    std::complex<double> rotation{1.0, 0.0};
+    double sum{0.0};
+    for (std::size_t k{0}; k < N; ++k) {
+      sum += cosPhi[k].real() * rotation.real() -
+             cosPhi[k].imag() * rotation.imag();
+      rotation *= step;
+    }
+    const double put{std::max(dfR * K * sum, 0.0)};
+    out[j] = isCall ? std::max(put + S * dfQ - K * dfR, 0.0) : put;
+  }
+}
+
+void FourierPricer::fft() const {
+  const std::size_t n{fftData.size()};
+  if (twiddles.size() != n / 2) {
+    twiddles.resize(n / 2);
+    for (std::size_t k{0}; k < n / 2; ++k) {
+      const double angle{-2.0 * std::numbers::pi * k / n};
+      twiddles[k] = {std::cos(angle), std::sin(angle)};
+    }
+  }
+  for (std::size_t i{1}, j{0}; i < n; ++i) {  // bit-reversal permutation
+    std::size_t bit{n >> 1};
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) std::swap(fftData[i], fftData[j]);
+  }
+  for (std::size_t len{2}; len <= n; len <<= 1) {
+    const std::size_t stride{n / len};
+    for (std::size_t start{0}; start < n; start += len) {
+      for (std::size_t k{0}; k < len / 2; ++k) {
+        const std::complex<double> t{twiddles[k * stride] *
+                                     fftData[start + k + len / 2]};
+        fftData[start + k + len / 2] = fftData[start + k] - t;
+        fftData[start + k] += t;
+      }
+    }
+  }
+}
+
+void FourierPricer::priceCarrMadan(const CharacteristicFunction& cf, double S,
+                                   double T, double r, double q,
+                                   std::span<const double> strikes,
+                                   std::span<double> out) const {
+  const std::size_t N{config.fftSize};
+  const double eta{config.fftSpacing};
+  const double alpha{config.damping};
+  const double lambda{2.0 * std::numbers::pi / (N * eta)};
+  const double logS{std::log(S)};
+  const double k0{logS - 0.5 * N * lambda};  // grid centred on the spot
+  const double dfR{std::exp(-r * T)};
+  const double dfQ{std::exp(-q * T)};
+  const std::complex<double> i{0.0, 1.0};
+
+  if (simpson.size() != N) {
+    simpson.resize(N);
+    for (std::size_t j{0}; j < N; ++j) {
+      simpson[j] = (j == 0 ? 1.0 : (j % 2 == 1 ? 4.0 : 2.0)) / 3.0;
+    }
+  }
+  fftData.resize(N);
+  const double mean{logS + (r - q) * T};
+  for (std::size_t j{0}; j < N; ++j) {
+    const double v{eta * j};
+    const std::complex<double> u{v, -(alpha + 1.0)};
+    const std::complex<double> phiLogS{std::exp(i * u * mean) * cf(u, T)};
+    const std::complex<double> denom{alpha * alpha + alpha - v * v,
+                                     (2.0 * alpha + 1.0) * v};
+    const std::complex<double> psi{dfR * phiLogS / denom};
+    const std::complex<double> shift{std::cos(v * k0), -std::sin(v * k0)};
+    fftData[j] = shift * psi * (eta * simpson[j]);
+  }
+  fft();
+
+  const bool isCall{option.getType() == OptionType::CALL};
+  auto callAt = [&](std::size_t u) {
+    const double k{k0 + lambda * u};
+    return std::exp(-alpha * k) / std::numbers::pi * fftData[u].real();
+  };
+  for (std::size_t j{0}; j < strikes.size(); ++j) {
+    const double K{strikes[j]};
+    // cubic Lagrange interpolation in log-strike
+    const double pos{(std::log(K) - k0) / lambda};
+    const std::size_t base{static_cast<std::size_t>(
+        std::clamp(std::floor(pos) - 1.0, 0.0, static_cast<double>(N - 4)))};
+    const double t{pos - static_cast<double>(base)};
+    double call{0.0};
+    for (std::size_t m{0}; m < 4; ++m) {
+      double weight{1.0};
+      for (std::size_t l{0}; l < 4; ++l) {
+        if (l != m) {
+          weight *= (t - static_cast<double>(l)) /
+                    (static_cast<double>(m) - static_cast<double>(l));
+        }
+      }
+      call += weight * callAt(base + m);
+    }
+    call = std::max(call, 0.0);
+    out[j] = isCall ? call : std::max(call - S * dfQ + K * dfR, 0.0);
+  }
+}
+
+double FourierPricer::priceOne(const CharacteristicFunction& cf, double S,
+                               double T, double r) const {
+  const double K{option.getStrikePrice()};
+  double value{0.0};
+  price(cf, S, T, r, std::span<const double>{&K, 1},
+        std::span<double>{&value, 1});
+  return value;
+}
+
+double FourierPricer::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  cachedPrice = priceOne(*model, option.getStockPrice(),
+                         option.getTimeToMaturity(), option.getRiskFreeRate());
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks FourierPricer::calculateGreeks() {
+  const double V{calculatePrice()};
+  const double S{option.getStockPrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+  const double epsS{std::max(S * 1e-3, 1e-6)};
+  const double up{priceOne(*model, S + epsS, T, r)};
+  const double dn{priceOne(*model, S - epsS, T, r)};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * V + dn) / (epsS * epsS)};
+
+  const double epsVol{1e-4};
+  const double vega{(priceOne(*model->withVolatilityBump(epsVol), S, T, r) -
+                     priceOne(*model->withVolatilityBump(-epsVol), S, T, r)) /
+                    (2.0 * epsVol)};
+  const double epsR{std::max(std::abs(r) * 1e-3, 1e-5)};
+  const double rho{(priceOne(*model, S, T, r + epsR) -
+                    priceOne(*model, S, T, r - epsR)) /
+                   (2.0 * epsR)};
+  const double epsT{std::max(T * 1e-3, 1e-5)};
+  const double theta{(priceOne(*model, S, std::max(T - epsT, 1e-8), r) -
+                      priceOne(*model, S, T + epsT, r)) /
+                     (2.0 * epsT)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
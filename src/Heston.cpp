@@ -0,0 +1,154 @@
+#include "Heston.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "MathUtils.h"
+
+namespace {
+using math::GL_NODES;
+using math::GL_WEIGHTS;
+
+template <class F>
+double gaussLegendre(F&& f, double a, double b) {
+  const double mid{0.5 * (a + b)};
+  const double half{0.5 * (b - a)};
+  double sum{0.0};
+  for (std::size_t k{0}; k < GL_NODES.size(); ++k) {
+    const double dx{half * GL_NODES[k]};
+    sum += GL_WEIGHTS[k] * (f(mid - dx) + f(mid + dx));
+  }
+  return sum * half;
+}
+}  // namespace
+
+void HestonParams::validate() const {
+  if (v0 < 0.0 || theta < 0.0 || xi < 0.0) {
+    throw std::invalid_argument("Heston v0, theta and xi must be non-negative");
+  }
+  if (!(kappa > 0.0)) {
+    throw std::invalid_argument("Heston kappa must be positive");
+  }
+  if (std::abs(rho) > 1.0) {
+    throw std::invalid_argument("Heston rho must be in [-1, 1]");
+  }
+}
+
+namespace heston {
+std::complex<double> characteristicFunction(std::complex<double> u, double T,
+                                            const HestonParams& p) {
+  using C = std::complex<double>;
+  const C i{0.0, 1.0};
+  const double xi{std::max(p.xi, 1e-10)};  // ξ → 0 is a removable limit
+  const double xi2{xi * xi};
+  const C beta{p.kappa - p.rho * xi * i * u};
+  const C d{std::sqrt(beta * beta + xi2 * (i * u + u * u))};
+  const C g{(beta - d) / (beta + d)};
+  const C e{std::exp(-d * T)};
+  const C C_{p.kappa * p.theta / xi2 *
+             ((beta - d) * T - 2.0 * std::log((1.0 - g * e) / (1.0 - g)))};
+  const C D{(beta - d) / xi2 * (1.0 - e) / (1.0 - g * e)};
+  return std::exp(C_ + D * p.v0);
+}
+
+double price(OptionType type, double S, double K, double T, double r, double q,
+             const HestonParams& params) {
+  const double dfR{std::exp(-r * T)};
+  const double dfQ{std::exp(-q * T)};
+  if (T <= 0.0) {
+    return std::max(type == OptionType::CALL ? S - K : K - S, 0.0);
+  }
+  const double k{std::log(S / K) + (r - q) * T};
+  auto integrand = [&](double u) {
+    const std::complex<double> phi{
+        characteristicFunction({u, -0.5}, T, params)};
+    const std::complex<double> rotation{std::cos(u * k), std::sin(u * k)};
+    return (rotation * phi).real() / (u * u + 0.25);
+  };
+
+  // panels start narrow around the 1 / (u² + ¼) peak and widen towards
+  // ~1 / (vol·√T) until the tail stops contributing
+  const double avgVar{std::max(params.theta, params.v0)};
+  const double maxWidth{
+      std::clamp(2.0 / std::sqrt(avgVar * T + 1e-12), 1.0, 50.0)};
+  double integral{0.0};
+  double lower{0.0};
+  double width{0.25};
+  for (int panel{0}; panel < 4000; ++panel) {
+    const double piece{gaussLegendre(integrand, lower, lower + width)};
+    integral += piece;
+    lower += width;
+    width = std::min(2.0 * width, maxWidth);
+    if (panel > 8 &&
+        std::abs(piece) < 1e-15 * std::max(std::abs(integral), 1.0)) {
+      break;
+    }
+  }
+
+  const double call{S * dfQ - std::sqrt(S * K) * std::exp(-0.5 * (r + q) * T) *
+                                  integral / std::numbers::pi};
+  const double value{type == OptionType::CALL ? call : call - S * dfQ + K * dfR};
+  return std::max(value, 0.0);
+}
+}  // namespace heston
+
+HestonAnalytic::HestonAnalytic(const Option& option, const HestonParams& params)
+    : Pricer(option), params{params} {
+  params.validate();
+}
+
+double HestonAnalytic::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  cachedPrice = heston::price(option.getType(), option.getStockPrice(),
+                              option.getStrikePrice(),
+                              option.getTimeToMaturity(),
+                              option.getRiskFreeRate(),
+                              option.getDividendYield(), params);
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks HestonAnalytic::calculateGreeks() {
+  const double V{calculatePrice()};
+  const OptionType type{option.getType()};
+  const double S{option.getStockPrice()};
+  const double K{option.getStrikePrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  const double q{option.getDividendYield()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+
+  const double epsS{std::max(S * 1e-4, 1e-6)};
+  const double up{heston::price(type, S + epsS, K, T, r, q, params)};
+  const double dn{heston::price(type, S - epsS, K, T, r, q, params)};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * V + dn) / (epsS * epsS)};
+
+  const double vol0{std::sqrt(params.v0)};
+  const double epsVol{std::max(vol0 * 1e-3, 1e-5)};
+  HestonParams volUp{params}, volDn{params};
+  volUp.v0 = (vol0 + epsVol) * (vol0 + epsVol);
+  volDn.v0 = std::max(vol0 - epsVol, 0.0) * std::max(vol0 - epsVol, 0.0);
+  const double vega{(heston::price(type, S, K, T, r, q, volUp) -
+                     heston::price(type, S, K, T, r, q, volDn)) /
+                    (vol0 + epsVol - std::max(vol0 - epsVol, 0.0))};
+
+  const double epsR{std::max(std::abs(r) * 1e-3, 1e-5)};
+  const double rho{(heston::price(type, S, K, T, r + epsR, q, params) -
+                    heston::price(type, S, K, T, r - epsR, q, params)) /
+                   (2.0 * epsR)};
+  const double epsT{std::max(T * 1e-3, 1e-5)};
+  const double theta{(heston::price(type, S, K, std::max(T - epsT, 1e-8), r, q,
+                                    params) -
+                      heston::price(type, S, K, T + epsT, r, q, params)) /
+                     (2.0 * epsT)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
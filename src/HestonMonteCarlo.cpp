@@ -0,0 +1,201 @@
+#include "HestonMonteCarlo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "MathUtils.h"
+#include "Parallel.h"
+#include "RandomStreams.h"
+
+namespace {
+// each path step takes exactly two engine draws (variance, log-spot)
+constexpr std::uint64_t DRAWS_PER_STEP{2};
+
+using random_streams::toUniform;
+
+/**
+ * @brief Step constants shared by every path.
+ */
+struct QeStep {
+  double expKappa{}, c1{}, c2{};  // variance mean / variance coefficients
+  double k1{}, k2{}, k3{}, k4{};  // log-spot coefficients
+  double a{};                     // K2 + K4 / 2, for the martingale correction
+  double drift{};                 // (r - q)·Δ
+  double psiC{};
+};
+}  // namespace
+
+HestonMonteCarlo::HestonMonteCarlo(const Option& option,
+                                   const HestonParams& params, Config config)
+    : Pricer(option), params{params}, config{config} {
+  params.validate();
+  if (config.paths == 0 || config.steps == 0 || config.blockPaths == 0) {
+    throw std::invalid_argument("Paths, steps and block size must be positive");
+  }
+  if (config.psiCritical < 1.0 || config.psiCritical > 2.0) {
+    throw std::invalid_argument("QE switching threshold must be in [1, 2]");
+  }
+  layout = random_streams::BlockLayout{config.paths, config.blockPaths,
+                                       config.steps * DRAWS_PER_STEP};
+}
+
+HestonMonteCarlo::Estimate HestonMonteCarlo::run(double S, double T, double r,
+                                                 const HestonParams& p) const {
+  const double K{option.getStrikePrice()};
+  const double q{option.getDividendYield()};
+  const bool isCall{option.getType() == OptionType::CALL};
+  if (T <= 0.0) {
+    return {std::max(isCall ? S - K : K - S, 0.0), 0.0};
+  }
+
+  const double dt{T / config.steps};
+  const double xi{std::max(p.xi, 1e-10)};
+  QeStep step{};
+  step.expKappa = std::exp(-p.kappa * dt);
+  step.c1 = xi * xi * step.expKappa * (1.0 - step.expKappa) / p.kappa;
+  step.c2 = p.theta * xi * xi * (1.0 - step.expKappa) *
+            (1.0 - step.expKappa) / (2.0 * p.kappa);
+  // central discretization γ1 = γ2 = ½
+  step.k1 = 0.5 * dt * (p.kappa * p.rho / xi - 0.5) - p.rho / xi;
+  step.k2 = 0.5 * dt * (p.kappa * p.rho / xi - 0.5) + p.rho / xi;
+  step.k3 = 0.5 * dt * (1.0 - p.rho * p.rho);
+  step.k4 = step.k3;
+  step.a = step.k2 + 0.5 * step.k4;
+  step.drift = (r - q) * dt;
+  step.psiC = config.psiCritical;
+
+  std::vector<math::SampleMoments> blocks(layout.count());
+  const double logS0{std::log(S)};
+
+  parallel::forEachIndex(
+      layout.count(),
+      [&](std::size_t b) {
+        const std::size_t size{layout.size(b)};
+        random_streams::Engine engine{layout.seed(config.seed, b)};
+        std::vector<double> logS(size, logS0), v(size, p.v0);
+        std::vector<double> uV(size), zS(size);
+
+        for (unsigned n{0}; n < config.steps; ++n) {
+          // one draw per variate: the engine fills the step's uniforms,
+          // then the inverse CDF maps them to normals in a plain loop
+          for (std::size_t i{0}; i < size; ++i) uV[i] = toUniform(engine());
+          for (std::size_t i{0}; i < size; ++i) zS[i] = toUniform(engine());
+          for (std::size_t i{0}; i < size; ++i) zS[i] = math::norm_inv(zS[i]);
+
+          for (std::size_t i{0}; i < size; ++i) {
+            const double vi{v[i]};
+            const double m{p.theta + (vi - p.theta) * step.expKappa};
+            const double s2{vi * step.c1 + step.c2};
+            const double psi{s2 / (m * m)};
+            double vNext{};
+            double k0{};
+            if (psi <= step.psiC) {
+              // scaled non-central chi-square with one degree of freedom
+              const double inv{2.0 / psi};
+              const double b2{inv - 1.0 + std::sqrt(inv * (inv - 1.0))};
+              const double aa{m / (1.0 + b2)};
+              const double bb{std::sqrt(b2)};
+              const double zV{math::norm_inv(uV[i])};
+              vNext = aa * (bb + zV) * (bb + zV);
+              k0 = -step.a * b2 * aa / (1.0 - 2.0 * step.a * aa) +
+                   0.5 * std::log(1.0 - 2.0 * step.a * aa);
+            } else {
+              // exponential with a point mass at zero, by inversion
+              const double pm{(psi - 1.0) / (psi + 1.0)};
+              const double beta{(1.0 - pm) / m};
+              const double u{uV[i]};
+              vNext = u <= pm ? 0.0 : std::log((1.0 - pm) / (1.0 - u)) / beta;
+              k0 = -std::log(pm + beta * (1.0 - pm) / (beta - step.a));
+            }
+            k0 -= (step.k1 + 0.5 * step.k3) * vi;  // martingale correction
+            logS[i] += step.drift + k0 + step.k1 * vi + step.k2 * vNext +
+                       std::sqrt(step.k3 * vi + step.k4 * vNext) * zS[i];
+            v[i] = vNext;
+          }
+        }
+
+        math::ShiftedSums sums{};
+        for (std::size_t i{0}; i < size; ++i) {
+          const double ST{std::exp(logS[i])};
+          sums.add(std::max(isCall ? ST - K : K - ST, 0.0));
+        }
+        blocks[b] = sums.moments();
+      },
+      config.threads);
+
+  const math::SampleMoments payoff{math::merge_blocks(blocks)};
+  const double df{std::exp(-r * T)};
+  return {df * payoff.mean, df * payoff.standardError()};
+}
+
+double HestonMonteCarlo::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const Estimate estimate{run(option.getStockPrice(),
+                              option.getTimeToMaturity(),
+                              option.getRiskFreeRate(), params)};
+  cachedPrice = estimate.price;
+  standardError = estimate.standardError;
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks HestonMonteCarlo::calculateGreeks() {
+  const double V{calculatePrice()};
+  const double S{option.getStockPrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+
+  // common random numbers make the differences smooth; bumps are moderate
+  // so they stay well above the discretization noise
+  const double epsS{S * 0.01};
+  const double up{run(S + epsS, T, r, params).price};
+  const double dn{run(S - epsS, T, r, params).price};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * V + dn) / (epsS * epsS)};
+
+  const double vol0{std::sqrt(params.v0)};
+  const double epsVol{std::max(vol0 * 0.01, 1e-4)};
+  HestonParams volUp{params}, volDn{params};
+  volUp.v0 = (vol0 + epsVol) * (vol0 + epsVol);
+  volDn.v0 = std::max(vol0 - epsVol, 0.0) * std::max(vol0 - epsVol, 0.0);
+  const double vega{(run(S, T, r, volUp).price - run(S, T, r, volDn).price) /
+                    (vol0 + epsVol - std::max(vol0 - epsVol, 0.0))};
+
+  const double epsR{std::max(std::abs(r) * 0.01, 1e-4)};
+  const double rho{(run(S, T, r + epsR, params).price -
+                    run(S, T, r - epsR, params).price) /
+                   (2.0 * epsR)};
+  const double epsT{std::max(T * 0.01, 1e-4)};
+  const double theta{(run(S, std::max(T - epsT, 1e-8), r, params).price -
+                      run(S, T + epsT, r, params).price) /
+                     (2.0 * epsT)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
+
+double HestonMonteCarlo::getStandardError() {
+  validatePriceCalculated();
+  return standardError;
+}
+
+std::pair<double, double> HestonMonteCarlo::getConfidenceInterval(
+    double confidenceLevel) {
+  validatePriceCalculated();
+  return math::confidence_interval(cachedPrice, standardError,
+                                   confidenceLevel);
+}
+
+void HestonMonteCarlo::validatePriceCalculated() const {
+  if (!priceCalculated) {
+    throw std::runtime_error(
+        "Price must be calculated first. Call calculatePrice()");
+  }
+}
@@ -1,6 +1,7 @@
 #include "ImpliedVol.h"
 
 #include <cmath>
+#include <limits>
 #include <stdexcept>
 
 #include "BlackScholes.h"
@@ -8,13 +9,18 @@
 
 double impliedVolBS(const Option& opt, double targetPrice, double tol,
                     int maxIter) {
+  return impliedVolBS(opt.getType(), opt.getStockPrice(),
+                      opt.getStrikePrice(), opt.getTimeToMaturity(),
+                      opt.getRiskFreeRate(), opt.getDividendYield(),
+                      targetPrice, tol, maxIter);
+}
+
+double impliedVolBS(OptionType type, double S, double K, double T, double r,
+                    double q, double targetPrice, double tol, int maxIter) {
   if (targetPrice <= 0.0)
     throw std::invalid_argument("Target price must be > 0");
 
   // initial guess: use Brenner-Subrahmanyam ATM approx
-  double S = opt.getStockPrice(), K = opt.getStrikePrice();
-  double T = opt.getTimeToMaturity(), r = opt.getRiskFreeRate();
-  double q = opt.getDividendYield();
   double guess = std::sqrt(2.0 * std::fabs(std::log(S / K)) / T);
   if (guess <= 0.0 || std::isnan(guess)) guess = 0.2;
 
@@ -22,9 +28,7 @@ double impliedVolBS(const Option& opt, double targetPrice, double tol,
   double sigma = guess;
 
   for (int i = 0; i < maxIter; ++i) {
-    Option tmp(opt.getType(), S, K, T, r, sigma, q);
-    BlackScholes bs(tmp);
-    double price = bs.calculatePrice();
+    double price = BlackScholes::price(type, S, K, T, r, sigma, q);
     double diff = price - targetPrice;
 
     if (std::fabs(diff) < tol) return sigma;
@@ -50,4 +54,20 @@ double impliedVolBS(const Option& opt, double targetPrice, double tol,
     }
   }
   return sigma;  // best effort
-}
\ No newline at end of file
+}
+
+void impliedVolBatch(const OptionColumns& options,
+                     std::span<const double> targetPrices,
+                     std::span<double> out, double tol, int maxIter) {
+  const std::size_t n = options.size();
+  if (targetPrices.size() != n || out.size() != n) {
+    throw std::invalid_argument("Batch columns must all have the same size");
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = targetPrices[i] > 0.0
+                 ? impliedVolBS(options.type[i], options.S[i], options.K[i],
+                                options.T[i], options.r[i], options.q[i],
+                                targetPrices[i], tol, maxIter)
+                 : std::numeric_limits<double>::quiet_NaN();
+  }
+}
@@ -0,0 +1,235 @@
+#include "Lattice.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief Peizer-Pratt method 2 inversion of the normal CDF, as used by
+ * Leisen and Reimer for an n-step tree.
+ */
+double peizerPratt(double z, std::size_t n) {
+  const double nn{static_cast<double>(n)};
+  const double w{z / (nn + 1.0 / 3.0 + 0.1 / (nn + 1.0))};
+  const double root{
+      std::sqrt(0.25 - 0.25 * std::exp(-w * w * (nn + 1.0 / 6.0)))};
+  return z >= 0.0 ? 0.5 + root : 0.5 - root;
+}
+
+std::size_t roundedSteps(LatticeMethod method, std::size_t steps) {
+  return method == LatticeMethod::LEISEN_REIMER ? (steps | 1) : steps;
+}
+}  // namespace
+
+Lattice::Lattice(const Option& option, Config config)
+    : Pricer(option), config{config} {
+  if (config.steps < 4) {
+    throw std::invalid_argument("Lattice needs at least 4 steps");
+  }
+}
+
+std::size_t Lattice::getSteps() const {
+  return roundedSteps(config.method, config.steps);
+}
+
+Lattice::Layers Lattice::induce(const Option& priced, std::size_t n) const {
+  const double S0{priced.getStockPrice()};
+  const double K{priced.getStrikePrice()};
+  const double T{priced.getTimeToMaturity()};
+  const double r{priced.getRiskFreeRate()};
+  const double q{priced.getDividendYield()};
+  const double sigma{std::max(priced.getVolatility(), 1e-12)};
+  const bool isCall{priced.getType() == OptionType::CALL};
+  const bool american{config.exercise == ExerciseStyle::AMERICAN};
+  const double sign{isCall ? 1.0 : -1.0};
+
+  Layers layers{};
+  layers.dt = T / static_cast<double>(n);
+  const double dt{layers.dt};
+  const double disc{std::exp(-r * dt)};
+  const double growth{std::exp((r - q) * dt)};
+
+  if (config.method == LatticeMethod::TRINOMIAL) {
+    const double nu{r - q - 0.5 * sigma * sigma};
+    const double dx{sigma * std::sqrt(3.0 * dt)};
+    const double spread{(sigma * sigma * dt + nu * nu * dt * dt) / (dx * dx)};
+    const double pu{disc * 0.5 * (spread + nu * dt / dx)};
+    const double pd{disc * 0.5 * (spread - nu * dt / dx)};
+    const double pm{disc * (1.0 - spread)};
+
+    const std::size_t width{2 * n + 1};
+    values.resize(width);
+    spots.resize(width);
+    const double lowest{S0 * std::exp(-static_cast<double>(n) * dx)};
+    const double up{std::exp(dx)};
+    spots[0] = lowest;
+    for (std::size_t k{1}; k < width; ++k) spots[k] = spots[k - 1] * up;
+    for (std::size_t k{0}; k < width; ++k) {
+      values[k] = std::max(sign * (spots[k] - K), 0.0);
+    }
+
+    for (std::size_t i{n}; i-- > 0;) {
+      const std::size_t nodes{2 * i + 1};
+      double* v{values.data()};
+      for (std::size_t k{0}; k < nodes; ++k) {
+        v[k] = pd * v[k] + pm * v[k + 1] + pu * v[k + 2];
+      }
+      if (american) {
+        double* s{spots.data()};
+        for (std::size_t k{0}; k < nodes; ++k) {
+          s[k] = s[k + 1];  // node (i, k) sits at node (i + 1, k + 1)
+          v[k] = std::max(v[k], sign * (s[k] - K));
+        }
+      }
+      if (i == 1) {
+        for (std::size_t k{0}; k < 3; ++k) {
+          layers.v1[k] = v[k];
+          layers.s1[k] = S0 * std::exp((static_cast<double>(k) - 1.0) * dx);
+        }
+      }
+    }
+    layers.price = values[0];
+    return layers;
+  }
+
+  double u{}, d{}, p{};
+  if (config.method == LatticeMethod::CRR) {
+    u = std::exp(sigma * std::sqrt(dt));
+    d = 1.0 / u;
+    p = (growth - d) / (u - d);
+  } else {
+    const double vsT{sigma * std::sqrt(T)};
+    const double d1{(std::log(S0 / K) + (r - q + 0.5 * sigma * sigma) * T) /
+                    vsT};
+    const double d2{d1 - vsT};
+    p = peizerPratt(d2, n);
+    const double pBar{peizerPratt(d1, n)};
+    u = growth * pBar / p;
+    d = (growth - p * u) / (1.0 - p);
+  }
+  const double pu{disc * p};
+  const double pd{disc * (1.0 - p)};
+
+  values.resize(n + 1);
+  spots.resize(n + 1);
+  spots[0] = S0 * std::pow(d, static_cast<double>(n));
+  const double ratio{u / d};
+  for (std::size_t j{1}; j <= n; ++j) spots[j] = spots[j - 1] * ratio;
+  for (std::size_t j{0}; j <= n; ++j) {
+    values[j] = std::max(sign * (spots[j] - K), 0.0);
+  }
+
+  const double invD{1.0 / d};
+  for (std::size_t i{n}; i-- > 0;) {
+    double* v{values.data()};
+    for (std::size_t j{0}; j <= i; ++j) {
+      v[j] = pd * v[j] + pu * v[j + 1];
+    }
+    if (american) {
+      double* s{spots.data()};
+      for (std::size_t j{0}; j <= i; ++j) {
+        s[j] *= invD;  // node (i, j) is node (i + 1, j) without its down move
+        v[j] = std::max(v[j], sign * (s[j] - K));
+      }
+    }
+    if (i == 2) {
+      for (std::size_t j{0}; j < 3; ++j) {
+        layers.v2[j] = v[j];
+        layers.s2[j] = S0 * std::pow(u, static_cast<double>(j)) *
+                       std::pow(d, static_cast<double>(2 - j));
+      }
+    } else if (i == 1) {
+      layers.v1[0] = v[0], layers.s1[0] = S0 * d;
+      layers.v1[1] = v[1], layers.s1[1] = S0 * u;
+    }
+  }
+  layers.price = values[0];
+  return layers;
+}
+
+double Lattice::priceOf(const Option& priced, Layers* fineLayers) const {
+  const std::size_t n{getSteps()};
+  const Layers layers{induce(priced, n)};
+  if (fineLayers) *fineLayers = layers;
+  const double fine{layers.price};
+  if (!config.richardson) return fine;
+
+  std::size_t m{roundedSteps(config.method, n / 2)};
+  if (m == n) m -= 2;
+  const double coarse{induce(priced, m).price};
+  const double N{static_cast<double>(n)};
+  const double M{static_cast<double>(m)};
+  if (config.method == LatticeMethod::LEISEN_REIMER) {
+    return (N * N * fine - M * M * coarse) / (N * N - M * M);
+  }
+  return (N * fine - M * coarse) / (N - M);
+}
+
+double Lattice::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  cachedPrice = option.getTimeToMaturity() <= 0.0
+                    ? option.calculatePayoff(option.getStockPrice())
+                    : priceOf(option, &priceLayers);
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks Lattice::calculateGreeks() {
+  calculatePrice();
+  const double T{option.getTimeToMaturity()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+  // the fine tree behind the price already holds the first layers
+  const Layers& layers{priceLayers};
+  const double V0{layers.price};
+
+  double delta{}, gamma{}, theta{};
+  if (config.method == LatticeMethod::TRINOMIAL) {
+    const double* v{layers.v1};
+    const double* s{layers.s1};
+    const double dUp{(v[2] - v[1]) / (s[2] - s[1])};
+    const double dDn{(v[1] - v[0]) / (s[1] - s[0])};
+    delta = (v[2] - v[0]) / (s[2] - s[0]);
+    gamma = (dUp - dDn) / (0.5 * (s[2] - s[0]));
+    theta = (v[1] - V0) / layers.dt;  // middle node keeps the spot
+  } else {
+    delta = (layers.v1[1] - layers.v1[0]) / (layers.s1[1] - layers.s1[0]);
+    const double* v{layers.v2};
+    const double* s{layers.s2};
+    const double dUp{(v[2] - v[1]) / (s[2] - s[1])};
+    const double dDn{(v[1] - v[0]) / (s[1] - s[0])};
+    gamma = (dUp - dDn) / (0.5 * (s[2] - s[0]));
+    // the middle node of layer 2 is at (or, for Leisen-Reimer, near) the
+    // spot; correct its value to the spot with the tree's delta and gamma
+    const double ds{s[1] - option.getStockPrice()};
+    const double atSpot{v[1] - delta * ds - 0.5 * gamma * ds * ds};
+    theta = (atSpot - V0) / (2.0 * layers.dt);
+  }
+
+  const double S0{option.getStockPrice()};
+  const double K{option.getStrikePrice()};
+  const double r{option.getRiskFreeRate()};
+  const double q{option.getDividendYield()};
+  const double sigma{option.getVolatility()};
+  const OptionType type{option.getType()};
+  auto priceAt = [&](double rr, double sg) {
+    return priceOf(Option(type, S0, K, T, rr, sg, q));
+  };
+  // CRR and trinomial prices oscillate as nodes move across the strike, so
+  // the bumps must be wide enough to average over that
+  const double epsSig{std::max(sigma * 0.05, 1e-3)};
+  const double epsR{std::max(std::abs(r) * 0.05, 1e-3)};
+  // the down bump is clamped for small σ: divide by the actual spread
+  const double sigmaDn{std::max(sigma - epsSig, 1e-8)};
+  const double vega{(priceAt(r, sigma + epsSig) - priceAt(r, sigmaDn)) /
+                    (sigma + epsSig - sigmaDn)};
+  const double rho{(priceAt(r + epsR, sigma) - priceAt(r - epsR, sigma)) /
+                   (2.0 * epsR)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
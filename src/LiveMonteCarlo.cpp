@@ -0,0 +1,194 @@
+#include "LiveMonteCarlo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "MathUtils.h"
+
+LiveMonteCarlo::LiveMonteCarlo(const Option& option,
+                               unsigned long numSimulations, unsigned int seed)
+    : Pricer{option},
+      numSimulations{numSimulations},
+      randomEngine{seed},
+      standardNormal{0.0, 1.0} {
+  if (numSimulations == 0) {
+    throw std::invalid_argument("Number of simulations must be positive.");
+  }
+  normals.resize(numSimulations);
+  for (double& z : normals) {
+    z = standardNormal(randomEngine);
+  }
+  diffusion.resize(numSimulations);
+  refreshDiffusion();
+  refreshDrift();
+}
+
+// delegate ctor
+LiveMonteCarlo::LiveMonteCarlo(const Option& option,
+                               unsigned long numSimulations)
+    : LiveMonteCarlo(option, numSimulations, std::random_device{}()) {}
+
+double LiveMonteCarlo::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+
+  const auto start{std::chrono::high_resolution_clock::now()};
+
+  const double S{option.getStockPrice()};
+  const double K{option.getStrikePrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  const double q{option.getDividendYield()};
+  const double sig{option.getVolatility()};
+  const double disc{std::exp(-r * T)};
+  // +1 for calls, -1 for puts: payoff = max(sign * (S_T - K), 0)
+  const double sign{option.getType() == OptionType::CALL ? 1.0 : -1.0};
+  // spot bump for gamma, taken on pathwise deltas
+  const double h{S * 1e-2};
+
+  const double* e{diffusion.data()};
+  const double* z{normals.data()};
+
+  // moments are shifted by the first payoff, as in MonteCarlo, so deep
+  // in-the-money payoffs do not cancel catastrophically
+  const double shift{std::max(sign * (S * driftFactor * e[0] - K), 0.0)};
+  double sumPay{0}, sumShifted{0}, sumShiftedSq{0};
+  double sumItmG{0}, sumItmGUp{0}, sumItmGDn{0};
+  double sumItmST{0}, sumItmSTz{0};
+
+  // single branch-free pass: growth factor, payoff and pathwise weights
+  for (unsigned long i{0}; i < numSimulations; ++i) {
+    const double g{driftFactor * e[i]};
+    const double ST{S * g};
+    const double payoff{std::max(sign * (ST - K), 0.0)};
+    const double itm{payoff > 0.0 ? 1.0 : 0.0};
+    const double itmUp{sign * ((S + h) * g - K) > 0.0 ? 1.0 : 0.0};
+    const double itmDn{sign * ((S - h) * g - K) > 0.0 ? 1.0 : 0.0};
+
+    sumPay += payoff;
+    const double d{payoff - shift};
+    sumShifted += d;
+    sumShiftedSq += d * d;
+    sumItmG += itm * g;
+    sumItmGUp += itmUp * g;
+    sumItmGDn += itmDn * g;
+    sumItmST += itm * ST;
+    sumItmSTz += itm * ST * z[i];
+  }
+
+  const double n{static_cast<double>(numSimulations)};
+  const double meanPay{sumPay / n};
+  cachedPrice = disc * meanPay;
+
+  const double variance{
+      numSimulations > 1
+          ? std::max(sumShiftedSq - sumShifted * sumShifted / n, 0.0) /
+                (n - 1.0)
+          : 0.0};
+  standardError = disc * std::sqrt(variance / n);
+
+  if (T <= 1e-12 || sig <= 1e-12) {
+    cachedGreeks = Greeks{};
+  } else {
+    const double sqrtT{std::sqrt(T)};
+    const double mu{r - q - 0.5 * sig * sig};
+    const double meanItmST{sumItmST / n};
+    const double meanItmSTz{sumItmSTz / n};
+
+    // dS_T/dS0 = g, dS_T/dσ = S_T (√T z - σT), dS_T/dr = S_T T,
+    // dS_T/dT = S_T (μ + σ z / (2√T))
+    const double delta{sign * disc * sumItmG / n};
+    const double gamma{sign * disc * (sumItmGUp - sumItmGDn) / (n * 2.0 * h)};
+    const double vega{sign * disc *
+                      (sqrtT * meanItmSTz - sig * T * meanItmST)};
+    const double rho{sign * disc * T * meanItmST - T * cachedPrice};
+    const double dVdT{-r * cachedPrice +
+                      sign * disc *
+                          (mu * meanItmST + sig / (2.0 * sqrtT) * meanItmSTz)};
+    cachedGreeks = Greeks{delta, gamma, -dVdT, vega, rho};  // matches BS sign
+  }
+
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks LiveMonteCarlo::calculateGreeks() {
+  calculatePrice();
+  return cachedGreeks;
+}
+
+double LiveMonteCarlo::getStandardError() {
+  calculatePrice();
+  return standardError;
+}
+
+std::pair<double, double> LiveMonteCarlo::getConfidenceInterval(
+    double confidenceLevel) {
+  const double zScore{math::confidence_z(confidenceLevel)};
+  const double price{calculatePrice()};
+  const double marginOfError{zScore * standardError};
+  return {price - marginOfError, price + marginOfError};
+}
+
+void LiveMonteCarlo::updateSpot(double S) {
+  rebuild(S, option.getTimeToMaturity(), option.getRiskFreeRate(),
+          option.getVolatility(), option.getDividendYield());
+}
+
+void LiveMonteCarlo::updateVolatility(double sigma) {
+  rebuild(option.getStockPrice(), option.getTimeToMaturity(),
+          option.getRiskFreeRate(), sigma, option.getDividendYield());
+  refreshDiffusion();
+  refreshDrift();  // drift carries the -σ²/2 term
+}
+
+void LiveMonteCarlo::updateRiskFreeRate(double r) {
+  rebuild(option.getStockPrice(), option.getTimeToMaturity(), r,
+          option.getVolatility(), option.getDividendYield());
+  refreshDrift();
+}
+
+void LiveMonteCarlo::updateDividendYield(double q) {
+  rebuild(option.getStockPrice(), option.getTimeToMaturity(),
+          option.getRiskFreeRate(), option.getVolatility(), q);
+  refreshDrift();
+}
+
+void LiveMonteCarlo::updateTimeToMaturity(double T) {
+  rebuild(option.getStockPrice(), T, option.getRiskFreeRate(),
+          option.getVolatility(), option.getDividendYield());
+  refreshDiffusion();
+  refreshDrift();
+}
+
+void LiveMonteCarlo::reset(const Option& newOption) {
+  Pricer::reset(newOption);
+  refreshDiffusion();
+  refreshDrift();
+}
+
+void LiveMonteCarlo::rebuild(double S, double T, double r, double sigma,
+                             double q) {
+  // goes through the validating constructor
+  Pricer::reset(Option(option.getType(), S, option.getStrikePrice(), T, r,
+                       sigma, q));
+}
+
+void LiveMonteCarlo::refreshDiffusion() {
+  const double volTimesSqrtT{option.getVolatility() *
+                             std::sqrt(option.getTimeToMaturity())};
+  for (unsigned long i{0}; i < numSimulations; ++i) {
+    diffusion[i] = std::exp(volTimesSqrtT * normals[i]);
+  }
+}
+
+void LiveMonteCarlo::refreshDrift() {
+  const double sig{option.getVolatility()};
+  driftFactor = std::exp((option.getRiskFreeRate() -
+                          option.getDividendYield() - 0.5 * sig * sig) *
+                         option.getTimeToMaturity());
+}
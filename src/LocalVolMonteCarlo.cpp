@@ -0,0 +1,159 @@
+#include "LocalVolMonteCarlo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "MathUtils.h"
+#include "Parallel.h"
+#include "RandomStreams.h"
+
+namespace {
+using random_streams::toUniform;
+}  // namespace
+
+LocalVolMonteCarlo::LocalVolMonteCarlo(
+    const Option& option, std::shared_ptr<const LocalVolSurface> surface,
+    Config config)
+    : Pricer(option), surface{std::move(surface)}, config{config} {
+  if (!this->surface) {
+    throw std::invalid_argument("Local-volatility surface must not be null");
+  }
+  if (option.getTimeToMaturity() > this->surface->getHorizon()) {
+    throw std::invalid_argument(
+        "Option maturity lies beyond the local-volatility grid");
+  }
+  if (config.paths == 0 || config.steps == 0 || config.blockPaths == 0) {
+    throw std::invalid_argument("Paths, steps and block size must be positive");
+  }
+  layout = random_streams::BlockLayout{config.paths, config.blockPaths,
+                                       config.steps};
+}
+
+LocalVolMonteCarlo::Estimate LocalVolMonteCarlo::run(double S, double T,
+                                                     double r,
+                                                     double volShift) const {
+  const double K{option.getStrikePrice()};
+  const double q{option.getDividendYield()};
+  const bool isCall{option.getType() == OptionType::CALL};
+  if (T <= 0.0) {
+    return {std::max(isCall ? S - K : K - S, 0.0), 0.0};
+  }
+
+  // one time-interpolated row per step, shared read-only by every block
+  const double dt{T / config.steps};
+  const double sqrtDt{std::sqrt(dt)};
+  const std::size_t nodes{surface->getSpotNodes()};
+  std::vector<double> rows(static_cast<std::size_t>(config.steps) * nodes);
+  for (unsigned n{0}; n < config.steps; ++n) {
+    const std::span<double> row{rows.data() + n * nodes, nodes};
+    surface->interpolateRow(n * dt, row);
+    if (volShift != 0.0) {
+      for (double& sigma : row) sigma = std::max(sigma + volShift, 0.0);
+    }
+  }
+
+  std::vector<math::SampleMoments> blocks(layout.count());
+  const double logS0{std::log(S)};
+  const double drift{(r - q) * dt};
+
+  parallel::forEachIndex(
+      layout.count(),
+      [&](std::size_t b) {
+        const std::size_t size{layout.size(b)};
+        random_streams::Engine engine{layout.seed(config.seed, b)};
+        std::vector<double> logS(size, logS0), z(size);
+
+        for (unsigned n{0}; n < config.steps; ++n) {
+          for (std::size_t i{0}; i < size; ++i) z[i] = toUniform(engine());
+          for (std::size_t i{0}; i < size; ++i) z[i] = math::norm_inv(z[i]);
+          const double* row{rows.data() + n * nodes};
+          for (std::size_t i{0}; i < size; ++i) {
+            const double sigma{surface->lookup(row, logS[i])};
+            logS[i] += drift - 0.5 * sigma * sigma * dt + sigma * sqrtDt * z[i];
+          }
+        }
+
+        math::ShiftedSums sums{};
+        for (std::size_t i{0}; i < size; ++i) {
+          const double ST{std::exp(logS[i])};
+          sums.add(std::max(isCall ? ST - K : K - ST, 0.0));
+        }
+        blocks[b] = sums.moments();
+      },
+      config.threads);
+
+  const math::SampleMoments payoff{math::merge_blocks(blocks)};
+  const double df{std::exp(-r * T)};
+  return {df * payoff.mean, df * payoff.standardError()};
+}
+
+double LocalVolMonteCarlo::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const Estimate estimate{run(option.getStockPrice(),
+                              option.getTimeToMaturity(),
+                              option.getRiskFreeRate(), 0.0)};
+  cachedPrice = estimate.price;
+  standardError = estimate.standardError;
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks LocalVolMonteCarlo::calculateGreeks() {
+  const double V{calculatePrice()};
+  const double S{option.getStockPrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+
+  const double epsS{S * 0.01};
+  const double up{run(S + epsS, T, r, 0.0).price};
+  const double dn{run(S - epsS, T, r, 0.0).price};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * V + dn) / (epsS * epsS)};
+
+  const double epsVol{1e-3};
+  const double vega{
+      (run(S, T, r, epsVol).price - run(S, T, r, -epsVol).price) /
+      (2.0 * epsVol)};
+
+  const double epsR{std::max(std::abs(r) * 0.01, 1e-4)};
+  const double rho{(run(S, T, r + epsR, 0.0).price -
+                    run(S, T, r - epsR, 0.0).price) /
+                   (2.0 * epsR)};
+  // the surface ends at its horizon, so theta differences backwards there
+  const double epsT{std::max(T * 0.01, 1e-4)};
+  const double later{std::min(T + epsT, surface->getHorizon())};
+  const double earlier{std::max(T - epsT, 1e-8)};
+  const double theta{(run(S, earlier, r, 0.0).price -
+                      run(S, later, r, 0.0).price) /
+                     (later - earlier)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
+
+double LocalVolMonteCarlo::getStandardError() {
+  validatePriceCalculated();
+  return standardError;
+}
+
+std::pair<double, double> LocalVolMonteCarlo::getConfidenceInterval(
+    double confidenceLevel) {
+  validatePriceCalculated();
+  return math::confidence_interval(cachedPrice, standardError,
+                                   confidenceLevel);
+}
+
+void LocalVolMonteCarlo::validatePriceCalculated() const {
+  if (!priceCalculated) {
+    throw std::runtime_error(
+        "Price must be calculated first. Call calculatePrice()");
+  }
+}
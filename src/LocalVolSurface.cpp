@@ -0,0 +1,244 @@
+#include "LocalVolSurface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "Parallel.h"
+
+namespace {
+// log-moneyness step for the strike derivatives of w
+constexpr double MONEYNESS_STEP{1e-3};
+// largest time step for the calendar derivative of w
+constexpr double MAX_TIME_STEP{1e-3};
+// extrapolated wings never fall below this fraction of the end variance
+constexpr double WING_FLOOR{0.1};
+
+bool strictlyIncreasing(const std::vector<double>& values) {
+  for (std::size_t i{1}; i < values.size(); ++i) {
+    if (!(values[i] > values[i - 1])) return false;
+  }
+  return true;
+}
+}  // namespace
+
+ImpliedVolSurface::ImpliedVolSurface(std::vector<double> expiries,
+                                     std::vector<double> strikes,
+                                     std::vector<double> vols, double spot,
+                                     double riskFreeRate,
+                                     double dividendYield)
+    : expiries{std::move(expiries)},
+      strikes{std::move(strikes)},
+      spot{spot},
+      riskFreeRate{riskFreeRate},
+      dividendYield{dividendYield} {
+  const std::size_t rows{this->expiries.size()};
+  const std::size_t cols{this->strikes.size()};
+  if (rows == 0 || cols < 2) {
+    throw std::invalid_argument(
+        "Surface needs at least one expiry and two strikes");
+  }
+  if (vols.size() != rows * cols) {
+    throw std::invalid_argument("Surface needs one volatility per quote");
+  }
+  if (!strictlyIncreasing(this->expiries) || this->expiries.front() <= 0.0 ||
+      !strictlyIncreasing(this->strikes) || this->strikes.front() <= 0.0) {
+    throw std::invalid_argument(
+        "Expiries and strikes must be positive and strictly increasing");
+  }
+  if (!(spot > 0.0) ||
+      std::any_of(vols.begin(), vols.end(), [](double v) { return !(v > 0); })) {
+    throw std::invalid_argument("Spot and volatilities must be positive");
+  }
+
+  variances.resize(rows * cols);
+  moneyness.resize(rows * cols);
+  curvature.assign(rows * cols, 0.0);
+  std::vector<double> diagonal(cols), rhs(cols);
+  for (std::size_t i{0}; i < rows; ++i) {
+    const double T{this->expiries[i]};
+    const double logForward{std::log(forward(T))};
+    double* y{&moneyness[i * cols]};
+    double* w{&variances[i * cols]};
+    double* m{&curvature[i * cols]};
+    for (std::size_t j{0}; j < cols; ++j) {
+      y[j] = std::log(this->strikes[j]) - logForward;
+      w[j] = vols[i * cols + j] * vols[i * cols + j] * T;
+    }
+    // natural spline: tridiagonal system for the interior curvatures,
+    // solved by forward elimination and back substitution
+    for (std::size_t j{1}; j + 1 < cols; ++j) {
+      const double hl{y[j] - y[j - 1]};
+      const double hr{y[j + 1] - y[j]};
+      diagonal[j] = 2.0 * (hl + hr);
+      rhs[j] = 6.0 * ((w[j + 1] - w[j]) / hr - (w[j] - w[j - 1]) / hl);
+      if (j > 1) {
+        const double factor{hl / diagonal[j - 1]};
+        diagonal[j] -= factor * hl;
+        rhs[j] -= factor * rhs[j - 1];
+      }
+    }
+    for (std::size_t j{cols - 1}; j-- > 1;) {
+      const double hr{y[j + 1] - y[j]};
+      m[j] = (rhs[j] - hr * m[j + 1]) / diagonal[j];
+    }
+  }
+}
+
+double ImpliedVolSurface::rowVariance(std::size_t i, double y) const {
+  const std::size_t cols{strikes.size()};
+  const double* ys{&moneyness[i * cols]};
+  const double* w{&variances[i * cols]};
+  const double* m{&curvature[i * cols]};
+  if (y <= ys[0] || y >= ys[cols - 1]) {
+    // linear wings with the spline's end slopes
+    const bool left{y <= ys[0]};
+    const std::size_t a{left ? 0 : cols - 2};
+    const double h{ys[a + 1] - ys[a]};
+    const double slope{(w[a + 1] - w[a]) / h +
+                       (left ? -h * m[a + 1] / 6.0 : h * m[a] / 6.0)};
+    const std::size_t end{left ? 0 : cols - 1};
+    return std::max(w[end] + slope * (y - ys[end]), WING_FLOOR * w[end]);
+  }
+  const std::size_t b{static_cast<std::size_t>(
+      std::upper_bound(ys, ys + cols, y) - ys)};
+  const std::size_t a{b - 1};
+  const double h{ys[b] - ys[a]};
+  const double u{(ys[b] - y) / h};
+  const double v{1.0 - u};
+  return u * w[a] + v * w[b] +
+         ((u * u * u - u) * m[a] + (v * v * v - v) * m[b]) * h * h / 6.0;
+}
+
+double ImpliedVolSurface::totalVariance(double T, double y) const {
+  const std::size_t last{expiries.size() - 1};
+  if (T <= expiries.front()) {
+    return T / expiries.front() * rowVariance(0, y);
+  }
+  if (T >= expiries[last]) {
+    return T / expiries[last] * rowVariance(last, y);
+  }
+  const std::size_t b{static_cast<std::size_t>(
+      std::upper_bound(expiries.begin(), expiries.end(), T) -
+      expiries.begin())};
+  const std::size_t a{b - 1};
+  const double weight{(T - expiries[a]) / (expiries[b] - expiries[a])};
+  return (1.0 - weight) * rowVariance(a, y) + weight * rowVariance(b, y);
+}
+
+double ImpliedVolSurface::volatility(double T, double K) const {
+  const double t{std::max(T, 1e-12)};
+  return std::sqrt(totalVariance(t, std::log(K / forward(t))) / t);
+}
+
+double ImpliedVolSurface::forward(double T) const {
+  return spot * std::exp((riskFreeRate - dividendYield) * T);
+}
+
+std::shared_ptr<const LocalVolSurface> LocalVolSurface::build(
+    const ImpliedVolSurface& implied, Config config) {
+  if (config.timeSteps == 0 || config.spotNodes < 3) {
+    throw std::invalid_argument(
+        "Local-volatility grid needs a time step and three spot nodes");
+  }
+  if (config.spotRange <= 0.0 || config.minVol <= 0.0 ||
+      config.maxVol <= config.minVol || config.horizon < 0.0) {
+    throw std::invalid_argument(
+        "Spot range and volatility bounds must be positive and ordered");
+  }
+
+  // private constructor, so no make_shared
+  std::shared_ptr<LocalVolSurface> surface{new LocalVolSurface{}};
+  surface->horizon =
+      config.horizon > 0.0 ? config.horizon : implied.getExpiries().back();
+  surface->timeNodes = config.timeSteps + 1;
+  surface->spotNodes = config.spotNodes;
+  surface->timeStep = surface->horizon / config.timeSteps;
+
+  const double H{surface->horizon};
+  const double atmVol{std::sqrt(implied.totalVariance(H, 0.0) / H)};
+  const double halfWidth{config.spotRange * atmVol * std::sqrt(H)};
+  const double center{std::log(implied.forward(0.5 * H))};
+  surface->logSpotMin = center - halfWidth;
+  surface->logSpotStep = 2.0 * halfWidth / (config.spotNodes - 1);
+  surface->inverseLogSpotStep = 1.0 / surface->logSpotStep;
+  surface->maxIndex = std::nextafter(static_cast<double>(config.spotNodes - 1),
+                                     0.0);
+
+  const std::size_t n{surface->spotNodes};
+  surface->grid.resize(surface->timeNodes * n);
+  std::vector<std::size_t> rowClamps(surface->timeNodes);
+  const double minVar{config.minVol * config.minVol};
+  const double maxVar{config.maxVol * config.maxVol};
+
+  parallel::forEachIndex(surface->timeNodes, [&](std::size_t a) {
+    // Dupire is singular at t = 0; the first row uses the half-step time
+    const double t{std::max(static_cast<double>(a) * surface->timeStep,
+                            0.5 * surface->timeStep)};
+    const double ht{std::min(MAX_TIME_STEP, 0.5 * t)};
+    const double hy{MONEYNESS_STEP};
+    const double logForward{std::log(implied.forward(t))};
+    double* row{&surface->grid[a * n]};
+    std::size_t clamps{0};
+    for (std::size_t b{0}; b < n; ++b) {
+      const double y{surface->logSpotMin +
+                     static_cast<double>(b) * surface->logSpotStep -
+                     logForward};
+      const double w{implied.totalVariance(t, y)};
+      const double wUp{implied.totalVariance(t, y + hy)};
+      const double wDn{implied.totalVariance(t, y - hy)};
+      const double wy{(wUp - wDn) / (2.0 * hy)};
+      const double wyy{(wUp - 2.0 * w + wDn) / (hy * hy)};
+      const double wt{(implied.totalVariance(t + ht, y) -
+                       implied.totalVariance(t - ht, y)) /
+                      (2.0 * ht)};
+      const double denominator{1.0 - y * wy / w +
+                               0.25 * (-0.25 - 1.0 / w + y * y / (w * w)) *
+                                   wy * wy +
+                               0.5 * wyy};
+      double variance{};
+      if (wt <= 0.0) {
+        variance = minVar;  // calendar arbitrage
+      } else if (denominator <= 0.0) {
+        variance = maxVar;  // butterfly arbitrage
+      } else {
+        variance = wt / denominator;
+      }
+      if (wt <= 0.0 || denominator <= 0.0 || variance < minVar ||
+          variance > maxVar) {
+        ++clamps;
+      }
+      row[b] = std::sqrt(std::clamp(variance, minVar, maxVar));
+    }
+    rowClamps[a] = clamps;
+  });
+  for (const std::size_t clamps : rowClamps) surface->clampedNodes += clamps;
+  return surface;
+}
+
+void LocalVolSurface::interpolateRow(double t, std::span<double> out) const {
+  if (out.size() != spotNodes) {
+    throw std::invalid_argument("Row must have one entry per spot node");
+  }
+  const double s{std::clamp(t / timeStep, 0.0,
+                            static_cast<double>(timeNodes - 1))};
+  const std::size_t a{std::min(static_cast<std::size_t>(s), timeNodes - 2)};
+  const double frac{s - static_cast<double>(a)};
+  const double* lo{&grid[a * spotNodes]};
+  const double* hi{lo + spotNodes};
+  for (std::size_t b{0}; b < spotNodes; ++b) {
+    out[b] = lo[b] + frac * (hi[b] - lo[b]);
+  }
+}
+
+double LocalVolSurface::localVol(double t, double S) const {
+  const double s{std::clamp(t / timeStep, 0.0,
+                            static_cast<double>(timeNodes - 1))};
+  const std::size_t a{std::min(static_cast<std::size_t>(s), timeNodes - 2)};
+  const double frac{s - static_cast<double>(a)};
+  const double x{std::log(S)};
+  const double lo{lookup(&grid[a * spotNodes], x)};
+  const double hi{lookup(&grid[(a + 1) * spotNodes], x)};
+  return lo + frac * (hi - lo);
+}
@@ -0,0 +1,337 @@
+#include "LongstaffSchwartz.h"
+
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "MathUtils.h"
+#include "Parallel.h"
+#include "RandomStreams.h"
+
+namespace {
+// each normal takes exactly one engine draw, mapped through the inverse
+// CDF, so block substreams are sized exactly
+constexpr std::uint64_t DRAWS_PER_NORMAL{1};
+
+using random_streams::toUniform;
+
+constexpr std::size_t NB{LongstaffSchwartz::MAX_BASIS};
+using Vector = std::array<double, NB>;
+using Matrix = std::array<double, NB * NB>;
+
+/**
+ * @brief One cache block of paths: three doubles per path plus the block's
+ * random substream and its share of the normal equations.
+ */
+struct Block {
+  random_streams::Engine engine;
+  std::vector<double> w{};     // Brownian motion at the current date
+  std::vector<double> x{};     // moneyness S/K at the current date
+  std::vector<double> cash{};  // cash flow discounted to the current date
+  Matrix gram{};
+  Vector rhs{};
+  unsigned long inTheMoney{0};
+  double europeanSum{0.0};
+
+  Block(unsigned int seed, std::size_t size)
+      : engine{seed}, w(size), x(size), cash(size) {}
+};
+
+/**
+ * @brief Solves the symmetric normal equations A·β = b by Cholesky.
+ *
+ * Only the upper triangle of A is read. A tiny ridge keeps near-collinear
+ * bases solvable.
+ *
+ * @return false if A is not positive definite.
+ */
+bool solveNormalEquations(Matrix a, Vector b, std::size_t n, Vector& beta) {
+  double trace{0.0};
+  for (std::size_t i{0}; i < n; ++i) trace += a[i * NB + i];
+  const double ridge{1e-12 * trace / static_cast<double>(n)};
+
+  // L stored in the lower triangle of a
+  for (std::size_t j{0}; j < n; ++j) {
+    double d{a[j * NB + j] + ridge};
+    for (std::size_t k{0}; k < j; ++k) d -= a[j * NB + k] * a[j * NB + k];
+    if (!(d > 0.0)) return false;
+    d = std::sqrt(d);
+    a[j * NB + j] = d;
+    for (std::size_t i{j + 1}; i < n; ++i) {
+      double s{a[j * NB + i]};  // upper triangle holds A(j, i)
+      for (std::size_t k{0}; k < j; ++k) s -= a[i * NB + k] * a[j * NB + k];
+      a[i * NB + j] = s / d;
+    }
+  }
+  for (std::size_t i{0}; i < n; ++i) {  // L·y = b
+    for (std::size_t k{0}; k < i; ++k) b[i] -= a[i * NB + k] * b[k];
+    b[i] /= a[i * NB + i];
+  }
+  for (std::size_t i{n}; i-- > 0;) {  // Lᵀ·β = y
+    for (std::size_t k{i + 1}; k < n; ++k) b[i] -= a[k * NB + i] * b[k];
+    b[i] /= a[i * NB + i];
+  }
+  beta = b;
+  return true;
+}
+}  // namespace
+
+LongstaffSchwartz::LongstaffSchwartz(const Option& option, Config config)
+    : Pricer(option), config{config} {
+  if (config.paths == 0 || config.exerciseDates == 0 ||
+      config.blockPaths == 0) {
+    throw std::invalid_argument(
+        "Paths, exercise dates and block size must be positive");
+  }
+  if (config.degree + 1 > MAX_BASIS) {
+    throw std::invalid_argument("Regression degree too high");
+  }
+  layout = random_streams::BlockLayout{config.paths, config.blockPaths,
+                                       config.exerciseDates * DRAWS_PER_NORMAL};
+}
+
+std::array<double, LongstaffSchwartz::MAX_BASIS>
+LongstaffSchwartz::evaluateBasis(RegressionBasis basis, unsigned degree,
+                                 double x) {
+  std::array<double, MAX_BASIS> phi{};
+  phi[0] = 1.0;
+  if (degree == 0) return phi;
+  switch (basis) {
+    case RegressionBasis::MONOMIAL:
+      for (unsigned n{1}; n <= degree; ++n) phi[n] = phi[n - 1] * x;
+      break;
+    case RegressionBasis::LAGUERRE:
+      phi[1] = 1.0 - x;
+      for (unsigned n{1}; n < degree; ++n) {
+        phi[n + 1] = ((2.0 * n + 1.0 - x) * phi[n] - n * phi[n - 1]) / (n + 1);
+      }
+      break;
+    case RegressionBasis::HERMITE:
+      phi[1] = x;
+      for (unsigned n{1}; n < degree; ++n) {
+        phi[n + 1] = x * phi[n] - n * phi[n - 1];
+      }
+      break;
+  }
+  return phi;
+}
+
+LongstaffSchwartz::Estimate LongstaffSchwartz::run(const Option& priced) const {
+  const double S0{priced.getStockPrice()};
+  const double K{priced.getStrikePrice()};
+  const double T{priced.getTimeToMaturity()};
+  const double r{priced.getRiskFreeRate()};
+  const double q{priced.getDividendYield()};
+  const double sig{priced.getVolatility()};
+  const bool isCall{priced.getType() == OptionType::CALL};
+  auto intrinsic = [isCall, K](double x) {
+    return K * std::max(isCall ? x - 1.0 : 1.0 - x, 0.0);
+  };
+
+  if (T <= 0.0) {
+    const double value{intrinsic(S0 / K)};
+    return {value, 0.0, value};
+  }
+
+  const unsigned N{config.exerciseDates};
+  const std::size_t nb{config.degree + 1};
+  const double dt{T / N};
+  const double mu{r - q - 0.5 * sig * sig};
+  const double x0{S0 / K};
+  const double stepDiscount{std::exp(-r * dt)};
+
+  const std::size_t blockCount{layout.count()};
+  std::vector<Block> blocks{};
+  blocks.reserve(blockCount);
+  for (std::size_t b{0}; b < blockCount; ++b) {
+    blocks.emplace_back(layout.seed(config.seed, b), layout.size(b));
+  }
+
+  const RegressionBasis basis{config.basis};
+  const unsigned degree{config.degree};
+
+  // the date's regression, run once every worker has accumulated its
+  // blocks; block order keeps results independent of the thread count
+  Vector beta{};
+  bool regressed{false};
+  auto regress = [&]() noexcept {
+    Matrix gram{};
+    Vector rhs{};
+    unsigned long inTheMoney{0};
+    for (const Block& blk : blocks) {
+      for (std::size_t j{0}; j < gram.size(); ++j) gram[j] += blk.gram[j];
+      for (std::size_t j{0}; j < nb; ++j) rhs[j] += blk.rhs[j];
+      inTheMoney += blk.inTheMoney;
+    }
+    // too few in-the-money paths to regress: no exercise at this date
+    regressed = inTheMoney >= nb && solveNormalEquations(gram, rhs, nb, beta);
+  };
+
+  // one team for the whole induction: each worker owns every workers-th
+  // block and the team meets at a barrier per date, instead of starting
+  // threads twice per date. forEachIndex gives each of the `workers` tasks
+  // its own thread, so all of them reach the barrier.
+  const unsigned threads{config.threads == 0 ? parallel::defaultThreadCount()
+                                             : config.threads};
+  const std::size_t workers{std::min<std::size_t>(threads, blockCount)};
+  std::barrier sync{static_cast<std::ptrdiff_t>(workers), regress};
+  const double sqrtT{std::sqrt(T)};
+
+  parallel::forEachIndex(
+      workers,
+      [&](std::size_t worker) {
+        // maturity: draw W(T) and start every path at its payoff
+        for (std::size_t b{worker}; b < blockCount; b += workers) {
+          Block& blk{blocks[b]};
+          for (std::size_t i{0}; i < blk.w.size(); ++i) {
+            blk.w[i] = sqrtT * math::norm_inv(toUniform(blk.engine()));
+            blk.x[i] = x0 * std::exp(mu * T + sig * blk.w[i]);
+            blk.cash[i] = intrinsic(blk.x[i]);
+            blk.europeanSum += blk.cash[i];
+          }
+        }
+
+        for (unsigned k{N - 1}; k >= 1; --k) {
+          // bridge W(t_{k+1}) -> W(t_k): mean k/(k+1)·W, variance dt·k/(k+1)
+          const double t{k * dt};
+          const double a{static_cast<double>(k) / (k + 1)};
+          const double s{std::sqrt(dt * a)};
+
+          for (std::size_t b{worker}; b < blockCount; b += workers) {
+            Block& blk{blocks[b]};
+            blk.gram.fill(0.0);
+            blk.rhs.fill(0.0);
+            blk.inTheMoney = 0;
+            for (std::size_t i{0}; i < blk.w.size(); ++i) {
+              blk.w[i] = a * blk.w[i] +
+                         s * math::norm_inv(toUniform(blk.engine()));
+              blk.x[i] = x0 * std::exp(mu * t + sig * blk.w[i]);
+              blk.cash[i] *= stepDiscount;
+              if (intrinsic(blk.x[i]) <= 0.0) continue;
+              const auto phi{evaluateBasis(basis, degree, blk.x[i])};
+              for (std::size_t p{0}; p < nb; ++p) {
+                for (std::size_t c{p}; c < nb; ++c) {
+                  blk.gram[p * NB + c] += phi[p] * phi[c];
+                }
+                blk.rhs[p] += phi[p] * blk.cash[i];
+              }
+              ++blk.inTheMoney;
+            }
+          }
+
+          // regress() runs once, on the last arrival; β is next rewritten
+          // only after every worker has finished this date's exercise pass
+          sync.arrive_and_wait();
+          if (!regressed) continue;
+
+          for (std::size_t b{worker}; b < blockCount; b += workers) {
+            Block& blk{blocks[b]};
+            for (std::size_t i{0}; i < blk.x.size(); ++i) {
+              const double exercise{intrinsic(blk.x[i])};
+              if (exercise <= 0.0) continue;
+              const auto phi{evaluateBasis(basis, degree, blk.x[i])};
+              double continuation{0.0};
+              for (std::size_t p{0}; p < nb; ++p) {
+                continuation += beta[p] * phi[p];
+              }
+              if (exercise > continuation) blk.cash[i] = exercise;
+            }
+          }
+        }
+      },
+      static_cast<unsigned>(workers));
+
+  // discount from the first date to today and collect the moments
+  math::SampleMoments cash{};
+  double europeanSum{0.0};
+  for (const Block& blk : blocks) {
+    math::ShiftedSums sums{};
+    for (const double c : blk.cash) sums.add(c * stepDiscount);
+    cash.merge(sums.moments());
+    europeanSum += blk.europeanSum;
+  }
+
+  Estimate estimate{};
+  // exercise today if better
+  estimate.price = std::max(cash.mean, intrinsic(x0));
+  estimate.standardError = cash.standardError();
+  estimate.european =
+      europeanSum / static_cast<double>(config.paths) * std::exp(-r * T);
+  return estimate;
+}
+
+double LongstaffSchwartz::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const Estimate estimate{run(option)};
+  cachedPrice = estimate.price;
+  standardError = estimate.standardError;
+  europeanPrice = estimate.european;
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks LongstaffSchwartz::calculateGreeks() {
+  const double base{calculatePrice()};
+  const double S0{option.getStockPrice()};
+  const double K{option.getStrikePrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  const double sig{option.getVolatility()};
+  const double q{option.getDividendYield()};
+  const OptionType type{option.getType()};
+
+  // bumps are larger than MonteCarlo's: exercise decisions make the
+  // estimator piecewise in the inputs, so tiny bumps only see noise
+  const double epsS{std::max(S0 * 0.01, 1e-6)};
+  const double epsSig{std::max(sig * 0.05, 1e-4)};
+  const double epsR{std::max(std::abs(r) * 0.05, 1e-4)};
+  const double epsT{std::max(T * 0.01, 1e-5)};
+  auto price = [&](double s, double t, double rr, double sg) {
+    return run(Option(type, s, K, t, rr, sg, q)).price;
+  };
+
+  const double up{price(S0 + epsS, T, r, sig)};
+  const double dn{price(S0 - epsS, T, r, sig)};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * base + dn) / (epsS * epsS)};
+  // σ and T bumps are clamped near zero: divide by the actual spread
+  const double sigDn{std::max(sig - epsSig, 1e-8)};
+  const double vega{(price(S0, T, r, sig + epsSig) - price(S0, T, r, sigDn)) /
+                    (sig + epsSig - sigDn)};
+  const double rho{(price(S0, T, r + epsR, sig) - price(S0, T, r - epsR, sig)) /
+                   (2.0 * epsR)};
+  const double tDn{std::max(T - epsT, 1e-8)};
+  const double theta{(price(S0, tDn, r, sig) - price(S0, T + epsT, r, sig)) /
+                     (T + epsT - tDn)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
+
+double LongstaffSchwartz::getStandardError() {
+  validatePriceCalculated();
+  return standardError;
+}
+
+std::pair<double, double> LongstaffSchwartz::getConfidenceInterval(
+    double confidenceLevel) {
+  validatePriceCalculated();
+  return math::confidence_interval(cachedPrice, standardError,
+                                   confidenceLevel);
+}
+
+double LongstaffSchwartz::getEarlyExercisePremium() {
+  validatePriceCalculated();
+  return cachedPrice - europeanPrice;
+}
+
+void LongstaffSchwartz::validatePriceCalculated() const {
+  if (!priceCalculated) {
+    throw std::runtime_error(
+        "Price must be calculated first. Call calculatePrice()");
+  }
+}
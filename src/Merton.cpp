@@ -0,0 +1,158 @@
+#include "Merton.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+
+namespace {
+// series terms handed to BlackScholes::priceBatch at a time; a few cover
+// the usual λT < 1, so chunks stay small
+constexpr std::size_t SERIES_CHUNK{8};
+// hard stop for the series, far beyond any sensible λT
+constexpr unsigned MAX_SERIES_TERMS{8192};
+}  // namespace
+
+void MertonParams::validate() const {
+  if (sigma < 0.0 || lambda < 0.0 || jumpVol < 0.0) {
+    throw std::invalid_argument(
+        "Merton sigma, lambda and jump volatility must be non-negative");
+  }
+}
+
+double MertonParams::compensator() const {
+  return std::exp(jumpMean + 0.5 * jumpVol * jumpVol) - 1.0;
+}
+
+namespace merton {
+std::complex<double> characteristicFunction(std::complex<double> u, double T,
+                                            const MertonParams& p) {
+  const std::complex<double> i{0.0, 1.0};
+  const double s2{p.sigma * p.sigma};
+  const std::complex<double> diffusion{-0.5 * s2 * (i * u + u * u)};
+  const std::complex<double> jumps{
+      p.lambda * (std::exp(i * u * p.jumpMean -
+                           0.5 * p.jumpVol * p.jumpVol * u * u) -
+                  1.0 - i * u * p.compensator())};
+  return std::exp(T * (diffusion + jumps));
+}
+
+double price(OptionType type, double S, double K, double T, double r,
+             double q, const MertonParams& p, double tolerance,
+             unsigned* terms) {
+  if (T <= 0.0) {
+    if (terms != nullptr) *terms = 0;
+    return std::max(type == OptionType::CALL ? S - K : K - S, 0.0);
+  }
+  const double k{p.compensator()};
+  const double lambdaT{p.lambda * (1.0 + k) * T};
+  const double logLambdaT{lambdaT > 0.0 ? std::log(lambdaT) : 0.0};
+  const double logJump{std::log1p(k)};  // μ_J + σ_J²/2
+  const double s2{p.sigma * p.sigma};
+  const double j2{p.jumpVol * p.jumpVol};
+  const double bound{S * std::exp(-q * T)};
+
+  // columns for one chunk of terms: only rₙ and σₙ change between terms
+  std::array<OptionType, SERIES_CHUNK> types{};
+  std::array<double, SERIES_CHUNK> spot{}, strike{}, maturity{}, rate{},
+      vol{}, yield{}, weight{}, out{};
+  types.fill(OptionType::CALL);
+  spot.fill(S);
+  strike.fill(K);
+  maturity.fill(T);
+  yield.fill(q);
+  const OptionColumns columns{types, spot, strike, maturity, rate, vol, yield};
+
+  double call{0.0};
+  double mass{0.0};
+  unsigned used{0};
+  bool done{false};
+  while (!done) {
+    for (std::size_t i{0}; i < SERIES_CHUNK; ++i) {
+      const double n{static_cast<double>(used + i)};
+      rate[i] = r - p.lambda * k + n * logJump / T;
+      vol[i] = std::sqrt(s2 + n * j2 / T);
+      weight[i] = lambdaT > 0.0 ? std::exp(-lambdaT + n * logLambdaT -
+                                           std::lgamma(n + 1.0))
+                                : (used + i == 0 ? 1.0 : 0.0);
+    }
+    BlackScholes::priceBatch(columns, out);
+    for (std::size_t i{0}; i < SERIES_CHUNK && !done; ++i) {
+      call += weight[i] * out[i];
+      mass += weight[i];
+      ++used;
+      // past the Poisson mode the tail only shrinks, so its mass bounds
+      // the error left in the sum
+      done = (used >= lambdaT &&
+              std::max(1.0 - mass, 0.0) * bound <= tolerance) ||
+             used >= MAX_SERIES_TERMS;
+    }
+  }
+  if (terms != nullptr) *terms = used;
+  if (type == OptionType::CALL) {
+    return call;
+  }
+  return std::max(call - bound + K * std::exp(-r * T), 0.0);
+}
+}  // namespace merton
+
+MertonAnalytic::MertonAnalytic(const Option& option, const MertonParams& params)
+    : Pricer(option), params{params} {
+  params.validate();
+}
+
+double MertonAnalytic::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  cachedPrice = merton::price(option.getType(), option.getStockPrice(),
+                              option.getStrikePrice(),
+                              option.getTimeToMaturity(),
+                              option.getRiskFreeRate(),
+                              option.getDividendYield(), params, 1e-12,
+                              &seriesTerms);
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks MertonAnalytic::calculateGreeks() {
+  const double V{calculatePrice()};
+  const OptionType type{option.getType()};
+  const double S{option.getStockPrice()};
+  const double K{option.getStrikePrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  const double q{option.getDividendYield()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+
+  const double epsS{std::max(S * 1e-4, 1e-6)};
+  const double up{merton::price(type, S + epsS, K, T, r, q, params)};
+  const double dn{merton::price(type, S - epsS, K, T, r, q, params)};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * V + dn) / (epsS * epsS)};
+
+  const double epsVol{std::max(params.sigma * 1e-3, 1e-5)};
+  MertonParams volUp{params}, volDn{params};
+  volUp.sigma = params.sigma + epsVol;
+  volDn.sigma = std::max(params.sigma - epsVol, 0.0);
+  const double vega{(merton::price(type, S, K, T, r, q, volUp) -
+                     merton::price(type, S, K, T, r, q, volDn)) /
+                    (volUp.sigma - volDn.sigma)};
+
+  const double epsR{std::max(std::abs(r) * 1e-3, 1e-5)};
+  const double rho{(merton::price(type, S, K, T, r + epsR, q, params) -
+                    merton::price(type, S, K, T, r - epsR, q, params)) /
+                   (2.0 * epsR)};
+  const double epsT{std::max(T * 1e-3, 1e-5)};
+  const double theta{(merton::price(type, S, K, std::max(T - epsT, 1e-8), r, q,
+                                    params) -
+                      merton::price(type, S, K, T + epsT, r, q, params)) /
+                     (2.0 * epsT)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
@@ -0,0 +1,158 @@
+#include "MertonMonteCarlo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "MathUtils.h"
+#include "Parallel.h"
+#include "RandomStreams.h"
+
+namespace {
+// each path takes exactly three engine draws (diffusion, count, jump sizes)
+constexpr std::uint64_t DRAWS_PER_PATH{3};
+// inversion stops here even if rounding leaves the CDF just short of u
+constexpr unsigned MAX_JUMPS{10000};
+
+using random_streams::toUniform;
+}  // namespace
+
+MertonMonteCarlo::MertonMonteCarlo(const Option& option,
+                                   const MertonParams& params, Config config)
+    : Pricer(option), params{params}, config{config} {
+  params.validate();
+  layout = random_streams::BlockLayout{config.paths, config.blockPaths,
+                                       DRAWS_PER_PATH};
+}
+
+MertonMonteCarlo::Estimate MertonMonteCarlo::run(double S, double T, double r,
+                                                 const MertonParams& p) const {
+  const double K{option.getStrikePrice()};
+  const double q{option.getDividendYield()};
+  const bool isCall{option.getType() == OptionType::CALL};
+  if (T <= 0.0) {
+    return {std::max(isCall ? S - K : K - S, 0.0), 0.0};
+  }
+
+  const double lambdaT{p.lambda * T};
+  const double noJumps{std::exp(-lambdaT)};
+  const double drift{std::log(S) +
+                     (r - q - p.lambda * p.compensator() -
+                      0.5 * p.sigma * p.sigma) *
+                         T};
+  const double diffusion{p.sigma * std::sqrt(T)};
+
+  std::vector<math::SampleMoments> blocks(layout.count());
+
+  parallel::forEachIndex(
+      layout.count(),
+      [&](std::size_t b) {
+        const std::size_t size{layout.size(b)};
+        random_streams::Engine engine{layout.seed(config.seed, b)};
+        std::vector<double> zW(size), uN(size), zJ(size);
+        std::vector<unsigned> jumps(size);
+
+        for (std::size_t i{0}; i < size; ++i) zW[i] = toUniform(engine());
+        for (std::size_t i{0}; i < size; ++i) uN[i] = toUniform(engine());
+        for (std::size_t i{0}; i < size; ++i) zJ[i] = toUniform(engine());
+        for (std::size_t i{0}; i < size; ++i) zW[i] = math::norm_inv(zW[i]);
+        for (std::size_t i{0}; i < size; ++i) zJ[i] = math::norm_inv(zJ[i]);
+
+        // Poisson inversion: for the usual λT < 1 almost every path stops
+        // at the first comparison
+        for (std::size_t i{0}; i < size; ++i) {
+          unsigned n{0};
+          double term{noJumps};
+          double cdf{noJumps};
+          while (uN[i] > cdf && n < MAX_JUMPS) {
+            ++n;
+            term *= lambdaT / n;
+            cdf += term;
+          }
+          jumps[i] = n;
+        }
+
+        math::ShiftedSums sums{};
+        for (std::size_t i{0}; i < size; ++i) {
+          const double n{static_cast<double>(jumps[i])};
+          const double logS{drift + diffusion * zW[i] + n * p.jumpMean +
+                            p.jumpVol * std::sqrt(n) * zJ[i]};
+          const double ST{std::exp(logS)};
+          sums.add(std::max(isCall ? ST - K : K - ST, 0.0));
+        }
+        blocks[b] = sums.moments();
+      },
+      config.threads);
+
+  const math::SampleMoments payoff{math::merge_blocks(blocks)};
+  const double df{std::exp(-r * T)};
+  return {df * payoff.mean, df * payoff.standardError()};
+}
+
+double MertonMonteCarlo::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const Estimate estimate{run(option.getStockPrice(),
+                              option.getTimeToMaturity(),
+                              option.getRiskFreeRate(), params)};
+  cachedPrice = estimate.price;
+  standardError = estimate.standardError;
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+Greeks MertonMonteCarlo::calculateGreeks() {
+  const double V{calculatePrice()};
+  const double S{option.getStockPrice()};
+  const double T{option.getTimeToMaturity()};
+  const double r{option.getRiskFreeRate()};
+  if (T <= 0.0) {
+    return Greeks{};
+  }
+
+  const double epsS{S * 0.01};
+  const double up{run(S + epsS, T, r, params).price};
+  const double dn{run(S - epsS, T, r, params).price};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * V + dn) / (epsS * epsS)};
+
+  const double epsVol{std::max(params.sigma * 0.01, 1e-4)};
+  MertonParams volUp{params}, volDn{params};
+  volUp.sigma = params.sigma + epsVol;
+  volDn.sigma = std::max(params.sigma - epsVol, 0.0);
+  const double vega{(run(S, T, r, volUp).price - run(S, T, r, volDn).price) /
+                    (volUp.sigma - volDn.sigma)};
+
+  const double epsR{std::max(std::abs(r) * 0.01, 1e-4)};
+  const double rho{(run(S, T, r + epsR, params).price -
+                    run(S, T, r - epsR, params).price) /
+                   (2.0 * epsR)};
+  const double epsT{std::max(T * 0.01, 1e-4)};
+  const double theta{(run(S, std::max(T - epsT, 1e-8), r, params).price -
+                      run(S, T + epsT, r, params).price) /
+                     (2.0 * epsT)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
+
+double MertonMonteCarlo::getStandardError() {
+  validatePriceCalculated();
+  return standardError;
+}
+
+std::pair<double, double> MertonMonteCarlo::getConfidenceInterval(
+    double confidenceLevel) {
+  validatePriceCalculated();
+  return math::confidence_interval(cachedPrice, standardError,
+                                   confidenceLevel);
+}
+
+void MertonMonteCarlo::validatePriceCalculated() const {
+  if (!priceCalculated) {
+    throw std::runtime_error(
+        "Price must be calculated first. Call calculatePrice()");
+  }
+}
@@ -1,9 +1,107 @@
 #include "MonteCarlo.h"
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <istream>
+#include <ostream>
 #include <ranges>
 #include <stdexcept>
+#include <vector>
+
+#include "MathUtils.h"
+#include "RandomStreams.h"
+
+namespace {
+constexpr const char* CHECKPOINT_MAGIC{"MCPCKPT"};
+// 2 adds the sampling scheme, 3 the strata
+constexpr int CHECKPOINT_VERSION{3};
+// paths between stop-token checks in cancellable runs
+constexpr unsigned long CANCEL_CHECK_PATHS{16384};
+
+// doubles are stored as their bit patterns so a restore is exact
+void putBits(std::ostream& out, double x) {
+  out << ' ' << std::hex << std::bit_cast<std::uint64_t>(x) << std::dec;
+}
+
+double getBits(std::istream& in) {
+  std::uint64_t bits{0};
+  in >> std::hex >> bits >> std::dec;
+  return std::bit_cast<double>(bits);
+}
+
+// bump-and-reprice scenarios on common random numbers, in GreekSums order
+enum GreekScenario : std::size_t {
+  BASE,
+  S_UP,
+  S_DN,
+  SIG_UP,
+  SIG_DN,
+  R_UP,
+  R_DN,
+  T_DN,
+  T_UP,
+  NUM_GREEK_SCENARIOS
+};
+
+// per scenario: S_T = spot * exp(drift + vol * z), discounted by disc
+struct GreekBumps {
+  bool active{false};
+  double epsS{}, epsSig{}, epsR{}, epsT{};
+  GreekSums spot{}, drift{}, vol{}, disc{};
+
+  explicit GreekBumps(const Option& option) {
+    const double S0{option.getStockPrice()};
+    const double T{option.getTimeToMaturity()};
+    const double r{option.getRiskFreeRate()};
+    const double q{option.getDividendYield()};
+    const double sig{option.getVolatility()};
+    if (T <= 1e-12 || sig <= 1e-12) return;
+    active = true;
+
+    // bump sizes
+    epsS = std::max(S0 * 1e-4, 1e-6);
+    epsSig = std::max(sig * 1e-3, 1e-4);
+    epsR = std::max(std::abs(r) * 1e-3, 1e-5);
+    epsT = std::max(T * 1e-3, 1e-5);
+
+    const double Tdn{std::max(T - epsT, 1e-8)};
+    const double Tup{T + epsT};
+    const double sigUp{sig + epsSig};
+    const double sigDn{std::max(sig - epsSig, 1e-12)};
+    const double rUp{r + epsR};
+    const double rDn{r - epsR};
+
+    auto set = [&](GreekScenario k, double s, double rr, double sg, double t) {
+      spot[k] = s;
+      drift[k] = (rr - q - 0.5 * sg * sg) * t;
+      vol[k] = sg * std::sqrt(t);
+      disc[k] = std::exp(-rr * t);
+    };
+    set(BASE, S0, r, sig, T);
+    set(S_UP, S0 + epsS, r, sig, T);
+    set(S_DN, std::max(S0 - epsS, 1e-8), r, sig, T);
+    set(SIG_UP, S0, r, sigUp, T);
+    set(SIG_DN, S0, r, sigDn, T);
+    set(R_UP, S0, rUp, sig, T);
+    set(R_DN, S0, rDn, sig, T);
+    set(T_DN, S0, r, sig, Tdn);
+    set(T_UP, S0, r, sig, Tup);
+    // the σ bumps are discounted at the base rate, the r bumps at their own
+  }
+};
+
+void expectTag(std::istream& in, const char* tag) {
+  std::string word{};
+  if (!(in >> word) || word != tag) {
+    throw std::runtime_error(std::string{"Malformed checkpoint: expected '"} +
+                             tag + "'");
+  }
+}
+}  // namespace
 
 MonteCarlo::MonteCarlo(const Option& option, unsigned long numSimulations,
                        unsigned int seed)
@@ -11,27 +109,269 @@ MonteCarlo::MonteCarlo(const Option& option, unsigned long numSimulations,
       numSimulations{numSimulations},
       randomEngine{seed},
       standardNormal{0.0, 1.0},
-      stockPrice{option.getStockPrice()},
-      // pre-calc drift: (r - q - 0.5 σ²) * T
-      driftPerSim{(option.getRiskFreeRate() - option.getDividendYield() -
-                   0.5 * option.getVolatility() * option.getVolatility()) *
-                  option.getTimeToMaturity()},
-      // pre-calc vol * sqrt(T)
-      volTimesSqrtT{option.getVolatility() *
-                    std::sqrt(option.getTimeToMaturity())} {
+      seed{seed} {
   if (numSimulations == 0) {
     throw std::invalid_argument("Number of simulations must be positive.");
   }
-  payoffs.reserve(numSimulations);
-  normals.reserve(numSimulations);
+  if (numSimulations > maxPaths()) {
+    throw std::invalid_argument(
+        "Number of simulations exceeds the random stream period.");
+  }
+  updateConstants();
 }
 
 // delegate ctor
 MonteCarlo::MonteCarlo(const Option& option, unsigned long numSimulations)
-    : MonteCarlo(option, numSimulations, std::random_device{}()) {}
+    : MonteCarlo(option, numSimulations, std::random_device{}()) {
+  seed.reset();  // a random-device seed cannot be reproduced
+}
 
 unsigned long MonteCarlo::getNumSimulations() const { return numSimulations; }
 
+std::uint64_t MonteCarlo::maxPaths() {
+  return random_streams::stride(1) / DRAWS_PER_PATH_BOUND;
+}
+
+void MonteCarlo::updateConstants() {
+  stockPrice = option.getStockPrice();
+  // pre-calc drift: (r - q - 0.5 σ²) * T
+  driftPerSim = (option.getRiskFreeRate() - option.getDividendYield() -
+                 0.5 * option.getVolatility() * option.getVolatility()) *
+                option.getTimeToMaturity();
+  // pre-calc vol * sqrt(T)
+  volTimesSqrtT =
+      option.getVolatility() * std::sqrt(option.getTimeToMaturity());
+  importanceShift = sampling == SamplingScheme::IMPORTANCE
+                        ? fixedShift.value_or(optimalImportanceShift(option))
+                        : 0.0;
+}
+
+void MonteCarlo::setSamplingScheme(SamplingScheme scheme) {
+  if (priceCalculated) {
+    throw std::runtime_error("Sampling scheme must be set before pricing");
+  }
+  sampling = scheme;
+  updateConstants();
+}
+
+void MonteCarlo::setImportanceShift(std::optional<double> shift) {
+  if (priceCalculated) {
+    throw std::runtime_error("Sampling scheme must be set before pricing");
+  }
+  fixedShift = shift;
+  updateConstants();
+}
+
+void MonteCarlo::setStratification(unsigned strataCount,
+                                   StratumAllocation allocation) {
+  if (priceCalculated) {
+    throw std::runtime_error("Sampling scheme must be set before pricing");
+  }
+  if (strataCount == 0 || 2ul * strataCount > numSimulations) {
+    throw std::invalid_argument(
+        "Stratification needs at least 2 paths in each of 1 or more strata");
+  }
+  sampling = SamplingScheme::STRATIFIED;
+  this->strataCount = strataCount;
+  this->allocation = allocation;
+  strata.assign(strataCount, StratumStats{});
+  updateConstants();
+}
+
+std::vector<unsigned long> MonteCarlo::getStratumCounts() const {
+  std::vector<unsigned long> counts{};
+  if (sampling != SamplingScheme::STRATIFIED) return counts;
+  for (const StratumStats& s : strata) counts.push_back(s.count);
+  return counts;
+}
+
+double MonteCarlo::optimalImportanceShift(const Option& option) {
+  const double T{option.getTimeToMaturity()};
+  const double sig{option.getVolatility()};
+  if (T <= 1e-12 || sig <= 1e-12) return 0.0;
+  const bool isCall{option.getType() == OptionType::CALL};
+  const double S{option.getStockPrice()};
+  const double K{option.getStrikePrice()};
+  const double a{(option.getRiskFreeRate() - option.getDividendYield() -
+                  0.5 * sig * sig) *
+                 T};
+  const double b{sig * std::sqrt(T)};
+  if (K <= 0.0) return isCall ? b : 0.0;  // payoff S_T: shift by σ√T
+
+  // g(z) = d/dz [ln payoff(z) − z²/2]: +∞ at the strike on the call side,
+  // −∞ on the put side, and −z far from it, so one root brackets
+  const double zK{(std::log(K / S) - a) / b};
+  auto g = [&](double z) {
+    const double x{S * std::exp(a + b * z)};
+    return (isCall ? b * x / (x - K) : -b * x / (K - x)) - z;
+  };
+  double lo{zK};
+  double hi{zK};
+  if (isCall) {
+    hi = std::max(zK, 0.0) + 1.0;
+    while (g(hi) > 0.0) hi = lo + 2.0 * (hi - lo);
+  } else {
+    lo = std::min(zK, 0.0) - 1.0;
+    while (g(lo) < 0.0) lo = hi - 2.0 * (hi - lo);
+  }
+  for (int i{0}; i < 200 && hi - lo > 1e-12; ++i) {
+    const double mid{0.5 * (lo + hi)};
+    // g is positive left of the root on either side
+    if (g(mid) > 0.0) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return 0.5 * (lo + hi);
+}
+
+void MonteCarlo::reset(const Option& newOption) {
+  Pricer::reset(newOption);
+  updateConstants();
+  // clear() keeps capacity, so the next run reuses the same storage
+  payoffs.clear();
+  normals.clear();
+  seed.reset();  // the stream continues from where it was
+  sumPayoffs = 0.0;
+  payoffShift = 0.0;
+  sumShifted = 0.0;
+  sumShiftedSquares = 0.0;
+  payoffSketch.clear();
+  strata.assign(strataCount, StratumStats{});
+  pathStrata.clear();
+  strataPlan.clear();
+  bufferStart = 0;
+  pendingSimulations = 0;
+}
+
+void MonteCarlo::reset(const Option& newOption, unsigned int seed) {
+  reset(newOption);
+  randomEngine.seed(seed);
+  standardNormal.reset();
+  this->seed = seed;
+}
+
+std::optional<PriceKey> MonteCarlo::cacheKey() const {
+  if (!seed) return std::nullopt;
+  if (sampling == SamplingScheme::IMPORTANCE) {
+    return PriceKey::make(
+        PriceKey::engineId("Monte Carlo/importance"), option,
+        {static_cast<double>(numSimulations), importanceShift}, *seed);
+  }
+  if (sampling == SamplingScheme::STRATIFIED) {
+    // Neyman runs are keyed with a negative stratum count
+    const double strataKey{allocation == StratumAllocation::NEYMAN
+                               ? -static_cast<double>(strataCount)
+                               : static_cast<double>(strataCount)};
+    return PriceKey::make(PriceKey::engineId("Monte Carlo/stratified"), option,
+                          {static_cast<double>(numSimulations), strataKey},
+                          *seed);
+  }
+  return PriceKey::make(PriceKey::engineId("Monte Carlo"), option,
+                        {static_cast<double>(numSimulations), 0.0}, *seed);
+}
+
+double MonteCarlo::meanPayoff() const {
+  if (sampling != SamplingScheme::STRATIFIED) {
+    return sumPayoffs / static_cast<double>(numSimulations);
+  }
+  double mean{0.0};
+  for (const StratumStats& s : strata) {
+    if (s.count > 0) mean += s.sum / static_cast<double>(s.count);
+  }
+  return mean / static_cast<double>(strataCount);
+}
+
+double MonteCarlo::pathWeight(std::size_t index) const {
+  switch (sampling) {
+    case SamplingScheme::IMPORTANCE:
+      return std::exp(importanceShift *
+                      (0.5 * importanceShift - normals[index]));
+    case SamplingScheme::STRATIFIED:
+      return static_cast<double>(numSimulations) /
+             (static_cast<double>(strataCount) *
+              static_cast<double>(strata[pathStrata[index]].count));
+    default:
+      return 1.0;
+  }
+}
+
+void MonteCarlo::planStrata(unsigned long paths) const {
+  // Neyman: the total per stratum should follow its standard deviation;
+  // new paths go to the strata furthest below that target
+  std::vector<double> sd(strataCount, 0.0);
+  double sdTotal{0.0};
+  unsigned long done{0};
+  for (unsigned j{0}; j < strataCount; ++j) {
+    const StratumStats& s{strata[j]};
+    done += s.count;
+    if (s.count > 1) {
+      const double n{static_cast<double>(s.count)};
+      sd[j] = std::sqrt(std::max(
+          (s.sumShiftedSquares - s.sumShifted * s.sumShifted / n) / (n - 1.0),
+          0.0));
+    }
+    sdTotal += sd[j];
+  }
+  const double total{static_cast<double>(done + paths)};
+  std::vector<double> deficit(strataCount);
+  double deficitTotal{0.0};
+  for (unsigned j{0}; j < strataCount; ++j) {
+    const double target{sdTotal > 0.0 ? total * sd[j] / sdTotal
+                                      : total / strataCount};
+    deficit[j] = std::max(target - static_cast<double>(strata[j].count), 0.0);
+    deficitTotal += deficit[j];
+  }
+  std::vector<unsigned long> add(strataCount, 0);
+  unsigned long assigned{0};
+  if (deficitTotal > 0.0) {
+    for (unsigned j{0}; j < strataCount; ++j) {
+      add[j] = static_cast<unsigned long>(
+          std::floor(static_cast<double>(paths) * deficit[j] / deficitTotal));
+      assigned += add[j];
+    }
+  }
+  // remainder (rounding, or no deficit at all) cycles through the strata
+  for (unsigned j{0}; assigned < paths; j = (j + 1) % strataCount) {
+    if (deficitTotal == 0.0 || deficit[j] > 0.0) {
+      ++add[j];
+      ++assigned;
+    }
+  }
+  strataPlan.clear();
+  strataPlan.reserve(paths);
+  for (unsigned j{0}; j < strataCount; ++j) {
+    strataPlan.insert(strataPlan.end(), add[j], j);
+  }
+}
+
+bool MonteCarlo::neymanAllocated() const {
+  return sampling == SamplingScheme::STRATIFIED &&
+         allocation == StratumAllocation::NEYMAN;
+}
+
+unsigned long MonteCarlo::runPaths(unsigned long from, unsigned long to,
+                                   std::stop_token token) const {
+  if (sampling != SamplingScheme::STRATIFIED ||
+      allocation == StratumAllocation::PROPORTIONAL) {
+    return simulate(from, to, token);
+  }
+  unsigned long begin{from};
+  if (from == 0) {
+    // proportional pilot for the per-stratum standard deviations
+    const unsigned long pilot{
+        std::min(to, std::max(2ul * strataCount, to / 10))};
+    strataPlan.clear();
+    begin = simulate(0, pilot, token);
+    if (begin < pilot) return begin;
+  }
+  planStrata(to - begin);
+  const unsigned long end{simulate(begin, to, token)};
+  strataPlan.clear();
+  return end;
+}
+
 double MonteCarlo::calculatePrice() const {
   if (priceCalculated) {
     return cachedPrice;
@@ -42,187 +382,144 @@ double MonteCarlo::calculatePrice() const {
   const double discountFactor{
       std::exp(-option.getRiskFreeRate() * option.getTimeToMaturity())};
 
-  double sumPayoffs{0.0};
-  normals.resize(numSimulations);
-  payoffs.resize(numSimulations);
+  runPaths(0, numSimulations);
 
-  for (unsigned long i{0}; i < numSimulations; ++i) {
-    const double z{standardNormal(randomEngine)};
-    normals[i] = z;
-
-    const double ST{stockPrice * std::exp(driftPerSim + volTimesSqrtT * z)};
-    const double payoff{option.calculatePayoff(ST)};
-    payoffs[i] = payoff;
-    sumPayoffs += payoff;
-  }
-
-  cachedPrice =
-      (sumPayoffs / static_cast<double>(numSimulations)) * discountFactor;
+  cachedPrice = meanPayoff() * discountFactor;
   priceCalculated = true;
   lastRunDuration = std::chrono::high_resolution_clock::now() - start;
 
   return cachedPrice;
 }
 
+bool MonteCarlo::calculatePriceCancellable(std::stop_token token) {
+  if (priceCalculated) {
+    return true;
+  }
+  if (token.stop_requested()) {
+    return false;
+  }
+
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const unsigned long done{runPaths(0, numSimulations, token)};
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  // a stopped run keeps what it simulated, like a restored checkpoint
+  if (done < numSimulations && neymanAllocated()) seed.reset();
+  pendingSimulations += numSimulations - done;
+  numSimulations = done;
+  cachedPrice = meanPayoff() * std::exp(-option.getRiskFreeRate() *
+                                        option.getTimeToMaturity());
+  priceCalculated = true;
+  return pendingSimulations == 0;
+}
+
 std::string MonteCarlo::getPricingMethod() const {
   return "Monte Carlo";
 }
 
 Greeks MonteCarlo::calculateGreeks() {
   calculatePrice();  // ensure normals/payoffs are filled
+  if (bufferStart != 0 || normals.size() != numSimulations) {
+    throw std::runtime_error(
+        "Greeks need every path buffered (paths not stored or restored from "
+        "a checkpoint)");
+  }
+  return greeksFromSums(option, greekSums(), numSimulations);
+}
 
-  const double S0{option.getStockPrice()};
-  const double T{option.getTimeToMaturity()};
-  const double r{option.getRiskFreeRate()};
-  const double q{option.getDividendYield()};
-  const double sig{option.getVolatility()};
+GreekSums MonteCarlo::greekSums() const {
+  const GreekBumps bumps{option};
+  GreekSums sums{};
+  if (!bumps.active) return sums;
+  // path weights depend only on the draw, so every bumped scenario reuses
+  // the base weight
+  for (std::size_t i{0}; i < normals.size(); ++i) {
+    const double z{normals[i]};
+    const double weight{pathWeight(i)};
+    for (std::size_t k{0}; k < NUM_GREEK_SCENARIOS; ++k) {
+      const double ST{bumps.spot[k] *
+                      std::exp(bumps.drift[k] + bumps.vol[k] * z)};
+      sums[k] += weight * option.calculatePayoff(ST);
+    }
+  }
+  return sums;
+}
+
+Greeks MonteCarlo::greeksFromSums(const Option& option, const GreekSums& sums,
+                                  std::uint64_t paths) {
+  const GreekBumps bumps{option};
+  if (!bumps.active || paths == 0) return Greeks{};
+
+  const double invN{1.0 / static_cast<double>(paths)};
+  GreekSums prices{};
+  for (std::size_t k{0}; k < NUM_GREEK_SCENARIOS; ++k) {
+    prices[k] = sums[k] * bumps.disc[k] * invN;
+  }
 
-  if (T <= 1e-12 || sig <= 1e-12) return Greeks{};
-
-  // bump sizes
-  const double epsS{std::max(S0 * 1e-4, 1e-6)};
-  const double epsSig{std::max(sig * 1e-3, 1e-4)};
-  const double epsR{std::max(std::abs(r) * 1e-3, 1e-5)};
-  const double epsT{std::max(T * 1e-3, 1e-5)};
-
-  // times for theta
-  const double Tdn{std::max(T - epsT, 1e-8)};
-  const double Tup{T + epsT};
-
-  // base stuff
-  const double sqrtT{std::sqrt(T)};
-  const double drift{(r - q - 0.5 * sig * sig) * T};
-  const double volBase{sig * sqrtT};
-  const double disc{std::exp(-r * T)};
-
-  auto disc_rT = [](double rr, double TT) { return std::exp(-rr * TT); };
-
-  // bumps (S)
-  const double S_up{S0 + epsS};
-  const double S_dn{std::max(S0 - epsS, 1e-8)};
-
-  // bumps (σ)
-  const double sigUp{sig + epsSig};
-  const double sigDn{std::max(sig - epsSig, 1e-12)};
-  const double volUpSig{sigUp * sqrtT};
-  const double volDnSig{sigDn * sqrtT};
-  const double driftUpSig{(r - q - 0.5 * sigUp * sigUp) * T};
-  const double driftDnSig{(r - q - 0.5 * sigDn * sigDn) * T};
-
-  // bumps (r)
-  const double rUp{r + epsR};
-  const double rDn{r - epsR};
-  const double driftUpR{(rUp - q - 0.5 * sig * sig) * T};
-  const double driftDnR{(rDn - q - 0.5 * sig * sig) * T};
-
-  // bumps (T)
-  const double sqrtTdn{std::sqrt(Tdn)};
-  const double sqrtTup{std::sqrt(Tup)};
-  const double driftTdn{(r - q - 0.5 * sig * sig) * Tdn};
-  const double driftTup{(r - q - 0.5 * sig * sig) * Tup};
-  const double volTdn{sig * sqrtTdn};
-  const double volTup{sig * sqrtTup};
-
-  // accumulators
-  double sumBase{0}, sumSup{0}, sumSdn{0};
-  double sumSigUp{0}, sumSigDn{0};
-  double sumRup{0}, sumRdn{0};
-  double sumTdn{0}, sumTup{0};
-
-  for (unsigned long i = 0; i < numSimulations; ++i) {
-    const double z = normals[i];
-
-    const double ST = S0 * std::exp(drift + volBase * z);
-    const double ST_Su = S_up * std::exp(drift + volBase * z);
-    const double ST_Sd = S_dn * std::exp(drift + volBase * z);
-
-    const double ST_sigU = S0 * std::exp(driftUpSig + volUpSig * z);
-    const double ST_sigD = S0 * std::exp(driftDnSig + volDnSig * z);
-
-    const double ST_rU = S0 * std::exp(driftUpR + volBase * z);
-    const double ST_rD = S0 * std::exp(driftDnR + volBase * z);
-
-    const double ST_Td = S0 * std::exp(driftTdn + volTdn * z);
-    const double ST_Tu = S0 * std::exp(driftTup + volTup * z);
-
-    sumBase += option.calculatePayoff(ST);
-    sumSup += option.calculatePayoff(ST_Su);
-    sumSdn += option.calculatePayoff(ST_Sd);
-    sumSigUp += option.calculatePayoff(ST_sigU);
-    sumSigDn += option.calculatePayoff(ST_sigD);
-    sumRup += option.calculatePayoff(ST_rU);
-    sumRdn += option.calculatePayoff(ST_rD);
-    sumTdn += option.calculatePayoff(ST_Td);
-    sumTup += option.calculatePayoff(ST_Tu);
-  }
-
-  const double invN{1.0 / static_cast<double>(numSimulations)};
-  const double priceB{sumBase * disc * invN};
-  const double priceSu{sumSup * disc * invN};
-  const double priceSd{sumSdn * disc * invN};
-  const double priceSigU{sumSigUp * disc * invN};
-  const double priceSigD{sumSigDn * disc * invN};
-
-  const double discUpR{disc_rT(rUp, T)};
-  const double discDnR{disc_rT(rDn, T)};
-  const double priceRu{sumRup * discUpR * invN};
-  const double priceRd{sumRdn * discDnR * invN};
-
-  const double discTd{disc_rT(r, Tdn)};
-  const double discTu{disc_rT(r, Tup)};
-  const double priceTd{sumTdn * discTd * invN};
-  const double priceTu{sumTup * discTu * invN};
-
-  const double delta = (priceSu - priceSd) / (2.0 * epsS);
-  const double gamma = (priceSu - 2.0 * priceB + priceSd) / (epsS * epsS);
-  const double vega = (priceSigU - priceSigD) / (2.0 * epsSig);
-  const double rho = (priceRu - priceRd) / (2.0 * epsR);
-  const double theta = (priceTd - priceTu) / (2.0 * epsT);  // matches BS sign
+  const double delta = (prices[S_UP] - prices[S_DN]) / (2.0 * bumps.epsS);
+  const double gamma = (prices[S_UP] - 2.0 * prices[BASE] + prices[S_DN]) /
+                       (bumps.epsS * bumps.epsS);
+  const double vega =
+      (prices[SIG_UP] - prices[SIG_DN]) / (2.0 * bumps.epsSig);
+  const double rho = (prices[R_UP] - prices[R_DN]) / (2.0 * bumps.epsR);
+  const double theta =
+      (prices[T_DN] - prices[T_UP]) / (2.0 * bumps.epsT);  // matches BS sign
 
   return Greeks{delta, gamma, theta, vega, rho};
 }
 
-std::pair<double, double> MonteCarlo::getConfidenceInterval(
-    double confidenceLevel) {
+MonteCarloPartial MonteCarlo::getPartial(bool withGreeks) const {
   validatePriceCalculated();
-
-  if (confidenceLevel <= 0.0 || confidenceLevel >= 1.0) {
-    throw std::invalid_argument("Confidence level must be between 0 and 1");
+  if (sampling == SamplingScheme::STRATIFIED) {
+    throw std::runtime_error("Stratified runs do not form mergeable partials");
   }
+  MonteCarloPartial partial{};
+  partial.paths = numSimulations;
+  partial.sumPayoffs = sumPayoffs;
+  const double n{static_cast<double>(numSimulations)};
+  partial.meanPayoff = payoffShift + sumShifted / n;
+  partial.sumSquaredDeviations =
+      sumShiftedSquares - sumShifted * sumShifted / n;
+  partial.sketch = payoffSketch;
+  if (withGreeks) {
+    if (bufferStart != 0 || normals.size() != numSimulations) {
+      throw std::runtime_error("Greek sums need every path buffered");
+    }
+    partial.hasGreeks = true;
+    partial.greekSums = greekSums();
+  }
+  return partial;
+}
 
-  double zScore{};
-  if (confidenceLevel >= 0.99)
-    zScore = 2.576;
-  else if (confidenceLevel >= 0.95)
-    zScore = 1.96;
-  else if (confidenceLevel >= 0.90)
-    zScore = 1.645;
-  else
-    zScore = 1.282;
-
-  const double marginOfError{zScore * getStandardError()};
-  return {cachedPrice - marginOfError, cachedPrice + marginOfError};
+std::pair<double, double> MonteCarlo::getConfidenceInterval(
+    double confidenceLevel) {
+  validatePriceCalculated();
+  return math::confidence_interval(cachedPrice, getStandardError(),
+                                   confidenceLevel);
 }
 
 double MonteCarlo::getStandardError() {
   validatePriceCalculated();
 
-  double mean{0.0};
-  for (double p : payoffs) {
-    mean += p;
-  }
-  mean /= static_cast<double>(payoffs.size());
-
-  double variance{0.0};
-  for (double p : payoffs) {
-    const double diff{p - mean};
-    variance += diff * diff;
-  }
-  variance /= static_cast<double>(payoffs.size() - 1);
-
   const double disc{
       std::exp(-option.getRiskFreeRate() * option.getTimeToMaturity())};
-  return disc * std::sqrt(variance / static_cast<double>(payoffs.size()));
+
+  // moments about the first payoff avoid cancellation in sum² - (sum)²/n
+  if (sampling == SamplingScheme::STRATIFIED) {
+    // Var = Σ_j s_j² / (J² n_j)
+    double varianceOfMean{0.0};
+    for (const StratumStats& s : strata) {
+      if (s.count < 2) continue;
+      const double n{static_cast<double>(s.count)};
+      const double variance{
+          (s.sumShiftedSquares - s.sumShifted * s.sumShifted / n) / (n - 1.0)};
+      varianceOfMean += std::max(variance, 0.0) / n;
+    }
+    return disc * std::sqrt(varianceOfMean) / static_cast<double>(strataCount);
+  }
+  const double n{static_cast<double>(numSimulations)};
+  const double variance{
+      (sumShiftedSquares - sumShifted * sumShifted / n) / (n - 1.0)};
+  return disc * std::sqrt(std::max(variance, 0.0) / n);
 }
 
 double MonteCarlo::calculateVaR(double confidenceLevel) {
@@ -231,7 +528,33 @@ double MonteCarlo::calculateVaR(double confidenceLevel) {
     throw std::invalid_argument("confidenceLevel must be in (0,1)");
   }
 
-  std::vector<double> sortedPayoffs{payoffs};
+  const bool buffered{bufferStart == 0 && payoffs.size() == numSimulations};
+  if (sampling != SamplingScheme::PLAIN) {
+    if (!buffered) {
+      throw std::runtime_error("Weighted VaR needs every path buffered");
+    }
+    // weighted quantile: first payoff whose cumulative path weight passes
+    // the level; the index scratch comes from the thread's buffer pool
+    std::vector<std::size_t, PoolAllocator<std::size_t>> order(
+        payoffs.size());
+    for (std::size_t i{0}; i < order.size(); ++i) order[i] = i;
+    std::ranges::sort(order, {}, [&](std::size_t i) { return payoffs[i]; });
+    double total{0.0};
+    for (std::size_t i{0}; i < payoffs.size(); ++i) total += pathWeight(i);
+    double seen{0.0};
+    for (const std::size_t i : order) {
+      seen += pathWeight(i);
+      if (seen > confidenceLevel * total) return payoffs[i];
+    }
+    return payoffs[order.back()];
+  }
+
+  if (!buffered) {
+    return payoffSketch.quantile(confidenceLevel);
+  }
+
+  // scratch copy comes from the thread's buffer pool, not a fresh malloc
+  SimBuffer sortedPayoffs{payoffs};
   const std::size_t idx{
       static_cast<std::size_t>(confidenceLevel * sortedPayoffs.size())};
 
@@ -241,33 +564,24 @@ double MonteCarlo::calculateVaR(double confidenceLevel) {
 
 double MonteCarlo::runMoreSimulations(unsigned long additionalSimulations) {
   validatePriceCalculated();
+  if (additionalSimulations > maxPaths() - numSimulations) {
+    throw std::invalid_argument(
+        "Total simulations would exceed the random stream period.");
+  }
 
   const unsigned long oldNum{numSimulations};
   const double discountFactor{
       std::exp(-option.getRiskFreeRate() * option.getTimeToMaturity())};
 
-  const double oldSumUndisc{cachedPrice * oldNum / discountFactor};
-
   numSimulations += additionalSimulations;
+  pendingSimulations -= std::min(pendingSimulations, additionalSimulations);
+  if (neymanAllocated()) seed.reset();
 
   const auto start{std::chrono::high_resolution_clock::now()};
 
-  payoffs.resize(numSimulations);
-  normals.resize(numSimulations);
+  runPaths(oldNum, numSimulations);
 
-  double newSumUndisc{0.0};
-  for (unsigned long i{oldNum}; i < numSimulations; ++i) {
-    const double z{standardNormal(randomEngine)};
-    normals[i] = z;
-    const double ST{stockPrice * std::exp(driftPerSim + volTimesSqrtT * z)};
-    const double payoff{option.calculatePayoff(ST)};
-    payoffs[i] = payoff;
-    newSumUndisc += payoff;
-  }
-
-  cachedPrice =
-      ((oldSumUndisc + newSumUndisc) / static_cast<double>(numSimulations)) *
-      discountFactor;
+  cachedPrice = meanPayoff() * discountFactor;
 
   lastRunDuration = std::chrono::high_resolution_clock::now() - start;
   return cachedPrice;
@@ -278,4 +592,300 @@ void MonteCarlo::validatePriceCalculated() const {
     throw std::runtime_error(
         "Price must be calculated first. Call calculatePrice()");
   }
-}
\ No newline at end of file
+}
+unsigned long MonteCarlo::simulate(unsigned long from, unsigned long to,
+                                   std::stop_token token) const {
+  const bool stratified{sampling == SamplingScheme::STRATIFIED};
+  if (storePaths) {
+    normals.resize(to - bufferStart);
+    payoffs.resize(to - bufferStart);
+    if (stratified) pathStrata.resize(to - bufferStart);
+  }
+  const unsigned long target{numSimulations + pendingSimulations};
+  const bool cancellable{token.stop_possible()};
+  unsigned long nextCheckpoint{checkpointEvery > 0 ? from + checkpointEvery
+                                                   : to};
+
+  for (unsigned long begin{from}; begin < to;) {
+    unsigned long end{std::min(to, nextCheckpoint)};
+    if (cancellable) end = std::min(end, begin + CANCEL_CHECK_PATHS);
+
+    // one sequential pass; the sums continue exactly across calls
+    double sum{sumPayoffs};
+    double shift{payoffShift};
+    double sum1{sumShifted};
+    double sum2{sumShiftedSquares};
+    const bool weighted{sampling == SamplingScheme::IMPORTANCE};
+    const double theta{importanceShift};
+    for (unsigned long i{begin}; i < end; ++i) {
+      double z{};
+      double weight{1.0};
+      std::uint32_t stratum{0};
+      if (stratified) {
+        stratum = strataPlan.empty()
+                      ? static_cast<std::uint32_t>(i % strataCount)
+                      : strataPlan[i - from];
+        const double u{(stratum + random_streams::toUniform(randomEngine())) /
+                       strataCount};
+        z = math::norm_inv(u);
+      } else {
+        z = standardNormal(randomEngine);
+      }
+      if (weighted) {
+        z += theta;
+        weight = std::exp(theta * (0.5 * theta - z));
+      }
+      const double ST{stockPrice * std::exp(driftPerSim + volTimesSqrtT * z)};
+      const double payoff{option.calculatePayoff(ST)};
+      if (stratified) {
+        StratumStats& s{strata[stratum]};
+        if (s.count == 0) s.shift = payoff;
+        ++s.count;
+        s.sum += payoff;
+        const double ds{payoff - s.shift};
+        s.sumShifted += ds;
+        s.sumShiftedSquares += ds * ds;
+      }
+      // moments are over the weighted payoffs, the sketch over raw ones
+      const double y{weight * payoff};
+      if (i == 0) shift = y;
+      sum += y;
+      const double d{y - shift};
+      sum1 += d;
+      sum2 += d * d;
+      if (sampling == SamplingScheme::PLAIN) payoffSketch.add(payoff);
+      if (storePaths) {
+        normals[i - bufferStart] = z;
+        payoffs[i - bufferStart] = payoff;
+        if (stratified) pathStrata[i - bufferStart] = stratum;
+      }
+    }
+    sumPayoffs = sum;
+    payoffShift = shift;
+    sumShifted = sum1;
+    sumShiftedSquares = sum2;
+
+    if (checkpointEvery > 0 && (end == nextCheckpoint || end == to)) {
+      writeCheckpointFile(checkpointPath, end, target);
+      nextCheckpoint += checkpointEvery;
+    }
+    begin = end;
+    if (cancellable && begin < to && token.stop_requested()) {
+      if (storePaths) {
+        normals.resize(begin - bufferStart);
+        payoffs.resize(begin - bufferStart);
+        if (stratified) pathStrata.resize(begin - bufferStart);
+      }
+      return begin;
+    }
+  }
+  return to;
+}
+
+void MonteCarlo::setCheckpointing(const std::string& path,
+                                  unsigned long everyPaths) {
+  if (everyPaths > 0 && path.empty()) {
+    throw std::invalid_argument("Checkpoint path must not be empty.");
+  }
+  checkpointPath = path;
+  checkpointEvery = everyPaths;
+}
+
+void MonteCarlo::saveCheckpoint(std::ostream& out) const {
+  if (priceCalculated) {
+    writeCheckpoint(out, numSimulations, numSimulations + pendingSimulations);
+  } else {
+    writeCheckpoint(out, 0, numSimulations);
+  }
+}
+
+void MonteCarlo::saveCheckpoint(const std::string& path) const {
+  if (priceCalculated) {
+    writeCheckpointFile(path, numSimulations,
+                        numSimulations + pendingSimulations);
+  } else {
+    writeCheckpointFile(path, 0, numSimulations);
+  }
+}
+
+void MonteCarlo::writeCheckpoint(std::ostream& out, unsigned long completed,
+                                 unsigned long target) const {
+  out << CHECKPOINT_MAGIC << ' ' << CHECKPOINT_VERSION << '\n';
+  out << "option " << static_cast<int>(option.getType());
+  for (const double x :
+       {option.getStockPrice(), option.getStrikePrice(),
+        option.getTimeToMaturity(), option.getRiskFreeRate(),
+        option.getVolatility(), option.getDividendYield()}) {
+    putBits(out, x);
+  }
+  out << "\npaths " << completed << ' ' << target << '\n';
+  out << "seed ";
+  if (seed) {
+    out << *seed;
+  } else {
+    out << '-';
+  }
+  out << "\nstore " << (storePaths ? 1 : 0) << '\n';
+  out << "sampling " << static_cast<int>(sampling) << ' '
+      << (fixedShift ? 1 : 0);
+  putBits(out, importanceShift);
+  out << "\nstrata " << strataCount << ' ' << static_cast<int>(allocation);
+  for (const StratumStats& st : strata) {
+    out << ' ' << st.count;
+    for (const double x :
+         {st.sum, st.shift, st.sumShifted, st.sumShiftedSquares}) {
+      putBits(out, x);
+    }
+  }
+  out << '\n';
+  out << "engine " << randomEngine << '\n';
+  out << "normal " << standardNormal << '\n';
+  out << "sums";
+  for (const double x :
+       {sumPayoffs, payoffShift, sumShifted, sumShiftedSquares}) {
+    putBits(out, x);
+  }
+  out << '\n';
+  payoffSketch.save(out);
+}
+
+void MonteCarlo::writeCheckpointFile(const std::string& path,
+                                     unsigned long completed,
+                                     unsigned long target) const {
+  // write a temporary, then rename over the old checkpoint (atomic on POSIX)
+  const std::string tmp{path + ".tmp"};
+  {
+    std::ofstream out{tmp, std::ios::trunc};
+    if (!out) {
+      throw std::runtime_error("Cannot write checkpoint " + tmp);
+    }
+    writeCheckpoint(out, completed, target);
+    if (!out.flush()) {
+      throw std::runtime_error("Failed writing checkpoint " + tmp);
+    }
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    throw std::runtime_error("Cannot replace checkpoint " + path);
+  }
+}
+
+MonteCarlo MonteCarlo::restoreCheckpoint(std::istream& in) {
+  std::string magic{};
+  int version{0};
+  if (!(in >> magic >> version) || magic != CHECKPOINT_MAGIC) {
+    throw std::runtime_error("Not a Monte Carlo checkpoint");
+  }
+  if (version < 1 || version > CHECKPOINT_VERSION) {
+    throw std::runtime_error("Unsupported checkpoint version " +
+                             std::to_string(version));
+  }
+
+  expectTag(in, "option");
+  int type{0};
+  in >> type;
+  double params[6]{};
+  for (double& x : params) x = getBits(in);
+  expectTag(in, "paths");
+  unsigned long completed{0};
+  unsigned long target{0};
+  in >> completed >> target;
+  expectTag(in, "seed");
+  std::string seedText{};
+  in >> seedText;
+  expectTag(in, "store");
+  int store{1};
+  in >> store;
+  int scheme{0};
+  int fixed{0};
+  double shift{0.0};
+  if (version >= 2) {
+    expectTag(in, "sampling");
+    in >> scheme >> fixed;
+    shift = getBits(in);
+  }
+  unsigned strataCount{0};
+  int allocation{0};
+  std::vector<StratumStats> strata{};
+  if (version >= 3) {
+    expectTag(in, "strata");
+    in >> strataCount >> allocation;
+    if (!in || strataCount > (1u << 24)) {
+      throw std::runtime_error("Malformed checkpoint strata");
+    }
+    strata.resize(strataCount);
+    for (StratumStats& st : strata) {
+      in >> st.count;
+      st.sum = getBits(in);
+      st.shift = getBits(in);
+      st.sumShifted = getBits(in);
+      st.sumShiftedSquares = getBits(in);
+    }
+  }
+  if (!in || (type != 0 && type != 1) || scheme < 0 || scheme > 2 ||
+      (scheme == 2) != (strataCount > 0) || allocation < 0 ||
+      allocation > 1 || target == 0 || completed > target) {
+    throw std::runtime_error("Malformed checkpoint header");
+  }
+  if (target > maxPaths()) {
+    throw std::runtime_error(
+        "Checkpoint path count exceeds the random stream period");
+  }
+
+  std::optional<Option> option{};
+  try {
+    option.emplace(static_cast<OptionType>(type), params[0], params[1],
+                   params[2], params[3], params[4], params[5]);
+  } catch (const std::invalid_argument& e) {
+    throw std::runtime_error(std::string{"Malformed checkpoint option: "} +
+                             e.what());
+  }
+  const std::optional<unsigned int> seed{
+      seedText == "-" ? std::nullopt
+                      : std::optional{static_cast<unsigned int>(
+                            std::stoul(seedText))}};
+
+  MonteCarlo mc{*option, completed > 0 ? completed : target, seed.value_or(0)};
+  mc.seed = seed;
+  mc.storePaths = store != 0;
+  mc.sampling = static_cast<SamplingScheme>(scheme);
+  if (fixed != 0) mc.fixedShift = shift;
+  mc.importanceShift = shift;
+  mc.strataCount = strataCount;
+  mc.allocation = static_cast<StratumAllocation>(allocation);
+  mc.strata = std::move(strata);
+  // the <random> extractors do not skip leading whitespace themselves
+  expectTag(in, "engine");
+  in >> std::ws >> mc.randomEngine;
+  expectTag(in, "normal");
+  in >> std::ws >> mc.standardNormal;
+  expectTag(in, "sums");
+  mc.sumPayoffs = getBits(in);
+  mc.payoffShift = getBits(in);
+  mc.sumShifted = getBits(in);
+  mc.sumShiftedSquares = getBits(in);
+  if (!in) {
+    throw std::runtime_error("Malformed checkpoint state");
+  }
+  mc.payoffSketch = QuantileSketch::load(in);
+
+  if (completed > 0) {
+    // paths before this point are summarised, not buffered
+    mc.bufferStart = completed;
+    if (mc.neymanAllocated()) mc.seed.reset();
+    mc.pendingSimulations = target - completed;
+    mc.cachedPrice = mc.meanPayoff() *
+                     std::exp(-mc.option.getRiskFreeRate() *
+                              mc.option.getTimeToMaturity());
+    mc.priceCalculated = true;
+  }
+  return mc;
+}
+
+MonteCarlo MonteCarlo::restoreCheckpoint(const std::string& path) {
+  std::ifstream in{path};
+  if (!in) {
+    throw std::runtime_error("Cannot open checkpoint " + path);
+  }
+  return restoreCheckpoint(in);
+}
@@ -0,0 +1,113 @@
+#include "MonteCarloPartial.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "MonteCarlo.h"
+
+namespace {
+void putBits(std::ostream& out, double x) {
+  out << ' ' << std::hex << std::bit_cast<std::uint64_t>(x) << std::dec;
+}
+
+double getBits(std::istream& in) {
+  std::uint64_t bits{0};
+  in >> std::hex >> bits >> std::dec;
+  return std::bit_cast<double>(bits);
+}
+
+double discount(const Option& option) {
+  return std::exp(-option.getRiskFreeRate() * option.getTimeToMaturity());
+}
+}  // namespace
+
+void MonteCarloPartial::merge(const MonteCarloPartial& other) {
+  if (other.paths == 0) return;
+  if (paths == 0) {
+    *this = other;
+    return;
+  }
+  if (hasGreeks != other.hasGreeks) {
+    throw std::invalid_argument(
+        "Cannot merge partials with and without Greek sums");
+  }
+  sketch.merge(other.sketch);
+
+  // Chan et al. pairwise update of mean and squared deviations
+  const double nA{static_cast<double>(paths)};
+  const double nB{static_cast<double>(other.paths)};
+  const double n{nA + nB};
+  const double delta{other.meanPayoff - meanPayoff};
+  meanPayoff += delta * nB / n;
+  sumSquaredDeviations +=
+      other.sumSquaredDeviations + delta * delta * nA * nB / n;
+  sumPayoffs += other.sumPayoffs;
+  paths += other.paths;
+  for (std::size_t k{0}; k < greekSums.size(); ++k) {
+    greekSums[k] += other.greekSums[k];
+  }
+}
+
+double MonteCarloPartial::price(const Option& option) const {
+  if (paths == 0) {
+    throw std::runtime_error("Partial result has no paths");
+  }
+  return (sumPayoffs / static_cast<double>(paths)) * discount(option);
+}
+
+double MonteCarloPartial::standardError(const Option& option) const {
+  if (paths < 2) {
+    throw std::runtime_error("Standard error needs at least two paths");
+  }
+  const double n{static_cast<double>(paths)};
+  const double variance{sumSquaredDeviations / (n - 1.0)};
+  return discount(option) * std::sqrt(std::max(variance, 0.0) / n);
+}
+
+Greeks MonteCarloPartial::greeks(const Option& option) const {
+  if (!hasGreeks) {
+    throw std::runtime_error("Partial result has no Greek sums");
+  }
+  return MonteCarlo::greeksFromSums(option, greekSums, paths);
+}
+
+void MonteCarloPartial::save(std::ostream& out) const {
+  out << "partial " << paths;
+  for (const double x : {sumPayoffs, meanPayoff, sumSquaredDeviations}) {
+    putBits(out, x);
+  }
+  out << ' ' << (hasGreeks ? 1 : 0);
+  if (hasGreeks) {
+    for (const double x : greekSums) putBits(out, x);
+  }
+  out << '\n';
+  sketch.save(out);
+}
+
+MonteCarloPartial MonteCarloPartial::load(std::istream& in) {
+  MonteCarloPartial partial{};
+  std::string tag{};
+  int greeks{0};
+  if (!(in >> tag) || tag != "partial") {
+    throw std::runtime_error("Malformed partial result");
+  }
+  in >> partial.paths;
+  partial.sumPayoffs = getBits(in);
+  partial.meanPayoff = getBits(in);
+  partial.sumSquaredDeviations = getBits(in);
+  in >> greeks;
+  partial.hasGreeks = greeks != 0;
+  if (partial.hasGreeks) {
+    for (double& x : partial.greekSums) x = getBits(in);
+  }
+  if (!in) {
+    throw std::runtime_error("Malformed partial result");
+  }
+  partial.sketch = QuantileSketch::load(in);
+  return partial;
+}
@@ -0,0 +1,338 @@
+#include "MultiAssetMonteCarlo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "MathUtils.h"
+#include "Parallel.h"
+#include "RandomStreams.h"
+
+namespace {
+/**
+ * @brief Factors a symmetric matrix as L·Lᵀ.
+ *
+ * @return false if a pivot is not safely positive.
+ */
+bool choleskyFactor(const std::vector<double>& a, std::size_t n,
+                    std::vector<double>& L) {
+  L.assign(n * n, 0.0);
+  for (std::size_t i{0}; i < n; ++i) {
+    for (std::size_t j{0}; j <= i; ++j) {
+      double s{a[i * n + j]};
+      for (std::size_t k{0}; k < j; ++k) s -= L[i * n + k] * L[j * n + k];
+      if (i == j) {
+        if (!(s > 1e-12)) return false;
+        L[i * n + i] = std::sqrt(s);
+      } else {
+        L[i * n + j] = s / L[j * n + j];
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Diagonalizes a symmetric matrix by cyclic Jacobi rotations.
+ *
+ * @param a the matrix (destroyed; its diagonal ends up holding the
+ * eigenvalues).
+ * @param v receives the eigenvectors as columns.
+ */
+void jacobiEigen(std::vector<double>& a, std::size_t n,
+                 std::vector<double>& v) {
+  v.assign(n * n, 0.0);
+  for (std::size_t i{0}; i < n; ++i) v[i * n + i] = 1.0;
+  for (int sweep{0}; sweep < 100; ++sweep) {
+    double off{0.0};
+    for (std::size_t p{0}; p < n; ++p) {
+      for (std::size_t q{p + 1}; q < n; ++q) {
+        off += a[p * n + q] * a[p * n + q];
+      }
+    }
+    if (off < 1e-30) return;
+    for (std::size_t p{0}; p < n; ++p) {
+      for (std::size_t q{p + 1}; q < n; ++q) {
+        const double apq{a[p * n + q]};
+        if (std::abs(apq) < 1e-300) continue;
+        const double theta{(a[q * n + q] - a[p * n + p]) / (2.0 * apq)};
+        const double t{(theta >= 0.0 ? 1.0 : -1.0) /
+                       (std::abs(theta) + std::sqrt(theta * theta + 1.0))};
+        const double c{1.0 / std::sqrt(t * t + 1.0)};
+        const double s{t * c};
+        for (std::size_t k{0}; k < n; ++k) {  // columns p, q
+          const double akp{a[k * n + p]};
+          const double akq{a[k * n + q]};
+          a[k * n + p] = c * akp - s * akq;
+          a[k * n + q] = s * akp + c * akq;
+        }
+        for (std::size_t k{0}; k < n; ++k) {  // rows p, q
+          const double apk{a[p * n + k]};
+          const double aqk{a[q * n + k]};
+          a[p * n + k] = c * apk - s * aqk;
+          a[q * n + k] = s * apk + c * aqk;
+        }
+        for (std::size_t k{0}; k < n; ++k) {
+          const double vkp{v[k * n + p]};
+          const double vkq{v[k * n + q]};
+          v[k * n + p] = c * vkp - s * vkq;
+          v[k * n + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+}
+}  // namespace
+
+void BasketOption::validate() const {
+  const std::size_t n{assets.size()};
+  if (n == 0) {
+    throw std::invalid_argument("A basket option needs at least one asset");
+  }
+  if (weights.size() != n || correlation.size() != n * n) {
+    throw std::invalid_argument(
+        "Weights and correlation must match the asset count");
+  }
+  if (payoff == BasketPayoff::SPREAD && n != 2) {
+    throw std::invalid_argument("A spread option needs exactly two assets");
+  }
+  if (strike < 0.0 || maturity < 0.0) {
+    throw std::invalid_argument("Strike and maturity must be non-negative");
+  }
+  for (const Asset& asset : assets) {
+    if (!(asset.spot > 0.0) || !(asset.volatility > 0.0)) {
+      throw std::invalid_argument("Spots and volatilities must be positive");
+    }
+  }
+  for (std::size_t i{0}; i < n; ++i) {
+    if (std::abs(correlation[i * n + i] - 1.0) > 1e-12) {
+      throw std::invalid_argument("Correlation diagonal must be 1");
+    }
+    for (std::size_t j{0}; j < i; ++j) {
+      const double rho{correlation[i * n + j]};
+      if (std::abs(rho - correlation[j * n + i]) > 1e-12 ||
+          !(std::abs(rho) <= 1.0)) {
+        throw std::invalid_argument(
+            "Correlation must be symmetric with entries in [-1, 1]");
+      }
+    }
+  }
+}
+
+std::vector<double> MultiAssetMonteCarlo::repairCorrelation(
+    std::vector<double> matrix, std::size_t n, double floor) {
+  std::vector<double> vectors{};
+  jacobiEigen(matrix, n, vectors);
+  std::vector<double> lambda(n);
+  for (std::size_t i{0}; i < n; ++i) {
+    lambda[i] = std::max(matrix[i * n + i], floor);
+  }
+  std::vector<double> repaired(n * n, 0.0);
+  for (std::size_t i{0}; i < n; ++i) {
+    for (std::size_t j{0}; j <= i; ++j) {
+      double s{0.0};
+      for (std::size_t k{0}; k < n; ++k) {
+        s += vectors[i * n + k] * lambda[k] * vectors[j * n + k];
+      }
+      repaired[i * n + j] = s;
+      repaired[j * n + i] = s;
+    }
+  }
+  std::vector<double> scale(n);
+  for (std::size_t i{0}; i < n; ++i) {
+    scale[i] = 1.0 / std::sqrt(repaired[i * n + i]);
+  }
+  for (std::size_t i{0}; i < n; ++i) {
+    for (std::size_t j{0}; j < n; ++j) {
+      repaired[i * n + j] =
+          i == j ? 1.0 : repaired[i * n + j] * scale[i] * scale[j];
+    }
+  }
+  return repaired;
+}
+
+MultiAssetMonteCarlo::MultiAssetMonteCarlo(BasketOption option, Config config)
+    : option{std::move(option)}, config{config} {
+  this->option.validate();
+  const std::size_t n{this->option.assets.size()};
+  // LHS takes one more draw per value for the permutation
+  layout = random_streams::BlockLayout{config.paths, config.blockPaths,
+                                       n * (config.latinHypercube ? 2 : 1)};
+  if (config.latinHypercube && layout.count() < 2) {
+    throw std::invalid_argument(
+        "Latin hypercube sampling needs at least two blocks for its error");
+  }
+  if (!choleskyFactor(this->option.correlation, n, cholesky)) {
+    repaired = true;
+    if (!choleskyFactor(repairCorrelation(this->option.correlation, n), n,
+                        cholesky)) {
+      throw std::invalid_argument("Correlation matrix could not be repaired");
+    }
+  }
+}
+
+MultiAssetMonteCarlo::Estimate MultiAssetMonteCarlo::run(
+    const std::vector<double>& spots) const {
+  const std::size_t n{option.assets.size()};
+  const double T{option.maturity};
+  const double r{option.riskFreeRate};
+  const double K{option.strike};
+  const bool isCall{option.type == OptionType::CALL};
+  const BasketPayoff kind{option.payoff};
+
+  // per-asset constants: log-spot mean and σ√T; spreads short asset 1
+  std::vector<double> mean(n), volSqrtT(n), weight(n);
+  for (std::size_t i{0}; i < n; ++i) {
+    const Asset& a{option.assets[i]};
+    mean[i] = std::log(spots[i]) +
+              (r - a.dividendYield - 0.5 * a.volatility * a.volatility) * T;
+    volSqrtT[i] = a.volatility * std::sqrt(T);
+    weight[i] = kind == BasketPayoff::SPREAD && i == 1 ? -option.weights[i]
+                                                       : option.weights[i];
+  }
+  const double start{kind == BasketPayoff::BEST_OF
+                         ? -std::numeric_limits<double>::infinity()
+                     : kind == BasketPayoff::WORST_OF
+                         ? std::numeric_limits<double>::infinity()
+                         : 0.0};
+
+  const std::size_t blockCount{layout.count()};
+  std::vector<math::SampleMoments> blocks(blockCount);
+
+  parallel::forEachIndex(
+      blockCount,
+      [&](std::size_t b) {
+        const std::size_t size{layout.size(b)};
+        random_streams::Engine engine{layout.seed(config.seed, b)};
+        // n × size normals, one row per asset
+        std::vector<double> z(n * size);
+        if (config.latinHypercube) {
+          // one uniform per cell, cells shuffled independently per asset
+          std::vector<std::size_t> cell(size);
+          for (std::size_t i{0}; i < n; ++i) {
+            for (std::size_t p{0}; p < size; ++p) cell[p] = p;
+            for (std::size_t p{size}; p-- > 1;) {
+              std::swap(cell[p], cell[engine() % (p + 1)]);
+            }
+            double* zi{z.data() + i * size};
+            for (std::size_t p{0}; p < size; ++p) {
+              zi[p] = (static_cast<double>(cell[p]) +
+                       random_streams::toUniform(engine())) /
+                      static_cast<double>(size);
+            }
+          }
+        } else {
+          for (double& x : z) x = random_streams::toUniform(engine());
+        }
+        for (double& x : z) x = math::norm_inv(x);
+
+        // W = L·Z in place: row i needs only rows j ≤ i, so go bottom-up
+        for (std::size_t i{n}; i-- > 0;) {
+          double* wi{z.data() + i * size};
+          const double lii{cholesky[i * n + i]};
+          for (std::size_t p{0}; p < size; ++p) wi[p] *= lii;
+          for (std::size_t j{0}; j < i; ++j) {
+            const double lij{cholesky[i * n + j]};
+            if (lij == 0.0) continue;
+            const double* zj{z.data() + j * size};
+            for (std::size_t p{0}; p < size; ++p) wi[p] += lij * zj[p];
+          }
+        }
+
+        std::vector<double> value(size, start);
+        for (std::size_t i{0}; i < n; ++i) {
+          const double* wi{z.data() + i * size};
+          for (std::size_t p{0}; p < size; ++p) {
+            const double s{weight[i] *
+                           std::exp(mean[i] + volSqrtT[i] * wi[p])};
+            switch (kind) {
+              case BasketPayoff::BEST_OF:
+                value[p] = std::max(value[p], s);
+                break;
+              case BasketPayoff::WORST_OF:
+                value[p] = std::min(value[p], s);
+                break;
+              default:
+                value[p] += s;
+            }
+          }
+        }
+
+        math::ShiftedSums sums{};
+        for (std::size_t p{0}; p < size; ++p) {
+          sums.add(std::max(isCall ? value[p] - K : K - value[p], 0.0));
+        }
+        blocks[b] = sums.moments();
+      },
+      config.threads);
+
+  const math::SampleMoments payoff{math::merge_blocks(blocks)};
+  const double df{std::exp(-r * T)};
+  if (config.latinHypercube) {
+    // variance of the mean from the independent block means, weighted by
+    // block size
+    double spread{0.0};
+    for (const math::SampleMoments& block : blocks) {
+      const double weight{block.count / payoff.count};
+      const double deviation{block.mean - payoff.mean};
+      spread += weight * weight * deviation * deviation;
+    }
+    const double B{static_cast<double>(blockCount)};
+    return {df * payoff.mean, df * std::sqrt(spread * B / (B - 1.0))};
+  }
+  return {df * payoff.mean, df * payoff.standardError()};
+}
+
+double MultiAssetMonteCarlo::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  std::vector<double> spots{};
+  for (const Asset& asset : option.assets) spots.push_back(asset.spot);
+  const Estimate estimate{run(spots)};
+  cachedPrice = estimate.price;
+  standardError = estimate.standardError;
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+std::vector<double> MultiAssetMonteCarlo::calculateDeltas() const {
+  std::vector<double> spots{};
+  for (const Asset& asset : option.assets) spots.push_back(asset.spot);
+  std::vector<double> deltas(spots.size());
+  // common random numbers: every bumped run reuses the same substreams
+  for (std::size_t i{0}; i < spots.size(); ++i) {
+    const double S{spots[i]};
+    const double eps{S * 0.01};
+    spots[i] = S + eps;
+    const double up{run(spots).price};
+    spots[i] = S - eps;
+    const double dn{run(spots).price};
+    spots[i] = S;
+    deltas[i] = (up - dn) / (2.0 * eps);
+  }
+  return deltas;
+}
+
+double MultiAssetMonteCarlo::getStandardError() const {
+  validatePriceCalculated();
+  return standardError;
+}
+
+std::pair<double, double> MultiAssetMonteCarlo::getConfidenceInterval(
+    double confidenceLevel) const {
+  validatePriceCalculated();
+  return math::confidence_interval(cachedPrice, standardError,
+                                   confidenceLevel);
+}
+
+void MultiAssetMonteCarlo::validatePriceCalculated() const {
+  if (!priceCalculated) {
+    throw std::runtime_error(
+        "Price must be calculated first. Call calculatePrice()");
+  }
+}
@@ -0,0 +1,427 @@
+#include "MultilevelMonteCarlo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "MathUtils.h"
+#include "Parallel.h"
+#include "RandomStreams.h"
+
+namespace {
+using random_streams::toUniform;
+
+/**
+ * @brief One Milstein step of GBM.
+ */
+inline double milstein(double s, double dW, double h, double mu,
+                       double sigma) {
+  return s * (1.0 + mu * h + sigma * dW + 0.5 * sigma * sigma * (dW * dW - h));
+}
+
+/**
+ * @brief Probability that a Brownian bridge from s0 to s1 over a step of
+ * variance vol²·h does not touch the barrier.
+ */
+inline double survival(double s0, double s1, double vol, double h,
+                       double barrier, bool up) {
+  const double d0{up ? barrier - s0 : s0 - barrier};
+  const double d1{up ? barrier - s1 : s1 - barrier};
+  if (d0 <= 0.0 || d1 <= 0.0) return 0.0;
+  return 1.0 - std::exp(-2.0 * d0 * d1 / (vol * vol * h));
+}
+
+/**
+ * @brief Least-squares slope of y against 1, 2, ..., n.
+ */
+double slope(const std::vector<double>& y) {
+  const double n{static_cast<double>(y.size())};
+  double sx{0.0}, sy{0.0}, sxx{0.0}, sxy{0.0};
+  for (std::size_t i{0}; i < y.size(); ++i) {
+    const double x{static_cast<double>(i + 1)};
+    sx += x;
+    sy += y[i];
+    sxx += x * x;
+    sxy += x * y[i];
+  }
+  const double denom{n * sxx - sx * sx};
+  return denom > 0.0 ? (n * sxy - sx * sy) / denom : 0.0;
+}
+}  // namespace
+
+MultilevelMonteCarlo::MultilevelMonteCarlo(const Option& option,
+                                           PathPayoff payoff, double barrier,
+                                           Config config)
+    : Pricer(option), payoff{payoff}, barrier{barrier}, config{config} {
+  if (!(config.targetRmse > 0.0)) {
+    throw std::invalid_argument("Target RMSE must be positive");
+  }
+  if (config.baseSteps == 0 || config.initialSamples == 0 ||
+      config.blockPaths == 0) {
+    throw std::invalid_argument(
+        "Base steps, initial samples and block size must be positive");
+  }
+  if (config.maxLevel < 2 || config.maxLevel > 20) {
+    throw std::invalid_argument("Maximum level must be in [2, 20]");
+  }
+  if (payoff == PathPayoff::UP_AND_OUT || payoff == PathPayoff::DOWN_AND_OUT) {
+    const double S{option.getStockPrice()};
+    if (!(barrier > 0.0) ||
+        (payoff == PathPayoff::UP_AND_OUT ? S >= barrier : S <= barrier)) {
+      throw std::invalid_argument(
+          "Barrier must be positive and not breached by the spot");
+    }
+  }
+  if (blockDraws(config.maxLevel) > levelShare()) {
+    throw std::invalid_argument(
+        "Too many draws per block for disjoint random substreams");
+  }
+}
+
+std::uint64_t MultilevelMonteCarlo::levelShare() const {
+  return random_streams::stride(config.maxLevel + 1);
+}
+
+std::uint64_t MultilevelMonteCarlo::blockDraws(unsigned level) const {
+  // one normal per fine step and path; coarse steps reuse them
+  return (static_cast<std::uint64_t>(config.blockPaths) * config.baseSteps)
+         << level;
+}
+
+MultilevelMonteCarlo::Inputs MultilevelMonteCarlo::baseInputs() const {
+  return {option.getStockPrice(), option.getTimeToMaturity(),
+          option.getRiskFreeRate(), option.getVolatility()};
+}
+
+MultilevelMonteCarlo::BlockSums MultilevelMonteCarlo::simulateBlock(
+    unsigned level, std::size_t block, const Inputs& in) const {
+  const std::size_t n{config.blockPaths};
+  const double K{option.getStrikePrice()};
+  const double mu{in.r - option.getDividendYield()};
+  const double sigma{in.sigma};
+  const bool isCall{option.getType() == OptionType::CALL};
+  const bool isBarrier{payoff == PathPayoff::UP_AND_OUT ||
+                       payoff == PathPayoff::DOWN_AND_OUT};
+  const bool up{payoff == PathPayoff::UP_AND_OUT};
+  const double df{std::exp(-in.r * in.T)};
+
+  random_streams::Engine engine{random_streams::seedAt(
+      config.seed, level * levelShare() + block * blockDraws(level))};
+
+  const unsigned long fineSteps{static_cast<unsigned long>(config.baseSteps)
+                                << level};
+  const double h{in.T / static_cast<double>(fineSteps)};
+  const double sqrtH{std::sqrt(h)};
+  // accumulators: running sum of the trapezoid average, or survival
+  const double accStart{isBarrier ? 1.0 : 0.0};
+  std::vector<double> sF(n, in.S), accF(n, accStart);
+  std::vector<double> sC(n, in.S), accC(n, accStart);
+  std::vector<double> z1(n), z2(n);
+
+  auto draw = [&](std::vector<double>& z) {
+    for (double& x : z) x = toUniform(engine());
+    for (double& x : z) x = sqrtH * math::norm_inv(x);
+  };
+  // fine step of size h from s0 with increment dW
+  auto fineStep = [&](std::size_t p, double dW) {
+    const double s0{sF[p]};
+    const double s1{milstein(s0, dW, h, mu, sigma)};
+    if (payoff == PathPayoff::ASIAN) {
+      accF[p] += 0.5 * (s0 + s1) * h;
+    } else if (isBarrier) {
+      accF[p] *= survival(s0, s1, sigma * s0, h, barrier, up);
+    }
+    sF[p] = s1;
+  };
+
+  if (level == 0) {
+    for (unsigned long k{0}; k < fineSteps; ++k) {
+      draw(z1);
+      for (std::size_t p{0}; p < n; ++p) fineStep(p, z1[p]);
+    }
+  } else {
+    for (unsigned long k{0}; k < fineSteps / 2; ++k) {
+      draw(z1);
+      draw(z2);
+      for (std::size_t p{0}; p < n; ++p) {
+        fineStep(p, z1[p]);
+        fineStep(p, z2[p]);
+        // coarse step of 2h driven by the summed increments
+        const double c0{sC[p]};
+        const double c2{milstein(c0, z1[p] + z2[p], 2.0 * h, mu, sigma)};
+        if (payoff == PathPayoff::ASIAN) {
+          accC[p] += (c0 + c2) * h;
+        } else if (isBarrier) {
+          // midpoint from the fine increments (Brownian interpolation)
+          const double mid{0.5 * (c0 + c2) +
+                           0.5 * sigma * c0 * (z1[p] - z2[p])};
+          accC[p] *= survival(c0, mid, sigma * c0, h, barrier, up) *
+                     survival(mid, c2, sigma * c0, h, barrier, up);
+        }
+        sC[p] = c2;
+      }
+    }
+  }
+
+  auto value = [&](double s, double acc) {
+    const double underlying{payoff == PathPayoff::ASIAN ? acc / in.T : s};
+    const double vanilla{
+        std::max(isCall ? underlying - K : K - underlying, 0.0)};
+    return df * (isBarrier ? acc * vanilla : vanilla);
+  };
+  math::ShiftedSums y{}, fine{};
+  for (std::size_t p{0}; p < n; ++p) {
+    const double f{value(sF[p], accF[p])};
+    y.add(level == 0 ? f : f - value(sC[p], accC[p]));
+    fine.add(f);
+  }
+  return {y.moments(), fine.moments()};
+}
+
+void MultilevelMonteCarlo::simulateTo(
+    const std::vector<std::size_t>& targetBlocks, const Inputs& in) const {
+  for (unsigned l{0}; l < targetBlocks.size(); ++l) {
+    if (targetBlocks[l] > levelShare() / blockDraws(l)) {
+      throw std::runtime_error("Level " + std::to_string(l) +
+                               " needs more draws than its random substream "
+                               "holds; raise the target RMSE");
+    }
+  }
+  blocks.resize(targetBlocks.size());
+  // flatten the missing (level, block) pairs of every level into one batch
+  std::vector<std::pair<unsigned, std::size_t>> tasks{};
+  for (unsigned l{0}; l < targetBlocks.size(); ++l) {
+    for (std::size_t b{blocks[l].size()}; b < targetBlocks[l]; ++b) {
+      tasks.emplace_back(l, b);
+    }
+    blocks[l].resize(std::max(blocks[l].size(), targetBlocks[l]));
+  }
+  parallel::forEachIndex(
+      tasks.size(),
+      [&](std::size_t t) {
+        const auto [l, b]{tasks[t]};
+        blocks[l][b] = simulateBlock(l, b, in);
+      },
+      config.threads);
+
+  levels.resize(targetBlocks.size());
+  for (unsigned l{0}; l < levels.size(); ++l) {
+    BlockSums total{};
+    for (const BlockSums& s : blocks[l]) {
+      total.y.merge(s.y);
+      total.p.merge(s.p);
+    }
+    LevelStats& stats{levels[l]};
+    stats.steps = static_cast<unsigned long>(config.baseSteps) << l;
+    stats.samples = blocks[l].size() * config.blockPaths;
+    stats.cost = static_cast<double>(l == 0 ? stats.steps
+                                            : stats.steps + stats.steps / 2);
+    stats.mean = total.y.mean;
+    stats.variance = total.y.variance();
+    stats.payoffVariance = total.p.variance();
+  }
+}
+
+double MultilevelMonteCarlo::calculatePrice() const {
+  if (priceCalculated) {
+    return cachedPrice;
+  }
+  const auto start{std::chrono::high_resolution_clock::now()};
+  const Inputs in{baseInputs()};
+  const double eps{config.targetRmse};
+  const std::size_t warmup{
+      (config.initialSamples + config.blockPaths - 1) / config.blockPaths};
+  levels.clear();
+  blocks.clear();
+  converged = false;
+
+  if (in.T <= 0.0) {
+    const double S{in.S};
+    const double K{option.getStrikePrice()};
+    cachedPrice = std::max(
+        option.getType() == OptionType::CALL ? S - K : K - S, 0.0);
+    converged = true;
+  } else {
+    std::vector<std::size_t> target(3, warmup);  // levels 0..2
+    for (;;) {
+      simulateTo(target, in);
+      const std::size_t L{levels.size() - 1};
+
+      // weak order α fitted over levels ≥ 1
+      std::vector<double> logMean{};
+      for (std::size_t l{1}; l <= L; ++l) {
+        logMean.push_back(
+            -std::log2(std::max(std::abs(levels[l].mean), 1e-300)));
+      }
+      const double alpha{std::max(slope(logMean), 0.5)};
+
+      // optimal allocation N_ℓ = 2/ε² √(V_ℓ/C_ℓ) Σ √(V_k C_k)
+      double total{0.0};
+      for (const LevelStats& s : levels) {
+        total += std::sqrt(s.variance * s.cost);
+      }
+      for (std::size_t l{0}; l <= L; ++l) {
+        const double samples{2.0 / (eps * eps) *
+                             std::sqrt(levels[l].variance / levels[l].cost) *
+                             total};
+        target[l] = std::max<std::size_t>(
+            static_cast<std::size_t>(
+                std::ceil(samples / static_cast<double>(config.blockPaths))),
+            blocks[l].size());
+      }
+      bool more{false};
+      for (std::size_t l{0}; l <= L; ++l) more |= target[l] > blocks[l].size();
+      if (more) continue;
+
+      // every level has its samples: test the extrapolated bias
+      const double bias{
+          std::max(std::abs(levels[L].mean),
+                   std::abs(levels[L - 1].mean) / std::pow(2.0, alpha)) /
+          (std::pow(2.0, alpha) - 1.0)};
+      if (bias <= eps / std::sqrt(2.0)) {
+        converged = true;
+        break;
+      }
+      if (L + 1 > config.maxLevel) break;
+      // a new level gets the warm-up before its variance enters the
+      // allocation above
+      target.push_back(warmup);
+    }
+    cachedPrice = 0.0;
+    for (const LevelStats& s : levels) cachedPrice += s.mean;
+  }
+  priceCalculated = true;
+  lastRunDuration = std::chrono::high_resolution_clock::now() - start;
+  return cachedPrice;
+}
+
+double MultilevelMonteCarlo::priceFixed(const Inputs& in) const {
+  if (in.T <= 0.0) {
+    const double K{option.getStrikePrice()};
+    return std::max(
+        option.getType() == OptionType::CALL ? in.S - K : K - in.S, 0.0);
+  }
+  std::vector<std::pair<unsigned, std::size_t>> tasks{};
+  for (unsigned l{0}; l < blocks.size(); ++l) {
+    for (std::size_t b{0}; b < blocks[l].size(); ++b) tasks.emplace_back(l, b);
+  }
+  std::vector<math::SampleMoments> differences(tasks.size());
+  parallel::forEachIndex(
+      tasks.size(),
+      [&](std::size_t t) {
+        differences[t] =
+            simulateBlock(tasks[t].first, tasks[t].second, in).y;
+      },
+      config.threads);
+  double price{0.0};
+  std::size_t t{0};
+  for (unsigned l{0}; l < blocks.size(); ++l) {
+    math::SampleMoments level{};
+    for (std::size_t b{0}; b < blocks[l].size(); ++b) {
+      level.merge(differences[t++]);
+    }
+    price += level.mean;
+  }
+  return price;
+}
+
+Greeks MultilevelMonteCarlo::calculateGreeks() {
+  const double V{calculatePrice()};
+  const Inputs base{baseInputs()};
+  if (base.T <= 0.0) {
+    return Greeks{};
+  }
+  // same levels, blocks and seeds at bumped inputs: common random numbers
+  auto bumped = [&](auto change) {
+    Inputs in{base};
+    change(in);
+    return priceFixed(in);
+  };
+  const double epsS{base.S * 0.01};
+  const double up{bumped([&](Inputs& in) { in.S += epsS; })};
+  const double dn{bumped([&](Inputs& in) { in.S -= epsS; })};
+  const double delta{(up - dn) / (2.0 * epsS)};
+  const double gamma{(up - 2.0 * V + dn) / (epsS * epsS)};
+  const double epsVol{std::max(base.sigma * 0.01, 1e-4)};
+  const double vega{(bumped([&](Inputs& in) { in.sigma += epsVol; }) -
+                     bumped([&](Inputs& in) { in.sigma -= epsVol; })) /
+                    (2.0 * epsVol)};
+  const double epsR{std::max(std::abs(base.r) * 0.01, 1e-4)};
+  const double rho{(bumped([&](Inputs& in) { in.r += epsR; }) -
+                    bumped([&](Inputs& in) { in.r -= epsR; })) /
+                   (2.0 * epsR)};
+  const double epsT{std::max(base.T * 0.01, 1e-4)};
+  const double theta{
+      (bumped([&](Inputs& in) { in.T = std::max(in.T - epsT, 1e-8); }) -
+       bumped([&](Inputs& in) { in.T += epsT; })) /
+      (2.0 * epsT)};
+  return Greeks{delta, gamma, theta, vega, rho};
+}
+
+double MultilevelMonteCarlo::getStandardError() {
+  validatePriceCalculated();
+  double variance{0.0};
+  for (const LevelStats& s : levels) {
+    variance += s.variance / static_cast<double>(s.samples);
+  }
+  return std::sqrt(variance);
+}
+
+std::pair<double, double> MultilevelMonteCarlo::getConfidenceInterval(
+    double confidenceLevel) {
+  return math::confidence_interval(cachedPrice, getStandardError(),
+                                   confidenceLevel);
+}
+
+std::string MultilevelMonteCarlo::getConvergenceInfo() const {
+  if (!priceCalculated) {
+    return "Price not calculated";
+  }
+  std::ostringstream out{};
+  out << levels.size() << " levels, target RMSE " << config.targetRmse
+      << (converged ? "" : " (bias criterion not met)") << '\n';
+  for (std::size_t l{0}; l < levels.size(); ++l) {
+    out << "  level " << l << ": " << levels[l].steps << " steps, "
+        << levels[l].samples << " samples, mean " << levels[l].mean
+        << ", variance " << levels[l].variance << '\n';
+  }
+  return out.str();
+}
+
+const std::vector<MultilevelMonteCarlo::LevelStats>&
+MultilevelMonteCarlo::getLevels() const {
+  validatePriceCalculated();
+  return levels;
+}
+
+double MultilevelMonteCarlo::getCost() const {
+  validatePriceCalculated();
+  double cost{0.0};
+  for (const LevelStats& s : levels) {
+    cost += static_cast<double>(s.samples) * s.cost;
+  }
+  return cost;
+}
+
+double MultilevelMonteCarlo::getSingleLevelCost() const {
+  validatePriceCalculated();
+  if (levels.empty()) return 0.0;
+  const LevelStats& finest{levels.back()};
+  const double eps{config.targetRmse};
+  return 2.0 * finest.payoffVariance / (eps * eps) *
+         static_cast<double>(finest.steps);
+}
+
+bool MultilevelMonteCarlo::isConverged() const {
+  validatePriceCalculated();
+  return converged;
+}
+
+void MultilevelMonteCarlo::validatePriceCalculated() const {
+  if (!priceCalculated) {
+    throw std::runtime_error(
+        "Price must be calculated first. Call calculatePrice()");
+  }
+}
@@ -0,0 +1,328 @@
+#include "OptionChainFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PRICER_HAS_MMAP 1
+#endif
+
+namespace {
+constexpr char MAGIC[8] = {'M', 'C', 'P', 'C', 'H', 'A', 'I', 'N'};
+constexpr std::uint32_t VERSION{1};
+// written in native order; reads back differently on a foreign-endian host
+constexpr std::uint32_t BYTE_ORDER_MARK{0x01020304};
+constexpr std::uint32_t FLAG_VALIDATED{1u << 0};
+constexpr std::uint32_t FLAG_RESULTS{1u << 1};
+constexpr std::size_t HEADER_SIZE{128};
+constexpr std::size_t ALIGN{64};
+
+enum Column : std::size_t {
+  TYPE,
+  SPOT,
+  STRIKE,
+  MATURITY,
+  RATE,
+  VOL,
+  DIVIDEND,
+  MARKET_PRICE,
+  VALUE,
+  STD_ERROR,
+  NUM_COLUMNS
+};
+
+struct ChainHeader {
+  char magic[8]{};
+  std::uint32_t version{};
+  std::uint32_t byteOrder{};
+  std::uint32_t flags{};
+  std::uint32_t reserved{};
+  std::uint64_t rows{};
+  std::uint64_t offsets[NUM_COLUMNS]{};
+};
+static_assert(sizeof(ChainHeader) <= HEADER_SIZE, "header must fit");
+
+std::size_t alignUp(std::size_t x) { return (x + ALIGN - 1) & ~(ALIGN - 1); }
+
+std::size_t columnBytes(std::size_t column, std::size_t rows) {
+  return column == TYPE ? rows * sizeof(OptionType) : rows * sizeof(double);
+}
+
+void writeAt(std::ostream& out, std::size_t offset, const void* data,
+             std::size_t bytes) {
+  out.seekp(static_cast<std::streamoff>(offset));
+  out.write(static_cast<const char*>(data),
+            static_cast<std::streamsize>(bytes));
+}
+
+void writeHeader(std::ostream& out, const ChainHeader& header) {
+  char buf[HEADER_SIZE]{};
+  std::memcpy(buf, &header, sizeof(header));
+  writeAt(out, 0, buf, sizeof(buf));
+}
+
+ChainHeader readHeader(const void* data, std::size_t length) {
+  if (length < HEADER_SIZE) {
+    throw std::runtime_error("Not an option chain file (too short)");
+  }
+  ChainHeader header{};
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("Not an option chain file (bad magic)");
+  }
+  if (header.byteOrder != BYTE_ORDER_MARK) {
+    throw std::runtime_error("Option chain file has foreign byte order");
+  }
+  if (header.version != VERSION) {
+    throw std::runtime_error("Unsupported option chain file version " +
+                             std::to_string(header.version));
+  }
+  if (!(header.flags & FLAG_VALIDATED)) {
+    throw std::runtime_error("Option chain file was not validated");
+  }
+  const std::size_t lastColumn{header.flags & FLAG_RESULTS ? NUM_COLUMNS
+                                                           : VALUE};
+  for (std::size_t c{0}; c < lastColumn; ++c) {
+    if (header.offsets[c] % ALIGN != 0 ||
+        header.offsets[c] + columnBytes(c, header.rows) > length) {
+      throw std::runtime_error("Option chain file is truncated or corrupt");
+    }
+  }
+  return header;
+}
+
+void validateRow(const OptionColumns& o, std::size_t i) {
+  const char* problem{nullptr};
+  if (o.type[i] != OptionType::CALL && o.type[i] != OptionType::PUT)
+    problem = "unknown option type";
+  else if (!(o.S[i] > 0) || !(o.K[i] > 0))
+    problem = "S and K must be > 0.";
+  else if (!(o.T[i] >= 0))
+    problem = "T must be >= 0.";
+  else if (!(o.sigma[i] >= 0))
+    problem = "sigma must be >= 0.";
+  else if (!(o.q[i] >= 0))
+    problem = "q must be >= 0.";
+  if (problem) {
+    throw std::invalid_argument("Row " + std::to_string(i) + ": " + problem);
+  }
+}
+}  // namespace
+
+void OptionChainData::add(const Option& option, double price) {
+  type.push_back(option.getType());
+  S.push_back(option.getStockPrice());
+  K.push_back(option.getStrikePrice());
+  T.push_back(option.getTimeToMaturity());
+  r.push_back(option.getRiskFreeRate());
+  sigma.push_back(option.getVolatility());
+  q.push_back(option.getDividendYield());
+  marketPrice.push_back(price);
+}
+
+OptionColumns OptionChainData::columns() const {
+  return OptionColumns{type, S, K, T, r, sigma, q};
+}
+
+namespace chain {
+void write(const std::string& path, const OptionColumns& options,
+           std::span<const double> marketPrices) {
+  const std::size_t rows{options.size()};
+  if (options.type.size() != rows || options.K.size() != rows ||
+      options.T.size() != rows || options.r.size() != rows ||
+      options.sigma.size() != rows || options.q.size() != rows ||
+      (!marketPrices.empty() && marketPrices.size() != rows)) {
+    throw std::invalid_argument("Chain columns must all have the same size");
+  }
+  // validate once, in bulk, so readers never have to
+  for (std::size_t i{0}; i < rows; ++i) {
+    validateRow(options, i);
+  }
+
+  ChainHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.flags = FLAG_VALIDATED;
+  header.rows = rows;
+  std::size_t offset{HEADER_SIZE};
+  for (std::size_t c{TYPE}; c <= MARKET_PRICE; ++c) {
+    header.offsets[c] = offset;
+    offset = alignUp(offset + columnBytes(c, rows));
+  }
+
+  std::ofstream out{path, std::ios::binary | std::ios::trunc};
+  if (!out) {
+    throw std::runtime_error("Cannot create option chain file " + path);
+  }
+  writeHeader(out, header);
+  const std::span<const double> doubles[]{options.S, options.K,     options.T,
+                                          options.r, options.sigma, options.q};
+  writeAt(out, header.offsets[TYPE], options.type.data(),
+          columnBytes(TYPE, rows));
+  for (std::size_t c{SPOT}; c <= DIVIDEND; ++c) {
+    writeAt(out, header.offsets[c], doubles[c - SPOT].data(),
+            columnBytes(c, rows));
+  }
+  if (marketPrices.empty()) {
+    const std::vector<double> zeros(rows, 0.0);
+    writeAt(out, header.offsets[MARKET_PRICE], zeros.data(),
+            columnBytes(MARKET_PRICE, rows));
+  } else {
+    writeAt(out, header.offsets[MARKET_PRICE], marketPrices.data(),
+            columnBytes(MARKET_PRICE, rows));
+  }
+  if (!out.flush()) {
+    throw std::runtime_error("Failed writing option chain file " + path);
+  }
+}
+
+void appendResults(const std::string& path, std::span<const double> values,
+                   std::span<const double> standardErrors) {
+  std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+  if (!file) {
+    throw std::runtime_error("Cannot open option chain file " + path);
+  }
+  char buf[HEADER_SIZE]{};
+  file.read(buf, sizeof(buf));
+  file.seekg(0, std::ios::end);
+  ChainHeader header{
+      readHeader(buf, file ? static_cast<std::size_t>(file.tellg()) : 0)};
+
+  const std::size_t rows{header.rows};
+  if (values.size() != rows ||
+      (!standardErrors.empty() && standardErrors.size() != rows)) {
+    throw std::invalid_argument("Result columns must have one entry per row");
+  }
+
+  // results always live right after the inputs, so re-appending replaces
+  header.offsets[VALUE] =
+      alignUp(header.offsets[MARKET_PRICE] + columnBytes(MARKET_PRICE, rows));
+  header.offsets[STD_ERROR] =
+      alignUp(header.offsets[VALUE] + columnBytes(VALUE, rows));
+
+  writeAt(file, header.offsets[VALUE], values.data(),
+          columnBytes(VALUE, rows));
+  if (standardErrors.empty()) {
+    const std::vector<double> zeros(rows, 0.0);
+    writeAt(file, header.offsets[STD_ERROR], zeros.data(),
+            columnBytes(STD_ERROR, rows));
+  } else {
+    writeAt(file, header.offsets[STD_ERROR], standardErrors.data(),
+            columnBytes(STD_ERROR, rows));
+  }
+  file.flush();
+  // publish the section only once its data is in place
+  header.flags |= FLAG_RESULTS;
+  writeHeader(file, header);
+  if (!file.flush()) {
+    throw std::runtime_error("Failed appending results to " + path);
+  }
+}
+}  // namespace chain
+
+MappedOptionChain::MappedOptionChain(const std::string& path) {
+#ifdef PRICER_HAS_MMAP
+  const int fd{::open(path.c_str(), O_RDONLY)};
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open option chain file " + path);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error("Not an option chain file (empty) " + path);
+  }
+  length = static_cast<std::size_t>(st.st_size);
+  void* mapped{::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0)};
+  ::close(fd);  // the mapping keeps the file alive
+  if (mapped == MAP_FAILED) {
+    throw std::runtime_error("Cannot map option chain file " + path);
+  }
+  base = mapped;
+  ::madvise(base, length, MADV_SEQUENTIAL);
+  try {
+    const ChainHeader header{readHeader(base, length)};
+    rows = header.rows;
+    results = (header.flags & FLAG_RESULTS) != 0;
+    for (std::size_t c{0}; c < NUM_COLUMNS; ++c) {
+      offsets[c] = header.offsets[c];
+    }
+  } catch (...) {
+    unmap();
+    throw;
+  }
+#else
+  (void)path;
+  throw std::runtime_error("Memory-mapped option chains need a POSIX system");
+#endif
+}
+
+MappedOptionChain::~MappedOptionChain() { unmap(); }
+
+MappedOptionChain::MappedOptionChain(MappedOptionChain&& other) noexcept
+    : base{std::exchange(other.base, nullptr)},
+      length{std::exchange(other.length, 0)},
+      rows{std::exchange(other.rows, 0)},
+      results{std::exchange(other.results, false)} {
+  std::memcpy(offsets, other.offsets, sizeof(offsets));
+}
+
+MappedOptionChain& MappedOptionChain::operator=(
+    MappedOptionChain&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    base = std::exchange(other.base, nullptr);
+    length = std::exchange(other.length, 0);
+    rows = std::exchange(other.rows, 0);
+    results = std::exchange(other.results, false);
+    std::memcpy(offsets, other.offsets, sizeof(offsets));
+  }
+  return *this;
+}
+
+void MappedOptionChain::unmap() noexcept {
+#ifdef PRICER_HAS_MMAP
+  if (base != nullptr) {
+    ::munmap(base, length);
+  }
+#endif
+  base = nullptr;
+}
+
+template <class T>
+std::span<const T> MappedOptionChain::column(std::size_t index) const {
+  return {reinterpret_cast<const T*>(static_cast<const char*>(base) +
+                                     offsets[index]),
+          rows};
+}
+
+OptionColumns MappedOptionChain::columns() const {
+  return OptionColumns{column<OptionType>(TYPE),   column<double>(SPOT),
+                       column<double>(STRIKE),     column<double>(MATURITY),
+                       column<double>(RATE),       column<double>(VOL),
+                       column<double>(DIVIDEND)};
+}
+
+std::span<const double> MappedOptionChain::marketPrices() const {
+  return column<double>(MARKET_PRICE);
+}
+
+std::span<const double> MappedOptionChain::resultValues() const {
+  if (!results) {
+    throw std::runtime_error("Option chain file has no results section");
+  }
+  return column<double>(VALUE);
+}
+
+std::span<const double> MappedOptionChain::resultStandardErrors() const {
+  if (!results) {
+    throw std::runtime_error("Option chain file has no results section");
+  }
+  return column<double>(STD_ERROR);
+}
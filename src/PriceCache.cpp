@@ -0,0 +1,127 @@
+#include "PriceCache.h"
+
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+// keeps `bits` mantissa bits (round to nearest); 0 = unchanged
+double quantize(double x, int bits) {
+  if (bits == 0 || x == 0.0 || !std::isfinite(x)) return x;
+  int exponent{0};
+  const double mantissa{std::frexp(x, &exponent)};
+  return std::ldexp(std::round(std::ldexp(mantissa, bits)), exponent - bits);
+}
+
+// +0.0 == -0.0 but their bits differ, and the hash works on bits
+double fold(double x) { return x == 0.0 ? 0.0 : x; }
+}  // namespace
+
+PriceCache::PriceCache(Config config) : config{config} {
+  if (config.maxEntries == 0) {
+    throw std::invalid_argument("Cache capacity must be positive.");
+  }
+  if (config.quantizeBits < 0 || config.quantizeBits > 52) {
+    throw std::invalid_argument("quantizeBits must be in [0, 52].");
+  }
+  const std::size_t count{std::bit_ceil(std::max<std::size_t>(config.shards, 1))};
+  shardMask = count - 1;
+  shardCapacity = std::max<std::size_t>(1, config.maxEntries / count);
+  shards = std::make_unique<Shard[]>(count);
+}
+
+PriceCache& PriceCache::global() {
+  static PriceCache cache{};
+  return cache;
+}
+
+PriceKey PriceCache::canonical(PriceKey key) const {
+  const int bits{config.quantizeBits};
+  for (double* x : {&key.S, &key.K, &key.T, &key.r, &key.sigma, &key.q}) {
+    *x = fold(quantize(*x, bits));
+  }
+  // engine settings and extra inputs are never quantized
+  key.params[0] = fold(key.params[0]);
+  key.params[1] = fold(key.params[1]);
+  return key;
+}
+
+std::optional<CachedResult> PriceCache::find(const PriceKey& key) {
+  const PriceKey k{canonical(key)};
+  Shard& shard{shardFor(k.hash())};
+  {
+    std::lock_guard lock{shard.mutex};
+    const auto it{shard.index.find(k)};
+    if (it != shard.index.end()) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return it->second->second;
+    }
+  }
+  misses.fetch_add(1, std::memory_order_relaxed);
+  return std::nullopt;
+}
+
+void PriceCache::insert(const PriceKey& key, const CachedResult& result) {
+  const PriceKey k{canonical(key)};
+  Shard& shard{shardFor(k.hash())};
+  std::lock_guard lock{shard.mutex};
+  const auto it{shard.index.find(k)};
+  if (it != shard.index.end()) {
+    it->second->second = result;
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    return;
+  }
+  if (shard.lru.size() >= shardCapacity) {
+    // recycle the least recently used node instead of reallocating
+    auto last{std::prev(shard.lru.end())};
+    shard.index.erase(last->first);
+    *last = Entry{k, result};
+    shard.lru.splice(shard.lru.begin(), shard.lru, last);
+    evictions.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    shard.lru.emplace_front(k, result);
+  }
+  shard.index.emplace(k, shard.lru.begin());
+  insertions.fetch_add(1, std::memory_order_relaxed);
+}
+
+CachedResult PriceCache::price(Pricer& pricer) {
+  auto compute = [&pricer] {
+    CachedResult result{pricer.calculatePrice(), 0.0};
+    try {
+      result.standardError = pricer.getStandardError();
+    } catch (const std::runtime_error&) {
+      // analytic engines have no standard error
+    }
+    return result;
+  };
+  const std::optional<PriceKey> key{pricer.cacheKey()};
+  if (!key) return compute();
+  return getOrCompute(*key, compute);
+}
+
+void PriceCache::clear() {
+  for (std::size_t s{0}; s <= shardMask; ++s) {
+    std::lock_guard lock{shards[s].mutex};
+    shards[s].index.clear();
+    shards[s].lru.clear();
+  }
+}
+
+PriceCache::Stats PriceCache::getStats() const {
+  Stats stats{hits.load(), misses.load(), insertions.load(),
+              evictions.load(), 0};
+  for (std::size_t s{0}; s <= shardMask; ++s) {
+    std::lock_guard lock{shards[s].mutex};
+    stats.size += shards[s].lru.size();
+  }
+  return stats;
+}
+
+void PriceCache::resetStats() {
+  hits = 0;
+  misses = 0;
+  insertions = 0;
+  evictions = 0;
+}
@@ -0,0 +1,493 @@
+#include "PricingService.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "BlackScholes.h"
+#include "ImpliedVol.h"
+#include "ShmRing.h"
+
+namespace {
+constexpr char MAGIC[8] = {'M', 'C', 'P', 'S', 'V', 'C', '0', '2'};
+constexpr std::size_t RING_SLOTS{1024};
+constexpr std::uint32_t MAX_CHANNELS{16};
+constexpr std::size_t MAX_BATCH{4096};
+static_assert(MAX_CHANNELS <= 32, "stalled channels are a 32-bit mask");
+
+struct Channel {
+  SpscRing<PricingRequest, RING_SLOTS> requests;
+  SpscRing<PricingResponse, RING_SLOTS> responses;
+};
+
+// layout of the shared-memory segment
+struct Segment {
+  char magic[8]{};
+  std::atomic<std::uint32_t> alive{0};
+  std::atomic<std::int64_t> owner{0};  // pid of the serving process
+  std::atomic<std::uint32_t> claimed[MAX_CHANNELS]{};
+  Channel channels[MAX_CHANNELS];
+};
+
+std::string shmName(const std::string& name) { return "/" + name; }
+
+Segment& seg(void* p) { return *static_cast<Segment*>(p); }
+
+// same rules as the Option constructor, without the exception
+bool isValid(const PricingRequest& req) {
+  return (req.type == OptionType::CALL || req.type == OptionType::PUT) &&
+         req.S > 0 && req.K > 0 && req.T >= 0 && req.sigma >= 0 &&
+         req.q >= 0 && std::isfinite(req.r);
+}
+
+sockaddr_un socketAddress(const std::string& path) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    throw std::runtime_error("Control socket path too long: " + path);
+  }
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  return addr;
+}
+
+bool processExists(std::int64_t pid) {
+  return pid > 0 &&
+         (::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+}
+
+// true if a daemon is serving under this name: its segment is marked alive
+// by a process that still exists, or its control socket accepts connections
+bool daemonAnswers(const std::string& name, const std::string& socket) {
+  const int fd{::shm_open(shmName(name).c_str(), O_RDONLY, 0)};
+  if (fd >= 0) {
+    bool alive{false};
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 &&
+        static_cast<std::size_t>(st.st_size) == sizeof(Segment)) {
+      void* mem{
+          ::mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0)};
+      if (mem != MAP_FAILED) {
+        const Segment& s{seg(mem)};
+        alive = std::memcmp(s.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                s.alive.load(std::memory_order_acquire) != 0 &&
+                processExists(s.owner.load(std::memory_order_relaxed));
+        ::munmap(mem, sizeof(Segment));
+      }
+    }
+    ::close(fd);
+    if (alive) return true;
+  }
+  const sockaddr_un addr{socketAddress(socket)};
+  const int probe{::socket(AF_UNIX, SOCK_STREAM, 0)};
+  if (probe < 0) return false;
+  const bool answers{::connect(probe, reinterpret_cast<const sockaddr*>(&addr),
+                               sizeof(addr)) == 0};
+  ::close(probe);
+  return answers;
+}
+}  // namespace
+
+std::string PricingService::socketPath(const std::string& name) {
+  return "/tmp/" + name + ".sock";
+}
+
+PricingService::PricingService(Config config) : config{std::move(config)} {
+  const std::string name{shmName(this->config.name)};
+  if (daemonAnswers(this->config.name, socketPath(this->config.name))) {
+    throw std::runtime_error("Pricing service '" + this->config.name +
+                             "' is already running");
+  }
+  ::shm_unlink(name.c_str());  // drop a segment left by a dead daemon
+  const int fd{::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600)};
+  if (fd < 0) {
+    throw std::runtime_error("Cannot create shared memory " + name + ": " +
+                             std::strerror(errno));
+  }
+  if (::ftruncate(fd, sizeof(Segment)) != 0) {
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    throw std::runtime_error("Cannot size shared memory " + name);
+  }
+  void* mem{::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0)};
+  ::close(fd);
+  if (mem == MAP_FAILED) {
+    ::shm_unlink(name.c_str());
+    throw std::runtime_error("Cannot map shared memory " + name);
+  }
+  segment = new (mem) Segment{};
+  std::memcpy(seg(segment).magic, MAGIC, sizeof(MAGIC));
+
+  if (this->config.controlSocket) {
+    const std::string path{socketPath(this->config.name)};
+    const sockaddr_un addr{socketAddress(path)};
+    ::unlink(path.c_str());  // nobody answers on it, so it is stale
+    controlFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (controlFd < 0 ||
+        ::bind(controlFd, reinterpret_cast<const sockaddr*>(&addr),
+               sizeof(addr)) != 0 ||
+        ::listen(controlFd, 8) != 0) {
+      if (controlFd >= 0) ::close(controlFd);
+      ::munmap(segment, sizeof(Segment));
+      ::shm_unlink(name.c_str());
+      throw std::runtime_error("Cannot listen on " + path);
+    }
+    ::fcntl(controlFd, F_SETFL, ::fcntl(controlFd, F_GETFL) | O_NONBLOCK);
+  }
+
+  // the serve loop never allocates: every workspace has its final size
+  batch.reserve(MAX_BATCH);
+  responses.reserve(MAX_BATCH);
+  bsRows.reserve(MAX_BATCH);
+  types.reserve(MAX_BATCH);
+  for (auto* column : {&S, &K, &T, &r, &sigma, &q, &prices}) {
+    column->reserve(MAX_BATCH);
+  }
+  // each stalled channel holds back at most one drain of its request ring
+  backlog.reserve(MAX_CHANNELS * RING_SLOTS);
+  for (unsigned part{1}; part < this->config.threads; ++part) {
+    workers.emplace_back([this, part] { workLoop(part); });
+  }
+
+  seg(segment).owner.store(::getpid(), std::memory_order_relaxed);
+  seg(segment).alive.store(1, std::memory_order_release);
+}
+
+PricingService::~PricingService() {
+  workersStopping.store(true);
+  ++generation;
+  generation.notify_all();
+  workers.clear();  // joins
+  seg(segment).alive.store(0, std::memory_order_release);
+  ::munmap(segment, sizeof(Segment));
+  ::shm_unlink(shmName(config.name).c_str());
+  if (controlFd >= 0) {
+    ::close(controlFd);
+    ::unlink(socketPath(config.name).c_str());
+  }
+}
+
+void PricingService::run(std::stop_token token) {
+  running.store(true);
+  unsigned idle{0};
+  std::uint64_t loops{0};
+  while (running.load(std::memory_order_relaxed) && !token.stop_requested()) {
+    if (drain() > 0) {
+      priceBatch();
+      deliver();
+      idle = 0;
+    } else if (!backlog.empty()) {
+      deliver();
+      std::this_thread::yield();
+    } else if (++idle < 64) {
+      // spin: keeps the latency of the next request minimal
+    } else if (idle < 4096) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds{20});
+    }
+    if ((++loops & 255) == 0) pollControl();
+  }
+  running.store(false);
+}
+
+PricingService::Stats PricingService::getStats() const {
+  Stats stats{requestCount.load(), batchCount.load(), largestBatch.load(), 0};
+  for (std::uint32_t c{0}; c < MAX_CHANNELS; ++c) {
+    stats.clients += seg(segment).claimed[c].load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+std::size_t PricingService::drain() {
+  Segment& s{seg(segment)};
+  batch.clear();
+  for (std::uint32_t c{0}; c < MAX_CHANNELS; ++c) {
+    if (s.claimed[c].load(std::memory_order_acquire) == 0) continue;
+    if (stalledChannels & (1u << c)) continue;  // let it catch up first
+    Pending p{c, {}};
+    while (batch.size() < MAX_BATCH &&
+           s.channels[c].requests.tryPop(p.request)) {
+      batch.push_back(p);
+    }
+  }
+  return batch.size();
+}
+
+void PricingService::priceBatch() {
+  // the batch keeps arrival order, so each channel's responses come back in
+  // request order; only the Black-Scholes rows are gathered by underlying
+  responses.assign(batch.size(), PricingResponse{});
+  bsRows.clear();
+
+  for (std::size_t i{0}; i < batch.size(); ++i) {
+    const PricingRequest& req{batch[i].request};
+    responses[i].requestId = req.requestId;
+    if (!isValid(req)) {
+      responses[i].status = 1;
+      continue;
+    }
+    if (req.engine == ServiceEngine::BLACK_SCHOLES) {
+      bsRows.push_back(i);
+    } else {
+      try {
+        responses[i].value =
+            impliedVolBS(req.type, req.S, req.K, req.T, req.r, req.q,
+                         req.marketPrice);
+      } catch (const std::exception&) {
+        responses[i].status = 1;
+      }
+    }
+  }
+
+  // ties broken by row: stable without stable_sort's scratch allocation
+  std::ranges::sort(bsRows, [this](std::size_t a, std::size_t b) {
+    return std::tie(batch[a].request.S, a) < std::tie(batch[b].request.S, b);
+  });
+  types.clear();
+  S.clear();
+  K.clear();
+  T.clear();
+  r.clear();
+  sigma.clear();
+  q.clear();
+  for (const std::size_t i : bsRows) {
+    const PricingRequest& req{batch[i].request};
+    types.push_back(req.type);
+    S.push_back(req.S);
+    K.push_back(req.K);
+    T.push_back(req.T);
+    r.push_back(req.r);
+    sigma.push_back(req.sigma);
+    q.push_back(req.q);
+  }
+
+  prices.resize(bsRows.size());
+  if (bsRows.size() >= config.parallelThreshold && !workers.empty()) {
+    partsLeft.store(workers.size());
+    ++generation;  // publishes the columns to the workers
+    generation.notify_all();
+    pricePart(0);
+    for (std::size_t left{partsLeft.load()}; left != 0;
+         left = partsLeft.load()) {
+      partsLeft.wait(left);
+    }
+  } else {
+    BlackScholes::priceBatch(OptionColumns{types, S, K, T, r, sigma, q},
+                             prices);
+  }
+  for (std::size_t j{0}; j < bsRows.size(); ++j) {
+    responses[bsRows[j]].value = prices[j];
+  }
+
+  requestCount += batch.size();
+  ++batchCount;
+  if (batch.size() > largestBatch.load()) largestBatch = batch.size();
+}
+
+void PricingService::pricePart(std::size_t part) {
+  const std::size_t parts{workers.size() + 1};
+  const std::size_t begin{bsRows.size() * part / parts};
+  const std::size_t len{bsRows.size() * (part + 1) / parts - begin};
+  const OptionColumns cols{types, S, K, T, r, sigma, q};
+  BlackScholes::priceBatch(
+      OptionColumns{cols.type.subspan(begin, len), cols.S.subspan(begin, len),
+                    cols.K.subspan(begin, len), cols.T.subspan(begin, len),
+                    cols.r.subspan(begin, len), cols.sigma.subspan(begin, len),
+                    cols.q.subspan(begin, len)},
+      std::span<double>{prices}.subspan(begin, len));
+}
+
+void PricingService::workLoop(std::size_t part) {
+  std::uint64_t seen{0};
+  for (;;) {
+    generation.wait(seen);
+    seen = generation.load();
+    if (workersStopping.load()) return;
+    pricePart(part);
+    if (partsLeft.fetch_sub(1) == 1) partsLeft.notify_one();
+  }
+}
+
+void PricingService::deliver() {
+  // write each response straight into its client's ring; a full ring holds
+  // that client's responses (and, via drain(), its requests) back, in order,
+  // instead of stalling every other client
+  Segment& s{seg(segment)};
+  std::uint32_t stalled{0};
+  const auto push = [&](std::uint32_t c, const PricingResponse& response) {
+    if (s.claimed[c].load(std::memory_order_acquire) == 0) {
+      return true;  // the client left: drop it
+    }
+    if ((stalled & (1u << c)) == 0 &&
+        s.channels[c].responses.tryPush(response)) {
+      return true;
+    }
+    stalled |= 1u << c;
+    return false;
+  };
+
+  std::size_t kept{0};
+  for (const Undelivered& u : backlog) {
+    if (!push(u.channel, u.response)) backlog[kept++] = u;
+  }
+  backlog.resize(kept);
+  for (std::size_t i{0}; i < batch.size(); ++i) {
+    if (!push(batch[i].channel, responses[i])) {
+      backlog.push_back({batch[i].channel, responses[i]});
+    }
+  }
+  batch.clear();
+  stalledChannels = stalled;
+}
+
+void PricingService::pollControl() {
+  if (controlFd < 0) return;
+  const int client{::accept(controlFd, nullptr, nullptr)};
+  if (client < 0) return;
+
+  timeval timeout{0, 100000};
+  ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  char buf[64]{};
+  const ssize_t n{::recv(client, buf, sizeof(buf) - 1, 0)};
+  std::string command{n > 0 ? std::string(buf, static_cast<std::size_t>(n))
+                            : std::string{}};
+  while (!command.empty() && (command.back() == '\n' || command.back() == '\r'))
+    command.pop_back();
+
+  std::string reply{};
+  if (command == "STATS") {
+    const Stats stats{getStats()};
+    reply = "requests=" + std::to_string(stats.requests) +
+            " batches=" + std::to_string(stats.batches) +
+            " largest_batch=" + std::to_string(stats.largestBatch) +
+            " clients=" + std::to_string(stats.clients) + "\n";
+  } else if (command == "STOP") {
+    reply = "OK\n";
+    running.store(false);
+  } else {
+    reply = "ERR unknown command\n";
+  }
+  ::send(client, reply.data(), reply.size(), MSG_NOSIGNAL);
+  ::close(client);
+}
+
+PricingClient::PricingClient(const std::string& name) {
+  const std::string shm{shmName(name)};
+  const int fd{::shm_open(shm.c_str(), O_RDWR, 0)};
+  if (fd < 0) {
+    throw std::runtime_error("Pricing service '" + name + "' is not running");
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) != sizeof(Segment)) {
+    ::close(fd);
+    throw std::runtime_error("Pricing service segment has the wrong layout");
+  }
+  void* mem{::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0)};
+  ::close(fd);
+  if (mem == MAP_FAILED) {
+    throw std::runtime_error("Cannot map pricing service segment");
+  }
+  Segment& s{seg(mem)};
+  if (std::memcmp(s.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      s.alive.load(std::memory_order_acquire) == 0) {
+    ::munmap(mem, sizeof(Segment));
+    throw std::runtime_error("Pricing service '" + name + "' is not running");
+  }
+  for (std::uint32_t c{0}; c < MAX_CHANNELS; ++c) {
+    std::uint32_t expected{0};
+    if (s.claimed[c].compare_exchange_strong(expected, 1)) {
+      segment = mem;
+      channel = c;
+      // discard responses addressed to a previous owner of the channel
+      PricingResponse stale{};
+      while (s.channels[c].responses.tryPop(stale)) {
+      }
+      return;
+    }
+  }
+  ::munmap(mem, sizeof(Segment));
+  throw std::runtime_error("All pricing service channels are in use");
+}
+
+PricingClient::~PricingClient() {
+  Segment& s{seg(segment)};
+  // give the service a moment to consume what we already sent
+  for (int i{0}; i < 1000 && s.channels[channel].requests.size() > 0 &&
+                 s.alive.load(std::memory_order_acquire) != 0;
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::microseconds{100});
+  }
+  s.claimed[channel].store(0, std::memory_order_release);
+  ::munmap(segment, sizeof(Segment));
+}
+
+bool PricingClient::trySubmit(const PricingRequest& request) {
+  return seg(segment).channels[channel].requests.tryPush(request);
+}
+
+bool PricingClient::tryReceive(PricingResponse& response) {
+  if (!early.empty()) {
+    response = early.front();
+    early.pop_front();
+    return true;
+  }
+  return seg(segment).channels[channel].responses.tryPop(response);
+}
+
+PricingResponse PricingClient::price(const PricingRequest& request) {
+  Segment& s{seg(segment)};
+  while (!trySubmit(request)) {
+    std::this_thread::yield();
+  }
+  PricingResponse response{};
+  for (unsigned spins{0};; ++spins) {
+    if (s.channels[channel].responses.tryPop(response)) {
+      if (response.requestId == request.requestId) return response;
+      early.push_back(response);  // an earlier trySubmit(); keep it
+      continue;
+    }
+    if (s.alive.load(std::memory_order_acquire) == 0) {
+      throw std::runtime_error("Pricing service stopped");
+    }
+    if (spins > 64) std::this_thread::yield();
+  }
+}
+
+std::string PricingClient::control(const std::string& name,
+                                   const std::string& command) {
+  const sockaddr_un addr{socketAddress(PricingService::socketPath(name))};
+  const int fd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+  if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&addr),
+                          sizeof(addr)) != 0) {
+    if (fd >= 0) ::close(fd);
+    throw std::runtime_error("Cannot reach control socket of '" + name + "'");
+  }
+  const std::string line{command + "\n"};
+  ::send(fd, line.data(), line.size(), MSG_NOSIGNAL);
+  std::string reply{};
+  char buf[256];
+  for (ssize_t n{}; (n = ::recv(fd, buf, sizeof(buf), 0)) > 0;) {
+    reply.append(buf, static_cast<std::size_t>(n));
+  }
+  ::close(fd);
+  while (!reply.empty() && reply.back() == '\n') reply.pop_back();
+  return reply;
+}
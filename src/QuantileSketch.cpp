@@ -0,0 +1,134 @@
+#include "QuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+
+QuantileSketch::QuantileSketch(unsigned subBucketBits)
+    : bits{subBucketBits}, shift{52 - subBucketBits} {
+  if (subBucketBits < 1 || subBucketBits > 16) {
+    throw std::invalid_argument("subBucketBits must be in [1, 16]");
+  }
+}
+
+void QuantileSketch::grow(std::int64_t index) {
+  if (counts.empty()) {
+    offset = index;
+    counts.assign(1, 0);
+    return;
+  }
+  // grow by at least one binade on the growing side to amortise copies
+  const std::int64_t slack{std::int64_t{1} << bits};
+  const std::int64_t end{offset + static_cast<std::int64_t>(counts.size())};
+  if (index >= offset && index < end) return;
+  const std::int64_t first{index < offset ? index - slack : offset};
+  const std::int64_t last{index >= end ? index + slack : end - 1};
+  std::vector<std::uint64_t> grown(static_cast<std::size_t>(last - first + 1),
+                                   0);
+  std::ranges::copy(counts, grown.begin() + (offset - first));
+  counts = std::move(grown);
+  offset = first;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+  if (other.bits != bits) {
+    throw std::invalid_argument("Cannot merge sketches of different precision");
+  }
+  if (!other.counts.empty()) {
+    grow(other.offset);
+    grow(other.offset + static_cast<std::int64_t>(other.counts.size()) - 1);
+    for (std::size_t i{0}; i < other.counts.size(); ++i) {
+      counts[static_cast<std::size_t>(other.offset - offset) + i] +=
+          other.counts[i];
+    }
+  }
+  zeros += other.zeros;
+  total += other.total;
+}
+
+double QuantileSketch::quantile(double q) const {
+  if (!(q >= 0.0 && q <= 1.0)) {
+    throw std::invalid_argument("Quantile must be in [0, 1]");
+  }
+  if (total == 0) return 0.0;
+  const std::uint64_t rank{std::min(
+      total - 1, static_cast<std::uint64_t>(q * static_cast<double>(total)))};
+  if (rank < zeros) return 0.0;
+  std::uint64_t seen{zeros};
+  for (std::size_t i{0}; i < counts.size(); ++i) {
+    seen += counts[i];
+    if (seen > rank) {
+      // midpoint of the bucket's [lower, upper) range
+      const auto index{static_cast<std::uint64_t>(offset) + i};
+      const double lower{std::bit_cast<double>(index << shift)};
+      const double upper{std::bit_cast<double>((index + 1) << shift)};
+      return 0.5 * (lower + upper);
+    }
+  }
+  return std::bit_cast<double>(
+      (static_cast<std::uint64_t>(offset) + counts.size()) << shift);
+}
+
+double QuantileSketch::relativeAccuracy() const {
+  return std::ldexp(1.0, -static_cast<int>(bits) - 1);
+}
+
+void QuantileSketch::clear() {
+  total = 0;
+  zeros = 0;
+  offset = 0;
+  counts.clear();
+}
+
+void QuantileSketch::save(std::ostream& out) const {
+  // sparse: only non-empty buckets are written
+  const auto nonEmpty{std::ranges::count_if(
+      counts, [](std::uint64_t c) { return c != 0; })};
+  out << "sketch " << bits << ' ' << total << ' ' << zeros << ' ' << nonEmpty;
+  for (std::size_t i{0}; i < counts.size(); ++i) {
+    if (counts[i] != 0) {
+      out << ' ' << offset + static_cast<std::int64_t>(i) << ' ' << counts[i];
+    }
+  }
+  out << '\n';
+}
+
+QuantileSketch QuantileSketch::load(std::istream& in) {
+  std::string tag{};
+  unsigned bits{0};
+  std::uint64_t total{0};
+  std::uint64_t zeros{0};
+  std::size_t nonEmpty{0};
+  if (!(in >> tag >> bits >> total >> zeros >> nonEmpty) || tag != "sketch" ||
+      bits < 1 || bits > 16) {
+    throw std::runtime_error("Malformed quantile sketch");
+  }
+  QuantileSketch sketch{bits};
+  std::vector<std::pair<std::int64_t, std::uint64_t>> buckets(nonEmpty);
+  std::uint64_t counted{zeros};
+  for (auto& [index, c] : buckets) {
+    if (!(in >> index >> c)) {
+      throw std::runtime_error("Malformed quantile sketch");
+    }
+    counted += c;
+  }
+  if (!buckets.empty()) {
+    const auto [lo, hi]{std::ranges::minmax_element(
+        buckets, {}, &std::pair<std::int64_t, std::uint64_t>::first)};
+    sketch.offset = lo->first;
+    sketch.counts.assign(static_cast<std::size_t>(hi->first - lo->first + 1),
+                         0);
+    for (const auto& [index, c] : buckets) {
+      sketch.counts[static_cast<std::size_t>(index - sketch.offset)] += c;
+    }
+  }
+  if (counted != total) {
+    throw std::runtime_error("Quantile sketch counts do not add up");
+  }
+  sketch.total = total;
+  sketch.zeros = zeros;
+  return sketch;
+}
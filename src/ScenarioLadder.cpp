@@ -0,0 +1,201 @@
+#include "ScenarioLadder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "Parallel.h"
+
+namespace {
+// paths per block: one block of factors (16 KiB) stays in L1 while every
+// cell of the group consumes it
+constexpr std::size_t BLOCK_SIZE{2048};
+
+struct Cell {
+  std::size_t index{};  // position in the result matrix
+  double scale{};       // S * exp((r - q - σ²/2) T)
+  double discount{};    // exp(-r T)
+};
+
+// cells sharing σ√T, and so the per-path factors exp(σ√T z)
+struct Group {
+  double volTimesSqrtT{};
+  std::vector<Cell> cells{};
+};
+
+struct Task {
+  std::size_t group{};
+  std::size_t begin{};
+  std::size_t end{};
+};
+}  // namespace
+
+ScenarioLadder::ScenarioLadder(const Option& option,
+                               unsigned long numSimulations, unsigned int seed)
+    : option{option}, numSimulations{numSimulations} {
+  if (numSimulations < 2) {
+    throw std::invalid_argument("Number of simulations must be at least 2.");
+  }
+  std::default_random_engine randomEngine{seed};
+  std::normal_distribution<double> standardNormal{0.0, 1.0};
+  normals.resize(numSimulations);
+  for (double& z : normals) {
+    z = standardNormal(randomEngine);
+  }
+}
+
+ScenarioResult ScenarioLadder::run(std::span<const ScenarioBump> rowBumps,
+                                   std::span<const ScenarioBump> colBumps,
+                                   unsigned threads) const {
+  if (rowBumps.empty() || colBumps.empty()) {
+    throw std::invalid_argument("Scenario ladder needs at least one row and "
+                                "one column.");
+  }
+  if (threads == 0) threads = parallel::defaultThreadCount();
+
+  ScenarioResult result{};
+  result.rows = rowBumps.size();
+  result.cols = colBumps.size();
+  result.prices.resize(result.rows * result.cols);
+  result.standardErrors.resize(result.rows * result.cols);
+
+  // hoist everything but the per-path factor into per-cell scalars
+  std::vector<Group> groups{};
+  std::map<std::pair<double, double>, std::size_t> groupOf{};
+  for (std::size_t i{0}; i < result.rows; ++i) {
+    for (std::size_t j{0}; j < result.cols; ++j) {
+      const ScenarioBump& a{rowBumps[i]};
+      const ScenarioBump& b{colBumps[j]};
+      // validating constructor rejects impossible scenarios
+      const Option cell{option.getType(),
+                        option.getStockPrice() * (1.0 + a.spot + b.spot),
+                        option.getStrikePrice(),
+                        option.getTimeToMaturity() + a.time + b.time,
+                        option.getRiskFreeRate() + a.rate + b.rate,
+                        option.getVolatility() + a.volatility + b.volatility,
+                        option.getDividendYield() + a.dividend + b.dividend};
+      const double T{cell.getTimeToMaturity()};
+      const double sig{cell.getVolatility()};
+      const double r{cell.getRiskFreeRate()};
+
+      const auto key{std::make_pair(sig, T)};
+      auto it{groupOf.find(key)};
+      if (it == groupOf.end()) {
+        it = groupOf.emplace(key, groups.size()).first;
+        groups.push_back(Group{sig * std::sqrt(T), {}});
+      }
+      groups[it->second].cells.push_back(Cell{
+          i * result.cols + j,
+          cell.getStockPrice() *
+              std::exp((r - cell.getDividendYield() - 0.5 * sig * sig) * T),
+          std::exp(-r * T)});
+    }
+  }
+
+  // split large groups so that few (σ, T) groups still fill every thread
+  const std::size_t partsPerGroup{
+      std::max<std::size_t>(1, (threads + groups.size() - 1) / groups.size())};
+  std::vector<Task> tasks{};
+  for (std::size_t g{0}; g < groups.size(); ++g) {
+    const std::size_t count{groups[g].cells.size()};
+    const std::size_t parts{std::min(partsPerGroup, count)};
+    for (std::size_t p{0}; p < parts; ++p) {
+      tasks.push_back(Task{g, count * p / parts, count * (p + 1) / parts});
+    }
+  }
+
+  const double K{option.getStrikePrice()};
+  const double sign{option.getType() == OptionType::CALL ? 1.0 : -1.0};
+  const double n{static_cast<double>(numSimulations)};
+
+  parallel::forEachIndex(
+      tasks.size(),
+      [&](std::size_t t) {
+        const Task& task{tasks[t]};
+        const Group& group{groups[task.group]};
+        const std::size_t numCells{task.end - task.begin};
+
+        // moments are shifted by each cell's first payoff, as in
+        // MonteCarlo, so deep in-the-money cells keep their precision
+        std::vector<double> shifts(numCells);
+        const double factor0{std::exp(group.volTimesSqrtT * normals[0])};
+        for (std::size_t c{0}; c < numCells; ++c) {
+          shifts[c] = std::max(
+              sign * (group.cells[task.begin + c].scale * factor0 - K), 0.0);
+        }
+        std::vector<double> sums(numCells, 0.0);
+        std::vector<double> sumShifted(numCells, 0.0);
+        std::vector<double> sumShiftedSqs(numCells, 0.0);
+        std::array<double, BLOCK_SIZE> factors{};
+
+        for (std::size_t start{0}; start < numSimulations;
+             start += BLOCK_SIZE) {
+          const std::size_t len{
+              std::min<std::size_t>(BLOCK_SIZE, numSimulations - start)};
+          for (std::size_t k{0}; k < len; ++k) {
+            factors[k] = std::exp(group.volTimesSqrtT * normals[start + k]);
+          }
+          for (std::size_t c{0}; c < numCells; ++c) {
+            const double scale{group.cells[task.begin + c].scale};
+            const double shift{shifts[c]};
+            double sum{0.0}, sum1{0.0}, sum2{0.0};
+            for (std::size_t k{0}; k < len; ++k) {
+              const double payoff{
+                  std::max(sign * (scale * factors[k] - K), 0.0)};
+              const double d{payoff - shift};
+              sum += payoff;
+              sum1 += d;
+              sum2 += d * d;
+            }
+            sums[c] += sum;
+            sumShifted[c] += sum1;
+            sumShiftedSqs[c] += sum2;
+          }
+        }
+
+        for (std::size_t c{0}; c < numCells; ++c) {
+          const Cell& cell{group.cells[task.begin + c]};
+          const double mean{sums[c] / n};
+          const double variance{
+              std::max(sumShiftedSqs[c] - sumShifted[c] * sumShifted[c] / n,
+                       0.0) /
+              (n - 1.0)};
+          result.prices[cell.index] = cell.discount * mean;
+          result.standardErrors[cell.index] =
+              cell.discount * std::sqrt(variance / n);
+        }
+      },
+      threads);
+
+  return result;
+}
+
+std::vector<ScenarioBump> ScenarioLadder::spotLadder(double from, double to,
+                                                     std::size_t steps) {
+  if (steps < 2) {
+    throw std::invalid_argument("A ladder needs at least two steps.");
+  }
+  std::vector<ScenarioBump> bumps(steps);
+  for (std::size_t i{0}; i < steps; ++i) {
+    bumps[i].spot = from + (to - from) * static_cast<double>(i) /
+                               static_cast<double>(steps - 1);
+  }
+  return bumps;
+}
+
+std::vector<ScenarioBump> ScenarioLadder::volLadder(double from, double to,
+                                                    std::size_t steps) {
+  if (steps < 2) {
+    throw std::invalid_argument("A ladder needs at least two steps.");
+  }
+  std::vector<ScenarioBump> bumps(steps);
+  for (std::size_t i{0}; i < steps; ++i) {
+    bumps[i].volatility = from + (to - from) * static_cast<double>(i) /
+                                     static_cast<double>(steps - 1);
+  }
+  return bumps;
+}
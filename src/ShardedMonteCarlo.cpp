@@ -0,0 +1,183 @@
+#include "ShardedMonteCarlo.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "MonteCarlo.h"
+#include "Parallel.h"
+#include "RandomStreams.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#define PRICER_HAS_FORK 1
+#endif
+
+ShardedMonteCarlo::ShardedMonteCarlo(const Option& option, Config config)
+    : option{option}, config{config} {
+  if (config.shards == 0 || config.pathsPerShard == 0) {
+    throw std::invalid_argument("Shards and paths per shard must be positive.");
+  }
+  if (config.pathsPerShard >
+      random_streams::stride(config.shards) /
+          MonteCarlo::DRAWS_PER_PATH_BOUND) {
+    throw std::invalid_argument(
+        "Paths per shard exceed the random substream capacity; use fewer "
+        "shards or paths.");
+  }
+}
+
+MonteCarloPartial ShardedMonteCarlo::runShard(unsigned shard) const {
+  if (shard >= config.shards) {
+    throw std::out_of_range("Shard index out of range");
+  }
+  MonteCarlo mc{option, config.pathsPerShard,
+                random_streams::seed(config.seed, shard, config.shards)};
+  mc.setStorePaths(config.greeks);  // Greek sums need the normals
+  mc.calculatePrice();
+  return mc.getPartial(config.greeks);
+}
+
+MonteCarloPartial ShardedMonteCarlo::mergeAll(
+    const std::vector<MonteCarloPartial>& partials) {
+  MonteCarloPartial merged{};
+  for (const MonteCarloPartial& p : partials) merged.merge(p);
+  return merged;
+}
+
+MonteCarloPartial ShardedMonteCarlo::runInProcess(unsigned threads) const {
+  std::vector<MonteCarloPartial> partials(config.shards);
+  parallel::forEachIndex(
+      config.shards,
+      [&](std::size_t s) {
+        partials[s] = runShard(static_cast<unsigned>(s));
+      },
+      threads);
+  return mergeAll(partials);
+}
+
+MonteCarloPartial ShardedMonteCarlo::runProcesses(unsigned processes) const {
+#ifdef PRICER_HAS_FORK
+  const unsigned workers{std::clamp(processes, 1u, config.shards)};
+  struct Worker {
+    pid_t pid{-1};
+    int fd{-1};
+    std::string output{};
+  };
+  std::vector<Worker> pool(workers);
+
+  auto cleanup = [&pool] {
+    for (Worker& w : pool) {
+      if (w.fd >= 0) ::close(w.fd);
+      if (w.pid > 0) ::waitpid(w.pid, nullptr, 0);
+    }
+  };
+
+  for (unsigned w{0}; w < workers; ++w) {
+    int fds[2]{};
+    if (::pipe(fds) != 0) {
+      cleanup();
+      throw std::runtime_error("Cannot create worker pipe");
+    }
+    const pid_t pid{::fork()};
+    if (pid < 0) {
+      ::close(fds[0]);
+      ::close(fds[1]);
+      cleanup();
+      throw std::runtime_error("Cannot fork worker process");
+    }
+    if (pid == 0) {
+      // worker: run its shards, write "shard <k>" + partial for each
+      ::close(fds[0]);
+      int status{0};
+      try {
+        for (unsigned s{w}; s < config.shards; s += workers) {
+          std::ostringstream out{};
+          out << "shard " << s << '\n';
+          runShard(s).save(out);
+          const std::string text{out.str()};
+          for (std::size_t done{0}; done < text.size();) {
+            const ssize_t n{::write(fds[1], text.data() + done,
+                                    text.size() - done)};
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) throw std::runtime_error("pipe write failed");
+            done += static_cast<std::size_t>(n);
+          }
+        }
+      } catch (...) {
+        status = 1;
+      }
+      ::close(fds[1]);
+      ::_exit(status);  // skip the parent's atexit handlers and destructors
+    }
+    ::close(fds[1]);
+    pool[w].pid = pid;
+    pool[w].fd = fds[0];
+  }
+
+  // drain every pipe until all workers close their end
+  std::vector<pollfd> polls(workers);
+  for (unsigned open{workers}; open > 0;) {
+    for (unsigned w{0}; w < workers; ++w) {
+      polls[w] = pollfd{pool[w].fd, POLLIN, 0};
+    }
+    if (::poll(polls.data(), polls.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      cleanup();
+      throw std::runtime_error("poll failed while reading workers");
+    }
+    for (unsigned w{0}; w < workers; ++w) {
+      if (pool[w].fd < 0 || polls[w].revents == 0) continue;
+      char buf[4096];
+      const ssize_t n{::read(pool[w].fd, buf, sizeof(buf))};
+      if (n > 0) {
+        pool[w].output.append(buf, static_cast<std::size_t>(n));
+      } else if (n == 0 || errno != EINTR) {
+        ::close(pool[w].fd);
+        pool[w].fd = -1;
+        --open;
+      }
+    }
+  }
+
+  bool failed{false};
+  for (Worker& w : pool) {
+    int status{0};
+    ::waitpid(w.pid, &status, 0);
+    w.pid = -1;
+    failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+  }
+  if (failed) {
+    throw std::runtime_error("A Monte Carlo worker process failed");
+  }
+
+  std::vector<MonteCarloPartial> partials(config.shards);
+  std::vector<bool> seen(config.shards, false);
+  for (const Worker& w : pool) {
+    std::istringstream in{w.output};
+    std::string tag{};
+    unsigned shard{0};
+    while (in >> tag) {
+      if (tag != "shard" || !(in >> shard) || shard >= config.shards ||
+          seen[shard]) {
+        throw std::runtime_error("Malformed output from worker process");
+      }
+      partials[shard] = MonteCarloPartial::load(in);
+      seen[shard] = true;
+    }
+  }
+  if (std::ranges::count(seen, false) != 0) {
+    throw std::runtime_error("Worker processes did not return every shard");
+  }
+  return mergeAll(partials);
+#else
+  (void)processes;
+  throw std::runtime_error("Worker processes need a POSIX system");
+#endif
+}
@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BatchIO.h"
+#include "BlackScholes.h"
+#include "BoundedQueue.h"
+#include "ImpliedVol.h"
+#include "MonteCarlo.h"
+#include "OptionChainFile.h"
+#include "Parallel.h"
+#include "PriceCache.h"
+
+namespace {
+struct CliOptions {
+  BatchConfig config{};
+  std::string input{"-"};
+  std::string output{"-"};
+  bool binary{false};
+  bool chain{false};        // input is a memory-mapped columnar chain
+  std::string toChain{};    // convert the input to a chain file instead
+  unsigned threads{0};
+  std::size_t batchSize{4096};
+  std::size_t queueDepth{8};
+  std::size_t cacheEntries{0};  // 0 = no result cache
+};
+
+struct RecordBatch {
+  std::uint64_t sequence{};
+  std::vector<OptionRecord> records{};
+};
+
+struct ResultBatch {
+  std::uint64_t sequence{};
+  std::vector<BatchResult> results{};
+};
+
+void printUsage(const char* argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " [options]\n"
+      << "  --engine bs|mc|iv    pricing engine (default bs)\n"
+      << "  --input PATH         input file, '-' for stdin (default -)\n"
+      << "  --output PATH        output file, '-' for stdout (default -)\n"
+      << "  --format csv|bin|chain  input format (default csv); chain\n"
+      << "                       results are appended to the input file\n"
+      << "  --to-chain PATH      convert csv/bin input to a chain file\n"
+      << "  --paths N            Monte Carlo paths per option (default "
+         "100000)\n"
+      << "  --seed N             base Monte Carlo seed (default 42)\n"
+      << "  --threads N          pricing threads (default: all cores)\n"
+      << "  --batch N            records per pipeline batch (default 4096)\n"
+      << "  --queue N            batches buffered per stage (default 8)\n"
+      << "  --cache N            cache up to N results for repeated "
+         "contracts\n"
+      << "  --seed-by-contract   MC seed from the contract, not the row id\n"
+      << "CSV input rows: type,S,K,T,r,sigma,q[,price]\n"
+      << "Output rows:    id,value,std_error,error\n";
+}
+
+CliOptions parseArgs(int argc, char** argv) {
+  CliOptions opts{};
+  for (int i{1}; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    auto next = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("Missing value for " + std::string{arg});
+      }
+      return argv[++i];
+    };
+    if (arg == "--engine") {
+      opts.config.engine = batch::parseEngine(next());
+    } else if (arg == "--input") {
+      opts.input = next();
+    } else if (arg == "--output") {
+      opts.output = next();
+    } else if (arg == "--format") {
+      const std::string format{next()};
+      if (format != "csv" && format != "bin" && format != "chain") {
+        throw std::invalid_argument("Unknown format '" + format + "'");
+      }
+      opts.binary = format == "bin";
+      opts.chain = format == "chain";
+    } else if (arg == "--to-chain") {
+      opts.toChain = next();
+    } else if (arg == "--paths") {
+      opts.config.numSimulations = std::stoul(next());
+    } else if (arg == "--seed") {
+      opts.config.seed = static_cast<unsigned int>(std::stoul(next()));
+    } else if (arg == "--threads") {
+      opts.threads = static_cast<unsigned>(std::stoul(next()));
+    } else if (arg == "--batch") {
+      opts.batchSize = std::stoul(next());
+    } else if (arg == "--queue") {
+      opts.queueDepth = std::stoul(next());
+    } else if (arg == "--cache") {
+      opts.cacheEntries = std::stoul(next());
+    } else if (arg == "--seed-by-contract") {
+      opts.config.seedByContract = true;
+    } else if (arg == "--help" || arg == "-h") {
+      printUsage(argv[0]);
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unknown argument " + std::string{arg});
+    }
+  }
+  if (opts.batchSize == 0 || opts.queueDepth == 0) {
+    throw std::invalid_argument("--batch and --queue must be positive");
+  }
+  if (opts.chain && (opts.input == "-" || !opts.toChain.empty())) {
+    throw std::invalid_argument("--format chain needs an --input file and "
+                                "cannot be combined with --to-chain");
+  }
+  if (opts.threads == 0) opts.threads = parallel::defaultThreadCount();
+  return opts;
+}
+
+// Prices a memory-mapped chain in place: columns go straight to the batch
+// kernels and the results are appended to the same file.
+int runChain(const CliOptions& opts) {
+  constexpr std::size_t CHUNK{65536};
+  const auto start{std::chrono::steady_clock::now()};
+
+  std::vector<double> values{};
+  std::vector<double> errors{};
+  {
+    const MappedOptionChain mapped{opts.input};
+    const OptionColumns all{mapped.columns()};
+    const std::size_t rows{mapped.size()};
+    values.resize(rows);
+    errors.assign(rows, 0.0);
+
+    parallel::forEachIndex(
+        (rows + CHUNK - 1) / CHUNK,
+        [&](std::size_t c) {
+          const std::size_t begin{c * CHUNK};
+          const std::size_t len{std::min(CHUNK, rows - begin)};
+          const OptionColumns part{
+              all.type.subspan(begin, len), all.S.subspan(begin, len),
+              all.K.subspan(begin, len),    all.T.subspan(begin, len),
+              all.r.subspan(begin, len),    all.sigma.subspan(begin, len),
+              all.q.subspan(begin, len)};
+          const std::span<double> out{values.data() + begin, len};
+          switch (opts.config.engine) {
+            case BatchEngine::BLACK_SCHOLES:
+              BlackScholes::priceBatch(part, out);
+              break;
+            case BatchEngine::IMPLIED_VOL:
+              impliedVolBatch(part, mapped.marketPrices().subspan(begin, len),
+                              out);
+              break;
+            case BatchEngine::MONTE_CARLO:
+              for (std::size_t i{0}; i < len; ++i) {
+                MonteCarlo mc{Option{part.type[i], part.S[i], part.K[i],
+                                     part.T[i], part.r[i], part.sigma[i],
+                                     part.q[i]},
+                              opts.config.numSimulations,
+                              opts.config.seed +
+                                  static_cast<unsigned int>(begin + i)};
+                out[i] = mc.calculatePrice();
+                errors[begin + i] = mc.getStandardError();
+              }
+              break;
+          }
+        },
+        opts.threads);
+  }  // unmap before growing the file
+  chain::appendResults(opts.input, values, errors);
+
+  const std::chrono::duration<double> elapsed{
+      std::chrono::steady_clock::now() - start};
+  std::cerr << "priced " << values.size() << " chain rows in " << std::fixed
+            << std::setprecision(3) << elapsed.count() << "s, "
+            << std::setprecision(0)
+            << (elapsed.count() > 0 ? values.size() / elapsed.count() : 0.0)
+            << " rows/s on " << opts.threads
+            << " thread(s); results appended to " << opts.input << "\n";
+  return 0;
+}
+
+// Reads csv/bin records and writes them out as a validated chain file.
+int convertToChain(std::istream& in, const CliOptions& opts) {
+  OptionChainData data{};
+  std::vector<OptionRecord> records{};
+  std::uint64_t nextId{0};
+  if (opts.binary) batch::readBinaryHeader(in);
+  while ((opts.binary
+              ? batch::readBinaryBatch(in, records, opts.batchSize, nextId)
+              : batch::readCsvBatch(in, records, opts.batchSize, nextId)) >
+         0) {
+    for (const OptionRecord& rec : records) {
+      if (!rec.error.empty()) {
+        throw std::invalid_argument("Record " + std::to_string(rec.id) +
+                                    ": " + rec.error);
+      }
+      data.type.push_back(rec.type);
+      data.S.push_back(rec.S);
+      data.K.push_back(rec.K);
+      data.T.push_back(rec.T);
+      data.r.push_back(rec.r);
+      data.sigma.push_back(rec.sigma);
+      data.q.push_back(rec.q);
+      data.marketPrice.push_back(rec.marketPrice);
+    }
+  }
+  chain::write(opts.toChain, data.columns(), data.marketPrice);
+  std::cerr << "wrote " << data.size() << " rows to " << opts.toChain << "\n";
+  return 0;
+}
+
+template <class T>
+void printQueueStats(const char* name, const BoundedQueue<T>& queue) {
+  const auto stats{queue.getStats()};
+  std::cerr << "  " << std::left << std::setw(16) << name << std::right
+            << " producer blocked " << std::setw(6) << stats.pushWaits
+            << "x / " << std::fixed << std::setprecision(3)
+            << stats.pushBlocked.count() << "s"
+            << ", consumer starved " << std::setw(6) << stats.popWaits
+            << "x / " << stats.popBlocked.count() << "s\n";
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  CliOptions opts{};
+  try {
+    opts = parseArgs(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << "error: " << e.what() << "\n";
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  if (opts.chain) {
+    try {
+      return runChain(opts);
+    } catch (const std::exception& e) {
+      std::cerr << "error: " << e.what() << "\n";
+      return 1;
+    }
+  }
+
+  std::ifstream inFile{};
+  if (opts.input != "-") {
+    inFile.open(opts.input, std::ios::binary);
+    if (!inFile) {
+      std::cerr << "error: cannot open " << opts.input << "\n";
+      return 1;
+    }
+  }
+  std::istream& in{opts.input == "-" ? std::cin : inFile};
+
+  if (!opts.toChain.empty()) {
+    try {
+      return convertToChain(in, opts);
+    } catch (const std::exception& e) {
+      std::cerr << "error: " << e.what() << "\n";
+      return 1;
+    }
+  }
+
+  std::ofstream outFile{};
+  if (opts.output != "-") {
+    outFile.open(opts.output);
+    if (!outFile) {
+      std::cerr << "error: cannot open " << opts.output << "\n";
+      return 1;
+    }
+  }
+  std::ostream& out{opts.output == "-" ? std::cout : outFile};
+  std::ios::sync_with_stdio(false);
+
+  std::unique_ptr<PriceCache> cache{};
+  if (opts.cacheEntries > 0) {
+    cache = std::make_unique<PriceCache>(
+        PriceCache::Config{opts.cacheEntries, 64, 0});
+    opts.config.cache = cache.get();
+  }
+
+  BoundedQueue<RecordBatch> parsed{opts.queueDepth};
+  BoundedQueue<ResultBatch> priced{opts.queueDepth};
+  std::string readError{};
+  // reorder window: a pricer holds a batch until it is within queueDepth
+  // batches of the next one to write, so a slow batch cannot make the
+  // writer's pending results grow with the input
+  std::mutex windowMutex{};
+  std::condition_variable windowMoved{};
+  std::uint64_t nextSeq{0};
+
+  const auto start{std::chrono::steady_clock::now()};
+
+  // stage 1: parse
+  std::jthread reader{[&] {
+    try {
+      if (opts.binary) batch::readBinaryHeader(in);
+      std::uint64_t nextId{0};
+      for (std::uint64_t seq{0};; ++seq) {
+        RecordBatch b{seq, {}};
+        b.records.reserve(opts.batchSize);
+        const std::size_t n{
+            opts.binary
+                ? batch::readBinaryBatch(in, b.records, opts.batchSize, nextId)
+                : batch::readCsvBatch(in, b.records, opts.batchSize, nextId)};
+        if (n == 0 || !parsed.push(std::move(b))) break;
+      }
+    } catch (const std::exception& e) {
+      readError = e.what();
+    }
+    parsed.close();
+  }};
+
+  // stage 2: price
+  std::vector<std::jthread> pricers{};
+  std::atomic<unsigned> activePricers{opts.threads};
+  for (unsigned t{0}; t < opts.threads; ++t) {
+    pricers.emplace_back([&] {
+      while (auto b{parsed.pop()}) {
+        {
+          // never blocks the batch the writer waits for, so cannot deadlock
+          std::unique_lock lock{windowMutex};
+          windowMoved.wait(lock, [&] {
+            return b->sequence < nextSeq + opts.queueDepth;
+          });
+        }
+        ResultBatch r{b->sequence, {}};
+        r.results.reserve(b->records.size());
+        for (const OptionRecord& rec : b->records) {
+          r.results.push_back(batch::priceRecord(rec, opts.config));
+        }
+        priced.push(std::move(r));
+      }
+      if (--activePricers == 0) priced.close();
+    });
+  }
+
+  // stage 3: write, restoring input order
+  out << "id,value,std_error,error\n";
+  std::map<std::uint64_t, std::vector<BatchResult>> pending{};
+  std::uint64_t records{0};
+  std::uint64_t failures{0};
+  std::uint64_t written{0};
+  while (auto r{priced.pop()}) {
+    pending.emplace(r->sequence, std::move(r->results));
+    for (auto it{pending.find(written)}; it != pending.end();
+         it = pending.find(++written)) {
+      for (const BatchResult& res : it->second) {
+        batch::writeCsvResult(out, res);
+        if (!res.error.empty()) ++failures;
+      }
+      records += it->second.size();
+      pending.erase(it);
+    }
+    {
+      const std::lock_guard lock{windowMutex};
+      nextSeq = written;
+    }
+    windowMoved.notify_all();
+  }
+  out.flush();
+
+  reader.join();
+  pricers.clear();
+  const std::chrono::duration<double> elapsed{
+      std::chrono::steady_clock::now() - start};
+
+  std::cerr << "priced " << records << " records (" << failures
+            << " failed) in " << std::fixed << std::setprecision(3)
+            << elapsed.count() << "s, "
+            << std::setprecision(0)
+            << (elapsed.count() > 0 ? records / elapsed.count() : 0.0)
+            << " records/s on " << opts.threads << " thread(s)\n"
+            << "stage backpressure:\n";
+  printQueueStats("parse->price", parsed);
+  printQueueStats("price->write", priced);
+  if (cache) {
+    const PriceCache::Stats stats{cache->getStats()};
+    std::cerr << "result cache: " << stats.hits << " hits, " << stats.misses
+              << " misses (" << std::setprecision(1) << 100.0 * stats.hitRate()
+              << "%), " << stats.evictions << " evictions\n";
+  }
+
+  if (!readError.empty()) {
+    std::cerr << "error: " << readError << "\n";
+    return 1;
+  }
+  return 0;
+}
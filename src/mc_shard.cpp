@@ -0,0 +1,127 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "ShardedMonteCarlo.h"
+
+namespace {
+void printUsage(const char* argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " [options]\n"
+      << "  --type call|put   option type (default call)\n"
+      << "  --S --K --T --r --sigma --q VALUE   option parameters\n"
+      << "  --shards N        number of shards / substreams (default 8)\n"
+      << "  --paths N         paths per shard (default 100000)\n"
+      << "  --seed N          base seed (default 42)\n"
+      << "  --processes N     worker processes (default 0 = in-process)\n"
+      << "  --threads N       threads for in-process runs (default 1)\n"
+      << "  --greeks          also compute Greeks\n"
+      << "  --worker K        run shard K only and print its partial result\n"
+      << "  --merge           read partial results from stdin and merge them\n";
+}
+
+void printResult(const MonteCarloPartial& result, const Option& option,
+                 bool greeks) {
+  std::cout << std::setprecision(10) << "paths  " << result.paths
+            << "\nprice  " << result.price(option) << "\nse     "
+            << result.standardError(option) << "\nvar5%  "
+            << result.valueAtRisk(0.05) << "\n";
+  if (greeks) std::cout << result.greeks(option) << "\n";
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  OptionType type{OptionType::CALL};
+  double S{100.0}, K{100.0}, T{1.0}, r{0.05}, sigma{0.2}, q{0.0};
+  ShardedMonteCarlo::Config config{};
+  unsigned processes{0};
+  unsigned threads{1};
+  std::optional<unsigned> worker{};
+  bool merge{false};
+
+  try {
+    for (int i{1}; i < argc; ++i) {
+      const std::string_view arg{argv[i]};
+      auto next = [&]() -> std::string {
+        if (i + 1 >= argc) {
+          throw std::invalid_argument("Missing value for " + std::string{arg});
+        }
+        return argv[++i];
+      };
+      if (arg == "--type") {
+        type = next() == "put" ? OptionType::PUT : OptionType::CALL;
+      } else if (arg == "--S") {
+        S = std::stod(next());
+      } else if (arg == "--K") {
+        K = std::stod(next());
+      } else if (arg == "--T") {
+        T = std::stod(next());
+      } else if (arg == "--r") {
+        r = std::stod(next());
+      } else if (arg == "--sigma") {
+        sigma = std::stod(next());
+      } else if (arg == "--q") {
+        q = std::stod(next());
+      } else if (arg == "--shards") {
+        config.shards = static_cast<unsigned>(std::stoul(next()));
+      } else if (arg == "--paths") {
+        config.pathsPerShard = std::stoul(next());
+      } else if (arg == "--seed") {
+        config.seed = static_cast<unsigned int>(std::stoul(next()));
+      } else if (arg == "--processes") {
+        processes = static_cast<unsigned>(std::stoul(next()));
+      } else if (arg == "--threads") {
+        threads = static_cast<unsigned>(std::stoul(next()));
+      } else if (arg == "--greeks") {
+        config.greeks = true;
+      } else if (arg == "--worker") {
+        worker = static_cast<unsigned>(std::stoul(next()));
+      } else if (arg == "--merge") {
+        merge = true;
+      } else if (arg == "--help" || arg == "-h") {
+        printUsage(argv[0]);
+        return 0;
+      } else {
+        throw std::invalid_argument("Unknown argument " + std::string{arg});
+      }
+    }
+
+    const Option option{type, S, K, T, r, sigma, q};
+    if (merge) {
+      // partials from remote workers, in shard order
+      MonteCarloPartial merged{};
+      while (std::cin >> std::ws && !std::cin.eof()) {
+        merged.merge(MonteCarloPartial::load(std::cin));
+      }
+      printResult(merged, option, merged.hasGreeks);
+      return 0;
+    }
+
+    const ShardedMonteCarlo sharded{option, config};
+    if (worker) {
+      sharded.runShard(*worker).save(std::cout);
+      return 0;
+    }
+
+    const auto start{std::chrono::steady_clock::now()};
+    const MonteCarloPartial result{processes > 0
+                                       ? sharded.runProcesses(processes)
+                                       : sharded.runInProcess(threads)};
+    const std::chrono::duration<double> elapsed{
+        std::chrono::steady_clock::now() - start};
+    printResult(result, option, config.greeks);
+    std::cerr << std::fixed << std::setprecision(3) << "ran " << config.shards
+              << " shards in " << elapsed.count() << "s using "
+              << (processes > 0 ? std::to_string(processes) + " process(es)"
+                                : std::to_string(threads) + " thread(s)")
+              << "\n";
+  } catch (const std::exception& e) {
+    std::cerr << "error: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "PricingService.h"
+
+namespace {
+void printUsage(const char* argv0) {
+  std::cerr << "Usage: " << argv0 << " [options]\n"
+            << "  --name NAME      service name (default mcpricer)\n"
+            << "  --requests N     number of requests to send (default "
+               "100000)\n"
+            << "  --engine bs|iv   request type (default bs)\n"
+            << "  --inflight N     requests kept in flight (default 1)\n"
+            << "  --control CMD    send STATS or STOP and exit\n";
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string name{"mcpricer"};
+  std::size_t total{100000};
+  std::size_t inflight{1};
+  ServiceEngine engine{ServiceEngine::BLACK_SCHOLES};
+  std::string command{};
+  for (int i{1}; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (i + 1 >= argc) {
+      printUsage(argv[0]);
+      return 2;
+    }
+    if (arg == "--name") {
+      name = argv[++i];
+    } else if (arg == "--requests") {
+      total = std::stoul(argv[++i]);
+    } else if (arg == "--inflight") {
+      inflight = std::max<std::size_t>(1, std::stoul(argv[++i]));
+    } else if (arg == "--engine") {
+      engine = std::string_view{argv[++i]} == "iv"
+                   ? ServiceEngine::IMPLIED_VOL
+                   : ServiceEngine::BLACK_SCHOLES;
+    } else if (arg == "--control") {
+      command = argv[++i];
+    } else {
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  try {
+    if (!command.empty()) {
+      std::cout << PricingClient::control(name, command) << "\n";
+      return 0;
+    }
+
+    PricingClient client{name};
+    std::mt19937 rng{7u};
+    std::uniform_real_distribution<double> strikes{80.0, 120.0};
+    using Clock = std::chrono::steady_clock;
+    std::vector<Clock::time_point> sentAt(total);
+    std::vector<double> latencies{};
+    latencies.reserve(total);
+
+    std::size_t sent{0};
+    std::size_t failed{0};
+    const auto start{Clock::now()};
+    while (latencies.size() < total) {
+      // keep up to `inflight` requests outstanding
+      while (sent < total && sent - latencies.size() < inflight) {
+        PricingRequest req{sent, engine, OptionType::CALL, 100.0,
+                           strikes(rng), 0.5, 0.03, 0.25, 0.0, 6.0};
+        sentAt[sent] = Clock::now();
+        if (!client.trySubmit(req)) break;
+        ++sent;
+      }
+      PricingResponse resp{};
+      bool any{false};
+      while (client.tryReceive(resp)) {
+        latencies.push_back(std::chrono::duration<double, std::micro>(
+                                Clock::now() - sentAt[resp.requestId])
+                                .count());
+        failed += resp.status != 0;
+        any = true;
+      }
+      if (!any) std::this_thread::yield();
+    }
+    const std::chrono::duration<double> elapsed{Clock::now() - start};
+
+    std::ranges::sort(latencies);
+    auto pct = [&](double p) {
+      return latencies[std::min(latencies.size() - 1,
+                                static_cast<std::size_t>(
+                                    p * static_cast<double>(latencies.size())))];
+    };
+    std::cout << std::fixed << std::setprecision(2) << total << " requests ("
+              << failed << " failed) in " << elapsed.count() << "s, "
+              << std::setprecision(0) << total / elapsed.count()
+              << " req/s\nlatency us: p50=" << std::setprecision(2)
+              << pct(0.50) << " p99=" << pct(0.99) << " p99.9=" << pct(0.999)
+              << " max=" << latencies.back() << "\n";
+  } catch (const std::exception& e) {
+    std::cerr << "error: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "Parallel.h"
+#include "PricingService.h"
+
+namespace {
+PricingService* activeService{nullptr};
+
+void handleSignal(int) {
+  if (activeService != nullptr) activeService->stop();
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  PricingService::Config config{};
+  config.threads = parallel::defaultThreadCount();
+  for (int i{1}; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg == "--name" && i + 1 < argc) {
+      config.name = argv[++i];
+    } else if (arg == "--threads" && i + 1 < argc) {
+      config.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--name NAME] [--threads N]\n";
+      return 2;
+    }
+  }
+
+  try {
+    PricingService service{config};
+    activeService = &service;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::cerr << "serving '" << config.name << "' (control socket "
+              << PricingService::socketPath(config.name) << ")\n";
+    service.run();
+    activeService = nullptr;
+
+    const auto stats{service.getStats()};
+    std::cerr << "served " << stats.requests << " requests in "
+              << stats.batches << " batches (largest " << stats.largestBatch
+              << ")\n";
+  } catch (const std::exception& e) {
+    std::cerr << "error: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
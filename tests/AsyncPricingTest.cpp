@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "AsyncPricing.h"
+#include "BlackScholes.h"
+#include "MonteCarlo.h"
+#include "Option.h"
+
+namespace {
+Option testOption() {
+  return Option::createCall(100, 100, 1.0, 0.05, 0.2, 0.0);
+}
+
+async::Task<double> priceTwice(std::shared_ptr<Pricer> a,
+                               std::shared_ptr<Pricer> b,
+                               PricingExecutor& executor) {
+  const AsyncPriceResult first{co_await async::price(a, {}, executor)};
+  const AsyncPriceResult second{co_await async::price(b, {}, executor)};
+  co_return *first.price + *second.price;
+}
+}  // namespace
+
+TEST(AsyncPricing, FutureMatchesSynchronousPrice) {
+  PricingExecutor executor{2};
+  auto pricer{std::make_shared<MonteCarlo>(testOption(), 20000, 3u)};
+  const AsyncPriceResult result{async::priceFuture(pricer, {}, executor).get()};
+
+  MonteCarlo sync(testOption(), 20000, 3u);
+  EXPECT_FALSE(result.cancelled);
+  ASSERT_TRUE(result.price.has_value());
+  EXPECT_EQ(*result.price, sync.calculatePrice());
+  EXPECT_EQ(*result.standardError, sync.getStandardError());
+  EXPECT_EQ(result.pricer, pricer);
+}
+
+TEST(AsyncPricing, AnalyticPricerHasNoStandardError) {
+  PricingExecutor executor{1};
+  const AsyncPriceResult result{
+      async::priceFuture(std::make_shared<BlackScholes>(testOption()), {},
+                         executor)
+          .get()};
+  ASSERT_TRUE(result.price.has_value());
+  EXPECT_NEAR(*result.price, 10.4506, 1e-4);
+  EXPECT_FALSE(result.standardError.has_value());
+}
+
+TEST(AsyncPricing, StoppedBeforeStartIsCancelledWithoutPrice) {
+  PricingExecutor executor{1};
+  std::stop_source source{};
+  source.request_stop();
+  auto pricer{std::make_shared<MonteCarlo>(testOption(), 20000, 3u)};
+  const AsyncPriceResult result{
+      async::priceFuture(pricer, source.get_token(), executor).get()};
+  EXPECT_TRUE(result.cancelled);
+  EXPECT_FALSE(result.price.has_value());
+  EXPECT_FALSE(pricer->isPriceCalculated());
+}
+
+TEST(AsyncPricing, CancelledRunKeepsPartialStatisticsAndResumes) {
+  constexpr unsigned long total{4000000};
+  PricingExecutor executor{1};
+  std::stop_source source{};
+  auto pricer{std::make_shared<MonteCarlo>(testOption(), total, 11u)};
+  pricer->setStorePaths(false);
+  auto future{async::priceFuture(pricer, source.get_token(), executor)};
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  source.request_stop();
+  const AsyncPriceResult result{future.get()};
+
+  if (!result.cancelled || !result.price) {
+    GTEST_SKIP() << "stop request did not land mid-run";
+  }
+  EXPECT_LT(pricer->getNumSimulations(), total);
+  EXPECT_EQ(pricer->getNumSimulations() + pricer->getPendingSimulations(),
+            total);
+  EXPECT_TRUE(std::isfinite(*result.price));
+  EXPECT_GT(*result.standardError, 0.0);
+
+  MonteCarlo full(testOption(), total, 11u);
+  full.setStorePaths(false);
+  EXPECT_EQ(pricer->runMoreSimulations(pricer->getPendingSimulations()),
+            full.calculatePrice());
+  EXPECT_EQ(pricer->getStandardError(), full.getStandardError());
+}
+
+TEST(AsyncPricing, CoroutineAwaitsPricings) {
+  PricingExecutor executor{2};
+  auto a{std::make_shared<MonteCarlo>(testOption(), 10000, 1u)};
+  auto b{std::make_shared<BlackScholes>(testOption())};
+  async::Task<double> task{priceTwice(a, b, executor)};
+  const double sum{task.get()};
+  EXPECT_TRUE(task.isReady());
+  EXPECT_DOUBLE_EQ(sum, a->getPrice() + b->getPrice());
+}
+
+TEST(AsyncPricing, ConcurrentSubmissionsAllComplete) {
+  PricingExecutor executor{3};
+  std::vector<std::shared_ptr<MonteCarlo>> pricers{};
+  std::vector<std::future<AsyncPriceResult>> futures{};
+  for (unsigned i{0}; i < 8; ++i) {
+    pricers.push_back(std::make_shared<MonteCarlo>(testOption(), 5000, i));
+    futures.push_back(async::priceFuture(pricers.back(), {}, executor));
+  }
+  for (unsigned i{0}; i < 8; ++i) {
+    MonteCarlo sync(testOption(), 5000, i);
+    EXPECT_EQ(*futures[i].get().price, sync.calculatePrice());
+  }
+}
+
+TEST(AsyncPricing, DestructorDrainsQueuedWork) {
+  std::atomic<int> done{0};
+  {
+    PricingExecutor executor{1};
+    for (int i{0}; i < 16; ++i) {
+      executor.post([&done] { done.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(done.load(), 16);
+}
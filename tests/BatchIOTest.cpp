@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "BatchIO.h"
+#include "BlackScholes.h"
+#include "BoundedQueue.h"
+
+TEST(BatchIO, ParsesCsvLines) {
+  OptionRecord rec{};
+  EXPECT_TRUE(batch::parseCsvLine("put, 100, 110, 0.5, 0.03, 0.25, 0.01", rec));
+  EXPECT_EQ(rec.type, OptionType::PUT);
+  EXPECT_DOUBLE_EQ(rec.K, 110.0);
+  EXPECT_DOUBLE_EQ(rec.q, 0.01);
+  EXPECT_DOUBLE_EQ(rec.marketPrice, 0.0);
+
+  EXPECT_TRUE(batch::parseCsvLine("C,100,100,1,0.05,0.2,0,10.45", rec));
+  EXPECT_EQ(rec.type, OptionType::CALL);
+  EXPECT_DOUBLE_EQ(rec.marketPrice, 10.45);
+
+  EXPECT_FALSE(batch::parseCsvLine("type,S,K,T,r,sigma,q", rec));
+  EXPECT_FALSE(batch::parseCsvLine("# comment", rec));
+  EXPECT_FALSE(batch::parseCsvLine("   ", rec));
+  EXPECT_THROW(batch::parseCsvLine("call,100,abc,1,0.05,0.2,0", rec),
+               std::invalid_argument);
+  EXPECT_THROW(batch::parseCsvLine("swap,100,100,1,0.05,0.2,0", rec),
+               std::invalid_argument);
+}
+
+TEST(BatchIO, BinaryRoundTrip) {
+  std::vector<OptionRecord> records{
+      {0, OptionType::CALL, 100, 100, 1, 0.05, 0.2, 0, 10.0},
+      {1, OptionType::PUT, 90, 100, 0.5, 0.01, 0.3, 0.02, 0.0}};
+  std::stringstream buf;
+  batch::writeBinaryRecords(buf, records);
+
+  batch::readBinaryHeader(buf);
+  std::vector<OptionRecord> back;
+  std::uint64_t nextId = 0;
+  EXPECT_EQ(batch::readBinaryBatch(buf, back, 16, nextId), 2u);
+  EXPECT_EQ(back[1].type, OptionType::PUT);
+  EXPECT_DOUBLE_EQ(back[1].q, 0.02);
+  EXPECT_EQ(back[1].id, 1u);
+  EXPECT_EQ(batch::readBinaryBatch(buf, back, 16, nextId), 0u);
+}
+
+TEST(BatchIO, PricesWithEachEngine) {
+  OptionRecord rec{7, OptionType::CALL, 100, 100, 1, 0.05, 0.2, 0, 0};
+  const double bsPrice =
+      BlackScholes(Option::createCall(100, 100, 1, 0.05, 0.2)).calculatePrice();
+
+  BatchConfig cfg{};
+  EXPECT_DOUBLE_EQ(batch::priceRecord(rec, cfg).value, bsPrice);
+
+  cfg.engine = BatchEngine::MONTE_CARLO;
+  cfg.numSimulations = 50000;
+  BatchResult mc = batch::priceRecord(rec, cfg);
+  EXPECT_NEAR(mc.value, bsPrice, 4 * mc.standardError);
+
+  cfg.engine = BatchEngine::IMPLIED_VOL;
+  rec.marketPrice = bsPrice;
+  EXPECT_NEAR(batch::priceRecord(rec, cfg).value, 0.2, 1e-6);
+
+  rec.S = -1;  // bad rows are reported, not thrown
+  BatchResult bad = batch::priceRecord(rec, cfg);
+  EXPECT_EQ(bad.id, 7u);
+  EXPECT_FALSE(bad.error.empty());
+}
+
+TEST(BatchIO, MalformedRowsBecomeErrorResults) {
+  std::istringstream csv{
+      "type,S,K,T,r,sigma,q\n"
+      "call,100,100,1,0.05,0.2,0\n"
+      "call,100,abc,1,0.05,0.2,0\n"
+      "# comment\n"
+      "put,100,100,1,0.05,0.2,0\n"};
+  std::vector<OptionRecord> records;
+  std::uint64_t nextId = 0;
+  ASSERT_EQ(batch::readCsvBatch(csv, records, 16, nextId), 3u);
+  EXPECT_TRUE(records[0].error.empty());
+  EXPECT_EQ(records[1].id, 1u);
+  EXPECT_FALSE(records[1].error.empty());
+  EXPECT_EQ(records[2].id, 2u);
+  EXPECT_EQ(records[2].type, OptionType::PUT);
+
+  const BatchResult bad = batch::priceRecord(records[1], BatchConfig{});
+  EXPECT_EQ(bad.id, 1u);
+  EXPECT_EQ(bad.error, records[1].error);
+  EXPECT_TRUE(batch::priceRecord(records[2], BatchConfig{}).error.empty());
+}
+
+TEST(BatchIO, RejectsUnknownBinaryTypeByte) {
+  std::stringstream buf;
+  batch::writeBinaryRecords(
+      buf, {{0, OptionType::PUT, 100, 100, 1, 0.05, 0.2, 0, 0.0}});
+  std::string bytes = buf.str();
+  bytes[sizeof(batch::BINARY_MAGIC)] = 7;  // corrupt the type byte
+  std::istringstream in{bytes};
+  batch::readBinaryHeader(in);
+  std::vector<OptionRecord> records;
+  std::uint64_t nextId = 0;
+  ASSERT_EQ(batch::readBinaryBatch(in, records, 16, nextId), 1u);
+  EXPECT_FALSE(records[0].error.empty());
+  EXPECT_FALSE(batch::priceRecord(records[0], BatchConfig{}).error.empty());
+}
+
+TEST(BatchIO, QuotesErrorsInCsvOutput) {
+  BatchResult result{};
+  result.id = 4;
+  result.error = "Expected type,S,K \"quoted\"";
+  std::ostringstream out;
+  batch::writeCsvResult(out, result);
+  EXPECT_EQ(out.str(), "4,,,\"Expected type,S,K \"\"quoted\"\"\"\n");
+}
+
+TEST(BoundedQueue, BlocksProducerWhenFull) {
+  BoundedQueue<int> q{2};
+  std::thread producer([&] {
+    for (int i = 0; i < 100; ++i) q.push(i);
+    q.close();
+  });
+  int expected = 0;
+  while (auto v = q.pop()) EXPECT_EQ(*v, expected++);
+  producer.join();
+  EXPECT_EQ(expected, 100);
+  EXPECT_FALSE(q.push(1));  // closed
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include "BufferPool.h"
+#include "MonteCarlo.h"
+#include "Option.h"
+
+TEST(BufferPool, ReleasedBlockIsReused) {
+  BufferPool& pool = BufferPool::local();
+  const std::size_t bytes = 100000 * sizeof(double);
+  void* first = BufferPool::acquire(bytes);
+  BufferPool::release(first, bytes);
+
+  const auto before = pool.getStats();
+  void* second = BufferPool::acquire(bytes);
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(pool.getStats().hits, before.hits + 1);
+  BufferPool::release(second, bytes);
+}
+
+TEST(BufferPool, TrimEmptiesFreeLists) {
+  BufferPool& pool = BufferPool::local();
+  const std::size_t bytes = 3 << 20;  // huge-page size class
+  BufferPool::release(BufferPool::acquire(bytes), bytes);
+  EXPECT_GT(pool.getStats().cachedBytes, 0u);
+  pool.trim();
+  EXPECT_EQ(pool.getStats().cachedBytes, 0u);
+}
+
+TEST(BufferPool, MonteCarloBuffersReusedAcrossInstances) {
+  Option opt = Option::createCall(100, 100, 1, 0.05, 0.2);
+  double first{};
+  {
+    MonteCarlo mc(opt, 50000, 3u);
+    first = mc.calculatePrice();
+    mc.calculateVaR(0.05);
+  }
+  const auto before = BufferPool::local().getStats();
+  MonteCarlo mc(opt, 50000, 3u);
+  EXPECT_DOUBLE_EQ(mc.calculatePrice(), first);
+  mc.calculateVaR(0.05);
+  const auto after = BufferPool::local().getStats();
+  EXPECT_EQ(after.misses, before.misses);
+  EXPECT_GE(after.hits, before.hits + 3);  // payoffs, normals, VaR scratch
+}
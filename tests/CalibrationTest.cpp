@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "Calibration.h"
+#include "Heston.h"
+#include "ImpliedVol.h"
+
+using calibration::Quote;
+
+namespace {
+constexpr double SPOT{100.0};
+constexpr double RATE{0.03};
+constexpr double YIELD{0.01};
+
+const std::vector<double> EXPIRIES{0.25, 0.5, 1.0};
+// arbitrage-free slices with skew flattening and variance growing in T
+const std::vector<SviParams> TRUE_SVI{{0.008, 0.10, -0.50, 0.02, 0.15},
+                                      {0.018, 0.12, -0.45, 0.03, 0.20},
+                                      {0.036, 0.14, -0.40, 0.05, 0.25}};
+
+std::vector<Quote> sviQuotes(const std::vector<SviParams>& slices,
+                             double bump = 0.0) {
+  std::vector<Quote> quotes;
+  for (std::size_t s{0}; s < slices.size(); ++s) {
+    const double T{EXPIRIES[s]};
+    const double forward{SPOT * std::exp((RATE - YIELD) * T)};
+    for (int j{0}; j < 15; ++j) {
+      const double K{60.0 + 6.0 * j};
+      const double w{slices[s].totalVariance(std::log(K / forward))};
+      quotes.push_back({T, K, std::sqrt(w / T) + bump});
+    }
+  }
+  return quotes;
+}
+
+const HestonParams TRUE_HESTON{0.05, 2.0, 0.06, 0.5, -0.65};
+
+std::vector<Quote> hestonQuotes() {
+  std::vector<Quote> quotes;
+  for (const double T : {0.1, 0.25, 0.5, 1.0, 2.0}) {
+    for (const double moneyness : {0.75, 0.85, 0.9, 0.95, 1.0, 1.05, 1.1,
+                                   1.2, 1.35}) {
+      const double K{SPOT * moneyness};
+      const OptionType type{K < SPOT ? OptionType::PUT : OptionType::CALL};
+      const double price{
+          heston::price(type, SPOT, K, T, RATE, YIELD, TRUE_HESTON)};
+      quotes.push_back(
+          {T, K, impliedVolBS(type, SPOT, K, T, RATE, YIELD, price, 1e-12)});
+    }
+  }
+  return quotes;
+}
+}  // namespace
+
+TEST(SviCalibration, RecoversKnownSlices) {
+  const std::vector<Quote> quotes{sviQuotes(TRUE_SVI)};
+  const std::vector<calibration::SviFit> fits{
+      calibration::fitSvi(quotes, SPOT, RATE, YIELD, {})};
+  ASSERT_EQ(fits.size(), EXPIRIES.size());
+  for (std::size_t s{0}; s < fits.size(); ++s) {
+    EXPECT_EQ(fits[s].expiry, EXPIRIES[s]);
+    EXPECT_LT(fits[s].rmse, 1e-6) << s;
+    EXPECT_NEAR(fits[s].params.b, TRUE_SVI[s].b, 1e-3) << s;
+    EXPECT_NEAR(fits[s].params.rho, TRUE_SVI[s].rho, 1e-2) << s;
+    EXPECT_NEAR(fits[s].params.m, TRUE_SVI[s].m, 1e-2) << s;
+    EXPECT_TRUE(fits[s].butterflyFree);
+    EXPECT_TRUE(fits[s].calendarFree);
+  }
+}
+
+TEST(SviCalibration, WarmStartNeedsFewerIterations) {
+  const std::vector<calibration::SviFit> first{
+      calibration::fitSvi(sviQuotes(TRUE_SVI), SPOT, RATE, YIELD, {})};
+  // the next tick moves every vol by a tenth of a point
+  const std::vector<Quote> moved{sviQuotes(TRUE_SVI, 0.001)};
+  const std::vector<calibration::SviFit> cold{
+      calibration::fitSvi(moved, SPOT, RATE, YIELD, {})};
+  const std::vector<calibration::SviFit> warm{
+      calibration::fitSvi(moved, SPOT, RATE, YIELD, {}, first)};
+  unsigned coldIterations{0}, warmIterations{0};
+  for (std::size_t s{0}; s < warm.size(); ++s) {
+    coldIterations += cold[s].iterations;
+    warmIterations += warm[s].iterations;
+    EXPECT_LT(warm[s].rmse, 1e-4) << s;
+  }
+  EXPECT_LT(warmIterations, coldIterations);
+}
+
+TEST(SviCalibration, KeepsNoArbitrageBoundsAndFlagsCalendarSpreads) {
+  // the later slice has less total variance than the earlier one
+  std::vector<SviParams> inverted{TRUE_SVI[1], TRUE_SVI[0]};
+  inverted[1].a = 0.002;
+  const std::vector<calibration::SviFit> fits{
+      calibration::fitSvi(sviQuotes(inverted), SPOT, RATE, YIELD, {})};
+  ASSERT_EQ(fits.size(), 2u);
+  EXPECT_TRUE(fits[0].calendarFree);
+  EXPECT_FALSE(fits[1].calendarFree);
+
+  // a smile too steep for Lee's bound is fitted inside it
+  std::vector<Quote> steep;
+  for (int j{0}; j < 9; ++j) {
+    const double K{50.0 + 12.5 * j};
+    steep.push_back({0.25, K, 0.2 + 1.5 * std::abs(std::log(K / 100.0))});
+  }
+  const SviParams p{
+      calibration::fitSvi(steep, SPOT, 0.0, 0.0, {}).front().params};
+  EXPECT_LE(p.b * (1.0 + std::abs(p.rho)), 2.0 + 1e-12);
+  EXPECT_GE(p.a + p.b * p.sigma * std::sqrt(1.0 - p.rho * p.rho), 0.0);
+}
+
+TEST(SviCalibration, RejectsInvalidInput) {
+  std::vector<Quote> quotes{sviQuotes(TRUE_SVI)};
+  quotes[3].vol = -0.1;
+  EXPECT_THROW(calibration::fitSvi(quotes, SPOT, RATE, YIELD, {}),
+               std::invalid_argument);
+  const std::vector<Quote> few(quotes.begin() + 4, quotes.begin() + 8);
+  EXPECT_THROW(calibration::fitSvi(few, SPOT, RATE, YIELD, {}),
+               std::invalid_argument);
+  EXPECT_THROW(calibration::fitSvi(sviQuotes(TRUE_SVI), 0.0, RATE, YIELD, {}),
+               std::invalid_argument);
+}
+
+TEST(HestonCalibration, RecoversParametersFromDistantStart) {
+  const std::vector<Quote> quotes{hestonQuotes()};
+  const calibration::HestonFit fit{calibration::fitHeston(
+      quotes, SPOT, RATE, YIELD, HestonParams{0.03, 1.0, 0.03, 0.3, -0.3},
+      {})};
+  EXPECT_TRUE(fit.converged);
+  EXPECT_LT(fit.rmse, 1e-5);
+  EXPECT_NEAR(fit.params.v0, TRUE_HESTON.v0, 1e-3);
+  EXPECT_NEAR(fit.params.kappa, TRUE_HESTON.kappa, 0.1);
+  EXPECT_NEAR(fit.params.theta, TRUE_HESTON.theta, 2e-3);
+  EXPECT_NEAR(fit.params.xi, TRUE_HESTON.xi, 0.02);
+  EXPECT_NEAR(fit.params.rho, TRUE_HESTON.rho, 0.01);
+}
+
+TEST(HestonCalibration, WarmStartAtSolutionStopsAtOnce) {
+  const std::vector<Quote> quotes{hestonQuotes()};
+  const calibration::HestonFit fit{
+      calibration::fitHeston(quotes, SPOT, RATE, YIELD, TRUE_HESTON, {})};
+  // the fixed quadrature reprices the adaptive integral to well below
+  // a hundredth of a vol point
+  EXPECT_LT(fit.rmse, 1e-6);
+  EXPECT_LE(fit.iterations, 3u);
+}
+
+TEST(HestonCalibration, RejectsInvalidInput) {
+  const std::vector<Quote> quotes{hestonQuotes()};
+  HestonParams bad{TRUE_HESTON};
+  bad.kappa = -1.0;
+  EXPECT_THROW(calibration::fitHeston(quotes, SPOT, RATE, YIELD, bad, {}),
+               std::invalid_argument);
+  const std::vector<Quote> few(quotes.begin(), quotes.begin() + 4);
+  EXPECT_THROW(
+      calibration::fitHeston(few, SPOT, RATE, YIELD, TRUE_HESTON, {}),
+      std::invalid_argument);
+}
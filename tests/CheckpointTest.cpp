@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+#include "MonteCarlo.h"
+#include "Option.h"
+
+namespace {
+Option testOption() {
+  return Option::createPut(100, 105, 0.75, 0.03, 0.25, 0.01);
+}
+}  // namespace
+
+TEST(Checkpoint, ResumedRunMatchesUninterruptedRun) {
+  MonteCarlo full(testOption(), 50000, 17u);
+  const double fullPrice = full.calculatePrice();
+  const double fullSE = full.getStandardError();
+
+  MonteCarlo first(testOption(), 20000, 17u);
+  first.calculatePrice();
+  std::stringstream buf;
+  first.saveCheckpoint(buf);
+
+  MonteCarlo resumed = MonteCarlo::restoreCheckpoint(buf);
+  EXPECT_EQ(resumed.getNumSimulations(), 20000u);
+  EXPECT_DOUBLE_EQ(resumed.getPrice(), first.getPrice());
+  EXPECT_EQ(resumed.runMoreSimulations(30000), fullPrice);
+  EXPECT_EQ(resumed.getStandardError(), fullSE);
+}
+
+TEST(Checkpoint, ExtendingMatchesFreshRun) {
+  MonteCarlo extended(testOption(), 10000, 5u);
+  extended.calculatePrice();
+  extended.runMoreSimulations(7000);
+  MonteCarlo fresh(testOption(), 17000, 5u);
+  EXPECT_EQ(extended.getPrice(), fresh.calculatePrice());
+  EXPECT_EQ(extended.getStandardError(), fresh.getStandardError());
+  EXPECT_DOUBLE_EQ(extended.calculateVaR(0.05), fresh.calculateVaR(0.05));
+}
+
+TEST(Checkpoint, PeriodicCheckpointsResumeInterruptedRun) {
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "mc_periodic.ckpt").string();
+  MonteCarlo full(testOption(), 40000, 23u);
+  const double fullPrice = full.calculatePrice();
+
+  {
+    MonteCarlo run(testOption(), 40000, 23u);
+    run.setCheckpointing(path, 15000);
+    run.calculatePrice();
+  }
+  // the last checkpoint covers the whole run
+  MonteCarlo done = MonteCarlo::restoreCheckpoint(path);
+  EXPECT_EQ(done.getNumSimulations(), 40000u);
+  EXPECT_EQ(done.getPendingSimulations(), 0u);
+  EXPECT_EQ(done.getPrice(), fullPrice);
+
+  // preempt a long run as soon as its first periodic checkpoint lands
+  std::filesystem::remove(path);
+  constexpr unsigned long PATHS = 4000000;
+  MonteCarlo reference(testOption(), PATHS, 23u);
+  reference.setStorePaths(false);
+  const double referencePrice = reference.calculatePrice();
+
+  MonteCarlo preempted(testOption(), PATHS, 23u);
+  preempted.setStorePaths(false);
+  preempted.setCheckpointing(path, 50000);
+  std::stop_source stop;
+  std::jthread watcher([&] {
+    // checkpoints are renamed into place, so an existing file is complete
+    while (!std::filesystem::exists(path)) std::this_thread::yield();
+    stop.request_stop();
+  });
+  EXPECT_FALSE(preempted.calculatePriceCancellable(stop.get_token()));
+  watcher.join();
+
+  MonteCarlo resumed = MonteCarlo::restoreCheckpoint(path);
+  ASSERT_GT(resumed.getPendingSimulations(), 0u);
+  EXPECT_EQ(resumed.getNumSimulations() % 50000, 0u);
+  EXPECT_EQ(resumed.getNumSimulations() + resumed.getPendingSimulations(),
+            PATHS);
+  EXPECT_EQ(resumed.runMoreSimulations(resumed.getPendingSimulations()),
+            referencePrice);
+  EXPECT_EQ(resumed.getPendingSimulations(), 0u);
+  std::filesystem::remove(path);
+}
+
+TEST(Checkpoint, RestoredStateUsesSketchAndRejectsGreeks) {
+  MonteCarlo mc(testOption(), 30000, 3u);
+  mc.calculatePrice();
+  const double exactVaR = mc.calculateVaR(0.9);
+  std::stringstream buf;
+  mc.saveCheckpoint(buf);
+
+  MonteCarlo restored = MonteCarlo::restoreCheckpoint(buf);
+  EXPECT_NEAR(restored.calculateVaR(0.9), exactVaR, exactVaR * 0.005);
+  EXPECT_THROW(restored.calculateGreeks(), std::runtime_error);
+  EXPECT_EQ(restored.cacheKey(), mc.cacheKey());
+}
+
+TEST(Checkpoint, PathStorageCanBeDisabled) {
+  MonteCarlo stored(testOption(), 20000, 8u);
+  MonteCarlo streamed(testOption(), 20000, 8u);
+  streamed.setStorePaths(false);
+  EXPECT_EQ(streamed.calculatePrice(), stored.calculatePrice());
+  EXPECT_EQ(streamed.getStandardError(), stored.getStandardError());
+  EXPECT_THROW(streamed.calculateGreeks(), std::runtime_error);
+  EXPECT_GT(streamed.calculateVaR(0.95), 0.0);
+}
+
+TEST(Checkpoint, RejectsRunsLongerThanTheStreamPeriod) {
+  MonteCarlo mc(testOption(), 1000, 3u);
+  mc.calculatePrice();
+  const double price{mc.getPrice()};
+  EXPECT_THROW(mc.runMoreSimulations(MonteCarlo::maxPaths()),
+               std::invalid_argument);
+  EXPECT_EQ(mc.getNumSimulations(), 1000u);
+  EXPECT_EQ(mc.getPrice(), price);
+
+  std::stringstream buf;
+  mc.saveCheckpoint(buf);
+  std::string text{buf.str()};
+  const std::string paths{"paths 1000 1000"};
+  text.replace(text.find(paths), paths.size(),
+               "paths 1000 " + std::to_string(MonteCarlo::maxPaths() + 1));
+  std::stringstream tooLong{text};
+  EXPECT_THROW(MonteCarlo::restoreCheckpoint(tooLong), std::runtime_error);
+  EXPECT_THROW(MonteCarlo(testOption(), MonteCarlo::maxPaths() + 1, 3u),
+               std::invalid_argument);
+}
+
+TEST(Checkpoint, RejectsMalformedInput) {
+  std::stringstream notCheckpoint("hello 1");
+  EXPECT_THROW(MonteCarlo::restoreCheckpoint(notCheckpoint),
+               std::runtime_error);
+
+  MonteCarlo mc(testOption(), 1000, 1u);
+  mc.calculatePrice();
+  std::stringstream buf;
+  mc.saveCheckpoint(buf);
+  std::string text = buf.str();
+  std::stringstream truncated(text.substr(0, text.find("engine")));
+  EXPECT_THROW(MonteCarlo::restoreCheckpoint(truncated), std::runtime_error);
+  EXPECT_THROW(MonteCarlo::restoreCheckpoint("/nonexistent/ckpt"),
+               std::runtime_error);
+  EXPECT_THROW(mc.setCheckpointing("", 10), std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "DeadlinePricing.h"
+#include "MonteCarlo.h"
+#include "Option.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+Option testOption() {
+  return Option::createCall(100, 100, 1.0, 0.05, 0.2, 0.0);
+}
+}  // namespace
+
+TEST(ThroughputModel, FirstSampleReplacesGuessThenSmooths) {
+  ThroughputModel model{{0.5, 1e6, 1.0}};
+  EXPECT_DOUBLE_EQ(model.pathsPerSecond(), 1e6);
+  model.record(1000, 1ms);  // 1e6 paths/s
+  EXPECT_NEAR(model.pathsPerSecond(), 1e6, 1e-3);
+  model.record(1000, 3ms);  // secondsPerPath -> (1e-6 + 3e-6) / 2
+  EXPECT_NEAR(model.pathsPerSecond(), 5e5, 1e-3);
+  EXPECT_EQ(model.samples(), 2u);
+  EXPECT_NEAR(static_cast<double>(model.pathsFor(10ms)), 5000.0, 1.0);
+  EXPECT_EQ(model.pathsFor(-1ms), 0u);
+}
+
+TEST(ThroughputModel, RejectsInvalidSettings) {
+  EXPECT_THROW(ThroughputModel({0.0, 1e6, 0.8}), std::invalid_argument);
+  EXPECT_THROW(ThroughputModel({0.2, 0.0, 0.8}), std::invalid_argument);
+  EXPECT_THROW(ThroughputModel({0.2, 1e6, 1.5}), std::invalid_argument);
+}
+
+TEST(DeadlinePricing, FallsBackToBlackScholesWhenNothingFits) {
+  ThroughputModel model{};
+  const DeadlineResult result{deadline::priceWithDeadline(
+      testOption(), std::chrono::steady_clock::now(), {}, model)};
+  EXPECT_TRUE(result.fallback);
+  EXPECT_EQ(result.paths, 0u);
+  EXPECT_FALSE(result.standardError.has_value());
+  EXPECT_DOUBLE_EQ(result.price, BlackScholes(testOption()).calculatePrice());
+}
+
+TEST(DeadlinePricing, SeededRunMatchesPlainMonteCarlo) {
+  ThroughputModel model{};
+  DeadlineConfig config{};
+  config.seed = 7u;
+  const DeadlineResult result{
+      deadline::priceWithin(testOption(), 50ms, config, model)};
+  ASSERT_FALSE(result.fallback);
+  EXPECT_GE(result.paths, config.minPaths);
+  EXPECT_GT(model.samples(), 0u);
+
+  MonteCarlo plain(testOption(), result.paths, 7u);
+  EXPECT_EQ(result.price, plain.calculatePrice());
+  EXPECT_EQ(*result.standardError, plain.getStandardError());
+}
+
+TEST(DeadlinePricing, RespectsMaxPaths) {
+  ThroughputModel model{};
+  DeadlineConfig config{};
+  config.maxPaths = 5000;
+  const DeadlineResult result{
+      deadline::priceWithin(testOption(), 1s, config, model)};
+  EXPECT_FALSE(result.fallback);
+  EXPECT_EQ(result.paths, 5000u);
+  EXPECT_TRUE(result.metDeadline);
+}
+
+TEST(DeadlinePricing, OptimisticModelStopsEarly) {
+  // a model that believes in 1e12 paths/s plans far too many paths; the
+  // clock checks between chunks must cut the run short
+  ThroughputModel model{{0.2, 1e12, 1.0}};
+  DeadlineConfig config{};
+  config.chunks = 1000;
+  const auto start{std::chrono::steady_clock::now()};
+  const DeadlineResult result{
+      deadline::priceWithin(testOption(), 20ms, config, model)};
+  EXPECT_FALSE(result.fallback);
+  EXPECT_LT(result.paths, config.maxPaths);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+}
+
+TEST(DeadlinePricing, RejectsInvalidConfig) {
+  DeadlineConfig config{};
+  config.minPaths = 0;
+  EXPECT_THROW(deadline::priceWithin(testOption(), 1ms, config),
+               std::invalid_argument);
+  config = {};
+  config.maxPaths = config.minPaths - 1;
+  EXPECT_THROW(deadline::priceWithin(testOption(), 1ms, config),
+               std::invalid_argument);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "BlackScholes.h"
+#include "ExposureEngine.h"
+#include "MathUtils.h"
+
+namespace {
+const ExposureEngine::Market MARKET{100.0, 0.03, 0.25, 0.01};
+
+std::vector<double> quarterly(int quarters) {
+  std::vector<double> dates;
+  for (int i{1}; i <= quarters; ++i) dates.push_back(0.25 * i);
+  return dates;
+}
+
+ExposureEngine::Config paths(unsigned long n) {
+  ExposureEngine::Config config{};
+  config.paths = n;
+  return config;
+}
+}  // namespace
+
+TEST(ExposureEngine, DiscountedValueIsMartingale) {
+  // a long/short book: E[e^{-rt} V(t)] stays at today's value
+  const std::vector<ExposureTrade> book{{OptionType::CALL, 100.0, 1.0, 2.0},
+                                        {OptionType::PUT, 90.0, 2.0, -1.0},
+                                        {OptionType::CALL, 120.0, 1.5, -1.5}};
+  ExposureEngine engine(MARKET, book, quarterly(4), paths(50000));
+  const double pv{engine.presentValue()};
+  const ExposureProfile& profile{engine.calculateProfile()};
+  for (std::size_t d{0}; d < profile.dates.size(); ++d) {
+    const double df{std::exp(-MARKET.riskFreeRate * profile.dates[d])};
+    EXPECT_NEAR(df * profile.expectedValue[d], pv, 0.1) << d;
+    EXPECT_NEAR(profile.expectedValue[d],
+                profile.expectedExposure[d] +
+                    profile.expectedNegativeExposure[d],
+                1e-9);
+    EXPECT_GE(profile.potentialFutureExposure[d], profile.expectedExposure[d]);
+  }
+}
+
+TEST(ExposureEngine, LongCallPfeMatchesLognormalQuantile) {
+  // the call's value is increasing in spot, so its PFE is the value at the
+  // spot quantile
+  const ExposureTrade call{OptionType::CALL, 105.0, 2.0, 1.0};
+  ExposureEngine engine(MARKET, {call}, quarterly(6), paths(50000));
+  const ExposureProfile& profile{engine.calculateProfile()};
+  const double z{math::norm_inv(engine.getConfig().pfeQuantile)};
+  const double s{MARKET.volatility};
+  for (std::size_t d{0}; d < profile.dates.size(); ++d) {
+    const double t{profile.dates[d]};
+    const double spot{MARKET.spot *
+                      std::exp((MARKET.riskFreeRate - MARKET.dividendYield -
+                                0.5 * s * s) *
+                                   t +
+                               s * std::sqrt(t) * z)};
+    const double expected{BlackScholes::price(
+        OptionType::CALL, spot, call.strike, call.maturity - t,
+        MARKET.riskFreeRate, s, MARKET.dividendYield)};
+    EXPECT_NEAR(profile.potentialFutureExposure[d], expected, 0.03 * expected)
+        << t;
+  }
+}
+
+TEST(ExposureEngine, ShortPositionHasNoPositiveExposure) {
+  ExposureEngine engine(MARKET, {{OptionType::PUT, 95.0, 1.0, -3.0}},
+                        quarterly(4), paths(4000));
+  const ExposureProfile& profile{engine.calculateProfile()};
+  for (std::size_t d{0}; d < profile.dates.size(); ++d) {
+    EXPECT_EQ(profile.expectedExposure[d], 0.0);
+    EXPECT_EQ(profile.potentialFutureExposure[d], 0.0);
+    EXPECT_LT(profile.expectedNegativeExposure[d], 0.0);
+  }
+  EXPECT_EQ(engine.calculateCva(0.02), 0.0);
+}
+
+TEST(ExposureEngine, ExpiredTradesDropOut) {
+  ExposureEngine engine(MARKET, {{OptionType::CALL, 100.0, 0.5, 1.0}},
+                        quarterly(4), paths(4000));
+  const ExposureProfile& profile{engine.calculateProfile()};
+  EXPECT_GT(profile.expectedExposure[1], 0.0);  // payoff at maturity
+  EXPECT_EQ(profile.expectedExposure[2], 0.0);
+  EXPECT_EQ(profile.expectedExposure[3], 0.0);
+}
+
+TEST(ExposureEngine, CvaOfLongCallMatchesClosedForm) {
+  // discounted EE of a long option is its price today at every date, so
+  // CVA = (1 − R) · C0 · P(default before maturity)
+  const ExposureTrade call{OptionType::CALL, 100.0, 2.0, 1.0};
+  ExposureEngine engine(MARKET, {call}, quarterly(8), paths(50000));
+  const double hazard{0.03};
+  const double recovery{0.4};
+  const double expected{(1.0 - recovery) * engine.presentValue() *
+                        (1.0 - std::exp(-hazard * call.maturity))};
+  EXPECT_NEAR(engine.calculateCva(hazard, recovery), expected,
+              0.01 * expected);
+}
+
+TEST(ExposureEngine, ResultsIndependentOfThreadCount) {
+  const std::vector<ExposureTrade> book{{OptionType::CALL, 100.0, 1.0, 1.0},
+                                        {OptionType::PUT, 100.0, 1.0, -0.5}};
+  ExposureEngine::Config config{paths(20000)};
+  config.blockPaths = 512;
+  config.threads = 1;
+  ExposureEngine serial(MARKET, book, quarterly(4), config);
+  config.threads = 3;
+  ExposureEngine threaded(MARKET, book, quarterly(4), config);
+  const ExposureProfile& a{serial.calculateProfile()};
+  const ExposureProfile& b{threaded.calculateProfile()};
+  EXPECT_EQ(a.expectedValue, b.expectedValue);
+  EXPECT_EQ(a.expectedExposure, b.expectedExposure);
+  EXPECT_EQ(a.expectedNegativeExposure, b.expectedNegativeExposure);
+  EXPECT_EQ(a.potentialFutureExposure, b.potentialFutureExposure);
+}
+
+TEST(ExposureEngine, RejectsInvalidInput) {
+  const std::vector<ExposureTrade> book{{OptionType::CALL, 100.0, 1.0, 1.0}};
+  EXPECT_THROW(ExposureEngine({0.0, 0.03, 0.2, 0.0}, book, quarterly(4)),
+               std::invalid_argument);
+  EXPECT_THROW(ExposureEngine(MARKET, {}, quarterly(4)),
+               std::invalid_argument);
+  EXPECT_THROW(ExposureEngine(MARKET, {{OptionType::PUT, -1.0, 1.0, 1.0}},
+                              quarterly(4)),
+               std::invalid_argument);
+  EXPECT_THROW(ExposureEngine(MARKET, book, {0.5, 0.25}),
+               std::invalid_argument);
+  EXPECT_THROW(ExposureEngine(MARKET, book, {}), std::invalid_argument);
+  ExposureEngine::Config config{};
+  config.pfeQuantile = 1.0;
+  EXPECT_THROW(ExposureEngine(MARKET, book, quarterly(4), config),
+               std::invalid_argument);
+  ExposureEngine engine(MARKET, book, quarterly(4), paths(1000));
+  EXPECT_THROW(engine.calculateCva(-0.1), std::invalid_argument);
+  EXPECT_THROW(engine.calculateCva(0.02, 1.5), std::invalid_argument);
+}
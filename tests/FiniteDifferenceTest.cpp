@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "BlackScholes.h"
+#include "FiniteDifference.h"
+#include "Option.h"
+
+namespace {
+FiniteDifference::Config american(AmericanSolver solver) {
+  FiniteDifference::Config config{};
+  config.exercise = ExerciseStyle::AMERICAN;
+  config.americanSolver = solver;
+  return config;
+}
+}  // namespace
+
+TEST(FiniteDifference, EuropeanMatchesBlackScholes) {
+  for (const Option& option :
+       {Option::createCall(100, 100, 1.0, 0.05, 0.2),
+        Option::createPut(100, 110, 0.5, 0.03, 0.3, 0.02),
+        Option::createCall(80, 100, 2.0, 0.01, 0.4, 0.03)}) {
+    FiniteDifference pde(option);
+    EXPECT_NEAR(pde.calculatePrice(), BlackScholes(option).calculatePrice(),
+                2e-3)
+        << option;
+  }
+}
+
+TEST(FiniteDifference, ErrorShrinksWithGrid) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  const double exact{BlackScholes(call).calculatePrice()};
+  FiniteDifference::Config coarse{};
+  coarse.spaceSteps = 50;
+  coarse.timeSteps = 25;
+  FiniteDifference::Config fine{};
+  fine.spaceSteps = 400;
+  fine.timeSteps = 200;
+  const double coarseError{
+      std::abs(FiniteDifference(call, coarse).calculatePrice() - exact)};
+  const double fineError{
+      std::abs(FiniteDifference(call, fine).calculatePrice() - exact)};
+  EXPECT_LT(fineError, coarseError / 10.0);
+}
+
+TEST(FiniteDifference, AmericanPutMatchesReference) {
+  // Longstaff & Schwartz (2001), table 1 quote 4.478 from a coarse grid;
+  // converged lattice and PDE values agree on 4.4867
+  const Option put{Option::createPut(36, 40, 1.0, 0.06, 0.2)};
+  FiniteDifference direct(put, american(AmericanSolver::BRENNAN_SCHWARTZ));
+  FiniteDifference iterative(put, american(AmericanSolver::PSOR));
+  EXPECT_NEAR(direct.calculatePrice(), 4.4867, 1e-3);
+  EXPECT_NEAR(iterative.calculatePrice(), direct.calculatePrice(), 1e-6);
+  EXPECT_GT(direct.calculatePrice(), BlackScholes(put).calculatePrice());
+}
+
+TEST(FiniteDifference, AmericanCallWithoutDividendsIsEuropean) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  FiniteDifference pde(call, american(AmericanSolver::BRENNAN_SCHWARTZ));
+  EXPECT_NEAR(pde.calculatePrice(), BlackScholes(call).calculatePrice(), 2e-3);
+}
+
+TEST(FiniteDifference, AmericanDividendCallSolversAgree) {
+  const Option call{Option::createCall(100, 90, 1.0, 0.03, 0.2, 0.08)};
+  FiniteDifference direct(call, american(AmericanSolver::BRENNAN_SCHWARTZ));
+  FiniteDifference iterative(call, american(AmericanSolver::PSOR));
+  EXPECT_NEAR(iterative.calculatePrice(), direct.calculatePrice(), 1e-6);
+  EXPECT_GT(direct.calculatePrice(), BlackScholes(call).calculatePrice());
+}
+
+TEST(FiniteDifference, PriceStrikesMatchesSingleSolves) {
+  const Option base{Option::createPut(100, 100, 0.75, 0.04, 0.25, 0.01)};
+  FiniteDifference chain(base, american(AmericanSolver::BRENNAN_SCHWARTZ));
+  const std::vector<double> strikes{80, 90, 100, 110, 120};
+  std::vector<double> prices(strikes.size());
+  chain.priceStrikes(strikes, prices);
+  for (std::size_t j{0}; j < strikes.size(); ++j) {
+    const Option single{Option::createPut(100, strikes[j], 0.75, 0.04, 0.25,
+                                          0.01)};
+    FiniteDifference pde(single, american(AmericanSolver::BRENNAN_SCHWARTZ));
+    EXPECT_NEAR(prices[j], pde.calculatePrice(), 5e-3) << strikes[j];
+  }
+  std::vector<double> wrongSize(2);
+  EXPECT_THROW(chain.priceStrikes(strikes, wrongSize), std::invalid_argument);
+}
+
+TEST(FiniteDifference, GridGreeksMatchBlackScholes) {
+  const Option put{Option::createPut(100, 105, 1.0, 0.05, 0.25, 0.02)};
+  FiniteDifference pde(put);
+  BlackScholes bs(put);
+  const Greeks g{pde.calculateGreeks()};
+  const Greeks exact{bs.calculateGreeks()};
+  EXPECT_NEAR(g.delta, exact.delta, 1e-3);
+  EXPECT_NEAR(g.gamma, exact.gamma, 1e-4);
+  EXPECT_NEAR(g.theta, exact.theta, 2e-2);
+  EXPECT_NEAR(g.vega, exact.vega, 1e-2);
+  EXPECT_NEAR(g.rho, exact.rho, 1e-2);
+}
+
+TEST(FiniteDifference, ReusedPricerRepricesAfterReset) {
+  const Option a{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  const Option b{Option::createPut(90, 100, 0.5, 0.02, 0.3)};
+  FiniteDifference pde(a);
+  pde.calculatePrice();
+  pde.reset(b);
+  EXPECT_DOUBLE_EQ(pde.calculatePrice(), FiniteDifference(b).calculatePrice());
+}
+
+TEST(FiniteDifference, RejectsInvalidConfig) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  FiniteDifference::Config config{};
+  config.spaceSteps = 2;
+  EXPECT_THROW(FiniteDifference(call, config), std::invalid_argument);
+  config = {};
+  config.psorOmega = 2.0;
+  EXPECT_THROW(FiniteDifference(call, config), std::invalid_argument);
+}
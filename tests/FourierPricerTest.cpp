@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "BlackScholes.h"
+#include "CharacteristicFunction.h"
+#include "FourierPricer.h"
+#include "Heston.h"
+#include "Merton.h"
+#include "Option.h"
+
+namespace {
+const HestonParams TYPICAL{0.04, 1.5, 0.04, 0.3, -0.7};
+
+FourierPricer::Config carrMadan() {
+  FourierPricer::Config config{};
+  config.method = FourierMethod::CARR_MADAN;
+  return config;
+}
+}  // namespace
+
+TEST(FourierPricer, CosMatchesBlackScholes) {
+  const auto model{std::make_shared<BlackScholesCF>(0.25)};
+  for (const double K : {70.0, 100.0, 140.0}) {
+    for (const OptionType type : {OptionType::CALL, OptionType::PUT}) {
+      const Option option{type, 100, K, 0.75, 0.03, 0.25, 0.01};
+      FourierPricer cos(option, model);
+      EXPECT_NEAR(cos.calculatePrice(),
+                  BlackScholes::price(type, 100, K, 0.75, 0.03, 0.25, 0.01),
+                  1e-8)
+          << K;
+    }
+  }
+}
+
+TEST(FourierPricer, CosMatchesHestonIntegral) {
+  const auto model{std::make_shared<HestonCF>(TYPICAL)};
+  for (const double K : {80.0, 100.0, 120.0}) {
+    const Option option{Option::createPut(100, K, 1.0, 0.02, 0.2, 0.01)};
+    FourierPricer cos(option, model);
+    EXPECT_NEAR(cos.calculatePrice(),
+                heston::price(OptionType::PUT, 100, K, 1.0, 0.02, 0.01,
+                              TYPICAL),
+                1e-6)
+        << K;
+  }
+}
+
+TEST(FourierPricer, CarrMadanMatchesBlackScholes) {
+  const auto model{std::make_shared<BlackScholesCF>(0.2)};
+  for (const double K : {80.0, 100.0, 125.0}) {
+    const Option call{Option::createCall(100, K, 1.0, 0.05, 0.2)};
+    FourierPricer fft(call, model, carrMadan());
+    EXPECT_NEAR(fft.calculatePrice(),
+                BlackScholes::price(OptionType::CALL, 100, K, 1.0, 0.05, 0.2, 0.0),
+                1e-4)
+        << K;
+  }
+}
+
+TEST(FourierPricer, MethodsAgreeUnderMerton) {
+  const auto model{std::make_shared<MertonCF>(MertonParams{})};
+  const Option put{Option::createPut(100, 95, 0.5, 0.03, 0.2)};
+  FourierPricer cos(put, model);
+  FourierPricer fft(put, model, carrMadan());
+  EXPECT_NEAR(cos.calculatePrice(), fft.calculatePrice(), 1e-4);
+  // jumps add value over the diffusion alone
+  EXPECT_GT(cos.getPrice(),
+            BlackScholes::price(OptionType::PUT, 100, 95, 0.5, 0.03, 0.2, 0.0));
+}
+
+TEST(FourierPricer, ChainMatchesSinglePrices) {
+  const auto model{std::make_shared<HestonCF>(TYPICAL)};
+  const Option call{Option::createCall(100, 100, 0.5, 0.03, 0.2)};
+  std::vector<double> strikes(200);
+  for (std::size_t i{0}; i < strikes.size(); ++i) {
+    strikes[i] = 60.0 + 0.4 * static_cast<double>(i);
+  }
+  for (const auto& config : {FourierPricer::Config{}, carrMadan()}) {
+    FourierPricer chain(call, model, config);
+    std::vector<double> prices(strikes.size());
+    chain.priceChain(strikes, prices);
+    for (std::size_t i{0}; i < strikes.size(); i += 37) {
+      const double reference{heston::price(OptionType::CALL, 100, strikes[i],
+                                           0.5, 0.03, 0.0, TYPICAL)};
+      EXPECT_NEAR(prices[i], reference, 1e-4) << strikes[i];
+    }
+    // a second call reuses the cached coefficients and workspace
+    std::vector<double> again(strikes.size());
+    chain.priceChain(strikes, again);
+    EXPECT_EQ(again, prices);
+  }
+}
+
+TEST(FourierPricer, GreeksMatchBlackScholes) {
+  const auto model{std::make_shared<BlackScholesCF>(0.2)};
+  const Option call{Option::createCall(100, 105, 1.0, 0.04, 0.2, 0.01)};
+  FourierPricer cos(call, model);
+  BlackScholes bs(call);
+  const Greeks g{cos.calculateGreeks()};
+  const Greeks expected{bs.calculateGreeks()};
+  EXPECT_NEAR(g.delta, expected.delta, 1e-5);
+  EXPECT_NEAR(g.gamma, expected.gamma, 1e-4);
+  EXPECT_NEAR(g.vega, expected.vega, 1e-3);
+  EXPECT_NEAR(g.rho, expected.rho, 1e-3);
+  EXPECT_NEAR(g.theta, expected.theta, 1e-3);
+}
+
+TEST(FourierPricer, RejectsInvalidInput) {
+  const auto model{std::make_shared<BlackScholesCF>(0.2)};
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  EXPECT_THROW(FourierPricer(call, nullptr), std::invalid_argument);
+  FourierPricer::Config config{};
+  config.fftSize = 1000;
+  EXPECT_THROW(FourierPricer(call, model, config), std::invalid_argument);
+  FourierPricer cos(call, model);
+  std::vector<double> strikes{90.0, -1.0};
+  std::vector<double> out(2);
+  EXPECT_THROW(cos.priceChain(strikes, out), std::invalid_argument);
+  std::vector<double> tooShort(1);
+  strikes[1] = 110.0;
+  EXPECT_THROW(cos.priceChain(strikes, tooShort), std::invalid_argument);
+}
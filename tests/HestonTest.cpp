@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "Heston.h"
+#include "HestonMonteCarlo.h"
+#include "Option.h"
+
+namespace {
+// Andersen (2008), case I: strongly skewed, Feller violated
+const HestonParams ANDERSEN_I{0.04, 0.5, 0.04, 1.0, -0.9};
+// Bakshi, Cao & Chen (1997) parameters
+const HestonParams BAKSHI{0.010201, 6.21, 0.019, 0.61, -0.7};
+const HestonParams TYPICAL{0.04, 1.5, 0.04, 0.3, -0.7};
+}  // namespace
+
+TEST(HestonAnalytic, MatchesPublishedReferences) {
+  EXPECT_NEAR(
+      heston::price(OptionType::CALL, 100, 100, 10.0, 0.0, 0.0, ANDERSEN_I),
+      13.0847, 1e-4);
+  EXPECT_NEAR(
+      heston::price(OptionType::CALL, 100, 100, 1.0, 0.0319, 0.0, BAKSHI),
+      6.8061, 1e-4);
+}
+
+TEST(HestonAnalytic, ReducesToBlackScholesWithoutVolOfVol) {
+  const HestonParams flat{0.04, 1.5, 0.04, 1e-4, 0.0};
+  for (const double T : {0.05, 1.0, 10.0}) {
+    EXPECT_NEAR(heston::price(OptionType::PUT, 100, 110, T, 0.03, 0.01, flat),
+                BlackScholes::price(OptionType::PUT, 100, 110, T, 0.03, 0.2,
+                                    0.01),
+                1e-6)
+        << T;
+  }
+}
+
+TEST(HestonAnalytic, SatisfiesPutCallParity) {
+  const double call{
+      heston::price(OptionType::CALL, 95, 100, 0.7, 0.04, 0.02, TYPICAL)};
+  const double put{
+      heston::price(OptionType::PUT, 95, 100, 0.7, 0.04, 0.02, TYPICAL)};
+  EXPECT_NEAR(call - put, 95 * std::exp(-0.02 * 0.7) - 100 * std::exp(-0.04 * 0.7),
+              1e-10);
+}
+
+TEST(HestonAnalytic, CharacteristicFunctionIsNormalised) {
+  const auto one{heston::characteristicFunction({0.0, 0.0}, 2.0, TYPICAL)};
+  EXPECT_NEAR(one.real(), 1.0, 1e-14);
+  // martingale: E[exp(X)] = 1 for the centred log-return
+  const auto mart{heston::characteristicFunction({0.0, -1.0}, 2.0, TYPICAL)};
+  EXPECT_NEAR(mart.real(), 1.0, 1e-12);
+  EXPECT_NEAR(mart.imag(), 0.0, 1e-12);
+}
+
+TEST(HestonAnalytic, GreeksAreConsistent) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.02, 0.2)};
+  HestonAnalytic pricer(call, TYPICAL);
+  const Greeks g{pricer.calculateGreeks()};
+  EXPECT_GT(g.delta, 0.5);
+  EXPECT_LT(g.delta, 0.8);
+  EXPECT_GT(g.gamma, 0.0);
+  EXPECT_GT(g.vega, 0.0);
+  EXPECT_GT(g.rho, 0.0);
+  EXPECT_LT(g.theta, 0.0);
+}
+
+TEST(HestonMonteCarlo, MatchesSemiAnalyticPrice) {
+  struct Case {
+    Option option;
+    HestonParams params;
+    unsigned steps;
+  };
+  for (const Case& c :
+       {Case{Option::createCall(100, 100, 1.0, 0.02, 0.2), TYPICAL, 50},
+        Case{Option::createPut(100, 110, 0.5, 0.03, 0.2, 0.01), TYPICAL, 25},
+        Case{Option::createCall(100, 100, 10.0, 0.0, 0.2), ANDERSEN_I, 40}}) {
+    HestonMonteCarlo::Config config{};
+    config.paths = 40000;
+    config.steps = c.steps;
+    HestonMonteCarlo mc(c.option, c.params, config);
+    const double price{mc.calculatePrice()};
+    const double exact{HestonAnalytic(c.option, c.params).calculatePrice()};
+    EXPECT_NEAR(price, exact, 3.5 * mc.getStandardError())
+        << c.option;
+  }
+}
+
+TEST(HestonMonteCarlo, ResultDoesNotDependOnThreadCount) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.02, 0.2)};
+  HestonMonteCarlo::Config config{};
+  config.paths = 5000;
+  config.steps = 20;
+  config.threads = 1;
+  HestonMonteCarlo serial(call, TYPICAL, config);
+  config.threads = 3;
+  HestonMonteCarlo parallel(call, TYPICAL, config);
+  EXPECT_EQ(serial.calculatePrice(), parallel.calculatePrice());
+  EXPECT_EQ(serial.getStandardError(), parallel.getStandardError());
+}
+
+TEST(HestonMonteCarlo, RejectsInvalidInput) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.02, 0.2)};
+  HestonParams bad{TYPICAL};
+  bad.rho = -1.5;
+  EXPECT_THROW(HestonAnalytic(call, bad), std::invalid_argument);
+  EXPECT_THROW(HestonMonteCarlo(call, bad), std::invalid_argument);
+  HestonMonteCarlo::Config config{};
+  config.psiCritical = 3.0;
+  EXPECT_THROW(HestonMonteCarlo(call, TYPICAL, config), std::invalid_argument);
+  HestonMonteCarlo unpriced(call, TYPICAL);
+  EXPECT_THROW(unpriced.getStandardError(), std::runtime_error);
+}
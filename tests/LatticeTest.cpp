@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "FiniteDifference.h"
+#include "Lattice.h"
+#include "Option.h"
+
+namespace {
+Lattice::Config config(LatticeMethod method, std::size_t steps,
+                       ExerciseStyle exercise = ExerciseStyle::EUROPEAN,
+                       bool richardson = false) {
+  Lattice::Config c{};
+  c.method = method;
+  c.steps = steps;
+  c.exercise = exercise;
+  c.richardson = richardson;
+  return c;
+}
+}  // namespace
+
+TEST(Lattice, EveryMethodConvergesToBlackScholes) {
+  const Option put{Option::createPut(100, 105, 1.0, 0.05, 0.25, 0.02)};
+  const double exact{BlackScholes(put).calculatePrice()};
+  EXPECT_NEAR(Lattice(put, config(LatticeMethod::CRR, 2000)).calculatePrice(),
+              exact, 5e-3);
+  EXPECT_NEAR(
+      Lattice(put, config(LatticeMethod::TRINOMIAL, 1000)).calculatePrice(),
+      exact, 5e-3);
+  EXPECT_NEAR(
+      Lattice(put, config(LatticeMethod::LEISEN_REIMER, 201)).calculatePrice(),
+      exact, 1e-4);
+}
+
+TEST(Lattice, RichardsonReducesError) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  const double exact{BlackScholes(call).calculatePrice()};
+  for (const auto method :
+       {LatticeMethod::LEISEN_REIMER, LatticeMethod::TRINOMIAL}) {
+    const double plain{
+        Lattice(call, config(method, 101)).calculatePrice() - exact};
+    const double extrapolated{
+        Lattice(call, config(method, 101, ExerciseStyle::EUROPEAN, true))
+            .calculatePrice() -
+        exact};
+    EXPECT_LT(std::abs(extrapolated), std::abs(plain)) << int(method);
+  }
+}
+
+TEST(Lattice, AmericanPutMatchesReference) {
+  const Option put{Option::createPut(36, 40, 1.0, 0.06, 0.2)};
+  for (const auto method : {LatticeMethod::CRR, LatticeMethod::LEISEN_REIMER,
+                            LatticeMethod::TRINOMIAL}) {
+    Lattice tree(put, config(method, 1001, ExerciseStyle::AMERICAN));
+    EXPECT_NEAR(tree.calculatePrice(), 4.4867, 2e-3) << int(method);
+  }
+}
+
+TEST(Lattice, AmericanDividendCallAgreesWithPde) {
+  const Option call{Option::createCall(100, 90, 1.0, 0.03, 0.2, 0.08)};
+  Lattice tree(call, config(LatticeMethod::LEISEN_REIMER, 501,
+                            ExerciseStyle::AMERICAN));
+  FiniteDifference::Config pde{};
+  pde.exercise = ExerciseStyle::AMERICAN;
+  EXPECT_NEAR(tree.calculatePrice(),
+              FiniteDifference(call, pde).calculatePrice(), 5e-3);
+}
+
+TEST(Lattice, TreeGreeksMatchBlackScholes) {
+  const Option call{Option::createCall(100, 95, 0.5, 0.04, 0.3, 0.01)};
+  const Greeks exact{BlackScholes(call).calculateGreeks()};
+  for (const auto method : {LatticeMethod::CRR, LatticeMethod::LEISEN_REIMER,
+                            LatticeMethod::TRINOMIAL}) {
+    Lattice tree(call, config(method, 801));
+    const Greeks g{tree.calculateGreeks()};
+    EXPECT_NEAR(g.delta, exact.delta, 2e-3) << int(method);
+    EXPECT_NEAR(g.gamma, exact.gamma, 5e-4) << int(method);
+    EXPECT_NEAR(g.theta, exact.theta, 5e-2) << int(method);
+    EXPECT_NEAR(g.vega, exact.vega, 0.1) << int(method);
+    EXPECT_NEAR(g.rho, exact.rho, 5e-2) << int(method);
+  }
+}
+
+TEST(Lattice, VegaUsesClampedBumpSpread) {
+  // σ below the bump: the down bump is clamped near zero, and the
+  // difference must be divided by the spread actually used
+  const Option call{Option::createCall(100, 100, 1.0, 0.0, 5e-4)};
+  Lattice tree(call, config(LatticeMethod::LEISEN_REIMER, 201));
+  EXPECT_NEAR(tree.calculateGreeks().vega,
+              BlackScholes(call).calculateGreeks().vega, 1.0);
+}
+
+TEST(Lattice, LeisenReimerUsesOddSteps) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  EXPECT_EQ(Lattice(call, config(LatticeMethod::LEISEN_REIMER, 100)).getSteps(),
+            101u);
+  EXPECT_EQ(Lattice(call, config(LatticeMethod::CRR, 100)).getSteps(), 100u);
+  EXPECT_THROW(Lattice(call, config(LatticeMethod::CRR, 3)),
+               std::invalid_argument);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "BlackScholes.h"
+#include "LiveMonteCarlo.h"
+#include "TestUtils.h"
+
+TEST(LiveMonteCarlo, PriceCloseToBSWithin3SE) {
+  Option opt = Option::createCall(100, 100, 1, 0.05, 0.2);
+  LiveMonteCarlo live(opt, 200000, 42u);
+  double price = live.calculatePrice();
+  double se = live.getStandardError();
+
+  BlackScholes bs(opt);
+  EXPECT_CLOSE_WITH_SE(price, bs.calculatePrice(), se, 3.0, "live vs BS");
+}
+
+TEST(LiveMonteCarlo, SpotTickMatchesFreshInstance) {
+  Option opt = Option::createPut(100, 100, 0.5, 0.03, 0.25, 0.01);
+  LiveMonteCarlo live(opt, 50000, 7u);
+  live.calculatePrice();
+  live.updateSpot(97.5);
+  EXPECT_FALSE(live.isPriceCalculated());
+
+  LiveMonteCarlo fresh(Option::createPut(97.5, 100, 0.5, 0.03, 0.25, 0.01),
+                       50000, 7u);
+  EXPECT_NEAR(live.calculatePrice(), fresh.calculatePrice(), 1e-10);
+}
+
+TEST(LiveMonteCarlo, VolAndRateUpdatesMatchFreshInstance) {
+  Option opt = Option::createCall(100, 110, 1, 0.05, 0.2);
+  LiveMonteCarlo live(opt, 50000, 11u);
+  live.calculatePrice();
+  live.updateVolatility(0.3);
+  live.updateRiskFreeRate(0.02);
+  live.updateDividendYield(0.01);
+  live.updateTimeToMaturity(0.75);
+
+  LiveMonteCarlo fresh(Option::createCall(100, 110, 0.75, 0.02, 0.3, 0.01),
+                       50000, 11u);
+  EXPECT_NEAR(live.calculatePrice(), fresh.calculatePrice(), 1e-10);
+  EXPECT_NEAR(live.calculateGreeks().vega, fresh.calculateGreeks().vega,
+              1e-8);
+}
+
+TEST(LiveMonteCarlo, GreeksRoughMatchBS) {
+  for (const Option& opt : {Option::createCall(100, 100, 1, 0.05, 0.2),
+                            Option::createPut(100, 95, 0.5, 0.02, 0.3, 0.01)}) {
+    LiveMonteCarlo live(opt, 400000, 1337u);
+    Greeks gMC = live.calculateGreeks();
+    Greeks gBS = BlackScholes(opt).calculateGreeks();
+
+    EXPECT_NEAR_REL(gMC.delta, gBS.delta, 1e-2, "delta");
+    EXPECT_NEAR_REL(gMC.gamma, gBS.gamma, 3e-2, "gamma");
+    EXPECT_NEAR_REL(gMC.vega, gBS.vega, 3e-2, "vega");
+    EXPECT_NEAR_REL(gMC.theta, gBS.theta, 3e-2, "theta");
+    EXPECT_NEAR_REL(gMC.rho, gBS.rho, 3e-2, "rho");
+  }
+}
+
+TEST(LiveMonteCarlo, RejectsInvalidUpdates) {
+  LiveMonteCarlo live(Option::createCall(100, 100, 1, 0.05, 0.2), 1000, 1u);
+  EXPECT_THROW(live.updateSpot(-1.0), std::invalid_argument);
+  EXPECT_THROW(live.updateVolatility(-0.1), std::invalid_argument);
+}
+
+TEST(LiveMonteCarlo, StandardErrorStableDeepInTheMoney) {
+  // payoffs ≈ 10^6 with spread 0.1: raw second moments would cancel away
+  const Option opt{Option::createCall(1e6, 1.0, 1.0, 0.0, 1e-7)};
+  LiveMonteCarlo live(opt, 10000, 5u);
+  live.calculatePrice();
+  EXPECT_NEAR(live.getStandardError(), 1e-3, 5e-5);
+}
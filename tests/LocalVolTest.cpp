@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "BlackScholes.h"
+#include "LocalVolMonteCarlo.h"
+#include "LocalVolSurface.h"
+#include "Option.h"
+#include "TestUtils.h"
+
+namespace {
+const std::vector<double> EXPIRIES{0.25, 0.5, 1.0};
+const std::vector<double> STRIKES{60, 70, 80, 90, 100, 110, 120, 135, 150};
+
+ImpliedVolSurface flatSurface(double vol) {
+  return ImpliedVolSurface(EXPIRIES, STRIKES,
+                           std::vector<double>(EXPIRIES.size() * STRIKES.size(),
+                                               vol),
+                           100.0, 0.03, 0.01);
+}
+
+// equity-style skew that flattens with maturity
+ImpliedVolSurface skewSurface() {
+  std::vector<double> vols;
+  for (const double T : EXPIRIES) {
+    for (const double K : STRIKES) {
+      vols.push_back(0.2 - 0.12 * std::log(K / 100.0) / std::sqrt(T / 0.25) +
+                     0.01 * T);
+    }
+  }
+  return ImpliedVolSurface(EXPIRIES, STRIKES, vols, 100.0, 0.03, 0.01);
+}
+
+LocalVolMonteCarlo::Config paths(unsigned long n, unsigned threads = 0) {
+  LocalVolMonteCarlo::Config config{};
+  config.paths = n;
+  config.threads = threads;
+  return config;
+}
+}  // namespace
+
+TEST(ImpliedVolSurface, InterpolatesQuotesAndRejectsBadGrids) {
+  const ImpliedVolSurface surface{skewSurface()};
+  EXPECT_NEAR(surface.volatility(0.5, 80.0),
+              0.2 - 0.12 * std::log(0.8) / std::sqrt(2.0) + 0.005, 1e-12);
+  EXPECT_NEAR(flatSurface(0.25).volatility(0.7, 143.0), 0.25, 1e-12);
+  // constant implied volatility beyond the last expiry
+  EXPECT_NEAR(flatSurface(0.25).volatility(3.0, 100.0), 0.25, 1e-12);
+
+  EXPECT_THROW(ImpliedVolSurface({0.5, 0.25}, {90, 110}, {0.2, 0.2, 0.2, 0.2},
+                                 100, 0.0),
+               std::invalid_argument);
+  EXPECT_THROW(ImpliedVolSurface({0.5}, {90}, {0.2}, 100, 0.0),
+               std::invalid_argument);
+  EXPECT_THROW(ImpliedVolSurface({0.5}, {90, 110}, {0.2, -0.2}, 100, 0.0),
+               std::invalid_argument);
+  EXPECT_THROW(ImpliedVolSurface({0.5}, {90, 110}, {0.2}, 100, 0.0),
+               std::invalid_argument);
+}
+
+TEST(LocalVolSurface, FlatImpliedGivesFlatLocalVol) {
+  const auto local{LocalVolSurface::build(flatSurface(0.3))};
+  EXPECT_EQ(local->getClampedNodes(), 0u);
+  for (const double sigma : local->getGrid()) {
+    EXPECT_NEAR(sigma, 0.3, 1e-6);
+  }
+  EXPECT_NEAR(local->localVol(0.4, 87.0), 0.3, 1e-6);
+}
+
+TEST(LocalVolSurface, SkewSteepensLocalVol) {
+  const ImpliedVolSurface implied{skewSurface()};
+  const auto local{LocalVolSurface::build(implied)};
+  // only the far upside wing of the steep short-dated skew hits the floor
+  EXPECT_LT(local->getClampedNodes(), local->getGrid().size() / 100);
+  EXPECT_GT(local->localVol(0.1, 150.0), 0.05);
+  // local skew is about twice the implied skew near the money
+  const double impliedSlope{(implied.volatility(0.5, 105.0) -
+                             implied.volatility(0.5, 95.0)) /
+                            std::log(105.0 / 95.0)};
+  const double localSlope{(local->localVol(0.5, 105.0) -
+                           local->localVol(0.5, 95.0)) /
+                          std::log(105.0 / 95.0)};
+  EXPECT_LT(localSlope, 1.5 * impliedSlope);
+
+  std::vector<double> row(local->getSpotNodes());
+  local->interpolateRow(0.5, row);
+  EXPECT_NEAR(local->lookup(row.data(), std::log(95.0)),
+              local->localVol(0.5, 95.0), 1e-12);
+}
+
+TEST(LocalVolSurface, CountsArbitrageNodes) {
+  // total variance falls between the expiries: calendar arbitrage
+  const ImpliedVolSurface implied({0.5, 1.0}, {80, 100, 120},
+                                  {0.4, 0.4, 0.4, 0.2, 0.2, 0.2}, 100, 0.0);
+  const auto local{LocalVolSurface::build(implied)};
+  EXPECT_GT(local->getClampedNodes(), 0u);
+  EXPECT_NEAR(local->localVol(0.75, 100.0), 0.01, 1e-12);
+
+  LocalVolSurface::Config bad{};
+  bad.spotNodes = 2;
+  EXPECT_THROW(LocalVolSurface::build(implied, bad), std::invalid_argument);
+  bad = LocalVolSurface::Config{};
+  bad.minVol = 1.0;
+  bad.maxVol = 0.5;
+  EXPECT_THROW(LocalVolSurface::build(implied, bad), std::invalid_argument);
+}
+
+TEST(LocalVolMonteCarlo, FlatSurfaceMatchesBlackScholes) {
+  const auto local{LocalVolSurface::build(flatSurface(0.25))};
+  for (const OptionType type : {OptionType::CALL, OptionType::PUT}) {
+    const Option option{type, 100, 110, 0.75, 0.03, 0.9, 0.01};
+    LocalVolMonteCarlo mc(option, local, paths(100000));
+    const double price{mc.calculatePrice()};
+    EXPECT_CLOSE_WITH_SE(
+        price, BlackScholes::price(type, 100, 110, 0.75, 0.03, 0.25, 0.01),
+        mc.getStandardError(), 4.0, "flat local vol vs BS");
+  }
+}
+
+TEST(LocalVolMonteCarlo, RepricesImpliedSurface) {
+  const ImpliedVolSurface implied{skewSurface()};
+  const auto local{LocalVolSurface::build(implied)};
+  for (const double K : {80.0, 100.0, 120.0}) {
+    const OptionType type{K < 100.0 ? OptionType::PUT : OptionType::CALL};
+    const Option option{type, 100, K, 1.0, 0.03, 0.2, 0.01};
+    LocalVolMonteCarlo mc(option, local, paths(200000));
+    const double price{mc.calculatePrice()};
+    const double target{BlackScholes::price(type, 100, K, 1.0, 0.03,
+                                            implied.volatility(1.0, K), 0.01)};
+    EXPECT_CLOSE_WITH_SE(price, target, mc.getStandardError(), 4.0,
+                         "local vol vs implied surface");
+  }
+}
+
+TEST(LocalVolMonteCarlo, SharesOneSurfaceAcrossPricersAndThreads) {
+  const auto local{LocalVolSurface::build(skewSurface())};
+  const Option put{Option::createPut(100, 95, 0.5, 0.03, 0.2, 0.01)};
+  LocalVolMonteCarlo one(put, local, paths(50000, 1));
+  LocalVolMonteCarlo many(put, local, paths(50000, 4));
+  EXPECT_EQ(local.use_count(), 3);
+  EXPECT_EQ(one.calculatePrice(), many.calculatePrice());
+  EXPECT_EQ(one.getStandardError(), many.getStandardError());
+
+  const Greeks g{many.calculateGreeks()};
+  EXPECT_LT(g.delta, 0.0);
+  EXPECT_GT(g.gamma, 0.0);
+  EXPECT_GT(g.vega, 0.0);
+}
+
+TEST(LocalVolMonteCarlo, RejectsInvalidInput) {
+  const auto local{LocalVolSurface::build(flatSurface(0.2))};
+  const Option longDated{Option::createCall(100, 100, 2.0, 0.03, 0.2)};
+  EXPECT_THROW(LocalVolMonteCarlo(longDated, local), std::invalid_argument);
+  const Option call{Option::createCall(100, 100, 0.5, 0.03, 0.2)};
+  EXPECT_THROW(LocalVolMonteCarlo(call, nullptr), std::invalid_argument);
+  EXPECT_THROW(LocalVolMonteCarlo(call, local, paths(0)),
+               std::invalid_argument);
+  LocalVolMonteCarlo mc(call, local);
+  EXPECT_THROW(mc.getStandardError(), std::runtime_error);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "LongstaffSchwartz.h"
+#include "Option.h"
+
+namespace {
+// Longstaff & Schwartz (2001), table 1: finite-difference value 4.478
+Option referencePut() { return Option::createPut(36, 40, 1.0, 0.06, 0.2); }
+
+LongstaffSchwartz::Config testConfig() {
+  LongstaffSchwartz::Config config{};
+  config.paths = 50000;
+  config.exerciseDates = 50;
+  config.seed = 7u;
+  return config;
+}
+}  // namespace
+
+TEST(LongstaffSchwartz, MatchesReferenceAmericanPut) {
+  LongstaffSchwartz pricer(referencePut(), testConfig());
+  const double price{pricer.calculatePrice()};
+  EXPECT_NEAR(price, 4.478, 0.04);
+  EXPECT_GT(pricer.getStandardError(), 0.0);
+  EXPECT_LT(pricer.getStandardError(), 0.02);
+  EXPECT_GT(pricer.getEarlyExercisePremium(), 0.2);  // European is ~3.84
+}
+
+TEST(LongstaffSchwartz, EveryBasisAgrees) {
+  for (const auto basis : {RegressionBasis::MONOMIAL, RegressionBasis::LAGUERRE,
+                           RegressionBasis::HERMITE}) {
+    auto config{testConfig()};
+    config.basis = basis;
+    LongstaffSchwartz pricer(referencePut(), config);
+    EXPECT_NEAR(pricer.calculatePrice(), 4.478, 0.05);
+  }
+}
+
+TEST(LongstaffSchwartz, CallWithoutDividendsIsEuropean) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  LongstaffSchwartz pricer(call, testConfig());
+  const double price{pricer.calculatePrice()};
+  EXPECT_NEAR(price, BlackScholes(call).calculatePrice(),
+              4.0 * pricer.getStandardError());
+}
+
+TEST(LongstaffSchwartz, DividendCallCarriesEarlyExercisePremium) {
+  const Option call{Option::createCall(100, 90, 1.0, 0.03, 0.2, 0.08)};
+  LongstaffSchwartz pricer(call, testConfig());
+  EXPECT_GT(pricer.calculatePrice(), BlackScholes(call).calculatePrice());
+}
+
+TEST(LongstaffSchwartz, ResultDoesNotDependOnThreadCount) {
+  auto config{testConfig()};
+  config.threads = 1;
+  LongstaffSchwartz serial(referencePut(), config);
+  config.threads = 3;
+  LongstaffSchwartz parallel(referencePut(), config);
+  EXPECT_EQ(serial.calculatePrice(), parallel.calculatePrice());
+  EXPECT_EQ(serial.getStandardError(), parallel.getStandardError());
+}
+
+TEST(LongstaffSchwartz, DeepInTheMoneyPutIsWorthIntrinsic) {
+  const Option put{Option::createPut(10, 40, 1.0, 0.06, 0.2)};
+  LongstaffSchwartz pricer(put, testConfig());
+  EXPECT_NEAR(pricer.calculatePrice(), 30.0, 1e-9);
+}
+
+TEST(LongstaffSchwartz, GreeksHaveExpectedSigns) {
+  auto config{testConfig()};
+  config.paths = 20000;
+  LongstaffSchwartz pricer(referencePut(), config);
+  const Greeks g{pricer.calculateGreeks()};
+  EXPECT_LT(g.delta, -0.5);
+  EXPECT_GT(g.delta, -1.0);
+  EXPECT_GT(g.vega, 0.0);
+  EXPECT_LT(g.rho, 0.0);
+}
+
+TEST(LongstaffSchwartz, BasisPolynomials) {
+  const auto lag{LongstaffSchwartz::evaluateBasis(RegressionBasis::LAGUERRE,
+                                                  3, 2.0)};
+  EXPECT_DOUBLE_EQ(lag[1], -1.0);                 // 1 - x
+  EXPECT_DOUBLE_EQ(lag[2], (4.0 - 8.0 + 2.0) / 2.0);  // (x² - 4x + 2) / 2
+  const auto her{LongstaffSchwartz::evaluateBasis(RegressionBasis::HERMITE,
+                                                  3, 2.0)};
+  EXPECT_DOUBLE_EQ(her[3], 8.0 - 6.0);  // x³ - 3x
+  EXPECT_DOUBLE_EQ(her[4], 0.0);
+}
+
+TEST(LongstaffSchwartz, RejectsInvalidConfig) {
+  auto config{testConfig()};
+  config.degree = LongstaffSchwartz::MAX_BASIS;
+  EXPECT_THROW(LongstaffSchwartz(referencePut(), config),
+               std::invalid_argument);
+  config = testConfig();
+  config.exerciseDates = 0;
+  EXPECT_THROW(LongstaffSchwartz(referencePut(), config),
+               std::invalid_argument);
+  LongstaffSchwartz unpriced(referencePut(), testConfig());
+  EXPECT_THROW(unpriced.getStandardError(), std::runtime_error);
+}
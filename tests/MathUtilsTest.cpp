@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <vector>
+
 #include "MathUtils.h"
 
 TEST(MathUtils, PdfIntegratesRoughlyToOne) {
@@ -16,3 +19,35 @@ TEST(MathUtils, CdfSymmetry) {
   double x{1.234};
   EXPECT_NEAR(math::norm_cdf(-x), 1.0 - math::norm_cdf(x), 1e-12);
 }
+
+TEST(MathUtils, InverseCdfRoundTrips) {
+  for (double p : {1e-12, 1e-6, 0.01, 0.02425, 0.3, 0.5, 0.8, 0.99, 1 - 1e-9}) {
+    EXPECT_NEAR(math::norm_cdf(math::norm_inv(p)), p, 1e-7 * p) << p;
+  }
+  EXPECT_NEAR(math::norm_inv(0.975), 1.959963985, 1e-8);
+}
+
+TEST(MathUtils, BlockMomentsKeepPrecisionFarFromZero) {
+  // deep in-the-money payoffs: a mean of 1e8 with a spread of ±1e-3
+  std::vector<math::SampleMoments> blocks{};
+  for (int b{0}; b < 4; ++b) {
+    math::ShiftedSums sums{};
+    for (int i{0}; i < 1000; ++i) {
+      sums.add(1e8 + ((b * 1000 + i) % 2 == 0 ? 1e-3 : -1e-3));
+    }
+    blocks.push_back(sums.moments());
+  }
+  const math::SampleMoments total{math::merge_blocks(blocks)};
+  EXPECT_EQ(total.count, 4000.0);
+  EXPECT_NEAR(total.mean, 1e8, 1e-6);
+  EXPECT_NEAR(total.variance(), 1e-6 * 4000.0 / 3999.0, 1e-9);
+}
+
+TEST(MathUtils, ConfidenceIntervalUsesZLadder) {
+  const auto [lo, hi]{math::confidence_interval(10.0, 0.5, 0.95)};
+  EXPECT_DOUBLE_EQ(lo, 10.0 - 1.96 * 0.5);
+  EXPECT_DOUBLE_EQ(hi, 10.0 + 1.96 * 0.5);
+  EXPECT_DOUBLE_EQ(math::confidence_z(0.995), 2.576);
+  EXPECT_DOUBLE_EQ(math::confidence_z(0.5), 1.282);
+  EXPECT_THROW(math::confidence_z(1.0), std::invalid_argument);
+}
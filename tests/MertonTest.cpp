@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "CharacteristicFunction.h"
+#include "FourierPricer.h"
+#include "Merton.h"
+#include "MertonMonteCarlo.h"
+#include "Option.h"
+#include "TestUtils.h"
+
+namespace {
+// large, frequent down-jumps, so the jump part dominates short-dated puts
+const MertonParams JUMPY{0.15, 1.5, -0.12, 0.2};
+
+MertonMonteCarlo::Config paths(unsigned long n, unsigned threads = 0) {
+  MertonMonteCarlo::Config config{};
+  config.paths = n;
+  config.threads = threads;
+  return config;
+}
+}  // namespace
+
+TEST(MertonAnalytic, ReducesToBlackScholesWithoutJumps) {
+  for (const OptionType type : {OptionType::CALL, OptionType::PUT}) {
+    const Option option{type, 100, 105, 0.5, 0.03, 0.25, 0.01};
+    MertonAnalytic merton(option, MertonParams{0.25, 0.0, -0.1, 0.15});
+    EXPECT_NEAR(merton.calculatePrice(),
+                BlackScholes::price(type, 100, 105, 0.5, 0.03, 0.25, 0.01),
+                1e-12);
+    EXPECT_EQ(merton.getSeriesTerms(), 1u);
+  }
+}
+
+TEST(MertonAnalytic, MatchesFourierPricer) {
+  const auto model{std::make_shared<MertonCF>(JUMPY)};
+  for (const double K : {70.0, 95.0, 100.0, 130.0}) {
+    for (const OptionType type : {OptionType::CALL, OptionType::PUT}) {
+      const Option option{type, 100, K, 0.25, 0.04, 0.2, 0.02};
+      FourierPricer cos(option, model);
+      EXPECT_NEAR(merton::price(type, 100, K, 0.25, 0.04, 0.02, JUMPY),
+                  cos.calculatePrice(), 1e-7)
+          << K;
+    }
+  }
+}
+
+TEST(MertonAnalytic, TruncationAdaptsToJumpIntensity) {
+  unsigned rare{}, frequent{};
+  merton::price(OptionType::CALL, 100, 100, 0.1, 0.03, 0.0,
+                MertonParams{0.2, 0.1, -0.1, 0.15}, 1e-12, &rare);
+  merton::price(OptionType::CALL, 100, 100, 2.0, 0.03, 0.0,
+                MertonParams{0.2, 20.0, -0.02, 0.05}, 1e-12, &frequent);
+  EXPECT_LE(rare, 8u);
+  EXPECT_GT(frequent, 40u);
+  // a looser tolerance needs fewer terms and moves the price by less
+  unsigned loose{};
+  const double tight{merton::price(OptionType::CALL, 100, 100, 2.0, 0.03, 0.0,
+                                   MertonParams{0.2, 20.0, -0.02, 0.05})};
+  const double coarse{merton::price(OptionType::CALL, 100, 100, 2.0, 0.03,
+                                    0.0, MertonParams{0.2, 20.0, -0.02, 0.05},
+                                    1e-4, &loose)};
+  EXPECT_LT(loose, frequent);
+  EXPECT_NEAR(coarse, tight, 1e-4);
+}
+
+TEST(MertonAnalytic, GreeksMatchDifferencedPrices) {
+  const Option put{Option::createPut(100, 95, 0.25, 0.03, 0.2)};
+  MertonAnalytic merton(put, JUMPY);
+  const Greeks g{merton.calculateGreeks()};
+  const double h{0.01};
+  const double up{merton::price(OptionType::PUT, 100 + h, 95, 0.25, 0.03, 0.0,
+                                JUMPY)};
+  const double dn{merton::price(OptionType::PUT, 100 - h, 95, 0.25, 0.03, 0.0,
+                                JUMPY)};
+  EXPECT_NEAR(g.delta, (up - dn) / (2.0 * h), 1e-5);
+  EXPECT_LT(g.delta, 0.0);
+  EXPECT_GT(g.gamma, 0.0);
+  EXPECT_GT(g.vega, 0.0);
+}
+
+TEST(MertonMonteCarlo, MatchesSeriesPrice) {
+  for (const double K : {80.0, 100.0, 115.0}) {
+    for (const OptionType type : {OptionType::CALL, OptionType::PUT}) {
+      const Option option{type, 100, K, 0.25, 0.04, 0.2, 0.02};
+      MertonMonteCarlo mc(option, JUMPY, paths(200000));
+      const double price{mc.calculatePrice()};
+      EXPECT_CLOSE_WITH_SE(price,
+                           merton::price(type, 100, K, 0.25, 0.04, 0.02, JUMPY),
+                           mc.getStandardError(), 4.0, "Merton MC vs series");
+    }
+  }
+}
+
+TEST(MertonMonteCarlo, ResultsDoNotDependOnThreadCount) {
+  const Option put{Option::createPut(100, 90, 0.1, 0.03, 0.2)};
+  MertonMonteCarlo one(put, JUMPY, paths(50000, 1));
+  MertonMonteCarlo many(put, JUMPY, paths(50000, 4));
+  EXPECT_EQ(one.calculatePrice(), many.calculatePrice());
+  EXPECT_EQ(one.getStandardError(), many.getStandardError());
+}
+
+TEST(MertonMonteCarlo, GreeksCloseToAnalytic) {
+  const Option call{Option::createCall(100, 100, 0.5, 0.03, 0.2)};
+  MertonMonteCarlo mc(call, JUMPY, paths(200000));
+  MertonAnalytic exact(call, JUMPY);
+  const Greeks g{mc.calculateGreeks()};
+  const Greeks expected{exact.calculateGreeks()};
+  EXPECT_NEAR(g.delta, expected.delta, 0.01);
+  EXPECT_NEAR(g.vega, expected.vega, 0.05 * expected.vega);
+  EXPECT_NEAR(g.rho, expected.rho, 0.05 * expected.rho);
+}
+
+TEST(MertonMonteCarlo, RejectsInvalidInput) {
+  const Option call{Option::createCall(100, 100, 0.5, 0.03, 0.2)};
+  EXPECT_THROW(MertonMonteCarlo(call, MertonParams{0.2, -1.0, 0.0, 0.1}),
+               std::invalid_argument);
+  EXPECT_THROW(MertonAnalytic(call, MertonParams{-0.2, 1.0, 0.0, 0.1}),
+               std::invalid_argument);
+  EXPECT_THROW(MertonMonteCarlo(call, JUMPY, paths(0)), std::invalid_argument);
+  MertonMonteCarlo mc(call, JUMPY);
+  EXPECT_THROW(mc.getStandardError(), std::runtime_error);
+}
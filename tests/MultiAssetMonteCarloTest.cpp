@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "BlackScholes.h"
+#include "MathUtils.h"
+#include "MultiAssetMonteCarlo.h"
+
+namespace {
+BasketOption twoAssets(BasketPayoff payoff, double strike, double rho) {
+  BasketOption option{};
+  option.type = OptionType::CALL;
+  option.payoff = payoff;
+  option.assets = {{100.0, 0.3, 0.02}, {95.0, 0.2, 0.0}};
+  option.weights = {1.0, 1.0};
+  option.correlation = {1.0, rho, rho, 1.0};
+  option.strike = strike;
+  option.maturity = 1.0;
+  option.riskFreeRate = 0.05;
+  return option;
+}
+
+// Margrabe's exchange option: max(S1 - S2, 0)
+double margrabe(const BasketOption& o) {
+  const Asset& a{o.assets[0]};
+  const Asset& b{o.assets[1]};
+  const double rho{o.correlation[1]};
+  const double T{o.maturity};
+  const double sigma{std::sqrt(a.volatility * a.volatility +
+                               b.volatility * b.volatility -
+                               2.0 * rho * a.volatility * b.volatility)};
+  const double fa{a.spot * std::exp(-a.dividendYield * T)};
+  const double fb{b.spot * std::exp(-b.dividendYield * T)};
+  const double d1{(std::log(fa / fb) + 0.5 * sigma * sigma * T) /
+                  (sigma * std::sqrt(T))};
+  const double d2{d1 - sigma * std::sqrt(T)};
+  return fa * math::norm_cdf(d1) - fb * math::norm_cdf(d2);
+}
+
+MultiAssetMonteCarlo::Config paths(unsigned long n, unsigned threads = 0) {
+  MultiAssetMonteCarlo::Config config{};
+  config.paths = n;
+  config.threads = threads;
+  return config;
+}
+}  // namespace
+
+TEST(MultiAssetMonteCarlo, SingleAssetMatchesBlackScholes) {
+  BasketOption option{};
+  option.type = OptionType::PUT;
+  option.assets = {{100.0, 0.25, 0.01}};
+  option.weights = {1.0};
+  option.correlation = {1.0};
+  option.strike = 105.0;
+  option.maturity = 0.75;
+  option.riskFreeRate = 0.03;
+  MultiAssetMonteCarlo mc(option, paths(200000));
+  const double price{mc.calculatePrice()};
+  EXPECT_NEAR(price,
+              BlackScholes::price(OptionType::PUT, 100, 105, 0.75, 0.03, 0.25,
+                                  0.01),
+              4.0 * mc.getStandardError());
+  const std::vector<double> deltas{mc.calculateDeltas()};
+  ASSERT_EQ(deltas.size(), 1u);
+  EXPECT_NEAR(deltas[0], -0.5, 0.2);
+}
+
+TEST(MultiAssetMonteCarlo, SpreadMatchesMargrabe) {
+  for (const double rho : {-0.5, 0.0, 0.6}) {
+    const BasketOption option{twoAssets(BasketPayoff::SPREAD, 0.0, rho)};
+    MultiAssetMonteCarlo mc(option, paths(200000));
+    const double price{mc.calculatePrice()};
+    EXPECT_NEAR(price, margrabe(option), 4.0 * mc.getStandardError()) << rho;
+  }
+}
+
+TEST(MultiAssetMonteCarlo, BestOfMatchesExchangeDecomposition) {
+  // max(S1, S2) = S2 + max(S1 - S2, 0)
+  const BasketOption option{twoAssets(BasketPayoff::BEST_OF, 0.0, 0.3)};
+  MultiAssetMonteCarlo mc(option, paths(200000));
+  const double price{mc.calculatePrice()};
+  EXPECT_NEAR(price, 95.0 + margrabe(option), 4.0 * mc.getStandardError());
+
+  // min(S1, S2) = S1 - max(S1 - S2, 0)
+  BasketOption worst{option};
+  worst.payoff = BasketPayoff::WORST_OF;
+  MultiAssetMonteCarlo mcWorst(worst, paths(200000));
+  const double worstPrice{mcWorst.calculatePrice()};
+  const double fa{100.0 * std::exp(-0.02)};
+  EXPECT_NEAR(worstPrice, fa - margrabe(option),
+              4.0 * mcWorst.getStandardError());
+}
+
+TEST(MultiAssetMonteCarlo, ResultsDoNotDependOnThreadCount) {
+  const BasketOption option{twoAssets(BasketPayoff::BASKET, 190.0, 0.4)};
+  MultiAssetMonteCarlo one(option, paths(30000, 1));
+  MultiAssetMonteCarlo four(option, paths(30000, 4));
+  EXPECT_EQ(one.calculatePrice(), four.calculatePrice());
+  EXPECT_EQ(one.getStandardError(), four.getStandardError());
+  EXPECT_EQ(one.calculateDeltas(), four.calculateDeltas());
+}
+
+TEST(MultiAssetMonteCarlo, RepairsIndefiniteCorrelation) {
+  // pairwise-consistent looking, but not positive semi-definite
+  const std::vector<double> bad{1.0, 0.9, 0.9,  //
+                                0.9, 1.0, -0.9,  //
+                                0.9, -0.9, 1.0};
+  const std::vector<double> fixed{
+      MultiAssetMonteCarlo::repairCorrelation(bad, 3)};
+  for (std::size_t i{0}; i < 3; ++i) {
+    EXPECT_DOUBLE_EQ(fixed[i * 3 + i], 1.0);
+    for (std::size_t j{0}; j < 3; ++j) {
+      EXPECT_DOUBLE_EQ(fixed[i * 3 + j], fixed[j * 3 + i]);
+      EXPECT_LE(std::abs(fixed[i * 3 + j]), 1.0);
+    }
+  }
+
+  BasketOption option{};
+  option.assets = {{100, 0.2}, {100, 0.2}, {100, 0.2}};
+  option.weights = {1.0, 1.0, 1.0};
+  option.correlation = bad;
+  option.strike = 300.0;
+  option.maturity = 1.0;
+  MultiAssetMonteCarlo mc(option, paths(10000));
+  EXPECT_TRUE(mc.correlationRepaired());
+  EXPECT_GT(mc.calculatePrice(), 0.0);
+
+  // a valid matrix is left alone
+  const std::vector<double> good{1.0, 0.3, 0.3, 1.0};
+  const std::vector<double> same{
+      MultiAssetMonteCarlo::repairCorrelation(good, 2)};
+  for (std::size_t k{0}; k < good.size(); ++k) {
+    EXPECT_NEAR(same[k], good[k], 1e-12);
+  }
+  EXPECT_FALSE(MultiAssetMonteCarlo(twoAssets(BasketPayoff::BASKET, 0, 0.3))
+                   .correlationRepaired());
+}
+
+TEST(MultiAssetMonteCarlo, FiftyPerfectlyCorrelatedAssetsActAsOne) {
+  // ρ = 1 everywhere is singular; after repair the basket behaves like a
+  // single asset with the average spot
+  const std::size_t n{50};
+  BasketOption option{};
+  option.assets.assign(n, Asset{100.0, 0.2, 0.0});
+  option.weights.assign(n, 1.0 / n);
+  option.correlation.assign(n * n, 1.0);
+  option.strike = 100.0;
+  option.maturity = 1.0;
+  option.riskFreeRate = 0.05;
+  MultiAssetMonteCarlo mc(option, paths(100000));
+  EXPECT_TRUE(mc.correlationRepaired());
+  const double price{mc.calculatePrice()};
+  EXPECT_NEAR(price,
+              BlackScholes::price(OptionType::CALL, 100, 100, 1.0, 0.05, 0.2,
+                                  0.0),
+              4.0 * mc.getStandardError() + 1e-3);
+}
+
+TEST(MultiAssetMonteCarlo, RejectsInvalidInput) {
+  BasketOption option{twoAssets(BasketPayoff::BASKET, 100.0, 0.2)};
+  option.weights = {1.0};
+  EXPECT_THROW(MultiAssetMonteCarlo{option}, std::invalid_argument);
+
+  option = twoAssets(BasketPayoff::BASKET, 100.0, 0.2);
+  option.correlation[1] = 0.5;  // not symmetric
+  EXPECT_THROW(MultiAssetMonteCarlo{option}, std::invalid_argument);
+
+  option = twoAssets(BasketPayoff::SPREAD, 0.0, 0.2);
+  option.assets.push_back({50.0, 0.1});
+  option.weights.push_back(1.0);
+  option.correlation = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  EXPECT_THROW(MultiAssetMonteCarlo{option}, std::invalid_argument);
+
+  MultiAssetMonteCarlo mc(twoAssets(BasketPayoff::BASKET, 100.0, 0.2));
+  EXPECT_THROW(mc.getStandardError(), std::runtime_error);
+  EXPECT_THROW(MultiAssetMonteCarlo(twoAssets(BasketPayoff::BASKET, 0, 0),
+                                    paths(0)),
+               std::invalid_argument);
+}
+
+TEST(MultiAssetMonteCarlo, LatinHypercubeReducesError) {
+  const BasketOption option{twoAssets(BasketPayoff::BASKET, 190.0, 0.4)};
+  MultiAssetMonteCarlo plain(option, paths(100000));
+  MultiAssetMonteCarlo::Config config{paths(100000)};
+  config.latinHypercube = true;
+  MultiAssetMonteCarlo lhs(option, config);
+  const double plainPrice{plain.calculatePrice()};
+  const double lhsPrice{lhs.calculatePrice()};
+  EXPECT_NEAR(lhsPrice, plainPrice,
+              4.0 * std::hypot(plain.getStandardError(),
+                               lhs.getStandardError()));
+  EXPECT_LT(lhs.getStandardError(), 0.5 * plain.getStandardError());
+
+  config.paths = config.blockPaths;  // one block: no error estimate
+  EXPECT_THROW(MultiAssetMonteCarlo(option, config), std::invalid_argument);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "MathUtils.h"
+#include "MultilevelMonteCarlo.h"
+#include "Option.h"
+
+namespace {
+MultilevelMonteCarlo::Config rmse(double eps, unsigned threads = 0) {
+  MultilevelMonteCarlo::Config config{};
+  config.targetRmse = eps;
+  config.threads = threads;
+  return config;
+}
+
+// continuously monitored down-and-out call, barrier below the strike
+double downAndOutCall(double S, double K, double B, double T, double r,
+                      double sigma) {
+  const double lambda{(r + 0.5 * sigma * sigma) / (sigma * sigma)};
+  const double sqrtT{sigma * std::sqrt(T)};
+  const double y{std::log(B * B / (S * K)) / sqrtT + lambda * sqrtT};
+  const double downIn{
+      S * std::pow(B / S, 2.0 * lambda) * math::norm_cdf(y) -
+      K * std::exp(-r * T) * std::pow(B / S, 2.0 * lambda - 2.0) *
+          math::norm_cdf(y - sqrtT)};
+  return BlackScholes::price(OptionType::CALL, S, K, T, r, sigma, 0.0) -
+         downIn;
+}
+
+// continuous geometric-average Asian call, a lower bound for the arithmetic
+double geometricAsianCall(double S, double K, double T, double r,
+                          double sigma) {
+  const double sigmaG{sigma / std::sqrt(3.0)};
+  const double b{0.5 * (r - sigma * sigma / 6.0)};
+  const double d1{(std::log(S / K) + (b + 0.5 * sigmaG * sigmaG) * T) /
+                  (sigmaG * std::sqrt(T))};
+  const double d2{d1 - sigmaG * std::sqrt(T)};
+  return S * std::exp((b - r) * T) * math::norm_cdf(d1) -
+         K * std::exp(-r * T) * math::norm_cdf(d2);
+}
+}  // namespace
+
+TEST(MultilevelMonteCarlo, EuropeanMatchesBlackScholes) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  MultilevelMonteCarlo mlmc(call, PathPayoff::EUROPEAN, 0.0, rmse(0.02));
+  const double price{mlmc.calculatePrice()};
+  EXPECT_TRUE(mlmc.isConverged());
+  EXPECT_NEAR(price, BlackScholes::price(OptionType::CALL, 100, 100, 1.0, 0.05,
+                                         0.2, 0.0),
+              0.06);
+  EXPECT_LT(mlmc.getStandardError(), 0.02);
+  EXPECT_GE(mlmc.getLevels().size(), 3u);
+}
+
+TEST(MultilevelMonteCarlo, BarrierMatchesClosedFormAndSavesWork) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  MultilevelMonteCarlo mlmc(call, PathPayoff::DOWN_AND_OUT, 85.0, rmse(0.01));
+  const double price{mlmc.calculatePrice()};
+  EXPECT_NEAR(price, downAndOutCall(100, 100, 85, 1.0, 0.05, 0.2), 0.04);
+  EXPECT_GT(mlmc.getSingleLevelCost(), 10.0 * mlmc.getCost());
+
+  // an up-and-out call is worth less than the vanilla
+  MultilevelMonteCarlo upOut(call, PathPayoff::UP_AND_OUT, 130.0, rmse(0.02));
+  const double upPrice{upOut.calculatePrice()};
+  EXPECT_GT(upPrice, 0.0);
+  EXPECT_LT(upPrice, BlackScholes::price(OptionType::CALL, 100, 100, 1.0, 0.05,
+                                         0.2, 0.0));
+}
+
+TEST(MultilevelMonteCarlo, AsianIsBracketedAndVarianceDecays) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  MultilevelMonteCarlo mlmc(call, PathPayoff::ASIAN, 0.0, rmse(0.01));
+  const double price{mlmc.calculatePrice()};
+  const double geometric{geometricAsianCall(100, 100, 1.0, 0.05, 0.2)};
+  EXPECT_GT(price, geometric);
+  EXPECT_LT(price, geometric + 0.4);
+  EXPECT_GT(mlmc.getSingleLevelCost(), 2.0 * mlmc.getCost());
+  // Milstein coupling: the correction variance falls with the level, and
+  // fewer samples are taken on finer levels
+  const auto& levels{mlmc.getLevels()};
+  for (std::size_t l{2}; l < levels.size(); ++l) {
+    EXPECT_LT(levels[l].variance, levels[l - 1].variance) << l;
+    EXPECT_LE(levels[l].samples, levels[l - 1].samples) << l;
+  }
+}
+
+TEST(MultilevelMonteCarlo, ResultsDoNotDependOnThreadCount) {
+  const Option put{Option::createPut(100, 105, 0.5, 0.03, 0.25)};
+  MultilevelMonteCarlo one(put, PathPayoff::ASIAN, 0.0, rmse(0.05, 1));
+  MultilevelMonteCarlo three(put, PathPayoff::ASIAN, 0.0, rmse(0.05, 3));
+  EXPECT_EQ(one.calculatePrice(), three.calculatePrice());
+  EXPECT_EQ(one.getStandardError(), three.getStandardError());
+}
+
+TEST(MultilevelMonteCarlo, GreeksUseCommonRandomNumbers) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  MultilevelMonteCarlo mlmc(call, PathPayoff::EUROPEAN, 0.0, rmse(0.05));
+  BlackScholes bs(call);
+  const Greeks g{mlmc.calculateGreeks()};
+  const Greeks expected{bs.calculateGreeks()};
+  EXPECT_NEAR(g.delta, expected.delta, 0.02);
+  EXPECT_NEAR(g.vega, expected.vega, 0.05 * expected.vega);
+  EXPECT_NEAR(g.rho, expected.rho, 0.05 * expected.rho);
+}
+
+TEST(MultilevelMonteCarlo, RejectsInvalidInput) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  EXPECT_THROW(MultilevelMonteCarlo(call, PathPayoff::EUROPEAN, 0.0, rmse(0.0)),
+               std::invalid_argument);
+  EXPECT_THROW(MultilevelMonteCarlo(call, PathPayoff::UP_AND_OUT, 90.0),
+               std::invalid_argument);
+  EXPECT_THROW(MultilevelMonteCarlo(call, PathPayoff::DOWN_AND_OUT, 0.0),
+               std::invalid_argument);
+  MultilevelMonteCarlo::Config deep{};
+  deep.maxLevel = 20;  // 2^30 draws per finest block
+  EXPECT_THROW(MultilevelMonteCarlo(call, PathPayoff::EUROPEAN, 0.0, deep),
+               std::invalid_argument);
+  MultilevelMonteCarlo mlmc(call, PathPayoff::EUROPEAN);
+  EXPECT_THROW(mlmc.getStandardError(), std::runtime_error);
+  EXPECT_THROW(mlmc.getLevels(), std::runtime_error);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "BlackScholes.h"
+#include "ImpliedVol.h"
+#include "OptionChainFile.h"
+
+namespace {
+std::string tempChainPath(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+OptionChainData sampleChain() {
+  OptionChainData data;
+  for (int i = 0; i < 100; ++i) {
+    const double K = 80.0 + 0.4 * i;
+    Option opt = (i % 2 == 0) ? Option::createCall(100, K, 0.5, 0.03, 0.25)
+                              : Option::createPut(100, K, 0.5, 0.03, 0.25, 0.01);
+    data.add(opt, BlackScholes(opt).calculatePrice());
+  }
+  return data;
+}
+}  // namespace
+
+TEST(OptionChainFile, MappedColumnsMatchWrittenData) {
+  const std::string path = tempChainPath("chain_roundtrip.mcpchain");
+  OptionChainData data = sampleChain();
+  chain::write(path, data.columns(), data.marketPrice);
+
+  MappedOptionChain mapped(path);
+  ASSERT_EQ(mapped.size(), data.size());
+  OptionColumns cols = mapped.columns();
+  EXPECT_EQ(cols.type[1], OptionType::PUT);
+  EXPECT_DOUBLE_EQ(cols.K[99], data.K[99]);
+  EXPECT_DOUBLE_EQ(cols.q[1], 0.01);
+  EXPECT_DOUBLE_EQ(mapped.marketPrices()[7], data.marketPrice[7]);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(cols.S.data()) % 64, 0u);
+  EXPECT_FALSE(mapped.hasResults());
+  EXPECT_THROW(mapped.resultValues(), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(OptionChainFile, BatchKernelsRunOnMappedColumns) {
+  const std::string path = tempChainPath("chain_batch.mcpchain");
+  OptionChainData data = sampleChain();
+  chain::write(path, data.columns(), data.marketPrice);
+
+  std::vector<double> prices, vols;
+  {
+    MappedOptionChain mapped(path);
+    prices.resize(mapped.size());
+    vols.resize(mapped.size());
+    BlackScholes::priceBatch(mapped.columns(), prices);
+    impliedVolBatch(mapped.columns(), mapped.marketPrices(), vols);
+  }
+  for (std::size_t i = 0; i < prices.size(); ++i) {
+    EXPECT_DOUBLE_EQ(prices[i], data.marketPrice[i]);
+    EXPECT_NEAR(vols[i], 0.25, 1e-5);
+  }
+
+  chain::appendResults(path, prices);
+  MappedOptionChain reopened(path);
+  ASSERT_TRUE(reopened.hasResults());
+  EXPECT_DOUBLE_EQ(reopened.resultValues()[42], prices[42]);
+  EXPECT_DOUBLE_EQ(reopened.resultStandardErrors()[42], 0.0);
+  EXPECT_DOUBLE_EQ(reopened.columns().K[42], data.K[42]);
+  std::filesystem::remove(path);
+}
+
+TEST(OptionChainFile, WriteValidatesEveryRow) {
+  const std::string path = tempChainPath("chain_invalid.mcpchain");
+  OptionChainData data = sampleChain();
+  data.sigma[57] = -0.1;
+  try {
+    chain::write(path, data.columns());
+    FAIL() << "expected invalid_argument";
+  } catch (const std::invalid_argument& e) {
+    EXPECT_NE(std::string(e.what()).find("Row 57"), std::string::npos);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(OptionChainFile, RejectsForeignFiles) {
+  const std::string path = tempChainPath("chain_foreign.mcpchain");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(256, 'x');
+  }
+  EXPECT_THROW(MappedOptionChain mapped(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
 #include "BlackScholes.h"
+#include "Lattice.h"
 #include "MonteCarlo.h"
 #include "Option.h"
 #include "TestUtils.h"
@@ -11,6 +18,14 @@ struct GridParam {
 };
 class MCBSParamGrid : public ::testing::TestWithParam<GridParam> {};
 
+const GridParam GRID[]{
+    {80, 100, 0.25, 0.00, 0.10, 0.00, OptionType::CALL},
+    {100, 100, 1.00, 0.05, 0.20, 0.00, OptionType::CALL},
+    {120, 90, 2.00, 0.03, 0.40, 0.00, OptionType::PUT},
+    {100, 110, 0.50, -0.01, 0.30, 0.02, OptionType::CALL},
+    {50, 150, 1.50, 0.07, 0.15, 0.00, OptionType::PUT},
+    {150, 50, 0.75, 0.02, 0.35, 0.05, OptionType::CALL}};
+
 TEST_P(MCBSParamGrid, MCWithin3SEofBS) {
   auto p = GetParam();
   Option opt = (p.type == OptionType::CALL)
@@ -30,12 +45,140 @@ TEST_P(MCBSParamGrid, MCWithin3SEofBS) {
   }
 }
 
-INSTANTIATE_TEST_SUITE_P(
-    ParamSweep, MCBSParamGrid,
-    ::testing::Values(
-        GridParam{80, 100, 0.25, 0.00, 0.10, 0.00, OptionType::CALL},
-        GridParam{100, 100, 1.00, 0.05, 0.20, 0.00, OptionType::CALL},
-        GridParam{120, 90, 2.00, 0.03, 0.40, 0.00, OptionType::PUT},
-        GridParam{100, 110, 0.50, -0.01, 0.30, 0.02, OptionType::CALL},
-        GridParam{50, 150, 1.50, 0.07, 0.15, 0.00, OptionType::PUT},
-        GridParam{150, 50, 0.75, 0.02, 0.35, 0.05, OptionType::CALL}));
+INSTANTIATE_TEST_SUITE_P(ParamSweep, MCBSParamGrid, ::testing::ValuesIn(GRID));
+
+// Leisen-Reimer converges at O(1/N²) and smoothly in N, so a modest tree
+// already matches Black-Scholes to well under MC noise on the same grid
+class LatticeBSParamGrid : public ::testing::TestWithParam<GridParam> {};
+
+TEST_P(LatticeBSParamGrid, LeisenReimerWithinTolerance) {
+  auto p = GetParam();
+  Option opt = (p.type == OptionType::CALL)
+                   ? Option::createCall(p.S, p.K, p.T, p.r, p.sig, p.q)
+                   : Option::createPut(p.S, p.K, p.T, p.r, p.sig, p.q);
+
+  Lattice::Config config{};
+  config.steps = 201;
+  Lattice tree(opt, config);
+  BlackScholes bs(opt);
+  EXPECT_NEAR(tree.calculatePrice(), bs.calculatePrice(), 1e-4);
+}
+
+INSTANTIATE_TEST_SUITE_P(ParamSweep, LatticeBSParamGrid,
+                         ::testing::ValuesIn(GRID));
+
+// convergence of each lattice method against Black-Scholes over the whole
+// grid: errors at N, 2N and 4N steps, the observed order, and the steps and
+// time needed to reach a price tolerance
+class LatticeConvergence : public ::testing::TestWithParam<LatticeMethod> {};
+
+namespace {
+Option gridOption(const GridParam& p) {
+  return Option(p.type, p.S, p.K, p.T, p.r, p.sig, p.q);
+}
+
+// largest |lattice - BS| over the grid at the given steps
+double maxGridError(LatticeMethod method, std::size_t steps) {
+  double worst{0.0};
+  for (const GridParam& p : GRID) {
+    const Option opt{gridOption(p)};
+    Lattice::Config config{};
+    config.method = method;
+    config.steps = steps;
+    worst = std::max(worst, std::abs(Lattice(opt, config).calculatePrice() -
+                                     BlackScholes(opt).calculatePrice()));
+  }
+  return worst;
+}
+
+// smallest doubling of 25 steps (up to 12800) whose worst grid error is
+// within tol
+std::size_t stepsToTolerance(LatticeMethod method, double tol) {
+  std::size_t steps{25};
+  while (steps < 12800 && maxGridError(method, steps) > tol) steps *= 2;
+  return steps;
+}
+
+const char* methodName(LatticeMethod method) {
+  switch (method) {
+    case LatticeMethod::CRR:
+      return "CRR";
+    case LatticeMethod::LEISEN_REIMER:
+      return "Leisen-Reimer";
+    case LatticeMethod::TRINOMIAL:
+      return "trinomial";
+  }
+  return "?";
+}
+
+template <class F>
+double secondsPerCall(F&& f, int repeats) {
+  const auto start{std::chrono::steady_clock::now()};
+  for (int i{0}; i < repeats; ++i) f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+             .count() /
+         repeats;
+}
+}  // namespace
+
+TEST_P(LatticeConvergence, ObservedOrderAgainstBlackScholes) {
+  const LatticeMethod method{GetParam()};
+  const std::size_t N{100};
+  for (const GridParam& p : GRID) {
+    const Option opt{gridOption(p)};
+    const double bs{BlackScholes(opt).calculatePrice()};
+    double error[3]{};
+    for (int k{0}; k < 3; ++k) {
+      Lattice::Config config{};
+      config.method = method;
+      config.steps = N << k;
+      error[k] = std::abs(Lattice(opt, config).calculatePrice() - bs);
+    }
+    const double order{std::log2(error[0] / error[2]) / 2.0};
+    RecordProperty("order_S" + std::to_string(static_cast<int>(p.S)) + "_K" +
+                       std::to_string(static_cast<int>(p.K)),
+                   std::to_string(order));
+    if (error[0] < 1e-9) continue;  // at round-off already
+    if (method == LatticeMethod::LEISEN_REIMER) {
+      // second order and smooth in N: every doubling cuts the error ~4x
+      EXPECT_GT(std::log2(error[0] / error[1]), 1.7) << p.S << '/' << p.K;
+      EXPECT_GT(std::log2(error[1] / error[2]), 1.7) << p.S << '/' << p.K;
+    }
+  }
+  // CRR and trinomial errors oscillate with N around a first-order
+  // envelope, so only the grid-wide worst case is checked for them
+  EXPECT_LT(maxGridError(method, 4 * N), 0.5 * maxGridError(method, N));
+}
+
+TEST_P(LatticeConvergence, TimeToToleranceAgainstBlackScholes) {
+  const LatticeMethod method{GetParam()};
+  const double tol{5e-3};
+  const std::size_t steps{stepsToTolerance(method, tol)};
+  const std::size_t leisenReimer{
+      stepsToTolerance(LatticeMethod::LEISEN_REIMER, tol)};
+  ASSERT_LT(steps, 12800u) << "tolerance not reached";
+  // Leisen-Reimer needs the fewest steps of the three
+  EXPECT_LE(leisenReimer, steps);
+
+  const Option opt{gridOption(GRID[1])};
+  Lattice::Config config{};
+  config.method = method;
+  config.steps = steps;
+  const double treeSeconds{secondsPerCall(
+      [&] { return Lattice(opt, config).calculatePrice(); }, 20)};
+  const double bsSeconds{secondsPerCall(
+      [&] { return BlackScholes(opt).calculatePrice(); }, 2000)};
+  RecordProperty("steps_to_tolerance", std::to_string(steps));
+  RecordProperty("seconds_vs_black_scholes",
+                 std::to_string(treeSeconds / bsSeconds));
+  std::cout << "[ lattice  ] " << methodName(method) << ": |error| <= " << tol
+            << " over the grid at " << steps << " steps, " << treeSeconds * 1e6
+            << " us per price ("
+            << treeSeconds / bsSeconds << "x Black-Scholes)\n";
+}
+
+INSTANTIATE_TEST_SUITE_P(Methods, LatticeConvergence,
+                         ::testing::Values(LatticeMethod::CRR,
+                                           LatticeMethod::LEISEN_REIMER,
+                                           LatticeMethod::TRINOMIAL));
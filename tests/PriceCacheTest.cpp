@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "BatchIO.h"
+#include "BlackScholes.h"
+#include "MonteCarlo.h"
+#include "Option.h"
+#include "PriceCache.h"
+
+TEST(PriceCache, IdenticalOptionsFromDifferentPricersHit) {
+  PriceCache cache;
+  Option opt = Option::createCall(100, 105, 0.5, 0.03, 0.2, 0.01);
+  BlackScholes a(opt);
+  BlackScholes b(Option::createCall(100, 105, 0.5, 0.03, 0.2, 0.01));
+
+  const double first = cache.price(a).value;
+  EXPECT_DOUBLE_EQ(first, a.calculatePrice());
+  EXPECT_DOUBLE_EQ(cache.price(b).value, first);
+  EXPECT_FALSE(b.isPriceCalculated());  // served from the cache
+
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.size, 1u);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+}
+
+TEST(PriceCache, KeyCoversEngineSettingsAndSeed) {
+  Option opt = Option::createPut(100, 100, 1, 0.05, 0.2);
+  const PriceKey bs = *BlackScholes(opt).cacheKey();
+  const PriceKey mc1 = *MonteCarlo(opt, 1000, 1u).cacheKey();
+  const PriceKey mc2 = *MonteCarlo(opt, 1000, 2u).cacheKey();
+  const PriceKey mc3 = *MonteCarlo(opt, 2000, 1u).cacheKey();
+  EXPECT_NE(bs, mc1);
+  EXPECT_NE(mc1, mc2);
+  EXPECT_NE(mc1, mc3);
+  EXPECT_EQ(mc1, *MonteCarlo(opt, 1000, 1u).cacheKey());
+  EXPECT_NE(bs, *BlackScholes(Option::createCall(100, 100, 1, 0.05, 0.2))
+                     .cacheKey());
+}
+
+TEST(PriceCache, IrreproducibleMonteCarloIsNotCached) {
+  Option opt = Option::createCall(100, 100, 1, 0.05, 0.2);
+  EXPECT_FALSE(MonteCarlo(opt, 1000).cacheKey().has_value());
+
+  MonteCarlo mc(opt, 1000, 5u);
+  mc.calculatePrice();
+  mc.reset(opt);  // stream continues, not reproducible from the seed
+  EXPECT_FALSE(mc.cacheKey().has_value());
+  mc.reset(opt, 5u);
+  EXPECT_TRUE(mc.cacheKey().has_value());
+  mc.calculatePrice();
+  mc.runMoreSimulations(500);  // same result as 1500 fresh paths
+  EXPECT_EQ(*mc.cacheKey(), *MonteCarlo(opt, 1500, 5u).cacheKey());
+
+  PriceCache cache;
+  MonteCarlo unseeded(opt, 1000);
+  cache.price(unseeded);
+  EXPECT_EQ(cache.getStats().size, 0u);
+}
+
+TEST(PriceCache, MonteCarloHitMatchesFreshRunWithStandardError) {
+  PriceCache cache;
+  Option opt = Option::createCall(100, 100, 1, 0.05, 0.2);
+  MonteCarlo a(opt, 20000, 9u);
+  const CachedResult miss = cache.price(a);
+  MonteCarlo b(opt, 20000, 9u);
+  const CachedResult hit = cache.price(b);
+  EXPECT_DOUBLE_EQ(hit.value, miss.value);
+  EXPECT_DOUBLE_EQ(hit.standardError, a.getStandardError());
+  EXPECT_GT(hit.standardError, 0.0);
+  EXPECT_DOUBLE_EQ(MonteCarlo(opt, 20000, 9u).calculatePrice(), hit.value);
+}
+
+TEST(PriceCache, EvictsLeastRecentlyUsed) {
+  PriceCache cache(PriceCache::Config{2, 1, 0});
+  auto key = [](double K) {
+    return *BlackScholes(Option::createCall(100, K, 1, 0.05, 0.2)).cacheKey();
+  };
+  cache.insert(key(90), {1.0, 0.0});
+  cache.insert(key(100), {2.0, 0.0});
+  ASSERT_TRUE(cache.find(key(90)));  // 90 is now most recent
+  cache.insert(key(110), {3.0, 0.0});
+
+  EXPECT_TRUE(cache.find(key(90)));
+  EXPECT_FALSE(cache.find(key(100)));
+  EXPECT_TRUE(cache.find(key(110)));
+  EXPECT_EQ(cache.getStats().evictions, 1u);
+  EXPECT_EQ(cache.getStats().size, 2u);
+
+  cache.clear();
+  EXPECT_EQ(cache.getStats().size, 0u);
+}
+
+TEST(PriceCache, QuantizationMergesNearbyInputs) {
+  Option base = Option::createCall(100, 100, 1, 0.05, 0.2);
+  Option near = Option::createCall(100 + 1e-10, 100, 1, 0.05, 0.2);
+  Option far = Option::createCall(100.01, 100, 1, 0.05, 0.2);
+
+  BlackScholes basePricer(base), nearPricer(near), farPricer(far);
+  PriceCache exact;
+  exact.price(basePricer);
+  exact.price(nearPricer);
+  EXPECT_EQ(exact.getStats().hits, 0u);
+
+  PriceCache loose(PriceCache::Config{1024, 4, 24});
+  loose.price(basePricer);
+  loose.price(nearPricer);
+  loose.price(farPricer);
+  EXPECT_EQ(loose.getStats().hits, 1u);
+  EXPECT_EQ(loose.getStats().size, 2u);
+
+  EXPECT_THROW(PriceCache(PriceCache::Config{0, 1, 0}), std::invalid_argument);
+  EXPECT_THROW(PriceCache(PriceCache::Config{8, 1, 60}),
+               std::invalid_argument);
+}
+
+TEST(PriceCache, ConcurrentLookupsAreConsistent) {
+  PriceCache cache(PriceCache::Config{256, 8, 0});
+  std::vector<std::jthread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache] {
+      for (int i = 0; i < 2000; ++i) {
+        BlackScholes bs(
+            Option::createCall(100, 80 + (i % 64), 1, 0.05, 0.2));
+        const double cached = cache.price(bs).value;
+        ASSERT_DOUBLE_EQ(cached, bs.calculatePrice());
+      }
+    });
+  }
+  threads.clear();
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits + stats.misses, 8000u);
+  EXPECT_LE(stats.size, 64u);
+  EXPECT_GT(stats.hitRate(), 0.9);
+}
+
+TEST(PriceCache, BatchRecordsShareEntries) {
+  PriceCache cache;
+  BatchConfig config;
+  config.engine = BatchEngine::MONTE_CARLO;
+  config.numSimulations = 5000;
+  config.seedByContract = true;
+  config.cache = &cache;
+
+  OptionRecord rec{0, OptionType::PUT, 100, 95, 0.5, 0.02, 0.3, 0.0, 0.0};
+  const BatchResult first = batch::priceRecord(rec, config);
+  rec.id = 7;  // same contract in another book
+  const BatchResult second = batch::priceRecord(rec, config);
+  EXPECT_DOUBLE_EQ(first.value, second.value);
+  EXPECT_DOUBLE_EQ(first.standardError, second.standardError);
+  EXPECT_EQ(cache.getStats().hits, 1u);
+}
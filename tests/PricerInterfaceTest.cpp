@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <vector>
+
 #include "BlackScholes.h"
 #include "MonteCarlo.h"
 #include "Option.h"
@@ -16,4 +19,38 @@ TEST(PricerInterface, CacheAndFlags) {
   MonteCarlo mc(opt, 10000, 1u);
   mc.calculatePrice();
   EXPECT_THROW(mc.calculateVaR(-0.1), std::invalid_argument);
-}
\ No newline at end of file
+}
+
+TEST(PricerInterface, OwnsOptionCopy) {
+  std::vector<std::unique_ptr<Pricer>> pool;
+  {
+    Option opt = Option::createPut(100, 105, 0.5, 0.03, 0.25);
+    pool.push_back(std::make_unique<BlackScholes>(opt));
+  }  // opt is gone, the pricer keeps its own copy
+  EXPECT_DOUBLE_EQ(pool.front()->getOption().getStrikePrice(), 105.0);
+  EXPECT_GT(pool.front()->calculatePrice(), 0.0);
+}
+
+TEST(PricerInterface, ResetRebindsAndClearsCache) {
+  Option a = Option::createCall(100, 100, 1, 0.05, 0.2);
+  Option b = Option::createCall(100, 120, 1, 0.05, 0.2);
+  BlackScholes bs(a);
+  double pa = bs.calculatePrice();
+  bs.reset(b);
+  EXPECT_FALSE(bs.isPriceCalculated());
+  EXPECT_LT(bs.calculatePrice(), pa);
+  EXPECT_DOUBLE_EQ(BlackScholes(b).calculatePrice(), bs.getPrice());
+}
+
+TEST(PricerInterface, PooledMonteCarloMatchesFreshInstance) {
+  Option a = Option::createCall(100, 100, 1, 0.05, 0.2);
+  Option b = Option::createPut(90, 100, 0.5, 0.01, 0.3, 0.02);
+  MonteCarlo pooled(a, 20000, 5u);
+  pooled.calculatePrice();
+  pooled.reset(b, 9u);
+  EXPECT_FALSE(pooled.isPriceCalculated());
+
+  MonteCarlo fresh(b, 20000, 9u);
+  EXPECT_DOUBLE_EQ(pooled.calculatePrice(), fresh.calculatePrice());
+  EXPECT_DOUBLE_EQ(pooled.getStandardError(), fresh.getStandardError());
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "BlackScholes.h"
+#include "PricingService.h"
+#include "ShmRing.h"
+
+namespace {
+std::string uniqueName(const char* tag) {
+  return std::string("mcp_test_") + tag + "_" +
+         std::to_string(::testing::UnitTest::GetInstance()->random_seed());
+}
+}  // namespace
+
+TEST(ShmRing, FifoAndCapacity) {
+  SpscRing<int, 4> ring;
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.tryPush(i));
+  EXPECT_FALSE(ring.tryPush(99));
+  int v = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.tryPop(v));
+    EXPECT_EQ(v, i);
+  }
+  EXPECT_FALSE(ring.tryPop(v));
+}
+
+TEST(PricingService, PricesRequestsFromClients) {
+  PricingService::Config cfg;
+  cfg.name = uniqueName("price");
+  PricingService service(cfg);
+  std::jthread server([&](std::stop_token st) { service.run(st); });
+
+  PricingClient client(cfg.name);
+  const double expected =
+      BlackScholes(Option::createPut(100, 105, 0.5, 0.03, 0.25, 0.01))
+          .calculatePrice();
+  PricingResponse bs = client.price(PricingRequest{
+      1, ServiceEngine::BLACK_SCHOLES, OptionType::PUT, 100, 105, 0.5, 0.03,
+      0.25, 0.01, 0.0});
+  EXPECT_EQ(bs.status, 0u);
+  EXPECT_DOUBLE_EQ(bs.value, expected);
+
+  PricingResponse iv = client.price(PricingRequest{
+      2, ServiceEngine::IMPLIED_VOL, OptionType::PUT, 100, 105, 0.5, 0.03,
+      0.0, 0.01, expected});
+  EXPECT_EQ(iv.status, 0u);
+  EXPECT_NEAR(iv.value, 0.25, 1e-6);
+
+  PricingResponse bad = client.price(PricingRequest{
+      3, ServiceEngine::BLACK_SCHOLES, OptionType::CALL, -5, 100, 1, 0.01,
+      0.2, 0.0, 0.0});
+  EXPECT_NE(bad.status, 0u);
+
+  // pipelined requests come back in one or more batches
+  for (std::uint64_t id = 10; id < 60; ++id) {
+    ASSERT_TRUE(client.trySubmit(PricingRequest{
+        id, ServiceEngine::BLACK_SCHOLES, OptionType::CALL, 100,
+        80.0 + static_cast<double>(id), 1, 0.05, 0.2, 0.0, 0.0}));
+  }
+  int received = 0;
+  PricingResponse resp;
+  while (received < 50) {
+    if (client.tryReceive(resp)) ++received;
+  }
+  EXPECT_GE(service.getStats().requests, 53u);
+  EXPECT_EQ(service.getStats().clients, 1u);
+}
+
+TEST(PricingService, ResponsesKeepSubmissionOrder) {
+  PricingService::Config cfg;
+  cfg.name = uniqueName("order");
+  PricingService service(cfg);
+  std::jthread server([&](std::stop_token st) { service.run(st); });
+
+  // falling spots and mixed engines: a batch sorted by (engine, S) would
+  // reverse them
+  PricingClient client(cfg.name);
+  for (std::uint64_t id = 1; id <= 40; ++id) {
+    const double spot = 140.0 - static_cast<double>(id);
+    ASSERT_TRUE(client.trySubmit(PricingRequest{
+        id, id % 2 ? ServiceEngine::IMPLIED_VOL : ServiceEngine::BLACK_SCHOLES,
+        OptionType::CALL, spot, 100, 1, 0.05, 0.2, 0.0, spot - 90.0}));
+  }
+  // price() reads past the pipelined responses and keeps them
+  const PricingResponse last = client.price(PricingRequest{
+      100, ServiceEngine::BLACK_SCHOLES, OptionType::CALL, 100, 100, 1, 0.05,
+      0.2, 0.0, 0.0});
+  EXPECT_EQ(last.requestId, 100u);
+  PricingResponse resp;
+  for (std::uint64_t id = 1; id <= 40; ++id) {
+    ASSERT_TRUE(client.tryReceive(resp));
+    EXPECT_EQ(resp.requestId, id);
+  }
+  EXPECT_FALSE(client.tryReceive(resp));
+}
+
+TEST(PricingService, ControlSocketStatsAndStop) {
+  PricingService::Config cfg;
+  cfg.name = uniqueName("control");
+  PricingService service(cfg);
+  std::thread server([&] { service.run(); });
+
+  std::string stats = PricingClient::control(cfg.name, "STATS");
+  EXPECT_NE(stats.find("requests=0"), std::string::npos);
+  EXPECT_EQ(PricingClient::control(cfg.name, "STOP"), "OK");
+  server.join();  // STOP ends the serve loop
+}
+
+TEST(PricingService, RefusesToReplaceLiveDaemon) {
+  PricingService::Config cfg;
+  cfg.name = uniqueName("twice");
+  PricingService service(cfg);
+  std::jthread server([&](std::stop_token st) { service.run(st); });
+  EXPECT_THROW(PricingService second(cfg), std::runtime_error);
+
+  // the first daemon keeps its segment and socket
+  PricingClient client(cfg.name);
+  EXPECT_EQ(client.price(PricingRequest{1, ServiceEngine::BLACK_SCHOLES,
+                                        OptionType::CALL, 100, 100, 1, 0.05,
+                                        0.2, 0.0, 0.0})
+                .status,
+            0u);
+  EXPECT_NE(PricingClient::control(cfg.name, "STATS").find("requests=1"),
+            std::string::npos);
+}
+
+TEST(PricingService, ReplacesSegmentOfDeadDaemon) {
+  PricingService::Config cfg;
+  cfg.name = uniqueName("crashed");
+  const pid_t child{::fork()};
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // dies without running the destructor, leaving segment and socket
+    PricingService crashed(cfg);
+    ::_exit(0);
+  }
+  int status{0};
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+
+  PricingService service(cfg);
+  std::jthread server([&](std::stop_token st) { service.run(st); });
+  PricingClient client(cfg.name);
+  EXPECT_EQ(client.price(PricingRequest{1, ServiceEngine::BLACK_SCHOLES,
+                                        OptionType::PUT, 100, 100, 1, 0.05,
+                                        0.2, 0.0, 0.0})
+                .status,
+            0u);
+}
+
+TEST(PricingService, FullResponseRingDoesNotStallOtherClients) {
+  PricingService::Config cfg;
+  cfg.name = uniqueName("slow");
+  cfg.threads = 3;
+  cfg.parallelThreshold = 64;
+  PricingService service(cfg);
+  std::jthread server([&](std::stop_token st) { service.run(st); });
+
+  // the slow client sends more than its response ring holds, reading nothing
+  PricingClient slow(cfg.name);
+  constexpr std::uint64_t SENT{1500};
+  for (std::uint64_t id = 0; id < SENT; ++id) {
+    const PricingRequest req{id, ServiceEngine::BLACK_SCHOLES,
+                             OptionType::CALL, 100, 50.0 + 0.05 * id, 1,
+                             0.05, 0.2, 0.0, 0.0};
+    while (!slow.trySubmit(req)) std::this_thread::yield();
+  }
+
+  PricingClient fast(cfg.name);
+  const PricingResponse resp = fast.price(PricingRequest{
+      7, ServiceEngine::BLACK_SCHOLES, OptionType::PUT, 100, 100, 1, 0.05,
+      0.2, 0.0, 0.0});
+  EXPECT_EQ(resp.status, 0u);
+
+  // the slow client still gets every response, each priced correctly
+  std::vector<bool> seen(SENT, false);
+  std::uint64_t received = 0;
+  PricingResponse r;
+  while (received < SENT) {
+    if (!slow.tryReceive(r)) continue;
+    ASSERT_LT(r.requestId, SENT);
+    EXPECT_FALSE(seen[r.requestId]);
+    seen[r.requestId] = true;
+    EXPECT_DOUBLE_EQ(r.value,
+                     BlackScholes::price(OptionType::CALL, 100,
+                                         50.0 + 0.05 * r.requestId, 1, 0.05,
+                                         0.2, 0.0));
+    ++received;
+  }
+}
+
+TEST(PricingService, ClientFailsWithoutService) {
+  EXPECT_THROW(PricingClient client(uniqueName("missing")), std::runtime_error);
+}
+#endif
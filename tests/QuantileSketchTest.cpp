@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "QuantileSketch.h"
+
+TEST(QuantileSketch, QuantilesWithinRelativeAccuracy) {
+  std::mt19937 rng(11);
+  std::lognormal_distribution<double> dist(0.0, 1.0);
+  QuantileSketch sketch;
+  std::vector<double> values;
+  for (int i = 0; i < 20000; ++i) {
+    const double x = i % 4 == 0 ? 0.0 : dist(rng);
+    values.push_back(x);
+    sketch.add(x);
+  }
+  std::ranges::sort(values);
+  for (double q : {0.01, 0.05, 0.25, 0.5, 0.9, 0.99}) {
+    const double exact = values[static_cast<std::size_t>(q * values.size())];
+    EXPECT_NEAR(sketch.quantile(q), exact,
+                exact * sketch.relativeAccuracy() + 1e-300)
+        << "q=" << q;
+  }
+  EXPECT_EQ(sketch.count(), 20000u);
+  EXPECT_DOUBLE_EQ(sketch.quantile(0.1), 0.0);  // a quarter are zeros
+}
+
+TEST(QuantileSketch, MergeEqualsSingleSketch) {
+  QuantileSketch all, left, right;
+  for (int i = 1; i <= 1000; ++i) {
+    all.add(i * 0.5);
+    (i % 2 ? left : right).add(i * 0.5);
+  }
+  left.merge(right);
+  for (double q : {0.0, 0.3, 0.7, 1.0}) {
+    EXPECT_DOUBLE_EQ(left.quantile(q), all.quantile(q));
+  }
+  EXPECT_THROW(left.merge(QuantileSketch(4)), std::invalid_argument);
+}
+
+TEST(QuantileSketch, SaveLoadRoundTrip) {
+  QuantileSketch sketch(9);
+  for (int i = 0; i < 500; ++i) sketch.add(i * 1.7);
+  std::stringstream buf;
+  sketch.save(buf);
+  const QuantileSketch loaded = QuantileSketch::load(buf);
+  EXPECT_EQ(loaded.count(), sketch.count());
+  EXPECT_DOUBLE_EQ(loaded.quantile(0.42), sketch.quantile(0.42));
+
+  std::stringstream bad("sketch 7 10 0 1 500 3");
+  EXPECT_THROW(QuantileSketch::load(bad), std::runtime_error);
+}
+
+TEST(QuantileSketch, RejectsInvalidInput) {
+  QuantileSketch sketch;
+  EXPECT_THROW(sketch.add(-1.0), std::invalid_argument);
+  EXPECT_EQ(sketch.count(), 0u);
+  EXPECT_THROW(sketch.quantile(1.5), std::invalid_argument);
+  EXPECT_THROW(QuantileSketch(0), std::invalid_argument);
+}
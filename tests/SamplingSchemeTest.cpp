@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "BlackScholes.h"
+#include "MonteCarlo.h"
+#include "Option.h"
+#include "TestUtils.h"
+
+namespace {
+MonteCarlo importance(const Option& option, unsigned long paths,
+                      unsigned int seed) {
+  MonteCarlo mc(option, paths, seed);
+  mc.setSamplingScheme(SamplingScheme::IMPORTANCE);
+  return mc;
+}
+}  // namespace
+
+TEST(ImportanceSampling, DeepOutOfTheMoneyMatchesBlackScholes) {
+  for (const Option& option :
+       {Option::createPut(100, 50, 1.0, 0.03, 0.2),
+        Option::createCall(100, 170, 0.5, 0.01, 0.25, 0.02),
+        Option::createPut(150, 50, 0.75, 0.02, 0.35, 0.05)}) {
+    MonteCarlo mc{importance(option, 20000, 7u)};
+    const double price{mc.calculatePrice()};
+    BlackScholes bs(option);
+    EXPECT_CLOSE_WITH_SE(price, bs.calculatePrice(), mc.getStandardError(),
+                         4.0, "importance-sampled vs BS");
+    EXPECT_GT(mc.getStandardError(), 0.0);
+  }
+}
+
+TEST(ImportanceSampling, CutsTailVarianceByOrdersOfMagnitude) {
+  const Option put{Option::createPut(100, 50, 1.0, 0.03, 0.2)};
+  MonteCarlo plain(put, 200000, 11u);
+  plain.calculatePrice();
+  MonteCarlo shifted{importance(put, 200000, 11u)};
+  shifted.calculatePrice();
+  const double ratio{std::pow(
+      plain.getStandardError() / shifted.getStandardError(), 2.0)};
+  // the variance ratio is how many times fewer paths reach the same SE
+  EXPECT_GT(ratio, 100.0);
+  EXPECT_LT(shifted.getImportanceShift(), -3.0);  // mode moved past the strike
+}
+
+TEST(ImportanceSampling, OptimalShiftSolvesSaddlePoint) {
+  const Option call{Option::createCall(100, 140, 1.0, 0.05, 0.2)};
+  const double theta{MonteCarlo::optimalImportanceShift(call)};
+  const double a{(0.05 - 0.5 * 0.04) * 1.0};
+  const double b{0.2};
+  const double x{100 * std::exp(a + b * theta)};
+  EXPECT_GT(x, 140.0);
+  EXPECT_NEAR(b * x / (x - 140.0), theta, 1e-9);
+  EXPECT_EQ(MonteCarlo::optimalImportanceShift(
+                Option::createCall(100, 100, 0.0, 0.05, 0.2)),
+            0.0);
+}
+
+TEST(ImportanceSampling, GreeksAndIntervalStayConsistent) {
+  const Option call{Option::createCall(100, 130, 1.0, 0.05, 0.2)};
+  MonteCarlo mc{importance(call, 100000, 3u)};
+  BlackScholes bs(call);
+  const Greeks g{mc.calculateGreeks()};
+  const Greeks expected{bs.calculateGreeks()};
+  EXPECT_NEAR(g.delta, expected.delta, 0.01);
+  EXPECT_NEAR(g.vega, expected.vega, 0.03 * expected.vega);
+  EXPECT_NEAR(g.rho, expected.rho, 0.03 * expected.rho);
+  const auto [lo, hi]{mc.getConfidenceInterval(0.99)};
+  EXPECT_LT(lo, bs.calculatePrice());
+  EXPECT_GT(hi, bs.calculatePrice());
+  // the weighted VaR sits where the plain one does
+  MonteCarlo plain(call, 100000, 3u);
+  plain.calculatePrice();
+  EXPECT_NEAR(mc.calculateVaR(0.95), plain.calculateVaR(0.95), 1.0);
+}
+
+TEST(ImportanceSampling, CheckpointsAndExtensionsKeepTheScheme) {
+  const Option put{Option::createPut(100, 60, 1.0, 0.03, 0.25)};
+  MonteCarlo full{importance(put, 30000, 5u)};
+  const double fullPrice{full.calculatePrice()};
+
+  MonteCarlo first{importance(put, 10000, 5u)};
+  first.calculatePrice();
+  std::stringstream buf;
+  first.saveCheckpoint(buf);
+  MonteCarlo resumed{MonteCarlo::restoreCheckpoint(buf)};
+  EXPECT_EQ(resumed.getSamplingScheme(), SamplingScheme::IMPORTANCE);
+  EXPECT_EQ(resumed.runMoreSimulations(20000), fullPrice);
+  EXPECT_THROW(resumed.calculateVaR(0.5), std::runtime_error);
+
+  EXPECT_NE(full.cacheKey(), MonteCarlo(put, 30000, 5u).cacheKey());
+  EXPECT_THROW(full.setSamplingScheme(SamplingScheme::PLAIN),
+               std::runtime_error);
+}
+
+namespace {
+MonteCarlo stratified(const Option& option, unsigned long paths,
+                      unsigned int seed, unsigned strata,
+                      StratumAllocation allocation =
+                          StratumAllocation::PROPORTIONAL) {
+  MonteCarlo mc(option, paths, seed);
+  mc.setStratification(strata, allocation);
+  return mc;
+}
+}  // namespace
+
+TEST(StratifiedSampling, MatchesBlackScholesWithSmallerError) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  BlackScholes bs(call);
+  MonteCarlo plain(call, 50000, 9u);
+  plain.calculatePrice();
+  for (const StratumAllocation allocation :
+       {StratumAllocation::PROPORTIONAL, StratumAllocation::NEYMAN}) {
+    MonteCarlo mc{stratified(call, 50000, 9u, 200, allocation)};
+    const double price{mc.calculatePrice()};
+    EXPECT_CLOSE_WITH_SE(price, bs.calculatePrice(), mc.getStandardError(),
+                         4.0, "stratified vs BS");
+    EXPECT_LT(mc.getStandardError(), plain.getStandardError() / 10.0);
+  }
+}
+
+TEST(StratifiedSampling, NeymanFavoursHighVarianceStrata) {
+  // out-of-the-money call: the lower strata all pay zero
+  const Option call{Option::createCall(100, 120, 1.0, 0.05, 0.2)};
+  MonteCarlo proportional{stratified(call, 40000, 4u, 20)};
+  MonteCarlo neyman{
+      stratified(call, 40000, 4u, 20, StratumAllocation::NEYMAN)};
+  proportional.calculatePrice();
+  neyman.calculatePrice();
+  EXPECT_LT(neyman.getStandardError(), proportional.getStandardError());
+  const std::vector<unsigned long> counts{neyman.getStratumCounts()};
+  ASSERT_EQ(counts.size(), 20u);
+  EXPECT_GT(counts.back(), 10 * counts.front());
+  unsigned long total{0};
+  for (const unsigned long c : counts) total += c;
+  EXPECT_EQ(total, 40000u);
+}
+
+TEST(StratifiedSampling, ReportedErrorMatchesSpreadAcrossSeeds) {
+  const Option put{Option::createPut(100, 95, 0.5, 0.02, 0.3)};
+  constexpr int RUNS{60};
+  double sum{0.0}, squares{0.0}, reported{0.0};
+  for (int k{0}; k < RUNS; ++k) {
+    MonteCarlo mc{stratified(put, 4000, 100u + k, 40)};
+    const double price{mc.calculatePrice()};
+    sum += price;
+    squares += price * price;
+    reported += mc.getStandardError();
+  }
+  const double mean{sum / RUNS};
+  const double spread{std::sqrt((squares - RUNS * mean * mean) / (RUNS - 1))};
+  EXPECT_NEAR(spread / (reported / RUNS), 1.0, 0.35);
+}
+
+TEST(StratifiedSampling, ExtendsStrataIncrementally) {
+  const Option put{Option::createPut(100, 105, 0.75, 0.03, 0.25, 0.01)};
+  MonteCarlo extended{stratified(put, 10000, 6u, 50)};
+  extended.calculatePrice();
+  extended.runMoreSimulations(15000);
+  MonteCarlo fresh{stratified(put, 25000, 6u, 50)};
+  EXPECT_EQ(extended.getPrice(), fresh.calculatePrice());
+  EXPECT_EQ(extended.getStandardError(), fresh.getStandardError());
+  EXPECT_EQ(extended.getStratumCounts(), fresh.getStratumCounts());
+
+  MonteCarlo neyman{stratified(put, 10000, 6u, 50, StratumAllocation::NEYMAN)};
+  neyman.calculatePrice();
+  const double before{neyman.getStandardError()};
+  neyman.runMoreSimulations(30000);
+  EXPECT_LT(neyman.getStandardError(), before / 1.5);
+
+  // checkpoints carry the strata
+  std::stringstream buf;
+  extended.saveCheckpoint(buf);
+  MonteCarlo restored{MonteCarlo::restoreCheckpoint(buf)};
+  EXPECT_EQ(restored.getPrice(), extended.getPrice());
+  EXPECT_EQ(restored.getStandardError(), extended.getStandardError());
+  EXPECT_EQ(restored.runMoreSimulations(5000),
+            extended.runMoreSimulations(5000));
+}
+
+TEST(StratifiedSampling, SplitNeymanRunsAreNotCacheable) {
+  // the Neyman pilot is sized by the first run, so an extended or restored
+  // run differs from a fresh run of the same length and must not share its
+  // cache key; proportional runs do match and keep theirs
+  const Option put{Option::createPut(100, 105, 0.75, 0.03, 0.25, 0.01)};
+  MonteCarlo neyman{stratified(put, 10000, 6u, 50, StratumAllocation::NEYMAN)};
+  neyman.calculatePrice();
+  ASSERT_TRUE(neyman.cacheKey().has_value());
+  std::stringstream buf;
+  neyman.saveCheckpoint(buf);
+  EXPECT_FALSE(MonteCarlo::restoreCheckpoint(buf).cacheKey().has_value());
+  neyman.runMoreSimulations(15000);
+  EXPECT_FALSE(neyman.cacheKey().has_value());
+
+  MonteCarlo proportional{stratified(put, 10000, 6u, 50)};
+  proportional.calculatePrice();
+  proportional.runMoreSimulations(15000);
+  EXPECT_EQ(proportional.cacheKey(), stratified(put, 25000, 6u, 50).cacheKey());
+}
+
+TEST(StratifiedSampling, GreeksAndVaRUseStratumWeights) {
+  const Option call{Option::createCall(100, 110, 1.0, 0.04, 0.25)};
+  MonteCarlo mc{stratified(call, 40000, 2u, 64, StratumAllocation::NEYMAN)};
+  BlackScholes bs(call);
+  const Greeks g{mc.calculateGreeks()};
+  const Greeks expected{bs.calculateGreeks()};
+  EXPECT_NEAR(g.delta, expected.delta, 0.005);
+  EXPECT_NEAR(g.vega, expected.vega, 0.02 * expected.vega);
+  MonteCarlo plain(call, 200000, 2u);
+  plain.calculatePrice();
+  EXPECT_NEAR(mc.calculateVaR(0.8), plain.calculateVaR(0.8), 0.5);
+  EXPECT_THROW(mc.getPartial(), std::runtime_error);
+}
+
+TEST(StratifiedSampling, RejectsInvalidSetup) {
+  const Option call{Option::createCall(100, 100, 1.0, 0.05, 0.2)};
+  MonteCarlo mc(call, 100, 1u);
+  EXPECT_THROW(mc.setStratification(0), std::invalid_argument);
+  EXPECT_THROW(mc.setStratification(51), std::invalid_argument);
+  mc.setStratification(50);
+  mc.calculatePrice();
+  EXPECT_THROW(mc.setStratification(10), std::runtime_error);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "BlackScholes.h"
+#include "MonteCarlo.h"
+#include "ScenarioLadder.h"
+#include "TestUtils.h"
+
+TEST(ScenarioLadder, UnbumpedCellMatchesMonteCarlo) {
+  Option opt = Option::createCall(100, 100, 1, 0.05, 0.2);
+  ScenarioLadder ladder(opt, 50000, 42u);
+  const ScenarioBump none{};
+  ScenarioResult res = ladder.run({&none, 1}, {&none, 1});
+
+  MonteCarlo mc(opt, 50000, 42u);
+  EXPECT_NEAR(res.price(0, 0), mc.calculatePrice(), 1e-9);
+  EXPECT_NEAR(res.standardError(0, 0), mc.getStandardError(), 1e-9);
+}
+
+TEST(ScenarioLadder, SpotVolGridCloseToBS) {
+  Option opt = Option::createPut(100, 100, 0.5, 0.03, 0.25, 0.01);
+  ScenarioLadder ladder(opt, 100000, 7u);
+  auto spots = ScenarioLadder::spotLadder(-0.10, 0.10, 21);
+  auto vols = ScenarioLadder::volLadder(-0.05, 0.05, 11);
+  ScenarioResult res = ladder.run(spots, vols, 4);
+
+  ASSERT_EQ(res.rows, 21u);
+  ASSERT_EQ(res.cols, 11u);
+  for (std::size_t i = 0; i < res.rows; i += 5) {
+    for (std::size_t j = 0; j < res.cols; j += 5) {
+      Option bumped = Option::createPut(100 * (1 + spots[i].spot), 100, 0.5,
+                                        0.03, 0.25 + vols[j].volatility, 0.01);
+      EXPECT_CLOSE_WITH_SE(res.price(i, j),
+                           BlackScholes(bumped).calculatePrice(),
+                           res.standardError(i, j), 4.0, "ladder vs BS");
+    }
+  }
+}
+
+TEST(ScenarioLadder, SharedNormalsGiveMonotoneSpotProfile) {
+  Option opt = Option::createCall(100, 100, 1, 0.05, 0.2);
+  ScenarioLadder ladder(opt, 20000, 3u);
+  auto spots = ScenarioLadder::spotLadder(-0.2, 0.2, 41);
+  const ScenarioBump none{};
+  ScenarioResult res = ladder.run(spots, {&none, 1}, 3);
+  for (std::size_t i = 1; i < res.rows; ++i) {
+    EXPECT_GT(res.price(i, 0), res.price(i - 1, 0));
+  }
+}
+
+TEST(ScenarioLadder, RejectsInvalidScenario) {
+  Option opt = Option::createCall(100, 100, 1, 0.05, 0.2);
+  ScenarioLadder ladder(opt, 1000, 1u);
+  ScenarioBump crash{};
+  crash.volatility = -0.5;
+  const ScenarioBump none{};
+  EXPECT_THROW(ladder.run({&crash, 1}, {&none, 1}), std::invalid_argument);
+}
+
+TEST(ScenarioLadder, StandardErrorStableDeepInTheMoney) {
+  // payoffs ≈ 10^8 with spread 0.1: raw second moments would cancel away
+  Option opt = Option::createCall(1e8, 1.0, 1.0, 0.0, 1e-9);
+  ScenarioLadder ladder(opt, 10000, 5u);
+  const ScenarioBump none{};
+  ScenarioResult res = ladder.run({&none, 1}, {&none, 1});
+  EXPECT_NEAR(res.standardError(0, 0), 1e-3, 5e-5);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include "BlackScholes.h"
+#include "MonteCarlo.h"
+#include "RandomStreams.h"
+#include "ShardedMonteCarlo.h"
+
+namespace {
+Option testOption() { return Option::createCall(100, 95, 0.5, 0.04, 0.3); }
+}  // namespace
+
+TEST(RandomStreams, SubstreamsAreJumpAheadBlocks) {
+  if (!random_streams::JUMP_AHEAD) GTEST_SKIP();
+  // stream 1 of a stream split with a tiny stride starts where stream 0
+  // would be after `stride` draws
+  const std::uint64_t streams = random_streams::stride(1) / 1000;
+  const std::uint64_t stride = random_streams::stride(streams);
+  random_streams::Engine base(7u);
+  base.discard(stride);
+  random_streams::Engine second(random_streams::seed(7u, 1, streams));
+  EXPECT_EQ(base(), second());
+  EXPECT_EQ(random_streams::seed(7u, 0, 4), 7u);
+  // an arbitrary offset lands on the same draw
+  base.discard(12344);
+  random_streams::Engine offset(random_streams::seedAt(7u, stride + 12345));
+  EXPECT_EQ(base(), offset());
+}
+
+TEST(MonteCarloPartial, SingleShardMatchesMonteCarlo) {
+  MonteCarlo mc(testOption(), 30000, 9u);
+  const double price = mc.calculatePrice();
+  const MonteCarloPartial partial = mc.getPartial(true);
+  EXPECT_EQ(partial.price(testOption()), price);
+  EXPECT_EQ(partial.standardError(testOption()), mc.getStandardError());
+  const Greeks g = mc.calculateGreeks();
+  const Greeks pg = partial.greeks(testOption());
+  EXPECT_EQ(pg.delta, g.delta);
+  EXPECT_EQ(pg.vega, g.vega);
+}
+
+TEST(MonteCarloPartial, MergeMatchesPooledStatistics) {
+  MonteCarlo a(testOption(), 20000, 1u), b(testOption(), 12000, 2u);
+  a.calculatePrice();
+  b.calculatePrice();
+  MonteCarloPartial merged = a.getPartial();
+  merged.merge(b.getPartial());
+  EXPECT_EQ(merged.paths, 32000u);
+  const double pooled = (a.getPrice() * 20000 + b.getPrice() * 12000) / 32000;
+  EXPECT_NEAR(merged.price(testOption()), pooled, 1e-12);
+  EXPECT_LT(merged.standardError(testOption()), a.getStandardError());
+
+  std::stringstream buf;
+  merged.save(buf);
+  const MonteCarloPartial loaded = MonteCarloPartial::load(buf);
+  EXPECT_EQ(loaded.price(testOption()), merged.price(testOption()));
+  EXPECT_EQ(loaded.standardError(testOption()),
+            merged.standardError(testOption()));
+
+  MonteCarloPartial withGreeks = a.getPartial(true);
+  EXPECT_THROW(withGreeks.merge(b.getPartial()), std::invalid_argument);
+  EXPECT_THROW(MonteCarloPartial{}.price(testOption()), std::runtime_error);
+}
+
+TEST(ShardedMonteCarlo, ProcessesMatchInProcessRun) {
+  ShardedMonteCarlo sharded(testOption(), {4, 20000, 11u, true});
+  const MonteCarloPartial local = sharded.runInProcess(1);
+  const MonteCarloPartial threaded = sharded.runInProcess(3);
+  EXPECT_EQ(local.paths, 80000u);
+  EXPECT_EQ(threaded.price(testOption()), local.price(testOption()));
+
+#if defined(__unix__) || defined(__APPLE__)
+  const MonteCarloPartial forked = sharded.runProcesses(3);
+  EXPECT_EQ(forked.price(testOption()), local.price(testOption()));
+  EXPECT_EQ(forked.standardError(testOption()),
+            local.standardError(testOption()));
+  EXPECT_EQ(forked.greeks(testOption()).delta,
+            local.greeks(testOption()).delta);
+#endif
+
+  const double bs = BlackScholes(testOption()).calculatePrice();
+  EXPECT_NEAR(local.price(testOption()), bs,
+              4 * local.standardError(testOption()));
+  EXPECT_NEAR(local.greeks(testOption()).delta,
+              BlackScholes(testOption()).calculateGreeks().delta, 0.02);
+}
+
+TEST(ShardedMonteCarlo, ValidatesLayout) {
+  EXPECT_THROW(ShardedMonteCarlo(testOption(), {0, 1000, 1u, false}),
+               std::invalid_argument);
+  if (random_streams::JUMP_AHEAD) {
+    EXPECT_THROW(ShardedMonteCarlo(testOption(), {64, 50000000, 1u, false}),
+                 std::invalid_argument);
+  }
+  ShardedMonteCarlo ok(testOption(), {2, 1000, 1u, false});
+  EXPECT_THROW(ok.runShard(2), std::out_of_range);
+}